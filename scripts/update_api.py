@@ -1715,7 +1715,9 @@ def write_log_h_preamble(log_h):
   log_h.write('#include "util/mutex.h"\n')
   log_h.write('extern atomic<bool> g_z3_log_enabled;\n')
   log_h.write('void ctx_enable_logging();\n')
-  log_h.write('class z3_log_ctx { bool m_prev; public: z3_log_ctx() { ATOMIC_EXCHANGE(m_prev, g_z3_log_enabled, false); } ~z3_log_ctx() { if (m_prev) g_z3_log_enabled = true; } bool enabled() const { return m_prev; } };\n')
+  log_h.write('void ctx_flush_log();\n')
+  # the exchange is only performed when logging is enabled, so API calls do not write to the shared flag.
+  log_h.write('class z3_log_ctx { bool m_prev = false; public: z3_log_ctx() { if (g_z3_log_enabled) { ATOMIC_EXCHANGE(m_prev, g_z3_log_enabled, false); } } ~z3_log_ctx() { if (m_prev) g_z3_log_enabled = true; } bool enabled() const { return m_prev; } };\n')
   log_h.write('void SetR(void * obj);\nvoid SetO(void * obj, unsigned pos);\nvoid SetAO(void * obj, unsigned pos, unsigned idx);\n')
   log_h.write('#define RETURN_Z3(Z3RES) do { auto tmp_ret = Z3RES; if (_LOG_CTX.enabled()) { SetR(tmp_ret); } return tmp_ret; } while (0)\n')
 
@@ -0,0 +1,192 @@
+# -- /usr/bin/env python
+"""
+Runs a directory of SMT-LIB2 benchmarks with fixed random seeds, collects
+wall time, memory and solver statistics per benchmark and compares the
+results against a stored baseline.
+
+Benchmarks are grouped in categories by their set-logic command
+(QF_BV, QF_LIA, UFLIA, QF_S, NRA, Horn, MaxSAT for optimization
+commands and other). A benchmark regresses when its mean time is
+above the baseline by more than the given tolerance and the 95%
+confidence intervals of both measurements do not overlap.
+
+Exit status is 1 if a benchmark regressed, 0 otherwise.
+
+With --threads, the suite is instead run once per thread count, setting
+smt.threads and sat.threads, and the total time and speedup over the
+first thread count are reported per category.
+"""
+import argparse
+import json
+import logging
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+
+CATEGORIES = ["QF_BV", "QF_LIA", "UFLIA", "QF_S", "NRA", "Horn", "MaxSAT"]
+STAT_RE = re.compile(r":([\w\-\.]+)\s+([0-9]+(?:\.[0-9]+)?)")
+LOGIC_RE = re.compile(r"\(\s*set-logic\s+([\w\-]+)\s*\)")
+
+
+def category(path):
+    with open(path, "r", errors="replace") as f:
+        text = f.read()
+    if re.search(r"\((minimize|maximize|assert-soft)\b", text):
+        return "MaxSAT"
+    m = LOGIC_RE.search(text)
+    logic = m.group(1) if m else ""
+    if logic == "HORN" or "(declare-rel" in text:
+        return "Horn"
+    if logic in ("QF_NRA", "NRA"):
+        return "NRA"
+    if logic in ("QF_S", "QF_SLIA"):
+        return "QF_S"
+    if logic in CATEGORIES:
+        return logic
+    return "other"
+
+
+def collect(root):
+    files = []
+    for d, _, names in os.walk(root):
+        for n in names:
+            if n.endswith(".smt2"):
+                files.append(os.path.join(d, n))
+    return sorted(files)
+
+
+def run_one(z3, path, seed, timeout, params):
+    cmd = [z3, "-st", "-T:%d" % timeout,
+           "smt.random_seed=%d" % seed, "sat.random_seed=%d" % seed] + params + [path]
+    start = time.perf_counter()
+    p = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    wall = time.perf_counter() - start
+    stats = {k: float(v) for k, v in STAT_RE.findall(p.stdout)}
+    answers = [l.strip() for l in p.stdout.splitlines() if l.strip() in ("sat", "unsat", "unknown", "timeout")]
+    return wall, stats, answers
+
+
+def mean_ci(xs):
+    n = len(xs)
+    m = sum(xs) / n
+    if n < 2:
+        return m, 0.0
+    sd = math.sqrt(sum((x - m) ** 2 for x in xs) / (n - 1))
+    return m, 1.96 * sd / math.sqrt(n)
+
+
+def measure(z3, files, root, runs, seed, timeout, params):
+    results = {}
+    for path in files:
+        name = os.path.relpath(path, root)
+        times, mem, stats, answers = [], 0.0, {}, []
+        for i in range(runs):
+            wall, stats, answers = run_one(z3, path, seed + i, timeout, params)
+            times.append(wall)
+            mem = max(mem, stats.get("max-memory", 0.0))
+        m, ci = mean_ci(times)
+        results[name] = {
+            "category": category(path),
+            "time": m,
+            "ci": ci,
+            "memory": mem,
+            "answers": answers,
+            "stats": {k: stats[k] for k in ("conflicts", "decisions", "propagations", "restarts") if k in stats},
+        }
+        logging.info("%-8s %-50s %8.3fs +- %.3f %8.2fMB %s", results[name]["category"], name, m, ci, mem, " ".join(answers))
+    return results
+
+
+def compare(results, baseline, tolerance):
+    regressions = []
+    totals = {}
+    for name, r in sorted(results.items()):
+        cat = totals.setdefault(r["category"], [0.0, 0.0])
+        cat[0] += r["time"]
+        b = baseline.get(name)
+        if b is None:
+            continue
+        cat[1] += b["time"]
+        if b.get("answers") and r["answers"] != b["answers"]:
+            regressions.append("%s: answers changed from %s to %s" % (name, b["answers"], r["answers"]))
+        elif r["time"] > b["time"] * (1 + tolerance) and r["time"] - r["ci"] > b["time"] + b["ci"]:
+            regressions.append("%s: %.3fs +- %.3f, baseline %.3fs +- %.3f" % (name, r["time"], r["ci"], b["time"], b["ci"]))
+    for cat, (t, bt) in sorted(totals.items()):
+        if bt > 0:
+            logging.info("category %-8s %8.3fs baseline %8.3fs (%+.1f%%)", cat, t, bt, 100.0 * (t - bt) / bt)
+        else:
+            logging.info("category %-8s %8.3fs", cat, t)
+    return regressions
+
+
+def scaling(z3, files, root, runs, seed, timeout, params, threads):
+    totals = []
+    for t in threads:
+        logging.info("threads %d", t)
+        results = measure(z3, files, root, runs, seed, timeout,
+                          params + ["smt.threads=%d" % t, "sat.threads=%d" % t])
+        cats = {}
+        for r in results.values():
+            cats[r["category"]] = cats.get(r["category"], 0.0) + r["time"]
+        totals.append(cats)
+    for cat in sorted(totals[0]):
+        base = totals[0][cat]
+        for t, cats in zip(threads, totals):
+            logging.info("category %-8s threads %4d %8.3fs speedup %6.2f", cat, t, cats[cat],
+                         base / cats[cat] if cats[cat] > 0 else 0.0)
+    return totals
+
+
+def main(args):
+    logging.basicConfig(level=logging.INFO, format="%(message)s")
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--z3", required=True, help="z3 executable")
+    parser.add_argument("--suite", required=True, help="directory of .smt2 benchmarks, searched recursively")
+    parser.add_argument("--baseline", default=None, help="JSON file with baseline results")
+    parser.add_argument("--output", default=None, help="write the results as JSON to this file")
+    parser.add_argument("--update-baseline", action="store_true", help="overwrite the baseline with the results")
+    parser.add_argument("--runs", type=int, default=3, help="runs per benchmark, with consecutive seeds")
+    parser.add_argument("--seed", type=int, default=0, help="random seed of the first run")
+    parser.add_argument("--timeout", type=int, default=60, help="timeout per run in seconds")
+    parser.add_argument("--tolerance", type=float, default=0.05, help="relative slowdown tolerated before reporting")
+    parser.add_argument("--threads", default=None,
+                        help="comma separated thread counts, e.g. 1,2,4,8,16; report the speedup per thread count instead of comparing with the baseline")
+    parser.add_argument("--param", action="append", default=[],
+                        help="additional z3 parameter, e.g. thread_affinity=true; can be repeated")
+    pargs = parser.parse_args(args)
+
+    files = collect(pargs.suite)
+    if not files:
+        logging.error("no benchmarks found in %s", pargs.suite)
+        return 1
+    if pargs.threads:
+        threads = [int(t) for t in pargs.threads.split(",")]
+        totals = scaling(pargs.z3, files, pargs.suite, pargs.runs, pargs.seed, pargs.timeout, pargs.param, threads)
+        if pargs.output:
+            with open(pargs.output, "w") as f:
+                json.dump(dict(zip(map(str, threads), totals)), f, indent=1, sort_keys=True)
+        return 0
+    results = measure(pargs.z3, files, pargs.suite, pargs.runs, pargs.seed, pargs.timeout, pargs.param)
+    if pargs.output:
+        with open(pargs.output, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+    baseline = {}
+    if pargs.baseline and os.path.exists(pargs.baseline):
+        with open(pargs.baseline) as f:
+            baseline = json.load(f)
+    regressions = compare(results, baseline, pargs.tolerance)
+    if pargs.baseline and (pargs.update_baseline or not baseline):
+        with open(pargs.baseline, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+        logging.info("baseline written to %s", pargs.baseline)
+        return 0
+    for r in regressions:
+        logging.error("regression %s", r)
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,297 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    lackr_solver.cpp
+
+Abstract:
+
+    Incremental solver for QF_UFBV based on lazy Ackermannization.
+
+    Assertions are abstracted when they are added: every application of an
+    uninterpreted function (of positive arity) is replaced by a fresh constant.
+    The abstraction is passed to the wrapped UF-free solver.
+    check_sat runs the wrapped solver and checks the congruence of the
+    abstracted applications in its model. Violated congruence lemmas are
+    asserted to the wrapped solver, and the check is repeated.
+
+    The wrapped solver is reused across iterations and across calls to
+    check_sat, so learned clauses and lemmas are kept.
+    The abstraction is global, so it is not undone on pop.
+    Lemmas are asserted in the current scope of the wrapped solver.
+    After a pop they are found again if they are still needed.
+
+--*/
+
+#include "ast/ast_pp.h"
+#include "ast/ast_util.h"
+#include "ast/ast_translation.h"
+#include "model/model.h"
+#include "solver/solver_na2as.h"
+#include "tactic/generic_model_converter.h"
+#include "ackermannization/lackr_solver.h"
+
+class lackr_solver : public solver_na2as {
+    ast_manager&          m;
+    ref<solver>           m_solver;
+    expr_ref_vector       m_pinned;
+    obj_map<expr, expr*>  m_abstr;      // term -> abstraction
+    ptr_vector<app>       m_terms;      // f(abstr(args)) for each abstracted application
+    obj_map<app, app*>    m_term2const; // f(abstr(args)) -> fresh constant
+    ptr_vector<expr>      m_todo;
+    bool                  m_has_quantifiers = false;
+    unsigned              m_num_iterations = 0;
+    unsigned              m_num_lemmas = 0;
+
+    expr* abstract(expr* e) {
+        expr* r = nullptr;
+        if (m_abstr.find(e, r))
+            return r;
+        m_todo.push_back(e);
+        ptr_buffer<expr> args;
+        while (!m_todo.empty()) {
+            expr* t = m_todo.back();
+            if (m_abstr.contains(t)) {
+                m_todo.pop_back();
+                continue;
+            }
+            if (!is_app(t)) {
+                m_has_quantifiers |= is_quantifier(t);
+                m_pinned.push_back(t);
+                m_abstr.insert(t, t);
+                m_todo.pop_back();
+                continue;
+            }
+            app* a = to_app(t);
+            bool visited = true;
+            for (expr* arg : *a) {
+                if (!m_abstr.contains(arg)) {
+                    m_todo.push_back(arg);
+                    visited = false;
+                }
+            }
+            if (!visited)
+                continue;
+            m_todo.pop_back();
+            args.reset();
+            bool change = false;
+            for (expr* arg : *a) {
+                expr* b = m_abstr[arg];
+                change |= b != arg;
+                args.push_back(b);
+            }
+            app* b = change ? m.mk_app(a->get_decl(), args.size(), args.data()) : a;
+            m_pinned.push_back(a);
+            m_pinned.push_back(b);
+            if (is_uninterp(a) && a->get_num_args() > 0) {
+                app* c = nullptr;
+                if (!m_term2const.find(b, c)) {
+                    c = m.mk_fresh_const(a->get_decl()->get_name(), a->get_sort());
+                    m_pinned.push_back(c);
+                    m_terms.push_back(b);
+                    m_term2const.insert(b, c);
+                }
+                b = c;
+            }
+            m_abstr.insert(a, b);
+        }
+        return m_abstr[e];
+    }
+
+    /**
+       \brief Add congruence lemmas for the abstracted applications whose
+       arguments evaluate to the same values in mdl but whose abstractions do not.
+       Return the number of lemmas added.
+    */
+    unsigned refine(model& mdl) {
+        model::scoped_model_completion _scm(mdl, true);
+        obj_map<app, app*> value2term;
+        expr_ref_vector pinned(m), lemmas(m);
+        ptr_buffer<expr> vals;
+        for (app* t : m_terms) {
+            vals.reset();
+            for (expr* arg : *t) {
+                expr_ref v = mdl(arg);
+                pinned.push_back(v);
+                vals.push_back(v);
+            }
+            app_ref key(m.mk_app(t->get_decl(), vals.size(), vals.data()), m);
+            app* s = nullptr;
+            if (!value2term.find(key, s)) {
+                pinned.push_back(key);
+                value2term.insert(key, t);
+                continue;
+            }
+            app* c1 = m_term2const[s], *c2 = m_term2const[t];
+            if (mdl.are_equal(c1, c2))
+                continue;
+            expr_ref_vector eqs(m);
+            for (unsigned i = 0; i < t->get_num_args(); ++i)
+                if (s->get_arg(i) != t->get_arg(i))
+                    eqs.push_back(m.mk_eq(s->get_arg(i), t->get_arg(i)));
+            expr_ref lemma(m.mk_implies(mk_and(eqs), m.mk_eq(c1, c2)), m);
+            TRACE("ackermannize", tout << "lemma " << lemma << "\n";);
+            lemmas.push_back(lemma);
+        }
+        m_solver->assert_expr(lemmas);
+        m_num_lemmas += lemmas.size();
+        return lemmas.size();
+    }
+
+    /**
+       \brief Extend the model of the abstraction with interpretations of the
+       uninterpreted functions, given by the values of their abstracted applications.
+    */
+    void add_func_interps(model& mdl) {
+        model::scoped_model_completion _scm(mdl, true);
+        obj_map<func_decl, func_interp*> interps;
+        expr_ref_vector vals(m);
+        for (app* t : m_terms) {
+            func_decl* f = t->get_decl();
+            func_interp* fi = nullptr;
+            if (!interps.find(f, fi)) {
+                fi = alloc(func_interp, m, f->get_arity());
+                interps.insert(f, fi);
+            }
+            vals.reset();
+            for (expr* arg : *t)
+                vals.push_back(mdl(arg));
+            if (!fi->get_entry(vals.data()))
+                fi->insert_new_entry(vals.data(), mdl(m_term2const[t]));
+        }
+        for (auto const& kv : interps) {
+            kv.m_value->set_else(mdl.get_some_value(kv.m_key->get_range()));
+            mdl.register_decl(kv.m_key, kv.m_value);
+        }
+    }
+
+public:
+
+    lackr_solver(ast_manager& m, params_ref const& p, solver* s):
+        solver_na2as(m),
+        m(m),
+        m_solver(s),
+        m_pinned(m) {
+        solver::updt_params(p);
+        m_solver->set_produce_models(true);
+    }
+
+    solver* translate(ast_manager& dst_m, params_ref const& p) override {
+        lackr_solver* result = alloc(lackr_solver, dst_m, p, m_solver->translate(dst_m, p));
+        ast_translation tr(m, dst_m);
+        for (auto const& kv : m_abstr) {
+            expr* k = tr(kv.m_key), *v = tr(kv.m_value);
+            result->m_pinned.push_back(k);
+            result->m_pinned.push_back(v);
+            result->m_abstr.insert(k, v);
+        }
+        for (app* t : m_terms) {
+            app* s = tr(t), *c = tr(m_term2const[t]);
+            result->m_pinned.push_back(s);
+            result->m_pinned.push_back(c);
+            result->m_terms.push_back(s);
+            result->m_term2const.insert(s, c);
+        }
+        result->m_has_quantifiers = m_has_quantifiers;
+        if (mc0())
+            result->set_model_converter(mc0()->translate(tr));
+        return result;
+    }
+
+    void assert_expr_core(expr* t) override {
+        m_solver->assert_expr(abstract(t));
+    }
+
+    void push_core() override {
+        m_solver->push();
+    }
+
+    void pop_core(unsigned n) override {
+        m_solver->pop(n);
+    }
+
+    lbool check_sat_core2(unsigned num_assumptions, expr* const* assumptions) override {
+        if (m_has_quantifiers) {
+            set_reason_unknown("lackr: quantifiers are not supported");
+            return l_undef;
+        }
+        m_solver->updt_params(get_params());
+        while (true) {
+            ++m_num_iterations;
+            if (!m.inc())
+                return l_undef;
+            lbool r = m_solver->check_sat_core(num_assumptions, assumptions);
+            if (r != l_true)
+                return r;
+            model_ref mdl;
+            m_solver->get_model(mdl);
+            if (!mdl || refine(*mdl) == 0)
+                return r;
+        }
+    }
+
+    void updt_params(params_ref const& p) override { solver::updt_params(p); m_solver->updt_params(p); }
+    void collect_param_descrs(param_descrs& r) override { m_solver->collect_param_descrs(r); }
+    void set_produce_models(bool f) override { }
+    void set_progress_callback(progress_callback* callback) override { m_solver->set_progress_callback(callback); }
+    void collect_statistics(statistics& st) const override {
+        m_solver->collect_statistics(st);
+        st.update("lackr-its", m_num_iterations);
+        st.update("ackr-constraints", m_num_lemmas);
+    }
+    void get_unsat_core(expr_ref_vector& r) override { m_solver->get_unsat_core(r); }
+    void set_phase(expr* e) override { m_solver->set_phase(abstract(e)); }
+    phase* get_phase() override { return m_solver->get_phase(); }
+    void set_phase(phase* p) override { m_solver->set_phase(p); }
+    void move_to_front(expr* e) override { m_solver->move_to_front(abstract(e)); }
+    lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) override {
+        return m_solver->find_mutexes(vars, mutexes);
+    }
+    void get_model_core(model_ref& mdl) override {
+        m_solver->get_model(mdl);
+        if (!mdl)
+            return;
+        mdl = mdl->copy();
+        add_func_interps(*mdl);
+        model_converter_ref mc = local_model_converter();
+        if (mc) (*mc)(mdl);
+    }
+    model_converter* local_model_converter() const {
+        if (m_terms.empty())
+            return nullptr;
+        generic_model_converter* mc = alloc(generic_model_converter, m, "lackr");
+        for (app* t : m_terms)
+            mc->hide(m_term2const[t]);
+        return mc;
+    }
+    model_converter_ref get_model_converter() const override {
+        model_converter_ref mc = concat(mc0(), local_model_converter());
+        mc = concat(mc.get(), m_solver->get_model_converter().get());
+        return mc;
+    }
+    proof* get_proof() override { return m_solver->get_proof(); }
+    std::string reason_unknown() const override { return m_solver->reason_unknown(); }
+    void set_reason_unknown(char const* msg) override { m_solver->set_reason_unknown(msg); }
+    void get_labels(svector<symbol>& r) override { m_solver->get_labels(r); }
+    ast_manager& get_manager() const override { return m; }
+    expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) override {
+        return m_solver->cube(vars, backtrack_level);
+    }
+    void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override {
+        m_solver->get_levels(vars, depth);
+    }
+    expr_ref_vector get_trail(unsigned max_level) override {
+        return m_solver->get_trail(max_level);
+    }
+    unsigned get_num_assertions() const override {
+        return m_solver->get_num_assertions();
+    }
+    expr* get_assertion(unsigned idx) const override {
+        return m_solver->get_assertion(idx);
+    }
+};
+
+solver * mk_lackr_solver(ast_manager & m, params_ref const & p, solver * s) {
+    return alloc(lackr_solver, m, p, s);
+}
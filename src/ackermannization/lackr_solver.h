@@ -0,0 +1,26 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    lackr_solver.h
+
+Abstract:
+
+    Incremental solver for QF_UFBV based on lazy Ackermannization.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+
+class ast_manager;
+class solver;
+
+/**
+   \brief Wrap the UF-free solver \c s (typically an inc_sat_solver) by a solver that
+   abstracts uninterpreted function applications by fresh constants and adds
+   congruence lemmas lazily, only for the pairs of applications that are violated
+   by the current model of \c s.
+*/
+solver * mk_lackr_solver(ast_manager & m, params_ref const & p, solver * s);
@@ -18,6 +18,7 @@ Revision History:
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_util.h"
+#include "api/api_ast_vector.h"
 #include "ast/well_sorted.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -183,6 +184,48 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_mk_app_batch(Z3_context c,
+                                         unsigned num_leaves, Z3_ast const leaves[],
+                                         unsigned num_apps, Z3_func_decl const decls[], unsigned const num_args[],
+                                         unsigned num_indices, unsigned const indices[]) {
+        Z3_TRY;
+        LOG_Z3_mk_app_batch(c, num_leaves, leaves, num_apps, decls, num_args, num_indices, indices);
+        RESET_ERROR_CODE();
+        ast_manager& m = mk_c(c)->m();
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        ptr_buffer<expr> arg_list;
+        unsigned pos = 0;
+        for (unsigned i = 0; i < num_apps; ++i) {
+            unsigned n = num_args[i];
+            if (pos + n > num_indices) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "not enough child indices");
+                RETURN_Z3(nullptr);
+            }
+            arg_list.reset();
+            for (unsigned j = 0; j < n; ++j) {
+                unsigned idx = indices[pos++];
+                if (idx < num_leaves)
+                    arg_list.push_back(to_expr(leaves[idx]));
+                else if (idx - num_leaves < i)
+                    arg_list.push_back(to_expr(v->m_ast_vector.get(idx - num_leaves)));
+                else {
+                    SET_ERROR_CODE(Z3_INVALID_ARG, "child index does not refer to a leaf or an earlier application");
+                    RETURN_Z3(nullptr);
+                }
+            }
+            app* a = m.mk_app(to_func_decl(decls[i]), n, arg_list.data());
+            v->m_ast_vector.push_back(a);
+            check_sorts(c, a);
+        }
+        if (pos != num_indices) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "unused child indices");
+            RETURN_Z3(nullptr);
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_ast Z3_API Z3_mk_const(Z3_context c, Z3_symbol s, Z3_sort ty) {
         Z3_TRY;
         LOG_Z3_mk_const(c, s, ty);
@@ -99,7 +99,12 @@ namespace api {
 	    m_char_fid   = m().mk_family_id("char");
         m_special_relations_fid   = m().mk_family_id("specrels");
         m_dt_plugin = static_cast<datatype_decl_plugin*>(m().get_plugin(m_dt_fid));
-    
+    }
+
+    void context::init_tactics() {
+        if (m_tactics_installed)
+            return;
+        m_tactics_installed = true;
         install_tactics(*this);
     }
 
@@ -138,6 +143,7 @@ namespace api {
     void context::set_error_code(Z3_error_code err, char const* opt_msg) {
         m_error_code = err; 
         if (err != Z3_OK) {
+            ctx_flush_log();
             m_exception_msg.clear();
             if (opt_msg) m_exception_msg = opt_msg;
             invoke_error_handler(err); 
@@ -147,6 +153,7 @@ namespace api {
     void context::set_error_code(Z3_error_code err, std::string &&opt_msg) {
         m_error_code = err;
         if (err != Z3_OK) {
+            ctx_flush_log();
             m_exception_msg = std::move(opt_msg);
             invoke_error_handler(err);
         }
@@ -214,7 +221,12 @@ namespace api {
 
     void context::save_ast_trail(ast * n) {
         SASSERT(m().contains(n));
-        if (m_user_ref_count) {
+        if (m_user_ref_count && m_ast_trail.size() == 1) {
+            // common case: replace the previous result in place.
+            // set increments the reference counter of n before decrementing the old result.
+            m_ast_trail.set(0, n);
+        }
+        else if (m_user_ref_count) {
             // Corner case bug: n may be in m_ast_trail, and this is the only reference to n.
             // When, we execute reset() it is deleted
             // To avoid this bug, I bump the reference counter before resetting m_ast_trail
@@ -384,6 +396,24 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_dec_ref_batch(Z3_context c, unsigned num_asts, Z3_ast const asts[]) {
+        Z3_TRY;
+        LOG_Z3_dec_ref_batch(c, num_asts, asts);
+        RESET_ERROR_CODE();
+        ast_manager & m = mk_c(c)->m();
+        for (unsigned i = 0; i < num_asts; ++i) {
+            Z3_ast a = asts[i];
+            if (!a)
+                continue;
+            if (to_ast(a)->get_ref_count() == 0) {
+                SET_ERROR_CODE(Z3_DEC_REF_ERROR, nullptr);
+                return;
+            }
+            m.dec_ref(to_ast(a));
+        }
+        Z3_CATCH;
+    }
+
 
     void Z3_API Z3_get_version(unsigned * major, 
                                unsigned * minor, 
@@ -75,6 +75,7 @@ namespace api {
         struct add_plugins {  add_plugins(ast_manager & m); };
         ast_context_params                m_params;
         bool                       m_user_ref_count; //!< if true, the user is responsible for managing reference counters.
+        bool                       m_tactics_installed = false;
         scoped_ptr<ast_manager>    m_manager;
         scoped_ptr<cmd_context>    m_cmd;
         add_plugins                m_plugins;
@@ -170,6 +171,15 @@ namespace api {
         void set_error_code(Z3_error_code err, std::string &&opt_msg);
         void set_error_handler(Z3_error_handler h) { m_error_handler = h; }
 
+        // Tactics and probes are installed on first use, since most contexts never look them up.
+        void init_tactics();
+        tactic_cmd * find_tactic_cmd(symbol const & s) { init_tactics(); return tactic_manager::find_tactic_cmd(s); }
+        probe_info * find_probe(symbol const & s) { init_tactics(); return tactic_manager::find_probe(s); }
+        unsigned num_tactics() { init_tactics(); return tactic_manager::num_tactics(); }
+        unsigned num_probes() { init_tactics(); return tactic_manager::num_probes(); }
+        tactic_cmd * get_tactic(unsigned i) { init_tactics(); return tactic_manager::get_tactic(i); }
+        probe_info * get_probe(unsigned i) { init_tactics(); return tactic_manager::get_probe(i); }
+
         unsigned add_object(api::object* o);
         void del_object(api::object* o);
 
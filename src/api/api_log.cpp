@@ -23,9 +23,30 @@ Revision History:
 #include "util/z3_version.h"
 #include "util/mutex.h"
 
-static std::ostream * g_z3_log = nullptr;
+namespace {
+    // Log records are written to a large buffer instead of being flushed
+    // one by one; the buffer is flushed when it fills up, when an API call
+    // reports an error, when the log is closed and at process exit.
+    class log_stream : public std::ofstream {
+        char m_buffer[1 << 20];
+    public:
+        log_stream(char const * filename) {
+            rdbuf()->pubsetbuf(m_buffer, sizeof(m_buffer));
+            open(filename);
+        }
+    };
+}
+
+static log_stream * g_z3_log = nullptr;
 atomic<bool> g_z3_log_enabled;
 
+static struct log_flusher {
+    ~log_flusher() {
+        if (g_z3_log != nullptr)
+            g_z3_log->flush();
+    }
+} g_log_flusher;
+
 #ifdef Z3_LOG_SYNC
 static mutex g_log_mux;
 #define SCOPED_LOCK() lock_guard lock(g_log_mux)
@@ -73,12 +94,12 @@ std::ostream & operator<<(std::ostream & out, ll_escaped const & d) {
 }
 }
 
-void R()              { *g_z3_log << 'R' << std::endl; }
-void P(void * obj)    { *g_z3_log << "P " << obj <<std::endl; }
-void I(int64_t i)     { *g_z3_log << "I " << i << std::endl; }
-void U(uint64_t u)    { *g_z3_log << "U " << u << std::endl; }
-void D(double d)      { *g_z3_log << "D " << d << std::endl; }
-void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << '"' << std::endl; }
+void R()              { *g_z3_log << "R\n"; }
+void P(void * obj)    { *g_z3_log << "P " << obj << '\n'; }
+void I(int64_t i)     { *g_z3_log << "I " << i << '\n'; }
+void U(uint64_t u)    { *g_z3_log << "U " << u << '\n'; }
+void D(double d)      { *g_z3_log << "D " << d << '\n'; }
+void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << "\"\n"; }
 void Sy(Z3_symbol sym) {
     symbol s = symbol::c_api_ext2symbol(sym);
     if (s.is_null()) {
@@ -90,14 +111,14 @@ void Sy(Z3_symbol sym) {
     else {
         *g_z3_log << "$ |" << ll_escaped{s.str().c_str()} << '|';
     }
-    *g_z3_log << std::endl;
+    *g_z3_log << '\n';
 }
-void Ap(unsigned sz)  { *g_z3_log << "p " << sz << std::endl; }
-void Au(unsigned sz)  { *g_z3_log << "u " << sz << std::endl; }
-void Ai(unsigned sz)  { *g_z3_log << "i " << sz << std::endl; }
-void Asy(unsigned sz) { *g_z3_log << "s " << sz << std::endl; }
-void C(unsigned id)   { *g_z3_log << "C " << id << std::endl; }
-static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << '"' << std::endl; }
+void Ap(unsigned sz)  { *g_z3_log << "p " << sz << '\n'; }
+void Au(unsigned sz)  { *g_z3_log << "u " << sz << '\n'; }
+void Ai(unsigned sz)  { *g_z3_log << "i " << sz << '\n'; }
+void Asy(unsigned sz) { *g_z3_log << "s " << sz << '\n'; }
+void C(unsigned id)   { *g_z3_log << "C " << id << '\n'; }
+static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << "\"\n"; }
 
 void ctx_enable_logging() {
     SCOPED_LOCK();
@@ -105,6 +126,13 @@ void ctx_enable_logging() {
         g_z3_log_enabled = true;
 }
 
+// flush the log before an error is reported, as error handlers may abort the process.
+void ctx_flush_log() {
+    SCOPED_LOCK();
+    if (g_z3_log != nullptr)
+        g_z3_log->flush();
+}
+
 static void Z3_close_log_unsafe(void) {
     if (g_z3_log != nullptr) {
         g_z3_log_enabled = false;
@@ -120,14 +148,14 @@ extern "C" {
         SCOPED_LOCK();
         Z3_close_log_unsafe();
 
-        g_z3_log = alloc(std::ofstream, filename);
+        g_z3_log = alloc(log_stream, filename);
         if (g_z3_log->bad() || g_z3_log->fail()) {
             dealloc(g_z3_log);
             g_z3_log = nullptr;
             res = false;
         }
         else {
-            *g_z3_log << "V \"" << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << '"' << std::endl;
+            *g_z3_log << "V \"" << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << "\"\n";
             res = true;
         }
 
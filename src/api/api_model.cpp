@@ -172,6 +172,35 @@ extern "C" {
         Z3_CATCH_RETURN(false);
     }
 
+    Z3_ast_vector Z3_API Z3_model_eval_many(Z3_context c, Z3_model m, Z3_ast_vector ts, bool model_completion) {
+        Z3_TRY;
+        LOG_Z3_model_eval_many(c, m, ts, model_completion);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, nullptr);
+        CHECK_NON_NULL(ts, nullptr);
+        model * _m = to_model_ref(m);
+        params_ref p;
+        ast_manager& mgr = mk_c(c)->m();
+        if (!_m->has_solver()) {
+            _m->set_solver(alloc(api::seq_expr_solver, mgr, p));
+        }
+        ast_ref_vector const& terms = to_ast_vector_ref(ts);
+        for (ast* t : terms) {
+            if (!is_expr(t)) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "expression expected");
+                RETURN_Z3(nullptr);
+            }
+        }
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mgr);
+        mk_c(c)->save_object(v);
+        model::scoped_model_completion _scm(*_m, model_completion);
+        for (ast* t : terms) {
+            v->m_ast_vector.push_back((*_m)(to_expr(t)));
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
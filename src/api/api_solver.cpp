@@ -31,6 +31,7 @@ Revision History:
 #include "api/api_model.h"
 #include "api/api_stats.h"
 #include "api/api_ast_vector.h"
+#include "ast/ast_serialize.h"
 #include "model/model_params.hpp"
 #include "smt/smt_solver.h"
 #include "smt/smt_implied_equalities.h"
@@ -301,6 +302,22 @@ extern "C" {
         }
     }
 
+    static void solver_from_binary_file(Z3_context c, Z3_solver s, char const* file_name) {
+        init_solver(c, s);
+        ast_manager& m = mk_c(c)->m();
+        std::ifstream is(file_name, std::ios::binary);
+        ast_ref_vector fmls(m);
+        ast_deserialize(m, is, fmls);
+        for (ast* f : fmls) {
+            if (!is_expr(f) || !m.is_bool(to_expr(f))) {
+                SET_ERROR_CODE(Z3_SORT_ERROR, "Boolean expressions expected");
+                return;
+            }
+        }
+        for (ast* f : fmls)
+            to_solver(s)->assert_expr(to_expr(f));
+    }
+
     // DIMACS files start with "p cnf" and number of variables/clauses.
     // This is not legal SMT syntax, so use the DIMACS parser.
     static bool is_dimacs_string(Z3_string c_str) {
@@ -333,6 +350,9 @@ extern "C" {
         else if (ext && (std::string("dimacs") == ext || std::string("cnf") == ext)) {
             solver_from_dimacs_stream(c, s, is);
         }
+        else if (ext && std::string("z3b") == ext) {
+            solver_from_binary_file(c, s, file_name);
+        }
         else {
             solver_from_stream(c, s, is);
         }
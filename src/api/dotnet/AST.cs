@@ -221,6 +221,11 @@ namespace Microsoft.Z3
             {
                 Native.Z3_dec_ref(ctx.nCtx, obj);
             }
+
+            internal override void DecRefBatch(Context ctx, IntPtr[] objs)
+            {
+                Native.Z3_dec_ref_batch(ctx.nCtx, (uint)objs.Length, objs);
+            }
         };
 
         internal override void IncRef(IntPtr o)
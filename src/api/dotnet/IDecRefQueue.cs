@@ -57,6 +57,16 @@ namespace Microsoft.Z3
         internal abstract void IncRef(Context ctx, IntPtr obj);
         internal abstract void DecRef(Context ctx, IntPtr obj);
 
+        /// <summary>
+        /// Decrements the references on a batch of objects.
+        /// Queues can override this to release all objects with a single native call.
+        /// </summary>
+        internal virtual void DecRefBatch(Context ctx, IntPtr[] objs)
+        {
+            foreach (IntPtr o in objs)
+                DecRef(ctx, o);
+        }
+
         internal void IncAndClear(Context ctx, IntPtr o)
         {
             Debug.Assert(ctx != null);
@@ -79,12 +89,16 @@ namespace Microsoft.Z3
         {
             Debug.Assert(ctx != null);
 
+            IntPtr[] objs;
             lock (m_lock)
             {
-                foreach (IntPtr o in m_queue)
-                    DecRef(ctx, o);
+                if (m_queue.Count == 0) return;
+                objs = m_queue.ToArray();
                 m_queue.Clear();
             }
+            // finalizers only contend for the lock while the queue is copied,
+            // not while the objects are released.
+            DecRefBatch(ctx, objs);
         }
     }
 
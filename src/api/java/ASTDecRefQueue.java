@@ -28,4 +28,9 @@ class ASTDecRefQueue extends IDecRefQueue<AST>
     protected void decRef(Context ctx, long obj) {
         Native.decRef(ctx.nCtx(), obj);
     }
+
+    @Override
+    protected void decRefBatch(Context ctx, int n, long[] objs) {
+        Native.decRefBatch(ctx.nCtx(), n, objs);
+    }
 };
@@ -40,6 +40,7 @@ public abstract class IDecRefQueue<T extends Z3Object> {
     private final ReferenceQueue<T> referenceQueue = new ReferenceQueue<>();
     private final Map<PhantomReference<T>, Long> referenceMap =
             new IdentityHashMap<>();
+    private long[] batch = new long[16];
 
     protected IDecRefQueue() {}
 
@@ -53,6 +54,21 @@ public abstract class IDecRefQueue<T extends Z3Object> {
      */
     protected abstract void decRef(Context ctx, long obj);
 
+    /**
+     * Decrement the references on the first {@code n} objects of {@code objs}.
+     * Implementations can override this to release all objects with a single
+     * native call.
+     *
+     * @param ctx Z3 context.
+     * @param n Number of objects.
+     * @param objs Pointers to Z3 objects.
+     */
+    protected void decRefBatch(Context ctx, int n, long[] objs) {
+        for (int i = 0; i < n; i++) {
+            decRef(ctx, objs[i]);
+        }
+    }
+
     public void storeReference(Context ctx, T obj) {
         PhantomReference<T> ref = new PhantomReference<>(obj, referenceQueue);
         referenceMap.put(ref, obj.getNativeObject());
@@ -64,11 +80,18 @@ public abstract class IDecRefQueue<T extends Z3Object> {
      */
     protected void clear(Context ctx)
     {
-        Reference<? extends T> ref;
-        while ((ref = referenceQueue.poll()) != null) {
-            long z3ast = referenceMap.remove(ref);
-            decRef(ctx, z3ast);
+        Reference<? extends T> ref = referenceQueue.poll();
+        if (ref == null) {
+            return;
         }
+        int n = 0;
+        do {
+            if (n == batch.length) {
+                batch = java.util.Arrays.copyOf(batch, 2 * n);
+            }
+            batch[n++] = referenceMap.remove(ref);
+        } while ((ref = referenceQueue.poll()) != null);
+        decRefBatch(ctx, n, batch);
     }
 
     /**
@@ -76,8 +99,11 @@ public abstract class IDecRefQueue<T extends Z3Object> {
      * <b>regardless</b> of whether they are in {@code referenceMap} or not.
      */
     public void forceClear(Context ctx) {
+        long[] objs = new long[referenceMap.size()];
+        int n = 0;
         for (long ref : referenceMap.values()) {
-            decRef(ctx, ref);
+            objs[n++] = ref;
         }
+        decRefBatch(ctx, n, objs);
     }
 }
@@ -10,14 +10,25 @@ import { functions } from './parse-api';
 
 console.log('--- Building WASM');
 
+// Z3_WASM_THREADS=<n> builds a thread-safe libz3 and starts a pool of n workers,
+// so that smt.threads and sat.threads can run in parallel. The hosting page
+// must be cross-origin isolated for SharedArrayBuffer to be available.
+// Z3_WASM_SIMD=1 compiles with wasm SIMD, which all current browsers support.
+const poolSize = parseInt(process.env.Z3_WASM_THREADS ?? '0', 10);
+assert(Number.isInteger(poolSize) && poolSize >= 0, 'Z3_WASM_THREADS must be a number of workers');
+const threaded = poolSize > 0;
+const simd = process.env.Z3_WASM_SIMD === '1';
+const simdFlags = simd ? ' -msimd128' : '';
+
 const SWAP_OPTS: SpawnOptions = {
   shell: true,
   stdio: 'inherit',
   env: {
     ...process.env,
-    CXXFLAGS: '-pthread -s USE_PTHREADS=1 -s DISABLE_EXCEPTION_CATCHING=0',
+    CXXFLAGS: '-pthread -s USE_PTHREADS=1 -s DISABLE_EXCEPTION_CATCHING=0' + simdFlags,
     LDFLAGS: '-s WASM_BIGINT -s -pthread -s USE_PTHREADS=1',
-    FPMATH_ENABLED: 'False', // Until Safari supports WASM SSE, we have to disable fast FP support
+    // Without SIMD, fast FP support is disabled for browsers without WASM SSE
+    FPMATH_ENABLED: simd ? 'True' : 'False',
     // TODO(ritave): Setting EM_CACHE breaks compiling on M1 MacBook
     //EM_CACHE: path.join(os.homedir(), '.emscripten/'),
   },
@@ -51,11 +62,20 @@ function exportedFuncs(): string[] {
 assert(fs.existsSync('./package.json'), 'Not in the root directory of js api');
 const z3RootDir = path.join(process.cwd(), '../../../');
 
-// TODO(ritave): Detect if it's in the configuration we need
-if (!existsSync(path.join(z3RootDir, 'build/Makefile'))) {
-  spawnSync('emconfigure python scripts/mk_make.py --staticlib --single-threaded --arm64=false', {
+// the configuration is recorded, so that changing the options reconfigures the build
+const config = `threads=${threaded} simd=${simd}`;
+const configPath = path.join(z3RootDir, 'build/wasm-config.txt');
+if (
+  !existsSync(path.join(z3RootDir, 'build/Makefile')) ||
+  !existsSync(configPath) ||
+  fs.readFileSync(configPath, 'utf8') !== config
+) {
+  const singleThreaded = threaded ? '' : ' --single-threaded';
+  spawnSync(`emconfigure python scripts/mk_make.py --staticlib${singleThreaded} --arm64=false`, {
     cwd: z3RootDir,
   });
+  spawnSync('make clean', { cwd: path.join(z3RootDir, 'build') });
+  fs.writeFileSync(configPath, config);
 }
 
 spawnSync(`emmake make -j${os.cpus().length} libz3.a`, { cwd: path.join(z3RootDir, 'build') });
@@ -69,7 +89,7 @@ const fns = JSON.stringify(exportedFuncs());
 const methods = '["ccall","FS","allocate","UTF8ToString","intArrayFromString","ALLOC_NORMAL"]';
 const libz3a = path.normalize('../../../build/libz3.a');
 spawnSync(
-  `emcc build/async-fns.cc ${libz3a} --std=c++20 --pre-js src/low-level/async-wrapper.js -g2 -pthread -fexceptions -s WASM_BIGINT -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=0 -s PTHREAD_POOL_SIZE_STRICT=0 -s MODULARIZE=1 -s 'EXPORT_NAME="initZ3"' -s EXPORTED_RUNTIME_METHODS=${methods} -s EXPORTED_FUNCTIONS=${fns} -s DISABLE_EXCEPTION_CATCHING=0 -s SAFE_HEAP=0 -s DEMANGLE_SUPPORT=1 -s TOTAL_MEMORY=1GB -I z3/src/api/ -o build/z3-built.js`,
+  `emcc build/async-fns.cc ${libz3a} --std=c++20 --pre-js src/low-level/async-wrapper.js -g2 -pthread -fexceptions${simdFlags} -s WASM_BIGINT -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=${poolSize} -s PTHREAD_POOL_SIZE_STRICT=0 -s MODULARIZE=1 -s 'EXPORT_NAME="initZ3"' -s EXPORTED_RUNTIME_METHODS=${methods} -s EXPORTED_FUNCTIONS=${fns} -s DISABLE_EXCEPTION_CATCHING=0 -s SAFE_HEAP=0 -s DEMANGLE_SUPPORT=1 -s TOTAL_MEMORY=1GB -I z3/src/api/ -o build/z3-built.js`,
 );
 
 fs.rmSync(ccWrapperPath);
@@ -905,6 +905,34 @@ def _to_func_decl_ref(a, ctx):
     return FuncDeclRef(a, ctx)
 
 
+def AppBatch(leaves, apps, ctx=None):
+    """Build a DAG of function applications with a single call into Z3.
+
+    `apps` is a list of pairs `(f, children)`. A child index `j` below `len(leaves)`
+    refers to `leaves[j]`, an index `len(leaves) + k` refers to the `k`-th application.
+    Returns the applications as an AstVector.
+
+    >>> x, y = Ints('x y')
+    >>> f = Function('f', IntSort(), IntSort(), IntSort())
+    >>> AppBatch([x, y], [(f, [0, 1]), (f, [2, 1])])
+    [f(x, y), f(f(x, y), y)]
+    """
+    ctx = _get_ctx(_ctx_from_ast_arg_list(leaves, ctx))
+    _leaves, num_leaves = _to_ast_array(leaves)
+    num_apps = len(apps)
+    decls = (FuncDecl * num_apps)()
+    num_args = (ctypes.c_uint * num_apps)()
+    flat = []
+    for i, (f, children) in enumerate(apps):
+        if z3_debug():
+            _z3_assert(is_func_decl(f), "Z3 function declaration expected")
+        decls[i] = f.ast
+        num_args[i] = len(children)
+        flat.extend(children)
+    indices = (ctypes.c_uint * len(flat))(*flat)
+    return AstVector(Z3_mk_app_batch(ctx.ref(), num_leaves, _leaves, num_apps, decls, num_args, len(flat), indices), ctx)
+
+
 def RecFunction(name, *sig):
     """Create a new Z3 recursive with the given sorts."""
     sig = _get_args(sig)
@@ -6401,6 +6429,23 @@ class ModelRef(Z3PPObject):
             return _to_expr_ref(r[0], self.ctx)
         raise Z3Exception("failed to evaluate expression in the model")
 
+    def eval_many(self, ts, model_completion=False):
+        """Evaluate the expressions `ts` in the model `self` with a single call into Z3.
+
+        >>> x, y = Ints('x y')
+        >>> s = Solver()
+        >>> s.add(x == 1, y == x + 1)
+        >>> s.check()
+        sat
+        >>> s.model().eval_many([x, y, x + y])
+        [1, 2, 3]
+        """
+        v = AstVector(None, self.ctx)
+        for t in ts:
+            v.push(t)
+        r = AstVector(Z3_model_eval_many(self.ctx.ref(), self.model, v.vector, model_completion), self.ctx)
+        return [r[i] for i in range(len(r))]
+
     def evaluate(self, t, model_completion=False):
         """Alias for `eval`.
 
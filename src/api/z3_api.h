@@ -1679,6 +1679,17 @@ extern "C" {
     */
     void Z3_API Z3_dec_ref(Z3_context c, Z3_ast a);
 
+    /**
+       \brief Decrement the reference counters of the given ASTs.
+       This is equivalent to calling #Z3_dec_ref on each AST, but it crosses
+       the API boundary only once. Null ASTs are ignored.
+
+       \sa Z3_dec_ref
+
+       def_API('Z3_dec_ref_batch', VOID, (_in(CONTEXT), _in(UINT), _in_array(1, AST)))
+    */
+    void Z3_API Z3_dec_ref_batch(Z3_context c, unsigned num_asts, Z3_ast const asts[]);
+
     /**
        \brief Set a value of a context parameter.
 
@@ -2235,6 +2246,28 @@ extern "C" {
         unsigned num_args,
         Z3_ast const args[]);
 
+    /**
+       \brief Create a batch of function applications in a single call.
+
+       The batch is described by \c num_apps instructions. Instruction \c i
+       applies \c decls[i] to \c num_args[i] children, taken in order from
+       \c indices. A child index \c j below \c num_leaves refers to
+       \c leaves[j], an index \c num_leaves + k refers to the result of
+       instruction \c k, which must precede instruction \c i.
+       The sum of \c num_args must be \c num_indices.
+
+       The result is a vector holding the \c num_apps applications in order.
+
+       \sa Z3_mk_app
+
+       def_API('Z3_mk_app_batch', AST_VECTOR, (_in(CONTEXT), _in(UINT), _in_array(1, AST), _in(UINT), _in_array(3, FUNC_DECL), _in_array(3, UINT), _in(UINT), _in_array(6, UINT)))
+    */
+    Z3_ast_vector Z3_API Z3_mk_app_batch(
+        Z3_context c,
+        unsigned num_leaves, Z3_ast const leaves[],
+        unsigned num_apps, Z3_func_decl const decls[], unsigned const num_args[],
+        unsigned num_indices, unsigned const indices[]);
+
     /**
        \brief Declare and create a constant.
 
@@ -5368,6 +5401,20 @@ extern "C" {
     */
     Z3_bool Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate every term of the vector \c ts in the given model.
+       Return a vector holding the values in the same order.
+
+       This is equivalent to calling #Z3_model_eval on each term, but it crosses
+       the API boundary once. Evaluation fails for the same reasons as #Z3_model_eval;
+       in that case an error is set and the result is null.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_many', AST_VECTOR, (_in(CONTEXT), _in(MODEL), _in(AST_VECTOR), _in(BOOL)))
+    */
+    Z3_ast_vector Z3_API Z3_model_eval_many(Z3_context c, Z3_model m, Z3_ast_vector ts, bool model_completion);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -6743,6 +6790,10 @@ extern "C" {
     /**
        \brief load solver assertions from a file.
 
+       Files with extension \c dimacs or \c cnf are read as DIMACS, files with extension
+       \c z3b are read as an AST vector written by #Z3_ast_vector_serialize, other files
+       are read as SMT-LIB2.
+
        \sa Z3_solver_from_string
        \sa Z3_solver_to_string
 
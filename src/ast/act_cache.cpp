@@ -77,6 +77,20 @@ void act_cache::dec_refs() {
         m_manager.dec_ref(kv.m_key.first);
         m_manager.dec_ref(UNTAG(expr*, kv.m_value));
     }
+    for (expr* k : m_dense_keys) {
+        m_manager.dec_ref(m_dense_table[k->get_id()]);
+        m_dense_table[k->get_id()] = nullptr;
+        m_manager.dec_ref(k);
+    }
+    m_dense_keys.reset();
+}
+
+void act_cache::set_dense(bool f) {
+    if (m_dense == f)
+        return;
+    reset();
+    m_dense_table.finalize();
+    m_dense = f;
 }
 
 act_cache::act_cache(ast_manager & m):
@@ -135,6 +149,23 @@ void act_cache::del_unused() {
 */
 void act_cache::insert(expr * k, unsigned offset, expr * v) {
     SASSERT(k);
+    if (m_dense && offset == 0) {
+        unsigned id = k->get_id();
+        m_dense_table.reserve(id + 1, nullptr);
+        expr * old_v = m_dense_table[id];
+        if (old_v == v)
+            return;
+        m_manager.inc_ref(v);
+        if (old_v) {
+            m_manager.dec_ref(old_v);
+        }
+        else {
+            m_manager.inc_ref(k);
+            m_dense_keys.push_back(k);
+        }
+        m_dense_table[id] = v;
+        return;
+    }
     entry_t e(k, offset);
     if (m_unused >= m_max_unused)
         del_unused();
@@ -180,11 +211,44 @@ void act_cache::insert(expr * k, unsigned offset, expr * v) {
     });
 }
 
+void act_cache::filter(std::function<bool(expr*)> const& keep) {
+    svector<entry_t> keys;
+    ptr_vector<expr> values;
+    for (auto & kv : m_table) {
+        if (keep(kv.m_key.first)) {
+            keys.push_back(kv.m_key);
+            values.push_back(UNTAG(expr*, kv.m_value));
+        }
+    }
+    for (expr* k : m_dense_keys) {
+        if (keep(k)) {
+            keys.push_back(entry_t(k, 0));
+            values.push_back(m_dense_table[k->get_id()]);
+        }
+    }
+    if (keys.size() == size())
+        return;
+    for (unsigned i = 0; i < keys.size(); ++i) {
+        m_manager.inc_ref(keys[i].first);
+        m_manager.inc_ref(values[i]);
+    }
+    reset();
+    for (unsigned i = 0; i < keys.size(); ++i) {
+        insert(keys[i].first, keys[i].second, values[i]);
+        m_manager.dec_ref(keys[i].first);
+        m_manager.dec_ref(values[i]);
+    }
+}
+
 /**
    \brief Search for key k in the cache.
    If entry k -> (v, tag) is found, we set tag to 1.
 */
 expr * act_cache::find(expr * k, unsigned offset) {
+    if (m_dense && offset == 0) {
+        unsigned id = k->get_id();
+        return id < m_dense_table.size() ? m_dense_table[id] : nullptr;
+    }
     entry_t e(k, offset);
     map::key_value * entry = m_table.find_core(e);
     if (entry == nullptr)
@@ -215,6 +279,8 @@ void act_cache::cleanup() {
     dec_refs();
     m_table.finalize();
     m_queue.finalize();
+    m_dense_table.finalize();
+    m_dense_keys.finalize();
     m_unused = 0;
     m_qhead = 0;
 }
@@ -22,6 +22,7 @@ Notes:
 #include "ast/ast.h"
 #include "util/obj_hashtable.h"
 #include "util/chashtable.h"
+#include <functional>
 
 class act_cache {
     ast_manager &        m_manager;
@@ -37,6 +38,11 @@ class act_cache {
     unsigned             m_qhead;
     unsigned             m_unused;
     unsigned             m_max_unused;
+    // dense mode: entries with offset 0 are indexed by the id of their key
+    // and are never evicted.
+    bool                 m_dense = false;
+    ptr_vector<expr>     m_dense_table;
+    ptr_vector<expr>     m_dense_keys;
 
     void compress_queue();
     void init();
@@ -53,9 +59,18 @@ public:
     expr * find(expr * k, unsigned offset);
     void reset();
     void cleanup();
-    unsigned size() const { return m_table.size(); }
-    unsigned capacity() const { return m_table.capacity(); }
-    bool empty() const { return m_table.empty(); }
+    // remove the entries whose key does not satisfy keep.
+    void filter(std::function<bool(expr*)> const& keep);
+    /**
+       \brief store entries with offset 0 in a table indexed by expression ids.
+       It trades the memory of the unbounded table for hash-free lookups on
+       large DAGs. The cache is reset when the mode changes.
+    */
+    void set_dense(bool f);
+    bool is_dense() const { return m_dense; }
+    unsigned size() const { return m_table.size() + m_dense_keys.size(); }
+    unsigned capacity() const { return m_table.capacity() + m_dense_table.size(); }
+    bool empty() const { return m_table.empty() && m_dense_keys.empty(); }
     bool check_invariant() const;
     
 };
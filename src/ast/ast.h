@@ -2026,6 +2026,7 @@ public:
     void push_back(expr_array const & s, expr * v, expr_array & r) { m_expr_array_manager.push_back(s, v, r); }
     void pop_back(expr_array & r) { m_expr_array_manager.pop_back(r); }
     void pop_back(expr_array const & s, expr_array & r) { m_expr_array_manager.pop_back(s, r); }
+    void shrink(expr_array & r, unsigned sz) { m_expr_array_manager.shrink(r, sz); }
     void unshare(expr_array & r) { m_expr_array_manager.unshare(r); }
     void unfold(expr_array & r) { m_expr_array_manager.unfold(r); }
     void reroot(expr_array & r) { m_expr_array_manager.reroot(r); }
@@ -2067,6 +2068,7 @@ public:
     }
     void pop_back(expr_dependency_array & r) { m_expr_dependency_array_manager.pop_back(r); }
     void pop_back(expr_dependency_array const & s, expr_dependency_array & r) { m_expr_dependency_array_manager.pop_back(s, r); }
+    void shrink(expr_dependency_array & r, unsigned sz) { m_expr_dependency_array_manager.shrink(r, sz); }
     void unshare(expr_dependency_array & r) { m_expr_dependency_array_manager.unshare(r); }
     void unfold(expr_dependency_array & r) { m_expr_dependency_array_manager.unfold(r); }
     void reroot(expr_dependency_array & r) { m_expr_dependency_array_manager.reroot(r); }
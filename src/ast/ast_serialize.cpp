@@ -0,0 +1,523 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.cpp
+
+Abstract:
+
+    Compact binary serialization of AST DAGs.
+
+    Layout:
+       magic "Z3AB", version
+       number of nodes, nodes in post-order
+       number of roots, root node ids
+
+    Symbols are written inline the first time they occur and referenced
+    by their position in the symbol table afterwards.
+
+--*/
+#include "util/map.h"
+#include "util/zstring.h"
+#include "ast/ast_serialize.h"
+
+namespace {
+
+    enum node_tag {
+        TAG_SORT_UNINTERPRETED,
+        TAG_SORT,
+        TAG_FUNC_DECL_UNINTERPRETED,
+        TAG_FUNC_DECL,
+        TAG_APP,
+        TAG_VAR,
+        TAG_QUANTIFIER
+    };
+
+    char const  magic[4] = { 'Z', '3', 'A', 'B' };
+    unsigned const version = 1;
+
+    void push_children(ast * n, ptr_buffer<ast> & children) {
+        auto push_params = [&](decl * d) {
+            for (unsigned i = 0; i < d->get_num_parameters(); ++i)
+                if (d->get_parameter(i).is_ast())
+                    children.push_back(d->get_parameter(i).get_ast());
+        };
+        switch (n->get_kind()) {
+        case AST_SORT:
+            push_params(to_sort(n));
+            break;
+        case AST_FUNC_DECL: {
+            func_decl * f = to_func_decl(n);
+            push_params(f);
+            children.append(f->get_arity(), reinterpret_cast<ast * const *>(f->get_domain()));
+            children.push_back(f->get_range());
+            break;
+        }
+        case AST_APP:
+            children.push_back(to_app(n)->get_decl());
+            children.append(to_app(n)->get_num_args(), reinterpret_cast<ast * const *>(to_app(n)->get_args()));
+            break;
+        case AST_VAR:
+            children.push_back(to_var(n)->get_sort());
+            break;
+        case AST_QUANTIFIER: {
+            quantifier * q = to_quantifier(n);
+            children.append(q->get_num_decls(), reinterpret_cast<ast * const *>(q->get_decl_sorts()));
+            children.append(q->get_num_patterns(), reinterpret_cast<ast * const *>(q->get_patterns()));
+            children.append(q->get_num_no_patterns(), reinterpret_cast<ast * const *>(q->get_no_patterns()));
+            children.push_back(q->get_expr());
+            break;
+        }
+        }
+    }
+
+    class writer {
+        ast_manager &                                         m;
+        std::ostream &                                        m_out;
+        obj_map<ast, unsigned>                                m_ids;
+        map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> m_symbols;
+        ptr_vector<ast>                                       m_order;
+
+        void write_uint(uint64_t n) {
+            while (n >= 0x80) {
+                m_out.put(static_cast<char>((n & 0x7f) | 0x80));
+                n >>= 7;
+            }
+            m_out.put(static_cast<char>(n));
+        }
+
+        void write_int(int64_t n) {
+            write_uint((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+        }
+
+        void write_string(std::string const & s) {
+            write_uint(s.size());
+            m_out.write(s.data(), s.size());
+        }
+
+        void write_symbol(symbol const & s) {
+            unsigned idx;
+            if (m_symbols.find(s, idx)) {
+                write_uint(idx + 1);
+                return;
+            }
+            write_uint(0);
+            m_symbols.insert(s, m_symbols.size());
+            if (s.is_null())
+                write_uint(0);
+            else if (s.is_numerical()) {
+                write_uint(1);
+                write_uint(s.get_num());
+            }
+            else {
+                write_uint(2);
+                write_string(s.str());
+            }
+        }
+
+        void write_id(ast * n) {
+            write_uint(m_ids[n]);
+        }
+
+        void write_family(family_id fid) {
+            write_symbol(fid == null_family_id ? symbol::null : m.get_family_name(fid));
+        }
+
+        void write_parameters(decl * d) {
+            write_uint(d->get_num_parameters());
+            for (unsigned i = 0; i < d->get_num_parameters(); ++i) {
+                parameter const & p = d->get_parameter(i);
+                write_uint(p.get_kind());
+                switch (p.get_kind()) {
+                case parameter::PARAM_INT: write_int(p.get_int()); break;
+                case parameter::PARAM_AST: write_id(p.get_ast()); break;
+                case parameter::PARAM_SYMBOL: write_symbol(p.get_symbol()); break;
+                case parameter::PARAM_ZSTRING: write_string(p.get_zstring().encode()); break;
+                case parameter::PARAM_RATIONAL: write_string(p.get_rational().to_string()); break;
+                case parameter::PARAM_DOUBLE: {
+                    double d = p.get_double();
+                    m_out.write(reinterpret_cast<char const *>(&d), sizeof(d));
+                    break;
+                }
+                default:
+                    throw default_exception("cannot serialize plugin specific parameter of " + d->get_name().str());
+                }
+            }
+        }
+
+        void write_sort(sort * s) {
+            sort_info * info = s->get_info();
+            if (!info) {
+                write_uint(TAG_SORT_UNINTERPRETED);
+                write_symbol(s->get_name());
+                return;
+            }
+            // the constructors and accessors of a datatype are kept by its plugin, not in the sort.
+            if (info->get_family_id() == m.get_family_id("datatype"))
+                throw default_exception("cannot serialize datatype sort " + s->get_name().str() + ", datatype declarations are not serialized");
+            write_uint(TAG_SORT);
+            write_symbol(s->get_name());
+            write_family(info->get_family_id());
+            write_uint(info->get_decl_kind());
+            sort_size const & sz = info->get_num_elements();
+            write_uint(sz.is_finite() ? 0 : sz.is_very_big() ? 1 : 2);
+            if (sz.is_finite())
+                write_uint(sz.size());
+            write_uint(info->private_parameters());
+            write_parameters(s);
+        }
+
+        void write_func_decl(func_decl * f) {
+            func_decl_info * info = f->get_info();
+            write_uint(info ? TAG_FUNC_DECL : TAG_FUNC_DECL_UNINTERPRETED);
+            write_symbol(f->get_name());
+            write_uint(f->get_arity());
+            for (sort * s : *f)
+                write_id(s);
+            write_id(f->get_range());
+            if (!info)
+                return;
+            if (info->is_lambda())
+                throw default_exception("cannot serialize lambda definition " + f->get_name().str());
+            write_family(info->get_family_id());
+            write_uint(info->get_decl_kind());
+            unsigned flags =
+                (info->is_left_associative() << 0) |
+                (info->is_right_associative() << 1) |
+                (info->is_flat_associative() << 2) |
+                (info->is_commutative() << 3) |
+                (info->is_chainable() << 4) |
+                (info->is_pairwise() << 5) |
+                (info->is_injective() << 6) |
+                (info->is_skolem() << 7) |
+                (info->is_idempotent() << 8);
+            write_uint(flags);
+            write_parameters(f);
+        }
+
+        void write_node(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                write_sort(to_sort(n));
+                break;
+            case AST_FUNC_DECL:
+                write_func_decl(to_func_decl(n));
+                break;
+            case AST_APP:
+                write_uint(TAG_APP);
+                write_id(to_app(n)->get_decl());
+                write_uint(to_app(n)->get_num_args());
+                for (expr * arg : *to_app(n))
+                    write_id(arg);
+                break;
+            case AST_VAR:
+                write_uint(TAG_VAR);
+                write_uint(to_var(n)->get_idx());
+                write_id(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                write_uint(TAG_QUANTIFIER);
+                write_uint(q->get_kind());
+                write_uint(q->get_num_decls());
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    write_symbol(q->get_decl_name(i));
+                    write_id(q->get_decl_sort(i));
+                }
+                write_int(q->get_weight());
+                write_symbol(q->get_qid());
+                write_symbol(q->get_skid());
+                write_uint(q->get_num_patterns());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    write_id(q->get_pattern(i));
+                write_uint(q->get_num_no_patterns());
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    write_id(q->get_no_pattern(i));
+                write_id(q->get_expr());
+                break;
+            }
+            }
+        }
+
+        void collect(ast * root) {
+            svector<std::pair<ast *, bool>> todo;
+            ptr_buffer<ast> children;
+            todo.push_back({ root, false });
+            while (!todo.empty()) {
+                auto [n, visited] = todo.back();
+                todo.pop_back();
+                if (m_ids.contains(n))
+                    continue;
+                if (visited) {
+                    m_ids.insert(n, m_order.size());
+                    m_order.push_back(n);
+                    continue;
+                }
+                todo.push_back({ n, true });
+                children.reset();
+                push_children(n, children);
+                for (ast * c : children)
+                    if (!m_ids.contains(c))
+                        todo.push_back({ c, false });
+            }
+        }
+
+    public:
+        writer(ast_manager & m, std::ostream & out) : m(m), m_out(out) {}
+
+        void operator()(unsigned num_roots, ast * const * roots) {
+            for (unsigned i = 0; i < num_roots; ++i)
+                collect(roots[i]);
+            m_out.write(magic, sizeof(magic));
+            write_uint(version);
+            write_uint(m_order.size());
+            for (ast * n : m_order)
+                write_node(n);
+            write_uint(num_roots);
+            for (unsigned i = 0; i < num_roots; ++i)
+                write_id(roots[i]);
+        }
+    };
+
+    class reader {
+        ast_manager &    m;
+        std::istream &   m_in;
+        ast_ref_vector   m_nodes;
+        vector<symbol>   m_symbols;
+
+        [[noreturn]] void fail(char const * msg) {
+            throw default_exception(std::string("malformed serialized ast: ") + msg);
+        }
+
+        uint64_t read_uint() {
+            uint64_t r = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                int c = m_in.get();
+                if (c == std::char_traits<char>::eof())
+                    fail("unexpected end of input");
+                r |= static_cast<uint64_t>(c & 0x7f) << shift;
+                if ((c & 0x80) == 0)
+                    return r;
+            }
+            fail("integer too large");
+        }
+
+        unsigned read_unsigned() {
+            uint64_t r = read_uint();
+            if (r > UINT_MAX)
+                fail("integer too large");
+            return static_cast<unsigned>(r);
+        }
+
+        int64_t read_int() {
+            uint64_t n = read_uint();
+            return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+        }
+
+        std::string read_string() {
+            uint64_t sz = read_uint();
+            std::string s;
+            s.resize(sz);
+            if (sz > 0 && !m_in.read(&s[0], sz))
+                fail("unexpected end of input");
+            return s;
+        }
+
+        symbol read_symbol() {
+            unsigned idx = read_unsigned();
+            if (idx > 0) {
+                if (idx > m_symbols.size())
+                    fail("symbol index out of range");
+                return m_symbols[idx - 1];
+            }
+            symbol s;
+            switch (read_unsigned()) {
+            case 0: break;
+            case 1: s = symbol(read_unsigned()); break;
+            case 2: s = symbol(read_string()); break;
+            default: fail("unknown symbol kind");
+            }
+            m_symbols.push_back(s);
+            return s;
+        }
+
+        ast * read_id() {
+            unsigned id = read_unsigned();
+            if (id >= m_nodes.size())
+                fail("node index out of range");
+            return m_nodes.get(id);
+        }
+
+        sort * read_sort_id() {
+            ast * n = read_id();
+            if (!is_sort(n))
+                fail("sort expected");
+            return to_sort(n);
+        }
+
+        expr * read_expr_id() {
+            ast * n = read_id();
+            if (!is_expr(n))
+                fail("expression expected");
+            return to_expr(n);
+        }
+
+        family_id read_family() {
+            symbol s = read_symbol();
+            return s.is_null() ? null_family_id : m.mk_family_id(s);
+        }
+
+        void read_parameters(vector<parameter> & ps) {
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i) {
+                switch (read_unsigned()) {
+                case parameter::PARAM_INT: ps.push_back(parameter(static_cast<int>(read_int()))); break;
+                case parameter::PARAM_AST: ps.push_back(parameter(read_id())); break;
+                case parameter::PARAM_SYMBOL: ps.push_back(parameter(read_symbol())); break;
+                case parameter::PARAM_ZSTRING: ps.push_back(parameter(zstring(read_string().c_str()))); break;
+                case parameter::PARAM_RATIONAL: ps.push_back(parameter(rational(read_string().c_str()))); break;
+                case parameter::PARAM_DOUBLE: {
+                    double d;
+                    if (!m_in.read(reinterpret_cast<char *>(&d), sizeof(d)))
+                        fail("unexpected end of input");
+                    ps.push_back(parameter(d));
+                    break;
+                }
+                default:
+                    fail("unknown parameter kind");
+                }
+            }
+        }
+
+        sort * read_sort() {
+            symbol name = read_symbol();
+            family_id fid = read_family();
+            if (fid == m.get_family_id("datatype"))
+                fail("datatype sorts are not supported");
+            decl_kind k = read_unsigned();
+            sort_size sz;
+            switch (read_unsigned()) {
+            case 0: sz = sort_size::mk_finite(read_uint()); break;
+            case 1: sz = sort_size::mk_very_big(); break;
+            case 2: sz = sort_size::mk_infinite(); break;
+            default: fail("unknown sort size");
+            }
+            bool private_parameters = read_unsigned() != 0;
+            vector<parameter> ps;
+            read_parameters(ps);
+            return m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.data(), private_parameters));
+        }
+
+        func_decl * read_func_decl(bool interpreted) {
+            symbol name = read_symbol();
+            unsigned arity = read_unsigned();
+            ptr_buffer<sort> domain;
+            for (unsigned i = 0; i < arity; ++i)
+                domain.push_back(read_sort_id());
+            sort * range = read_sort_id();
+            if (!interpreted)
+                return m.mk_func_decl(name, arity, domain.data(), range);
+            family_id fid = read_family();
+            decl_kind k = read_unsigned();
+            unsigned flags = read_unsigned();
+            vector<parameter> ps;
+            read_parameters(ps);
+            func_decl_info info(fid, k, ps.size(), ps.data());
+            info.set_left_associative((flags & (1 << 0)) != 0);
+            info.set_right_associative((flags & (1 << 1)) != 0);
+            info.set_flat_associative((flags & (1 << 2)) != 0);
+            info.set_commutative((flags & (1 << 3)) != 0);
+            info.set_chainable((flags & (1 << 4)) != 0);
+            info.set_pairwise((flags & (1 << 5)) != 0);
+            info.set_injective((flags & (1 << 6)) != 0);
+            info.set_skolem((flags & (1 << 7)) != 0);
+            info.set_idempotent((flags & (1 << 8)) != 0);
+            return m.mk_func_decl(name, arity, domain.data(), range, info);
+        }
+
+        app * read_app() {
+            ast * d = read_id();
+            if (!is_func_decl(d))
+                fail("declaration expected");
+            unsigned n = read_unsigned();
+            if (n != to_func_decl(d)->get_arity() && !to_func_decl(d)->is_associative())
+                fail("wrong number of arguments");
+            ptr_buffer<expr> args;
+            for (unsigned i = 0; i < n; ++i)
+                args.push_back(read_expr_id());
+            return m.mk_app(to_func_decl(d), n, args.data());
+        }
+
+        quantifier * read_quantifier() {
+            unsigned k = read_unsigned();
+            if (k > lambda_k)
+                fail("unknown quantifier kind");
+            unsigned num_decls = read_unsigned();
+            svector<symbol> names;
+            ptr_buffer<sort> sorts;
+            for (unsigned i = 0; i < num_decls; ++i) {
+                names.push_back(read_symbol());
+                sorts.push_back(read_sort_id());
+            }
+            int weight = static_cast<int>(read_int());
+            symbol qid = read_symbol();
+            symbol skid = read_symbol();
+            ptr_buffer<expr> patterns, no_patterns;
+            unsigned num_patterns = read_unsigned();
+            for (unsigned i = 0; i < num_patterns; ++i)
+                patterns.push_back(read_expr_id());
+            unsigned num_no_patterns = read_unsigned();
+            for (unsigned i = 0; i < num_no_patterns; ++i)
+                no_patterns.push_back(read_expr_id());
+            expr * body = read_expr_id();
+            if (k == lambda_k)
+                return m.mk_lambda(num_decls, sorts.data(), names.data(), body);
+            return m.mk_quantifier(static_cast<quantifier_kind>(k), num_decls, sorts.data(), names.data(), body,
+                                   weight, qid, skid, num_patterns, patterns.data(), num_no_patterns, no_patterns.data());
+        }
+
+        ast * read_node() {
+            switch (read_unsigned()) {
+            case TAG_SORT_UNINTERPRETED: return m.mk_uninterpreted_sort(read_symbol());
+            case TAG_SORT: return read_sort();
+            case TAG_FUNC_DECL_UNINTERPRETED: return read_func_decl(false);
+            case TAG_FUNC_DECL: return read_func_decl(true);
+            case TAG_APP: return read_app();
+            case TAG_VAR: {
+                unsigned idx = read_unsigned();
+                return m.mk_var(idx, read_sort_id());
+            }
+            case TAG_QUANTIFIER: return read_quantifier();
+            default: fail("unknown node kind");
+            }
+        }
+
+    public:
+        reader(ast_manager & m, std::istream & in) : m(m), m_in(in), m_nodes(m) {}
+
+        void operator()(ast_ref_vector & result) {
+            char buffer[sizeof(magic)];
+            if (!m_in.read(buffer, sizeof(buffer)) || memcmp(buffer, magic, sizeof(magic)) != 0)
+                fail("bad header");
+            if (read_unsigned() != version)
+                fail("unsupported version");
+            unsigned num_nodes = read_unsigned();
+            for (unsigned i = 0; i < num_nodes; ++i)
+                m_nodes.push_back(read_node());
+            unsigned num_roots = read_unsigned();
+            for (unsigned i = 0; i < num_roots; ++i)
+                result.push_back(read_id());
+        }
+    };
+}
+
+void ast_serialize(ast_manager & m, unsigned num_roots, ast * const * roots, std::ostream & out) {
+    writer w(m, out);
+    w(num_roots, roots);
+}
+
+void ast_deserialize(ast_manager & m, std::istream & in, ast_ref_vector & result) {
+    reader r(m, in);
+    r(result);
+}
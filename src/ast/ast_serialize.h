@@ -0,0 +1,38 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.h
+
+Abstract:
+
+    Compact binary serialization of AST DAGs.
+
+    The format lists every sort, declaration and term reachable from the
+    roots exactly once, in an order where children precede their parents.
+    Node references, integers and lengths are stored as variable length
+    integers and symbols are emitted once into a shared symbol table.
+    Theory declarations are identified by family name, so a stream can be
+    loaded into a different ast_manager.
+
+    Parameters that are private to a decl plugin (PARAM_EXTERNAL),
+    declarations of lambda definitions and datatypes are not supported.
+
+--*/
+#pragma once
+
+#include <iostream>
+#include "ast/ast.h"
+
+/**
+   \brief Write the DAG of the given roots to \c out.
+   Throws default_exception if a node cannot be serialized.
+*/
+void ast_serialize(ast_manager & m, unsigned num_roots, ast * const * roots, std::ostream & out);
+
+/**
+   \brief Read a DAG written by ast_serialize and append its roots to \c result.
+   Throws default_exception if the stream is malformed.
+*/
+void ast_deserialize(ast_manager & m, std::istream & in, ast_ref_vector & result);
@@ -54,6 +54,7 @@ namespace euf {
             m_tmp_node->m_args[i] = args[i];
         m_tmp_node->m_num_args = n;
         m_tmp_node->m_expr = e;
+        m_tmp_node->m_expr_id = e->get_id();
         m_tmp_node->m_table_id = UINT_MAX;
         return m_table.find(m_tmp_node);
     }
@@ -661,11 +662,14 @@ namespace euf {
         TRACE("euf_verbose", tout << bpp(n1) << " " << bpp(n2) << "\n");
             
         for (unsigned i = 0; i < n1->num_args(); ++i) 
-            push_lca(n1->get_arg(i), n2->get_arg(i));
+            if (n1->get_arg(i) != n2->get_arg(i))
+                push_lca(n1->get_arg(i), n2->get_arg(i));
     }
 
     enode* egraph::find_lca(enode* a, enode* b) {
         SASSERT(a->get_root() == b->get_root());
+        if (a == b)
+            return a;
         a->mark2_targets<true>();
         while (!b->is_marked2()) 
             b = b->m_target;
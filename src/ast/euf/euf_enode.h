@@ -56,6 +56,7 @@ namespace euf {
         unsigned      m_class_size = 1;         // Size of the equivalence class if the enode is the root.
         unsigned      m_table_id = UINT_MAX;       
         unsigned      m_generation = 0;         // Tracks how many quantifier instantiation rounds were needed to generate this enode.
+        unsigned      m_expr_id = UINT_MAX;     // Id of m_expr, kept here so that congruence hashing does not touch the expression.
         enode_vector  m_parents;
         enode*        m_next   = nullptr;
         enode*        m_root   = nullptr;
@@ -86,6 +87,7 @@ namespace euf {
             void* mem = r.allocate(get_enode_size(num_args));
             enode* n = new (mem) enode();
             n->m_expr = f;
+            n->m_expr_id = f->get_id();
             n->m_next = n;
             n->m_root = n;
             n->m_generation = generation, 
@@ -162,7 +164,7 @@ namespace euf {
         bool merge_tf() const { return merge_enabled() && (class_size() > 1 || num_parents() > 0 || num_args() > 0); }
 
         enode* get_arg(unsigned i) const { SASSERT(i < num_args()); return m_args[i]; }        
-        unsigned hash() const { return m_expr->get_id(); }
+        unsigned hash() const { return m_expr_id; }
 
         unsigned get_table_id() const { return m_table_id; }
         void     set_table_id(unsigned t) { m_table_id = t; }
@@ -203,8 +205,8 @@ namespace euf {
         sort*  get_sort() const { return m_expr->get_sort(); }
         app*  get_app() const { return to_app(m_expr); }
         func_decl* get_decl() const { return is_app(m_expr) ? to_app(m_expr)->get_decl() : nullptr; }
-        unsigned get_expr_id() const { return m_expr->get_id(); }
-        unsigned get_id() const { return m_expr->get_id(); }
+        unsigned get_expr_id() const { return m_expr_id; }
+        unsigned get_id() const { return m_expr_id; }
         unsigned get_small_id() const { return m_expr->get_small_id(); }
         unsigned get_root_id() const { return m_root->m_expr->get_id(); }
         bool children_are_roots() const;
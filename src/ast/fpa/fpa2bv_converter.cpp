@@ -4305,6 +4305,24 @@ void fpa2bv_converter_wrapped::mk_const(func_decl* f, expr_ref& result) {
     }
 }
 
+bool fpa2bv_converter_wrapped::mk_abstraction(app* t, expr_ref& result) {
+    if (!m_lazy || t->get_family_id() != m_util.get_family_id() || !is_ground(t))
+        return false;
+    switch (t->get_decl_kind()) {
+    case OP_FPA_MUL:
+    case OP_FPA_DIV:
+    case OP_FPA_REM:
+    case OP_FPA_FMA:
+    case OP_FPA_SQRT:
+        break;
+    default:
+        return false;
+    }
+    result = unwrap(wrap(t), t->get_sort());
+    m_abstracted.push_back(t);
+    return true;
+}
+
 app_ref fpa2bv_converter_wrapped::wrap(expr* e) {
     SASSERT(m_util.is_float(e) || m_util.is_rm(e));
     SASSERT(!m_util.is_bvwrap(e));
@@ -151,6 +151,12 @@ public:
 
     void set_unspecified_fp_hi(bool v) { m_hi_fp_unspecified = v; }
 
+    /**
+       \brief Return in \c result a replacement for the (unconverted) term \c t
+       instead of its bit-blasted encoding. Used for lazy encodings.
+    */
+    virtual bool mk_abstraction(app * t, expr_ref & result) { return false; }
+
     void mk_min(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_max(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_min_i(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
@@ -234,14 +240,26 @@ private:
 
 class fpa2bv_converter_wrapped : public fpa2bv_converter {
     th_rewriter& m_rw;
+    bool         m_lazy = false;
  public:
 
     fpa2bv_converter_wrapped(ast_manager & m, th_rewriter& rw) :
         fpa2bv_converter(m),
-        m_rw(rw) {}
+        m_rw(rw),
+        m_abstracted(m) {}
     virtual ~fpa2bv_converter_wrapped() {}
     void mk_const(func_decl * f, expr_ref & result) override;
     void mk_rm_const(func_decl * f, expr_ref & result) override;
+
+    /**
+       \brief In lazy mode, ground fp.mul, fp.div, fp.rem, fp.fma and fp.sqrt
+       terms are converted like uninterpreted constants, through the bvwrap
+       of the term. The abstracted terms are collected in m_abstracted and
+       the client is responsible for refining them.
+    */
+    void set_lazy(bool f) { m_lazy = f; }
+    bool mk_abstraction(app * t, expr_ref & result) override;
+    expr_ref_vector m_abstracted;
     app_ref wrap(expr * e);
     app_ref unwrap(expr * e, sort * s);
 
@@ -175,6 +175,16 @@ br_status fpa2bv_rewriter_cfg::reduce_app(func_decl * f, unsigned num, expr * co
     return BR_FAILED;
 }
 
+bool fpa2bv_rewriter_cfg::get_subst(expr * s, expr * & t, proof * & t_pr) {
+    expr_ref r(m());
+    if (!is_app(s) || !m_conv.mk_abstraction(to_app(s), r))
+        return false;
+    m_out.push_back(r);
+    t = r;
+    t_pr = nullptr;
+    return true;
+}
+
 bool fpa2bv_rewriter_cfg::pre_visit(expr * t)
 {
     TRACE("fpa2bv", tout << "pre_visit: " << mk_ismt2_pp(t, m()) << std::endl;);
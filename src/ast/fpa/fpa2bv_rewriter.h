@@ -56,6 +56,8 @@ struct fpa2bv_rewriter_cfg : public default_rewriter_cfg {
 
     bool pre_visit(expr * t);
 
+    bool get_subst(expr * s, expr * & t, proof * & t_pr);
+
     bool reduce_quantifier(quantifier * old_q,
                            expr * new_body,
                            expr * const * new_patterns,
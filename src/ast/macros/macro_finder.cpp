@@ -272,7 +272,14 @@ macro_finder::macro_finder(ast_manager & m, macro_manager & mm):
 macro_finder::~macro_finder() {
 }
 
-bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps) {
+/**
+   \brief expand the macros in exprs and collect new macros.
+   If todo is not empty, only the formulas i where todo[i] is set are processed,
+   the others are copied. new_todo is set for the formulas that were added
+   by macro rewriting and were not yet checked for macros.
+*/
+bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps,
+                                 svector<bool> const& todo, svector<bool>& new_todo) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
@@ -283,6 +290,15 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
         expr * n       = exprs[i];
         proof * pr     = m.proofs_enabled() ? prs[i] : nullptr;
         expr_dependency * dep = deps.get(i, nullptr);
+        if (!todo.empty() && !todo[i]) {
+            new_exprs.push_back(n);
+            if (m.proofs_enabled())
+                new_prs.push_back(pr);
+            if (deps_valid)
+                new_deps.push_back(dep);
+            new_todo.push_back(false);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -307,7 +323,9 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
                 new_prs.push_back(new_pr);
             if (deps_valid)
                 new_deps.push_back(new_dep);
+            new_todo.push_back(false);
         }
+        new_todo.resize(new_exprs.size(), true);
         SASSERT(exprs.size() != deps.size() || new_exprs.size() == new_deps.size());
         // SASSERT(!m.proofs_enabled() || new_exprs.size() == new_prs.size());
 
@@ -321,7 +339,9 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
     proof_ref_vector  _new_prs(m);
     expr_dependency_ref_vector _new_deps(m);
     unsigned num = exprs.size();
-    if (expand_macros(exprs, prs, deps, _new_exprs, _new_prs, _new_deps)) {
+    macro_occurs macro_occ(m_macro_manager);
+    svector<bool> todo, new_todo;
+    if (expand_macros(exprs, prs, deps, _new_exprs, _new_prs, _new_deps, todo, new_todo)) {
         for (unsigned i = 0; i < num; ++i) {
             expr_ref_vector  old_exprs(m);
             proof_ref_vector old_prs(m);
@@ -332,8 +352,15 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
             SASSERT(_new_exprs.empty());
             SASSERT(_new_prs.empty());
             SASSERT(_new_deps.empty());
+            // only formulas that use a macro found in the last round can change.
+            macro_occ.next_round();
+            todo.swap(new_todo);
+            new_todo.reset();
+            for (unsigned j = 0; j < old_exprs.size(); ++j)
+                if (!todo[j] && macro_occ(old_exprs.get(j)))
+                    todo[j] = true;
             if (!expand_macros(old_exprs, old_prs, old_deps,
-                               _new_exprs, _new_prs, _new_deps))
+                               _new_exprs, _new_prs, _new_deps, todo, new_todo))
                 break;
         }
     }
@@ -344,11 +371,17 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
 
 
 
-bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vector<justified_expr>& new_fmls) {
+bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vector<justified_expr>& new_fmls,
+                                 svector<bool> const& todo, svector<bool>& new_todo) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
     for (unsigned i = 0; i < num; i++) {
+        if (!todo.empty() && !todo[i]) {
+            new_fmls.push_back(fmls[i]);
+            new_todo.push_back(false);
+            continue;
+        }
         expr * n       = fmls[i].get_fml();
         proof * pr     = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
         expr_ref new_n(m), def(m);
@@ -371,7 +404,9 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
         }
         else {
             new_fmls.push_back(justified_expr(m, new_n, new_pr));
+            new_todo.push_back(false);
         }
+        new_todo.resize(new_fmls.size(), true);
     }
     return found_new_macro;
 }
@@ -379,12 +414,20 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
 void macro_finder::operator()(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls) {
     TRACE("macro_finder", tout << "processing macros...\n";);
     vector<justified_expr> _new_fmls;
-    if (expand_macros(n, fmls, _new_fmls)) {
+    macro_occurs macro_occ(m_macro_manager);
+    svector<bool> todo, new_todo;
+    if (expand_macros(n, fmls, _new_fmls, todo, new_todo)) {
         while (true) {
             vector<justified_expr> old_fmls;
             _new_fmls.swap(old_fmls);
             SASSERT(_new_fmls.empty());
-            if (!expand_macros(old_fmls.size(), old_fmls.data(), _new_fmls))
+            macro_occ.next_round();
+            todo.swap(new_todo);
+            new_todo.reset();
+            for (unsigned j = 0; j < old_fmls.size(); ++j)
+                if (!todo[j] && macro_occ(old_fmls[j].get_fml()))
+                    todo[j] = true;
+            if (!expand_macros(old_fmls.size(), old_fmls.data(), _new_fmls, todo, new_todo))
                 break;
         }
     }
@@ -31,8 +31,10 @@ class macro_finder {
     macro_util &                m_util;
     arith_util                  m_autil;
     bool expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const & deps, 
-                       expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector& new_deps);
-    bool expand_macros(unsigned n, justified_expr const * fmls, vector<justified_expr>& new_fmls);
+                       expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector& new_deps,
+                       svector<bool> const& todo, svector<bool>& new_todo);
+    bool expand_macros(unsigned n, justified_expr const * fmls, vector<justified_expr>& new_fmls,
+                       svector<bool> const& todo, svector<bool>& new_todo);
     bool is_arith_macro(expr * n, proof * pr, expr_ref_vector & new_exprs, proof_ref_vector & new_prs);
     bool is_arith_macro(expr * n, proof * pr, vector<justified_expr>& new_fmls);
     bool is_arith_macro(expr * n, proof * pr, bool deps_valid, expr_dependency * dep, expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps);
@@ -403,3 +403,52 @@ void macro_manager::expand_macros(expr * n, proof * pr, expr_dependency * dep, e
     SASSERT(!dep || new_dep);
 }
 
+
+bool macro_occurs::next_round() {
+    m_new_macros.reset();
+    m_visited.reset();
+    m_has_macro.reset();
+    for (; m_num_macros < m_macro_manager.get_num_macros(); ++m_num_macros)
+        m_new_macros.insert(m_macro_manager.get_macro_func_decl(m_num_macros));
+    return !m_new_macros.empty();
+}
+
+bool macro_occurs::operator()(expr * n) {
+    ptr_buffer<expr> todo;
+    todo.push_back(n);
+    while (!todo.empty()) {
+        expr * e = todo.back();
+        if (m_visited.is_marked(e)) {
+            todo.pop_back();
+            continue;
+        }
+        bool has_macro = false, visited = true;
+        if (is_app(e)) {
+            has_macro = m_new_macros.contains(to_app(e)->get_decl());
+            for (expr * arg : *to_app(e)) {
+                if (!m_visited.is_marked(arg)) {
+                    todo.push_back(arg);
+                    visited = false;
+                }
+                else if (m_has_macro.is_marked(arg))
+                    has_macro = true;
+            }
+        }
+        else if (is_quantifier(e)) {
+            expr * body = to_quantifier(e)->get_expr();
+            if (!m_visited.is_marked(body)) {
+                todo.push_back(body);
+                visited = false;
+            }
+            else
+                has_macro = m_has_macro.is_marked(body);
+        }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        m_visited.mark(e);
+        if (has_macro)
+            m_has_macro.mark(e);
+    }
+    return m_has_macro.is_marked(n);
+}
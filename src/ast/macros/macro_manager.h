@@ -90,4 +90,29 @@ public:
 
 };
 
+/**
+   \brief Track the macros added to a macro manager in rounds.
+   A formula only changes under macro expansion if it contains
+   an application of a macro found in the last round.
+*/
+class macro_occurs {
+    macro_manager &             m_macro_manager;
+    unsigned                    m_num_macros;
+    obj_hashtable<func_decl>    m_new_macros;
+    expr_mark                   m_visited;
+    expr_mark                   m_has_macro;
+public:
+    macro_occurs(macro_manager & mm): m_macro_manager(mm), m_num_macros(mm.get_num_macros()) {}
+    /**
+       \brief start a new round with the macros added since the previous round.
+       Return false if there are none.
+    */
+    bool next_round();
+    /**
+       \brief check if n contains an application of a macro of the current round.
+       Sub-terms are visited once per round.
+    */
+    bool operator()(expr * n);
+};
+
 
@@ -350,9 +350,11 @@ bool quasi_macros::find_macros(unsigned n, justified_expr const * exprs) {
     return res;
 }
 
-void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector& deps) {
+void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector& deps, macro_occurs& occurs) {
     unsigned n = exprs.size();
     for (unsigned i = 0 ; i < n ; i++ ) {
+        if (!occurs(exprs.get(i)))
+            continue;
         expr_ref r(m), rr(m);
         proof_ref pr(m), prr(m);
         expr_dependency_ref dep(m);
@@ -368,8 +370,10 @@ void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs,
 
 bool quasi_macros::operator()(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector & deps) {
     unsigned n = exprs.size();
+    macro_occurs occurs(m_macro_manager);
     if (find_macros(n, exprs.data())) {
-        apply_macros(exprs, prs, deps);
+        occurs.next_round();
+        apply_macros(exprs, prs, deps, occurs);
         return true;
     }
     else {
@@ -377,8 +381,12 @@ bool quasi_macros::operator()(expr_ref_vector & exprs, proof_ref_vector & prs, e
     }
 }
 
-void quasi_macros::apply_macros(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls) {
+void quasi_macros::apply_macros(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls, macro_occurs& occurs) {
     for (unsigned i = 0 ; i < n ; i++) {
+        if (!occurs(fmls[i].get_fml())) {
+            new_fmls.push_back(fmls[i]);
+            continue;
+        }
         expr_ref r(m), rr(m);
         proof_ref pr(m), prr(m);
         proof * p = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
@@ -392,8 +400,10 @@ void quasi_macros::apply_macros(unsigned n, justified_expr const* fmls, vector<j
 
 bool quasi_macros::operator()(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls) {
     TRACE("quasi_macros", m_macro_manager.display(tout););
+    macro_occurs occurs(m_macro_manager);
     if (find_macros(n, fmls)) {
-        apply_macros(n, fmls, new_fmls);
+        occurs.next_round();
+        apply_macros(n, fmls, new_fmls, occurs);
         return true;
     } 
     else {
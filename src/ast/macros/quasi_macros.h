@@ -55,8 +55,8 @@ class quasi_macros {
     void find_occurrences(expr * e);
     bool find_macros(unsigned n, expr * const * exprs);
     bool find_macros(unsigned n, justified_expr const* expr);
-    void apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector& deps);
-    void apply_macros(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls);
+    void apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector& deps, macro_occurs& occurs);
+    void apply_macros(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls, macro_occurs& occurs);
 
 public:
     quasi_macros(ast_manager & m, macro_manager & mm);
@@ -27,6 +27,8 @@ Revision History:
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
 #include "ast/rewriter/rewriter_def.h"
+#include "ast/ast_translation.h"
+#include "util/mutex.h"
 
 void smaller_pattern::save(expr * p1, expr * p2) {
     expr_pair e(p1, p2);
@@ -573,6 +575,111 @@ void pattern_inference_cfg::mk_patterns(unsigned num_bindings,
 }
 
 
+/**
+   \brief Process wide cache of inferred patterns.
+
+   Quantifiers are translated into a private ast_manager. Structurally
+   equal quantifiers, built in different contexts or managers, are then
+   the same quantifier in the cache manager. A separate table is kept
+   for each pattern inference configuration.
+   The cache is flushed when it holds max_entries quantifiers, so it does
+   not grow without bounds in long running processes.
+*/
+class pattern_inference_cache {
+    typedef obj_map<quantifier, quantifier*> table;
+    static const unsigned max_entries = 1 << 14;
+    mutex                m_mux;
+    unsigned             m_num_entries = 0;
+    ast_manager*         m_manager = nullptr;
+    quantifier_ref_vector* m_pinned = nullptr;
+    std::vector<std::pair<std::string, table*>> m_tables;
+
+    table& get_table(std::string const& config) {
+        for (auto const& [c, t] : m_tables)
+            if (c == config)
+                return *t;
+        m_tables.push_back({ config, alloc(table) });
+        return *m_tables.back().second;
+    }
+
+    void init() {
+        if (!m_manager) {
+            m_manager = alloc(ast_manager, PGM_DISABLED);
+            m_pinned = alloc(quantifier_ref_vector, *m_manager);
+        }
+    }
+
+public:
+    ~pattern_inference_cache() { reset(); }
+
+    bool find(ast_manager& m, std::string const& config, quantifier* q, expr_ref& result) {
+        lock_guard lock(m_mux);
+        if (!m_manager)
+            return false;
+        ast_translation to_cache(m, *m_manager);
+        quantifier* r = nullptr;
+        if (!get_table(config).find(to_cache(q), r))
+            return false;
+        ast_translation from_cache(*m_manager, m);
+        result = from_cache(r);
+        return true;
+    }
+
+    void insert(ast_manager& m, std::string const& config, quantifier* q, quantifier* r) {
+        lock_guard lock(m_mux);
+        if (m_num_entries >= max_entries)
+            reset();
+        init();
+        ++m_num_entries;
+        ast_translation to_cache(m, *m_manager);
+        quantifier* cq = to_cache(q);
+        quantifier* cr = to_cache(r);
+        m_pinned->push_back(cq);
+        m_pinned->push_back(cr);
+        get_table(config).insert(cq, cr);
+    }
+
+    void reset() {
+        for (auto const& [c, t] : m_tables)
+            dealloc(t);
+        m_tables.clear();
+        dealloc(m_pinned);
+        dealloc(m_manager);
+        m_pinned = nullptr;
+        m_manager = nullptr;
+        m_num_entries = 0;
+    }
+};
+
+static pattern_inference_cache* g_pattern_inference_cache = nullptr;
+static mutex g_pattern_inference_cache_mux;
+
+static pattern_inference_cache& get_pattern_inference_cache() {
+    lock_guard lock(g_pattern_inference_cache_mux);
+    if (!g_pattern_inference_cache)
+        g_pattern_inference_cache = alloc(pattern_inference_cache);
+    return *g_pattern_inference_cache;
+}
+
+void finalize_pattern_inference_cache() {
+    dealloc(g_pattern_inference_cache);
+    g_pattern_inference_cache = nullptr;
+}
+
+/**
+   \brief the cache can be used when the result only depends on the quantifier
+   and the parameters.
+*/
+bool pattern_inference_cfg::use_cache(quantifier * q, expr * new_body) const {
+    return m_params.m_pi_cache && m_preferred.empty() && new_body == q->get_expr() && !m.proofs_enabled();
+}
+
+std::string pattern_inference_cfg::cache_config() const {
+    std::ostringstream out;
+    m_params.display(out);
+    return out.str();
+}
+
 bool pattern_inference_cfg::reduce_quantifier(
     quantifier * q, 
     expr * new_body, 
@@ -615,6 +722,12 @@ bool pattern_inference_cfg::reduce_quantifier(
         return false;
     }
 
+    bool cache = use_cache(q, new_body);
+    if (cache && get_pattern_inference_cache().find(m, cache_config(), q, result)) {
+        TRACE("pattern_inference", tout << "cached:\n" << result << "\n";);
+        return result != q;
+    }
+
     if (m_params.m_pi_nopat_weight >= 0)
         weight = m_params.m_pi_nopat_weight;
 
@@ -710,10 +823,14 @@ bool pattern_inference_cfg::reduce_quantifier(
     }
 
     if (new_patterns.empty() && new_body == q->get_expr()) {
+        if (cache)
+            get_pattern_inference_cache().insert(m, cache_config(), q, q);
         return false;
     }
 
     result = new_q;
+    if (cache)
+        get_pattern_inference_cache().insert(m, cache_config(), q, new_q);
 
     IF_VERBOSE(10,
         verbose_stream() << "(smt.inferred-patterns :qid " << q->get_qid() << "\n";
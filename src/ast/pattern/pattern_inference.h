@@ -247,6 +247,10 @@ public:
     }
 
     bool is_forbidden(app * n) const;
+
+    bool use_cache(quantifier * q, expr * new_body) const;
+
+    std::string cache_config() const;
 };
 
 class pattern_inference_rw : public rewriter_tpl<pattern_inference_cfg> {
@@ -255,4 +259,10 @@ public:
     pattern_inference_rw(ast_manager& m, pattern_inference_params const & params);
 };
 
+void finalize_pattern_inference_cache();
+
+/*
+  ADD_FINALIZER('finalize_pattern_inference_cache();')
+*/
+
 
@@ -37,11 +37,28 @@ static void sort_args(expr * & l1, expr * & l2, expr * & l3) {
 }
 
 
+static bool strip_not(ast_manager & m, expr * & l) {
+    return m.is_not(l, l);
+}
+
 void bit_blaster_cfg::mk_xor3(expr * l1, expr * l2, expr * l3, expr_ref & r) {
     TRACE("xor3", tout << "#" << l1->get_id() << " #" << l2->get_id() << " #" << l3->get_id(););
+    // xor3 is odd in every argument, pull the negations out of the gate 
+    // so that gates that only differ in the polarity of their inputs are shared.
+    bool neg = false;
+    if (m_params.m_bb_ext_gates) {
+        neg ^= strip_not(m(), l1);
+        neg ^= strip_not(m(), l2);
+        neg ^= strip_not(m(), l3);
+    }
     sort_args(l1, l2, l3);
     TRACE("xor3_sorted", tout << "#" << l1->get_id() << " #" << l2->get_id() << " #" << l3->get_id(););
-    if (m_params.m_bb_ext_gates) {
+    if (neg) {
+        expr_ref t(m());
+        mk_xor3(l1, l2, l3, t);
+        m_rw.mk_not(t, r);
+    }
+    else if (m_params.m_bb_ext_gates) {
         if (l1 == l2)
             r = l3;
         else if (l1 == l3)
@@ -78,6 +95,16 @@ void bit_blaster_cfg::mk_xor3(expr * l1, expr * l2, expr * l3, expr_ref & r) {
 
 void bit_blaster_cfg::mk_carry(expr * l1, expr * l2, expr * l3, expr_ref & r) {
     TRACE("carry", tout << "#" << l1->get_id() << " #" << l2->get_id() << " #" << l3->get_id(););
+    // carry is self-dual, with at least two negated inputs use the negated carry of the complements.
+    if ((m().is_not(l1) ? 1 : 0) + (m().is_not(l2) ? 1 : 0) + (m().is_not(l3) ? 1 : 0) >= 2) {
+        expr_ref n1(m()), n2(m()), n3(m()), t(m());
+        m_rw.mk_not(l1, n1);
+        m_rw.mk_not(l2, n2);
+        m_rw.mk_not(l3, n3);
+        mk_carry(n1, n2, n3, t);
+        m_rw.mk_not(t, r);
+        return;
+    }
     sort_args(l1, l2, l3);
     TRACE("carry_sorted", tout << "#" << l1->get_id() << " #" << l2->get_id() << " #" << l3->get_id(););
     if (m_params.m_bb_ext_gates) {
@@ -48,6 +48,18 @@ struct blaster_cfg {
     void mk_or(unsigned sz, expr * const * args, expr_ref & r) { m_rewriter.mk_or(sz, args, r); }
     void mk_not(expr * a, expr_ref & r) { m_rewriter.mk_not(a, r); }
     void mk_carry(expr * a, expr * b, expr * c, expr_ref & r) {
+        // carry is self-dual: with at least two negated inputs build the carry
+        // of the complements and negate it, so that carries of subtractors and
+        // comparators share the gates of the corresponding adders.
+        if ((m().is_not(a) ? 1 : 0) + (m().is_not(b) ? 1 : 0) + (m().is_not(c) ? 1 : 0) >= 2) {
+            expr_ref na(m()), nb(m()), nc(m()), t(m());
+            mk_not(a, na);
+            mk_not(b, nb);
+            mk_not(c, nc);
+            mk_carry(na, nb, nc, t);
+            mk_not(t, r);
+            return;
+        }
         expr_ref t1(m()), t2(m()), t3(m());
 #if 1
         mk_and(a, b, t1);
@@ -33,7 +33,12 @@ bool cached_var_subst::key_eq_proc::operator()(cached_var_subst::key * k1, cache
 cached_var_subst::cached_var_subst(ast_manager & _m):
     m(_m),
     m_proc(m),
-    m_refs(m) {
+    m_refs(m),
+    m_pinned(m) {
+}
+
+cached_var_subst::~cached_var_subst() {
+    std::for_each(m_template_list.begin(), m_template_list.end(), delete_proc<inst_template>());
 }
 
 void cached_var_subst::reset() {
@@ -42,6 +47,94 @@ void cached_var_subst::reset() {
     m_region.reset();
     m_new_keys.reset();
     m_key = nullptr;
+    std::for_each(m_template_list.begin(), m_template_list.end(), delete_proc<inst_template>());
+    m_template_list.reset();
+    m_templates.reset();
+}
+
+/**
+   \brief Build the instantiation template of q, or return nullptr if the body
+   contains nested quantifiers. Ground sub-terms are not part of the template,
+   instances share them with the body.
+*/
+cached_var_subst::inst_template * cached_var_subst::mk_template(quantifier * q) {
+    expr * body = q->get_expr();
+    if (is_ground(body) || has_quantifiers(body))
+        return nullptr;
+    inst_template * t = alloc(inst_template);
+    obj_map<expr, unsigned> slot;
+    ptr_buffer<expr> todo;
+    todo.push_back(body);
+    while (!todo.empty()) {
+        expr * e = todo.back();
+        if (slot.contains(e)) {
+            todo.pop_back();
+            continue;
+        }
+        if (is_var(e)) {
+            t->m_max_var = std::max(t->m_max_var, to_var(e)->get_idx() + 1);
+            slot.insert(e, t->m_nodes.size());
+            t->m_nodes.push_back(e);
+            t->m_offsets.push_back(t->m_slots.size());
+            todo.pop_back();
+            continue;
+        }
+        SASSERT(is_app(e) && !is_ground(e));
+        bool visited = true;
+        for (expr * arg : *to_app(e)) {
+            if (!is_ground(arg) && !slot.contains(arg)) {
+                todo.push_back(arg);
+                visited = false;
+            }
+        }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        slot.insert(e, t->m_nodes.size());
+        t->m_nodes.push_back(e);
+        t->m_offsets.push_back(t->m_slots.size());
+        for (expr * arg : *to_app(e))
+            t->m_slots.push_back(is_ground(arg) ? UINT_MAX : slot[arg]);
+    }
+    t->m_offsets.push_back(t->m_slots.size());
+    m_template_list.push_back(t);
+    return t;
+}
+
+/**
+   \brief Instantiate the template by rebuilding only its non-ground nodes.
+   Return false if the bindings do not cover the variables of the body,
+   the caller then falls back to var_subst.
+*/
+bool cached_var_subst::instantiate(inst_template const & t, unsigned num_bindings, expr * const * bindings, expr_ref & result) {
+    if (t.m_max_var > num_bindings)
+        return false;
+    for (unsigned i = 0; i < t.m_max_var; ++i)
+        if (!bindings[num_bindings - i - 1])
+            return false;
+    unsigned sz = t.m_nodes.size();
+    m_values.reset();
+    m_pinned.reset();
+    for (unsigned i = 0; i < sz; ++i) {
+        expr * e = t.m_nodes[i];
+        if (is_var(e)) {
+            m_values.push_back(bindings[num_bindings - to_var(e)->get_idx() - 1]);
+            continue;
+        }
+        app * a = to_app(e);
+        m_args.reset();
+        unsigned j = t.m_offsets[i];
+        for (expr * arg : *a) {
+            unsigned s = t.m_slots[j++];
+            m_args.push_back(s == UINT_MAX ? arg : m_values[s]);
+        }
+        app * r = m.mk_app(a->get_decl(), m_args.size(), m_args.data());
+        m_pinned.push_back(r);
+        m_values.push_back(r);
+    }
+    result = m_values.back();
+    m_pinned.reset();
+    return true;
 }
 
 expr** cached_var_subst::operator()(quantifier* qa, unsigned num_bindings) {
@@ -75,7 +168,14 @@ expr_ref cached_var_subst::operator()() {
 
     SASSERT(entry->get_data().m_value == 0);
     try {
-        result = m_proc(m_key->m_qa->get_expr(), m_key->m_num_bindings, m_key->m_bindings);
+        inst_template * t = nullptr;
+        if (!m_templates.find(m_key->m_qa, t)) {
+            t = mk_template(m_key->m_qa);
+            m_templates.insert(m_key->m_qa, t);
+            m_refs.push_back(m_key->m_qa);
+        }
+        if (!t || !instantiate(*t, m_key->m_num_bindings, m_key->m_bindings, result))
+            result = m_proc(m_key->m_qa->get_expr(), m_key->m_num_bindings, m_key->m_bindings);
     }
     catch (...) {
         // CMW: The var_subst reducer was interrupted and m_instances is
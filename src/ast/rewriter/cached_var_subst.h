@@ -36,6 +36,23 @@ class cached_var_subst {
         bool operator()(key * k1, key * k2) const;
     };
     typedef map<key *, expr *, key_hash_proc, key_eq_proc> instances;
+
+    /**
+       \brief instantiation template of a quantifier body.
+       m_nodes contains the non-ground sub-terms of the body in post-order,
+       the body is the last one. For the application m_nodes[i], the range
+       [m_offsets[i], m_offsets[i+1]) of m_slots gives, for each argument,
+       the position of the argument in m_nodes or UINT_MAX if the argument
+       is ground and is shared by all instances.
+    */
+    struct inst_template {
+        ptr_vector<expr> m_nodes;
+        unsigned_vector  m_offsets;
+        unsigned_vector  m_slots;
+        unsigned         m_max_var = 0;
+    };
+    typedef obj_map<quantifier, inst_template *> templates;
+
     ast_manager&     m;
     var_subst        m_proc;
     expr_ref_vector  m_refs;
@@ -43,8 +60,17 @@ class cached_var_subst {
     region           m_region;
     ptr_vector<key>  m_new_keys; // mapping from num_bindings -> next key
     key*             m_key { nullptr };
+    templates        m_templates;
+    ptr_vector<inst_template> m_template_list;
+    ptr_vector<expr> m_values;
+    expr_ref_vector  m_pinned;
+    ptr_buffer<expr> m_args;
+
+    inst_template * mk_template(quantifier * q);
+    bool instantiate(inst_template const & t, unsigned num_bindings, expr * const * bindings, expr_ref & result);
 public:
     cached_var_subst(ast_manager & m);
+    ~cached_var_subst();
     expr** operator()(quantifier * qa, unsigned num_bindings);
     expr_ref operator()();
     void reset();
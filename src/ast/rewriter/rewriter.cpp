@@ -98,6 +98,15 @@ void rewriter_core::reset_cache() {
     }
 }
 
+void rewriter_core::filter_cache(std::function<bool(expr*)> const& keep) {
+    SASSERT(!m_cache_stack.empty());
+    if (m_proof_gen || m_cache != m_cache_stack[0]) {
+        reset();
+        return;
+    }
+    m_cache->filter(keep);
+}
+
 // free memory allocated by the rewriter
 void rewriter_core::free_memory() {
     del_cache_stack();
@@ -64,6 +64,8 @@ protected:
     obj_hashtable<expr>        m_blocked;
     expr *                     m_root;
     unsigned                   m_num_qvars;
+    unsigned                   m_num_cache_hits = 0;
+    unsigned                   m_num_cache_misses = 0;
     struct scope {
         expr *   m_old_root;
         unsigned m_old_num_qvars;
@@ -122,11 +124,18 @@ public:
     ast_manager & m() const { return m_manager; }
     void reset();
     void cleanup();
+    /**
+       \brief Drop the cached results of the keys that do not satisfy keep.
+       The remaining cached results are kept for the next invocation.
+    */
+    void filter_cache(std::function<bool(expr*)> const& keep);
     void set_cancel_check(bool f) { m_cancel_check = f; }
 #ifdef _TRACE
     void display_stack(std::ostream & out, unsigned pp_depth);
 #endif
     unsigned get_cache_size() const;
+    unsigned get_num_cache_hits() const { return m_num_cache_hits; }
+    unsigned get_num_cache_misses() const { return m_num_cache_misses; }
 };
 
 class var_shifter_core : public rewriter_core {
@@ -249,6 +258,8 @@ protected:
     bool cache_results() const { return m_cfg.cache_results(); }
     // cache all results share and non shared expressions non atomic expressions.
     bool cache_all_results() const { return m_cfg.cache_all_results(); }
+    // index the top-level cache by expression ids instead of hashing.
+    bool dense_cache() const { return m_cfg.dense_cache(); }
     // flat non shared AC terms
     bool flat_assoc(func_decl * f) const { return m_cfg.flat_assoc(f); }
     // rewrite patterns
@@ -376,6 +387,7 @@ public:
 
 struct default_rewriter_cfg {
     bool cache_all_results() const { return false; }
+    bool dense_cache() const { return false; }
     bool cache_results() const { return true; }
     bool flat_assoc(func_decl * f) const { return false; }
     bool rewrite_patterns() const { return true; }
@@ -171,6 +171,7 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
 #endif
         expr * r = get_cached(t);
         if (r) {
+            m_num_cache_hits++;
             SASSERT(r->get_sort() == t->get_sort());
             result_stack().push_back(r);
             set_new_child_flag(t, r);
@@ -182,6 +183,7 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
             }
             return true;
         }
+        m_num_cache_misses++;
     }
     if (!pre_visit(t)) {
         result_stack().push_back(t);
@@ -769,6 +771,7 @@ void rewriter_tpl<Config>::resume_core(expr_ref & result, proof_ref & result_pr)
         if (first_visit(fr) && fr.m_cache_result) {
             expr * r = get_cached(t);
             if (r) {
+                m_num_cache_hits++;
                 SASSERT(r->get_sort() == t->get_sort());
                 result_stack().push_back(r);
                 if (ProofGen) {
@@ -779,6 +782,7 @@ void rewriter_tpl<Config>::resume_core(expr_ref & result, proof_ref & result_pr)
                 set_new_child_flag(t, r);
                 continue;
             }
+            m_num_cache_misses++;
         }
         switch (t->get_kind()) {
         case AST_APP:
@@ -817,6 +821,8 @@ void rewriter_tpl<Config>::operator()(expr * t, expr_ref & result, proof_ref & r
         m_scopes.reset();
         reset_cache();
     }
+    if (m_cache->is_dense() != dense_cache())
+        m_cache->set_dense(dense_cache());
 
     if (m_proof_gen)
         main_loop<true>(t, result, result_pr);
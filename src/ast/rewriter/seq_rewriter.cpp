@@ -87,10 +87,12 @@ class sym_expr_boolean_algebra : public boolean_algebra<sym_expr*> {
     ast_manager& m;
     expr_solver& m_solver;
     expr_ref     m_var;
+    obj_map<expr, lbool> m_is_sat;  // solver results for predicates, which recur across products
+    expr_ref_vector      m_pinned;
     typedef sym_expr* T;
 public:
     sym_expr_boolean_algebra(ast_manager& m, expr_solver& s): 
-        m(m), m_solver(s), m_var(m) {}
+        m(m), m_solver(s), m_var(m), m_pinned(m) {}
 
     T mk_false() override {
         expr_ref fml(m.mk_false(), m);
@@ -225,7 +227,16 @@ public:
         if (m.is_false(fml)) {
             return l_false;
         }
-        return m_solver.check_sat(fml);
+        lbool r = l_undef;
+        if (m_is_sat.find(fml, r)) {
+            return r;
+        }
+        r = m_solver.check_sat(fml);
+        if (r != l_undef) {
+            m_pinned.push_back(fml);
+            m_is_sat.insert(fml, r);
+        }
+        return r;
     }
 
     T mk_not(T x) override {
@@ -234,12 +245,36 @@ public:
 
 };
 
-re2automaton::re2automaton(ast_manager& m): m(m), u(m), m_ba(nullptr), m_sa(nullptr) {}
+re2automaton::re2automaton(ast_manager& m): m(m), u(m), m_ba(nullptr), m_sa(nullptr), m_pinned(m) {}
 
 void re2automaton::set_solver(expr_solver* solver) {
     m_solver = solver;
     m_ba = alloc(sym_expr_boolean_algebra, m, *solver);
     m_sa = alloc(symbolic_automata_t, sm, *m_ba.get());
+    m_cache.reset();
+    m_cached.reset();
+    m_pinned.reset();
+}
+
+/**
+   \brief Complements and intersections are built by determinization and products
+   that check the satisfiability of character predicates. Their automata are cached
+   per regular expression, and callers receive copies they own.
+*/
+eautomaton* re2automaton::find_cached(expr* e) {
+    eautomaton* a = nullptr;
+    if (m_cache.find(e, a))
+        return eautomaton::clone(*a);
+    return nullptr;
+}
+
+eautomaton* re2automaton::cache(expr* e, eautomaton* a) {
+    if (!a)
+        return a;
+    m_pinned.push_back(e);
+    m_cached.push_back(eautomaton::clone(*a));
+    m_cache.insert(e, m_cached.back());
+    return a;
 }
 
 eautomaton* re2automaton::mk_product(eautomaton* a1, eautomaton* a2) {
@@ -311,8 +346,11 @@ eautomaton* re2automaton::re2aut(expr* e) {
             return alloc(eautomaton, sm);
         }
     }
+    else if (u.re.is_complement(e, e0) && m_sa && (a = find_cached(e))) {
+        return a.detach();
+    }
     else if (u.re.is_complement(e, e0) && (a = re2aut(e0)) && m_sa) {
-        return m_sa->mk_complement(*a);
+        return cache(e, m_sa->mk_complement(*a));
     }
     else if (u.re.is_loop(e, e1, lo, hi) && (a = re2aut(e1))) {
         scoped_ptr<eautomaton> eps = eautomaton::mk_epsilon(sm);
@@ -358,10 +396,13 @@ eautomaton* re2automaton::re2aut(expr* e) {
         a = alloc(eautomaton, sm, _true);
         return a.detach();
     }
+    else if (u.re.is_intersection(e, e1, e2) && m_sa && (a = find_cached(e))) {
+        return a.detach();
+    }
     else if (u.re.is_intersection(e, e1, e2) && m_sa && (a = re2aut(e1)) && (b = re2aut(e2))) {
         eautomaton* r = m_sa->mk_product(*a, *b);
-        TRACE("seq", display_expr1 disp(m); a->display(tout << "a:", disp); b->display(tout << "b:", disp); r->display(tout << "intersection:", disp););
-        return r;
+        TRACE("seq", display_expr1 disp(m); a->display(tout << "a:", disp); b->display(tout << "b:", disp); if (r) r->display(tout << "intersection:", disp););
+        return cache(e, r);
     }
     else {        
         TRACE("seq", tout << "not handled " << mk_pp(e, m) << "\n";);
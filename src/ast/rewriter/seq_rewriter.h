@@ -26,6 +26,7 @@ Notes:
 #include "util/params.h"
 #include "util/lbool.h"
 #include "util/sign.h"
+#include "util/scoped_ptr_vector.h"
 #include "math/automata/automaton.h"
 #include "math/automata/symbolic_automata.h"
 
@@ -97,10 +98,15 @@ class re2automaton {
     scoped_ptr<expr_solver>         m_solver;
     scoped_ptr<boolean_algebra_t>   m_ba;
     scoped_ptr<symbolic_automata_t> m_sa;
+    obj_map<expr, eautomaton*>      m_cache;    // automata of regular expressions built with solver calls
+    scoped_ptr_vector<eautomaton>   m_cached;
+    expr_ref_vector                 m_pinned;
 
     bool is_unit_char(expr* e, expr_ref& ch);
     eautomaton* re2aut(expr* e);
     eautomaton* seq2aut(expr* e);
+    eautomaton* find_cached(expr* e);
+    eautomaton* cache(expr* e, eautomaton* a);
 public:
     re2automaton(ast_manager& m);
     eautomaton* operator()(expr* e);
@@ -38,6 +38,7 @@ Notes:
 #include "ast/ast_util.h"
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
+#include "util/scoped_profile.h"
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -68,6 +69,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     bool                m_pull_cheap_ite = true;
     bool                m_flat = true;
     bool                m_cache_all = false;
+    bool                m_cache_dense = false;
     bool                m_push_ite_arith = true;
     bool                m_push_ite_bv = true;
     bool                m_ignore_patterns_on_ground_qbody = true;
@@ -83,6 +85,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_max_steps      = p.max_steps();
         m_pull_cheap_ite = p.pull_cheap_ite();
         m_cache_all      = p.cache_all();
+        m_cache_dense    = p.cache_dense();
         m_push_ite_arith = p.push_ite_arith();
         m_push_ite_bv    = p.push_ite_bv();
         m_ignore_patterns_on_ground_qbody = p.ignore_patterns_on_ground_qbody();
@@ -118,6 +121,8 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
 
     bool cache_all_results() const { return m_cache_all; }
 
+    bool dense_cache() const { return m_cache_dense; }
+
     bool max_steps_exceeded(unsigned num_steps) const {
         if (m_max_memory != SIZE_MAX && 
             memory::get_allocation_size() > m_max_memory)
@@ -929,6 +934,14 @@ unsigned th_rewriter::get_num_steps() const {
     return m_imp->get_num_steps();
 }
 
+unsigned th_rewriter::get_num_cache_hits() const {
+    return m_imp->get_num_cache_hits();
+}
+
+unsigned th_rewriter::get_num_cache_misses() const {
+    return m_imp->get_num_cache_misses();
+}
+
 
 void th_rewriter::cleanup() {
     ast_manager & m = m_imp->m();
@@ -942,16 +955,19 @@ void th_rewriter::reset() {
 }
 
 void th_rewriter::operator()(expr_ref & term) {
+    scoped_profile _profile("rewriter");
     expr_ref result(term.get_manager());
     m_imp->operator()(term, result);
     term = std::move(result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
+    scoped_profile _profile("rewriter");
     m_imp->operator()(t, result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
+    scoped_profile _profile("rewriter");
     m_imp->operator()(t, result, result_pr);
 }
 
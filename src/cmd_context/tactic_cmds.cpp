@@ -88,6 +88,7 @@ void help_tactic(cmd_context & ctx) {
     buf << "- (or-else <tactic>+) tries the given tactics in sequence until one of them succeeds (i.e., the first that doesn't fail).\n";
     buf << "- (par-or <tactic>+) executes the given tactics in parallel until one of them succeeds (i.e., the first that doesn't fail).\n";
     buf << "- (par-then <tactic1> <tactic2>) executes tactic1 and then tactic2 to every subgoal produced by tactic1. All subgoals are processed in parallel.\n";
+    buf << "- (par-components <tactic>) applies tactic to each group of assertions that share no uninterpreted symbols with the rest, processing the groups in parallel.\n";
     buf << "- (try-for <tactic> <num>) executes the given tactic for at most <num> milliseconds, it fails if the execution takes more than <num> milliseconds.\n";
     buf << "- (if <probe> <tactic> <tactic>) if <probe> evaluates to true, then execute the first tactic. Otherwise execute the second.\n";
     buf << "- (when <probe> <tactic>) shorthand for (if <probe> <tactic> skip).\n";
@@ -637,6 +638,15 @@ static tactic * mk_if_no_unsat_cores(cmd_context & ctx, sexpr * n) {
     return if_no_unsat_cores(t);
 }
 
+static tactic * mk_par_components(cmd_context & ctx, sexpr * n) {
+    SASSERT(n->is_composite());
+    unsigned num_children = n->get_num_children();
+    if (num_children != 2)
+        throw cmd_exception("invalid par-components combinator, one argument expected", n->get_line(), n->get_pos());
+    tactic * t = sexpr2tactic(ctx, n->get_child(1));
+    return par_components(t);
+}
+
 static tactic * mk_skip_if_failed(cmd_context & ctx, sexpr * n) {
     SASSERT(n->is_composite());
     unsigned num_children = n->get_num_children();
@@ -698,6 +708,8 @@ tactic * sexpr2tactic(cmd_context & ctx, sexpr * n) {
             return mk_if_no_unsat_cores(ctx, n);
         else if (cmd_name == "skip-if-failed")
             return mk_skip_if_failed(ctx, n);
+        else if (cmd_name == "par-components")
+            return mk_par_components(ctx, n);
         else
             throw cmd_exception("invalid tactic, unknown tactic combinator ", cmd_name, n->get_line(), n->get_pos());
     }
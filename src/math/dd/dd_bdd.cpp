@@ -43,8 +43,8 @@ namespace dd {
             m_nodes.back().m_index = m_nodes.size()-1;
         }
 
-        m_spare_entry = nullptr;
         m_max_num_bdd_nodes = 1 << 24; // up to 16M nodes
+        m_max_op_cache_size = 1 << 22;
         m_mark_level = 0;
         alloc_free_nodes(1024 + num_vars);
         m_disable_gc = false;
@@ -57,13 +57,6 @@ namespace dd {
     }
 
     bdd_manager::~bdd_manager() {
-        if (m_spare_entry) {
-            m_alloc.deallocate(sizeof(*m_spare_entry), m_spare_entry);
-        }
-        for (auto* e : m_op_cache) {
-            SASSERT(e != m_spare_entry);
-            m_alloc.deallocate(sizeof(*e), e);
-        }
     }
     
     bdd_manager::BDD bdd_manager::apply_const(BDD a, BDD b, bdd_op op) {
@@ -108,20 +101,50 @@ namespace dd {
     bdd bdd_manager::mk_forall(unsigned v, bdd const& b) { return mk_forall(1, &v, b); }
 
 
-    bool bdd_manager::check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c) {
-        if (e1 != e2) {
-            SASSERT(e2->m_result != null_bdd);
-            push_entry(e1);
-            e1 = nullptr;
-            return true;            
-        }
-        else {
-            e1->m_bdd1 = a;
-            e1->m_bdd2 = b;
-            e1->m_op = c;
-            SASSERT(e1->m_result == null_bdd);
-            return false;        
-        }
+    /**
+       The operation cache is a direct-mapped table: a slot holds the last
+       result computed for operands hashing to it, and a colliding entry
+       simply overwrites it. Results are cached after they are computed,
+       so there are no pending entries during the recursion.
+    */
+    bool bdd_manager::cache_lookup(BDD a, BDD b, BDD op, BDD& r) const {
+        op_entry const& e = m_op_cache[mk_mix(a, b, op) & (m_op_cache.size() - 1)];
+        if (e.m_result == null_bdd || e.m_bdd1 != a || e.m_bdd2 != b || e.m_op != op)
+            return false;
+        r = e.m_result;
+        SASSERT(!m_free_nodes.contains(r));
+        return true;
+    }
+
+    void bdd_manager::cache_insert(BDD a, BDD b, BDD op, BDD r) {
+        op_entry& e = m_op_cache[mk_mix(a, b, op) & (m_op_cache.size() - 1)];
+        e.m_bdd1 = a;
+        e.m_bdd2 = b;
+        e.m_op = op;
+        e.m_result = r;
+    }
+
+    /**
+       Grow the cache to the smallest power of two that is at least n,
+       bounded by m_max_op_cache_size. Valid entries are kept.
+    */
+    void bdd_manager::resize_op_cache(unsigned n) {
+        unsigned sz = std::max(1024u, m_op_cache.size());
+        while (sz < n && sz < m_max_op_cache_size)
+            sz *= 2;
+        if (sz == m_op_cache.size())
+            return;
+        svector<op_entry> old;
+        old.swap(m_op_cache);
+        m_op_cache.resize(sz, op_entry());
+        for (op_entry const& e : old)
+            if (e.m_result != null_bdd)
+                m_op_cache[e.hash() & (sz - 1)] = e;
+    }
+
+    void bdd_manager::reset_op_cache() {
+        for (op_entry& e : m_op_cache)
+            e.m_result = null_bdd;
     }
 
     bdd_manager::BDD bdd_manager::apply_rec(BDD a, BDD b, bdd_op op) {
@@ -150,14 +173,10 @@ namespace dd {
         if (is_const(a) && is_const(b)) {
             return m_apply_const[a + 2*b + 4*op];
         }
-        op_entry * e1 = pop_entry(a, b, op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, op)) {
-            SASSERT(!m_free_nodes.contains(e2->m_result));
-            return e2->m_result;
-        }
-        // SASSERT(well_formed());
         BDD r;
+        if (cache_lookup(a, b, op, r))
+            return r;
+        // SASSERT(well_formed());
         if (level(a) == level(b)) {
             push(apply_rec(lo(a), lo(b), op));
             push(apply_rec(hi(a), hi(b), op));
@@ -174,7 +193,7 @@ namespace dd {
             r = make_node(level(b), read(2), read(1));
         }
         pop(2);
-        e1->m_result = r;
+        cache_insert(a, b, op, r);
         // SASSERT(well_formed());
         SASSERT(!m_free_nodes.contains(r));
         return r;
@@ -192,28 +211,6 @@ namespace dd {
         return m_bdd_stack[m_bdd_stack.size() - index];
     }
 
-    bdd_manager::op_entry* bdd_manager::pop_entry(BDD l, BDD r, BDD op) {
-        op_entry* result = nullptr;
-        if (m_spare_entry) {
-            result = m_spare_entry;
-            m_spare_entry = nullptr;
-            result->m_bdd1 = l;
-            result->m_bdd2 = r;
-            result->m_op = op;
-        }
-        else {
-            void * mem = m_alloc.allocate(sizeof(op_entry));
-            result = new (mem) op_entry(l, r, op);
-        }
-        result->m_result = null_bdd;
-        return result;
-    }
-
-    void bdd_manager::push_entry(op_entry* e) {
-        SASSERT(!m_spare_entry);
-        m_spare_entry = e;
-    }
-
     bdd_manager::BDD bdd_manager::make_node(unsigned lvl, BDD l, BDD h) {
         m_is_new_node = false;
         if (l == h) {
@@ -263,15 +260,12 @@ namespace dd {
 
     void bdd_manager::try_reorder() {
         gc();        
-        for (auto* e : m_op_cache) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        m_op_cache.reset();
+        // sifting changes the meaning of node indices.
+        reset_op_cache();
         init_reorder();
         for (unsigned i = 0; i < m_var2level.size(); ++i) {
             sift_var(i);
         }
-        SASSERT(m_op_cache.empty());
         SASSERT(well_formed());
     }
 
@@ -560,15 +554,14 @@ namespace dd {
     bdd_manager::BDD bdd_manager::mk_not_rec(BDD b) {
         if (is_true(b)) return false_bdd;
         if (is_false(b)) return true_bdd;
-        op_entry* e1 = pop_entry(b, b, bdd_not_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, b, b, bdd_not_op)) 
-            return e2->m_result;
+        BDD r;
+        if (cache_lookup(b, b, bdd_not_op, r))
+            return r;
         push(mk_not_rec(lo(b)));
         push(mk_not_rec(hi(b)));
-        BDD r = make_node(level(b), read(2), read(1));
+        r = make_node(level(b), read(2), read(1));
         pop(2);
-        e1->m_result = r;
+        cache_insert(b, b, bdd_not_op, r);
         return r;
     }
     
@@ -596,12 +589,10 @@ namespace dd {
         if (is_false(b)) return apply(mk_not_rec(a), c, bdd_and_op);
         if (is_true(c)) return apply(mk_not_rec(a), b, bdd_or_op);
         SASSERT(!is_const(a) && !is_const(b) && !is_const(c));
-        op_entry * e1 = pop_entry(a, b, c);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, c)) 
-            return e2->m_result;
-        unsigned la = level(a), lb = level(b), lc = level(c);
         BDD r;
+        if (cache_lookup(a, b, c, r))
+            return r;
+        unsigned la = level(a), lb = level(b), lc = level(c);
         BDD a1, b1, c1, a2, b2, c2;
         unsigned lvl = la;
         if (la >= lb && la >= lc) {
@@ -629,7 +620,7 @@ namespace dd {
         push(mk_ite_rec(a2, b2, c2));
         r = make_node(lvl, read(2), read(1));
         pop(2);          
-        e1->m_result = r;
+        cache_insert(a, b, c, r);
         return r;
     }
 
@@ -665,18 +656,12 @@ namespace dd {
         else {
             BDD a = level2bdd(l);
             bdd_op q_op = op == bdd_and_op ? bdd_and_proj_op : bdd_or_proj_op;
-            op_entry * e1 = pop_entry(a, b, q_op);
-            op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-            if (check_result(e1, e2, a, b, q_op)) {
-                r = e2->m_result;
-            }
-            else {
-                SASSERT(e1->m_result == null_bdd);
+            if (!cache_lookup(a, b, q_op, r)) {
                 push(mk_quant_rec(l, lo(b), op));
                 push(mk_quant_rec(l, hi(b), op));
                 r = make_node(lvl, read(2), read(1));
                 pop(2);
-                e1->m_result = r;
+                cache_insert(a, b, q_op, r);
             }
         }
         SASSERT(r != UINT_MAX);
@@ -743,6 +728,7 @@ namespace dd {
             m_nodes.back().m_index = m_nodes.size() - 1;
         }
         m_free_nodes.reverse();
+        resize_op_cache(m_nodes.size());
     }
 
     void bdd_manager::gc() {
@@ -784,21 +770,14 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_bdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
-        m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
+        // retain cached results whose nodes all survive the collection.
+        reachable[false_bdd] = reachable[true_bdd] = true;
+        for (op_entry& e : m_op_cache) {
+            if (e.m_result == null_bdd)
+                continue;
+            if (!reachable[e.m_bdd1] || !reachable[e.m_bdd2] || !reachable[e.m_result] ||
+                (e.m_op >= bdd_no_op && !reachable[e.m_op]))
+                e.m_result = null_bdd;
         }
 
         m_node_table.reset();
@@ -840,10 +840,7 @@ lbool hilbert_basis::saturate_orig(num_vector const& ineq, bool is_eq) {
     for (; it != end(); ++it) {
         offset_t idx = *it;
         values v = vec(idx);
-        v.weight() = get_weight(v, ineq);
-        for (unsigned k = 0; k < m_current_ineq; ++k) {
-            v.weight(k) = get_weight(v, m_ineqs[k]);        
-        }
+        update_weights(v, ineq);
         add_goal(idx);
         if (m_use_support) {
             support.insert(idx.m_offset);
@@ -892,6 +889,20 @@ lbool hilbert_basis::saturate_orig(num_vector const& ineq, bool is_eq) {
     return m_basis.empty()?l_false:l_true;
 }
 
+/**
+   \brief prepare the weights of a basis vector for saturating ineq.
+   The weights of the inequalities before m_current_ineq - 1 are kept
+   up to date by resolve, so only the weight of the previous inequality
+   is moved into its slot and the weight of ineq is computed.
+*/
+void hilbert_basis::update_weights(values& v, num_vector const& ineq) {
+    if (m_current_ineq > 0) {
+        v.weight(m_current_ineq - 1) = v.weight();
+    }
+    v.weight() = get_weight(v, ineq);
+    SASSERT(m_current_ineq == 0 || v.weight(m_current_ineq - 1) == get_weight(v, m_ineqs[m_current_ineq - 1]));
+}
+
 bool hilbert_basis::vector_lt(offset_t idx1, offset_t idx2) const {
     values v = vec(idx1);
     values w = vec(idx2);
@@ -913,10 +924,7 @@ lbool hilbert_basis::saturate(num_vector const& ineq, bool is_eq) {
     for (unsigned i = 0; i < m_basis.size(); ++i) {
         offset_t idx = m_basis[i];
         values v = vec(idx);
-        v.weight() = get_weight(v, ineq);
-        for (unsigned k = 0; k < m_current_ineq; ++k) {
-            v.weight(k) = get_weight(v, m_ineqs[k]);        
-        }
+        update_weights(v, ineq);
         m_index->insert(idx, v);
         if (v.weight().is_zero()) {
             m_zero.push_back(idx);
@@ -185,15 +185,32 @@ branch y_i >= ceil(y0_i) is impossible.
 #endif                                                                                                            
                                     ) {
         init_matrix_A();
-        svector<unsigned> basis_rows;
         mpq big_number = m_abs_max.expt(3);
-        mpq d = hnf_calc::determinant_of_rectangular_matrix(m_A, basis_rows, big_number);
-        
-        if (d >= big_number) {
-            return lia_move::undef;
+        // The tight terms often stay the same between calls while only the
+        // right sides and the solution change. The determinant, the rank and
+        // the Hermite normal form depend only on the matrix.
+        if (m_A != m_cached_A) {
+            m_cached_basis_rows.reset();
+            m_cached_d = hnf_calc::determinant_of_rectangular_matrix(m_A, m_cached_basis_rows, big_number);
+            if (m_settings.get_cancel_flag()) {
+                m_cached_A = general_matrix();
+                return lia_move::undef;
+            }
+            m_cached_A = m_A;
+            if (m_cached_d < big_number) {
+                general_matrix A = m_A;
+                A.shrink_to_rank(m_cached_basis_rows);
+                hnf<general_matrix> h(A, m_cached_d);
+                m_cached_W = h.W();
+            }
+        }
+        else {
+            m_settings.stats().m_hnf_cache_hits++;
         }
+        svector<unsigned> const& basis_rows = m_cached_basis_rows;
+        mpq const& d = m_cached_d;
         
-        if (m_settings.get_cancel_flag()) {
+        if (d >= big_number) {
             return lia_move::undef;
         }
 
@@ -202,13 +219,12 @@ branch y_i >= ceil(y0_i) is impossible.
             shrink_explanation(basis_rows);
         }
         
-        hnf<general_matrix> h(m_A, d);        
         vector<mpq> b = create_b(basis_rows);
 #ifdef Z3DEBUG
         lp_assert(m_A * x0 == b);
 #endif
 
-        find_h_minus_1_b(h.W(), b);
+        find_h_minus_1_b(m_cached_W, b);
         int cut_row = find_cut_row_index(b);
 
         if (cut_row == -1) {
@@ -219,7 +235,7 @@ branch y_i >= ceil(y0_i) is impossible.
         // all integers in b's projection
         
         vector<mpq> row(m_A.column_count());
-        get_ei_H_minus_1(cut_row, h.W(), row);
+        get_ei_H_minus_1(cut_row, m_cached_W, row);
         vector<mpq> f = row * m_A;
         fill_term(f, t);
         k = floor(b[cut_row]);
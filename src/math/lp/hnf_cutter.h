@@ -39,6 +39,11 @@ class hnf_cutter {
     mpq                        m_abs_max;
     bool                       m_overflow;
     var_register               m_var_register;
+    // the Hermite normal form of the last matrix, reused while the matrix of tight terms is unchanged
+    general_matrix             m_cached_A;
+    mpq                        m_cached_d;
+    svector<unsigned>          m_cached_basis_rows;
+    general_matrix             m_cached_W;
 
 public:
 
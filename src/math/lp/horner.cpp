@@ -67,6 +67,35 @@ bool horner::row_is_interesting(const T& row) const {
     return false;
 }
 
+/**
+   \brief hash of the row coefficients and of the bounds of the variables
+   the cross-nested forms of the row are evaluated on.
+   If the row did not produce a lemma and its signature is unchanged the
+   interval evaluation would produce the same result, so the row is skipped.
+*/
+template <typename T>
+unsigned horner::row_signature(const T& row) const {
+    unsigned h = row.size();
+    auto add_var = [&](lpvar j) {
+        lp::constraint_index ci;
+        rational value;
+        bool is_strict;
+        h = hash_u_u(h, j);
+        if (c().has_lower_bound(j, ci, value, is_strict))
+            h = hash_u_u(h, hash_u_u(value.hash(), 2 * ci + is_strict));
+        if (c().has_upper_bound(j, ci, value, is_strict))
+            h = hash_u_u(h, hash_u_u(value.hash(), 2 * ci + is_strict));
+    };
+    for (const auto& p : row) {
+        h = hash_u_u(h, p.coeff().hash());
+        add_var(p.var());
+        if (c().is_monic_var(p.var()))
+            for (lpvar k : c().emons()[p.var()].vars())
+                add_var(k);
+    }
+    return h;
+}
+
 bool horner::lemmas_on_expr(cross_nested& cn, nex_sum* e) {
     TRACE("nla_horner", tout << "e = " << *e << "\n";);
     cn.run(e);
@@ -92,7 +121,7 @@ bool horner::lemmas_on_row(const T& row) {
         [this](unsigned j)   { return c().var_is_fixed(j); },
         [this]() { return c().random(); }, m_nex_creator);
     bool ret = lemmas_on_expr(cn, to_sum(e));
-    c().m_intervals.get_dep_intervals().reset(); // clean the memory allocated by the interval bound dependencies
+    c().reset_dep_intervals(); // clean the memory allocated by the interval bound dependencies
     return ret;
 
 }
@@ -122,10 +151,20 @@ bool horner::horner_lemmas() {
     bool conflict = false;
     for (unsigned i = 0; i < sz && !conflict; i++) {
         m_row_index = rows[(i + r) % sz];
-        if (lemmas_on_row(matrix.m_rows[m_row_index])) {
+        auto const& row = matrix.m_rows[m_row_index];
+        unsigned sig = row_signature(row), old_sig;
+        if (m_failed_rows.find(m_row_index, old_sig) && old_sig == sig) {
+            c().lp_settings().stats().m_horner_skipped_rows++;
+            continue;
+        }
+        if (lemmas_on_row(row)) {
             c().lp_settings().stats().m_horner_conflicts++;
+            m_failed_rows.erase(m_row_index);
             conflict = true;
         }
+        else {
+            m_failed_rows.insert(m_row_index, sig);
+        }
     }
     return conflict;
 }
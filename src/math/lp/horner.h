@@ -24,6 +24,7 @@
 #include "math/lp/nex.h"
 #include "math/lp/cross_nested.h"
 #include "math/lp/u_set.h"
+#include "util/map.h"
 
 namespace nla {
 class core;
@@ -32,6 +33,7 @@ class core;
 class horner : common {
     nex_creator::sum_factory  m_row_sum;
     unsigned         m_row_index;                      
+    u_map<unsigned>  m_failed_rows; // row index -> signature of the row when no lemma was found
 public:
     typedef intervals::interval interv;
     horner(core *core);
@@ -39,6 +41,7 @@ public:
     template <typename T> // T has an iterator of (coeff(), var())
     bool lemmas_on_row(const T&);
     template <typename T>  bool row_is_interesting(const T&) const;
+    template <typename T>  unsigned row_signature(const T&) const;
 
     
     intervals::interval interval_of_sum_with_deps(const nex_sum*);
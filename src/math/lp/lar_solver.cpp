@@ -1345,6 +1345,47 @@ namespace lp {
         ru.update();
     }
 
+    bool lar_solver::monoid_is_unlimited(row_cell<mpq> const& c, bool from_above) const {
+        switch (get_column_type(c.var())) {
+        case column_type::free_column:
+            return true;
+        case column_type::lower_bound:
+            return is_pos(c.coeff()) == from_above;
+        case column_type::upper_bound:
+            return is_neg(c.coeff()) == from_above;
+        default:
+            return false;
+        }
+    }
+
+    /**
+       \brief a row implies no bounds if two of its monoids are unlimited from above
+       and two are unlimited from below. The offsets of such monoids are kept
+       as watches, so a row that is touched again is dismissed without a scan
+       as long as the monoids at the watched offsets remain unlimited.
+       The watches are validated against the current row, so they stay sound
+       across pivoting and backtracking.
+    */
+    bool lar_solver::row_is_blocked_for_bound_propagation(unsigned i) {
+        auto const& row = A_r().m_rows[i];
+        m_row_watches.reserve(i + 1);
+        row_watch& w = m_row_watches[i];
+        auto is_watch = [&](unsigned k, bool from_above) {
+            return k < row.size() && monoid_is_unlimited(row[k], from_above);
+        };
+        if (is_watch(w.m_u[0], true) && is_watch(w.m_u[1], true) &&
+            is_watch(w.m_l[0], false) && is_watch(w.m_l[1], false))
+            return true;
+        unsigned nu = 0, nl = 0;
+        for (unsigned k = 0; k < row.size() && (nu < 2 || nl < 2); ++k) {
+            if (nu < 2 && monoid_is_unlimited(row[k], true))
+                w.m_u[nu++] = k;
+            if (nl < 2 && monoid_is_unlimited(row[k], false))
+                w.m_l[nl++] = k;
+        }
+        return nu == 2 && nl == 2;
+    }
+
     void lar_solver::mark_rows_for_bound_prop(lpvar j) {
         auto& column = A_r().m_columns[j];
         for (auto const& r : column) 
@@ -91,6 +91,10 @@ class lar_solver : public column_namer {
     u_set                                               m_columns_with_changed_bounds;
     u_set                                               m_rows_with_changed_bounds;
     unsigned_vector                                     m_row_bounds_to_replay;
+    // offsets of two monoids unlimited from above and two unlimited from below
+    // per row, see row_is_blocked_for_bound_propagation
+    struct row_watch { unsigned m_u[2] = { UINT_MAX, UINT_MAX }, m_l[2] = { UINT_MAX, UINT_MAX }; };
+    svector<row_watch>                                  m_row_watches;
     
     u_set                                               m_basic_columns_with_changed_cost;
     // these are basic columns with the value changed, so the the corresponding row in the tableau
@@ -179,6 +183,10 @@ class lar_solver : public column_namer {
             || row_has_a_big_num(row_index))
             return;
         lp_assert(use_tableau());
+        if (row_is_blocked_for_bound_propagation(row_index)) {
+            settings().stats().m_bp_blocked_rows++;
+            return;
+        }
         
         bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(A_r().m_rows[row_index],
                                                                                    null_ci,
@@ -188,6 +196,8 @@ class lar_solver : public column_namer {
                                                                                    );
     }
 
+    bool monoid_is_unlimited(row_cell<mpq> const& c, bool from_above) const;
+    bool row_is_blocked_for_bound_propagation(unsigned i);
     void substitute_basis_var_in_terms_for_row(unsigned i);
     template <typename T>
     void calculate_implied_bounds_for_row(unsigned i, lp_bound_propagator<T> & bp) {
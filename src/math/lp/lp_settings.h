@@ -120,13 +120,17 @@ struct statistics {
     unsigned m_patches_success;
     unsigned m_hnf_cutter_calls;
     unsigned m_hnf_cuts;
+    unsigned m_hnf_cache_hits;
     unsigned m_nla_calls;
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
+    unsigned m_horner_skipped_rows;
     unsigned m_cross_nested_forms;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
+    unsigned m_grobner_reused;
     unsigned m_offset_eqs;
+    unsigned m_bp_blocked_rows;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -142,12 +146,16 @@ struct statistics {
         st.update("arith-patches-success", m_patches_success);
         st.update("arith-hnf-calls", m_hnf_cutter_calls);
         st.update("arith-hnf-cuts", m_hnf_cuts);
+        st.update("arith-hnf-cache-hits", m_hnf_cache_hits);
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
+        st.update("arith-horner-skipped-rows", m_horner_skipped_rows);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
+        st.update("arith-grobner-reused", m_grobner_reused);
         st.update("arith-offset-eqs", m_offset_eqs);
+        st.update("arith-bound-prop-blocked-rows", m_bp_blocked_rows);
 
     }
 };
@@ -207,6 +207,8 @@ protected:
     // this routing also pins the variables to the boundaries
     bool row_is_obsolete(std::unordered_map<unsigned, T> & row, unsigned row_index );
 
+    bool row_is_singleton_bound(std::unordered_map<unsigned, T> & row, unsigned row_index, std::unordered_map<unsigned, unsigned> & column_occurrences);
+
     void remove_fixed_or_zero_columns();
 
     void remove_fixed_or_zero_columns_from_row(unsigned i, std::unordered_map<unsigned, T> & row);
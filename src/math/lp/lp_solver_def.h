@@ -376,11 +376,55 @@ template <typename T, typename X> void lp_solver<T, X>::remove_fixed_or_zero_col
     }
 }
 
+// A row with a single column j becomes a bound on j. An inequality is
+// kept when j occurs in no other row, since the columns outside of the rows
+// get no value from the core solver unless they are fixed.
+template <typename T, typename X> bool lp_solver<T, X>::row_is_singleton_bound(std::unordered_map<unsigned, T> & row, unsigned row_index, std::unordered_map<unsigned, unsigned> & column_occurrences) {
+    if (row.size() != 1)
+        return false;
+    unsigned j = row.begin()->first;
+    T a = row.begin()->second;
+    column_info<T> * ci = m_map_from_var_index_to_column_info[j];
+    if (is_zero(a) || ci->is_fixed())
+        return false;
+    auto & constraint = m_constraints[row_index];
+    bool lower = constraint.m_relation != lp_relation::Less_or_equal;
+    bool upper = constraint.m_relation != lp_relation::Greater_or_equal;
+    if (a < numeric_traits<T>::zero())
+        std::swap(lower, upper);
+    if (!(lower && upper) && column_occurrences[j] <= 1)
+        return false;
+    column_occurrences[j]--;
+    T bound = constraint.m_rs / a;
+    if (lower && (!ci->lower_bound_is_set() || bound > ci->get_lower_bound()))
+        ci->set_lower_bound(bound);
+    if (upper && (!ci->upper_bound_is_set() || bound < ci->get_upper_bound()))
+        ci->set_upper_bound(bound);
+    if (ci->lower_bound_is_set() && ci->upper_bound_is_set()) {
+        T diff = ci->get_lower_bound() - ci->get_upper_bound();
+        if (!val_is_smaller_than_eps(diff, m_settings.refactor_tolerance))
+            m_status = lp_status::INFEASIBLE;
+        else if (val_is_smaller_than_eps(-diff, m_settings.refactor_tolerance))
+            ci->set_fixed_value(ci->get_upper_bound());
+    }
+    return true;
+}
+
 template <typename T, typename X> unsigned lp_solver<T, X>::try_to_remove_some_rows() {
     vector<unsigned> rows_to_delete;
+    std::unordered_map<unsigned, unsigned> column_occurrences;
+    for (auto & t : m_A_values) 
+        for (auto & c : t.second)
+            column_occurrences[c.first]++;
     for (auto & t : m_A_values) {
         if (row_is_obsolete(t.second, t.first)) {
             rows_to_delete.push_back(t.first);
+            // the columns of a dropped row no longer occur in it.
+            for (auto & c : t.second)
+                column_occurrences[c.first]--;
+        }
+        else if (row_is_singleton_bound(t.second, t.first, column_occurrences)) {
+            rows_to_delete.push_back(t.first);
         }
 
         if (m_status == lp_status::INFEASIBLE) {
@@ -28,6 +28,7 @@ Revision History:
 #include <unordered_map>
 #include <ostream>
 #include <fstream>
+#include <iterator>
 #include <locale>
 #include "math/lp/lp_primal_simplex.h"
 #include "math/lp/lp_dual_simplex.h"
@@ -159,6 +160,9 @@ class mps_reader {
     std::string m_name;
     std::string m_cost_row_name;
     std::ifstream m_file_stream;
+    // the file is read into m_buffer at once, lines are cut from m_pos
+    std::string m_buffer;
+    size_t m_pos;
     // needed to adjust the index row
     unsigned m_cost_line_count;
     unsigned m_line_number;
@@ -212,9 +216,23 @@ class mps_reader {
         return true;
     }
 
+    bool next_line() {
+        if (m_pos >= m_buffer.size())
+            return false;
+        size_t end = m_buffer.find('\n', m_pos);
+        if (end == std::string::npos)
+            end = m_buffer.size();
+        size_t len = end - m_pos;
+        if (len > 0 && m_buffer[m_pos + len - 1] == '\r')
+            --len;
+        m_line.assign(m_buffer, m_pos, len);
+        m_pos = end + 1;
+        return true;
+    }
+
     void read_line() {
         while (m_is_OK) {
-            if (!getline(m_file_stream, m_line)) {
+            if (!next_line()) {
                 m_line_number++;
                 set_m_ok_to_false();
                 *m_message_stream << "cannot read from file" << std::endl;
@@ -762,7 +780,8 @@ public:
     mps_reader(const std::string & file_name):
         m_is_OK(true),
         m_file_name(file_name), 
-        m_file_stream(file_name),
+        m_file_stream(file_name, std::ios::binary),
+        m_pos(0),
         m_cost_line_count(0),
         m_line_number(0),
         m_message_stream(& std::cout) {}
@@ -771,6 +790,8 @@ public:
             set_m_ok_to_false();
             return;
         }
+        m_buffer.assign(std::istreambuf_iterator<char>(m_file_stream), std::istreambuf_iterator<char>());
+        m_file_stream.close();
 
         read_name();
         read_rows();
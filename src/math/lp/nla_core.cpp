@@ -33,6 +33,7 @@ core::core(lp::lar_solver& s, reslimit & lim) :
     m_horner(this),
     m_pdd_manager(s.number_of_vars()),
     m_pdd_grobner(lim, m_pdd_manager),
+    m_grobner_reusable(false),
     m_emons(m_evars),
     m_reslim(lim),
     m_use_nra_model(false),
@@ -149,6 +150,8 @@ void core::push() {
 void core::pop(unsigned n) {
     TRACE("nla_solver_verbose", tout << "n = " << n << "\n";);
     m_emons.pop(n);
+    // constraint indices recorded in the Grobner dependencies may be recycled
+    m_grobner_reusable = false;
     SASSERT(elists_are_consistent(false));
 }
 
@@ -1645,8 +1648,10 @@ void core::run_grobner() {
     find_nl_cluster();
 
     lp_settings().stats().m_grobner_calls++;
-    configure_grobner();
-    m_pdd_grobner.saturate();
+    if (configure_grobner())
+        m_pdd_grobner.saturate();
+    else
+        lp_settings().stats().m_grobner_reused++;
     bool conflict = false;
     unsigned n = m_pdd_grobner.number_of_conflicts_to_report();
     SASSERT(n > 0);
@@ -1659,6 +1664,7 @@ void core::run_grobner() {
     }
     TRACE("grobner", m_pdd_grobner.display(tout));
     if (conflict) {
+        m_grobner_reusable = false;
         IF_VERBOSE(2, verbose_stream() << "grobner conflict\n");
         return;
     }
@@ -1696,8 +1702,15 @@ void core::run_grobner() {
     
 }
 
-void core::configure_grobner() {
-    m_pdd_grobner.reset();
+/**
+   \brief collect the equations for the Grobner solver.
+   Return false if they coincide with the inputs of the previous run
+   and the saturated basis from that run can be reused as is.
+*/
+bool core::configure_grobner() {
+    vector<dd::pdd> polys;
+    ptr_vector<u_dependency> deps;
+    bool reset = false;
     try {
         set_level2var_for_grobner();
         TRACE("grobner",
@@ -1707,8 +1720,11 @@ void core::configure_grobner() {
                       tout << "j" << j << " ";
               tout << "\n");
         for (lpvar j : active_var_set()) {
-            if (m_lar_solver.is_base(j))
-                add_row_to_grobner(m_lar_solver.basic2row(j));
+            if (m_lar_solver.is_base(j)) {
+                u_dependency* dep = nullptr;
+                polys.push_back(row_to_pdd(m_lar_solver.basic2row(j), dep));
+                deps.push_back(dep);
+            }
                 
             if (is_monic_var(j) && var_is_fixed(j)) {
                 u_dependency* dep = nullptr;
@@ -1716,14 +1732,36 @@ void core::configure_grobner() {
                 for (lpvar k : emons()[j].vars()) 
                     r *= pdd_expr(rational::one(), k, dep);
                 r -= val_of_fixed_var_with_deps(j, dep);
-                add_eq_to_grobner(r, dep);
+                polys.push_back(r);
+                deps.push_back(dep);
             }
         }
+        if (same_grobner_inputs(polys, deps)) {
+            TRACE("grobner", tout << "reusing basis\n"; m_pdd_grobner.display(tout));
+            return false;
+        }
+        m_pdd_grobner.reset();
+        m_grobner_reusable = false;
+        reset = true;
+        for (unsigned i = 0; i < polys.size(); ++i) 
+            add_eq_to_grobner(polys[i], deps[i]);
     }
     catch (...) {
         IF_VERBOSE(2, verbose_stream() << "pdd throw\n");
-        return;
+        if (!reset)
+            m_pdd_grobner.reset();
+        m_grobner_reusable = false;
+        return true;
     }
+    m_grobner_polys.reset();
+    m_grobner_deps.reset();
+    for (unsigned i = 0; i < polys.size(); ++i) {
+        m_grobner_polys.push_back(polys[i]);
+        m_grobner_deps.push_back(unsigned_vector());
+        m_intervals.get_dep_intervals().linearize(deps[i], m_grobner_deps.back());
+        std::sort(m_grobner_deps.back().begin(), m_grobner_deps.back().end());
+    }
+    m_grobner_reusable = true;
     TRACE("grobner", m_pdd_grobner.display(tout));
     
 #if 0
@@ -1749,6 +1787,35 @@ void core::configure_grobner() {
     m_pdd_grobner.set(cfg);
     m_pdd_grobner.adjust_cfg();
     m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
+    return true;
+}
+
+/**
+   \brief release the memory of the interval bound dependencies.
+   The equations of the saturated Grobner basis refer to these dependencies,
+   so the basis cannot be reused afterwards.
+*/
+void core::reset_dep_intervals() {
+    m_intervals.get_dep_intervals().reset();
+    m_grobner_reusable = false;
+    m_grobner_polys.reset();
+    m_grobner_deps.reset();
+}
+
+bool core::same_grobner_inputs(vector<dd::pdd> const& polys, ptr_vector<u_dependency> const& deps) {
+    if (!m_grobner_reusable || polys.size() != m_grobner_polys.size())
+        return false;
+    unsigned_vector ds;
+    for (unsigned i = 0; i < polys.size(); ++i) {
+        if (polys[i] != m_grobner_polys[i])
+            return false;
+        ds.reset();
+        m_intervals.get_dep_intervals().linearize(deps[i], ds);
+        std::sort(ds.begin(), ds.end());
+        if (ds != m_grobner_deps[i])
+            return false;
+    }
+    return true;
 }
 
 std::ostream& core::diagnose_pdd_miss(std::ostream& out) {
@@ -1950,14 +2017,12 @@ void core::add_eq_to_grobner(dd::pdd& p, u_dependency* dep) {
 }
 
 
-void core::add_row_to_grobner(const vector<lp::row_cell<rational>> & row) {
-    u_dependency *dep = nullptr;
-    rational val;
+dd::pdd core::row_to_pdd(const vector<lp::row_cell<rational>> & row, u_dependency*& dep) {
     dd::pdd sum = m_pdd_manager.mk_val(rational(0));
     for (const auto &p : row) 
         sum += pdd_expr(p.coeff(), p.var(), dep);
     TRACE("grobner", print_row(row, tout) << " " << sum << "\n");
-    add_eq_to_grobner(sum, dep);
+    return sum;
 }
 
 
@@ -2050,7 +2115,13 @@ void core::set_level2var_for_grobner() {
     for (unsigned j = 0; j < n; j++)
         l2v[j] = sorted_vars[j];
 
-    m_pdd_manager.reset(l2v);
+    // keep the nodes of the previous run alive when the order did not change
+    if (l2v != m_pdd_manager.get_level2var()) {
+        m_pdd_grobner.reset();
+        m_grobner_polys.reset();
+        m_grobner_reusable = false;
+        m_pdd_manager.reset(l2v);
+    }
 
     TRACE("grobner",
           for (auto v : sorted_vars)
@@ -2108,6 +2179,7 @@ void core::collect_statistics(::statistics & st) {
     st.update("arith-nla-explanations", m_stats.m_nla_explanations);
     st.update("arith-nla-lemmas", m_stats.m_nla_lemmas);
     st.update("arith-nra-calls", m_stats.m_nra_calls);    
+    st.update("arith-nra-subpaving-conflicts", m_nra.num_subpaving_conflicts());
 }
 
 
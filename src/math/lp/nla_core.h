@@ -171,6 +171,11 @@ public:
     dd::pdd_manager          m_pdd_manager;
     dd::solver               m_pdd_grobner;
 private:
+    // inputs of the last saturated Grobner run, used to skip re-saturation
+    // when the equations handed to the solver did not change.
+    vector<dd::pdd>          m_grobner_polys;
+    vector<unsigned_vector>  m_grobner_deps;
+    bool                     m_grobner_reusable;
     emonics                  m_emons;
     svector<lpvar>           m_add_buffer;
     mutable lp::u_set        m_active_var_set;
@@ -466,14 +471,16 @@ public:
     void display_matrix_of_m_rows(std::ostream & out) const;
     void set_active_vars_weights(nex_creator&);
     unsigned get_var_weight(lpvar) const;
-    void add_row_to_grobner(const vector<lp::row_cell<rational>> & row);
+    dd::pdd row_to_pdd(const vector<lp::row_cell<rational>> & row, u_dependency*& dep);
     bool is_solved(dd::pdd const& p, unsigned& v, dd::pdd& r);
     void add_eq_to_grobner(dd::pdd& p, u_dependency* dep);
     bool check_pdd_eq(const dd::solver::equation*);
     const rational& val_of_fixed_var_with_deps(lpvar j, u_dependency*& dep);
     dd::pdd pdd_expr(const rational& c, lpvar j, u_dependency*&);
     void set_level2var_for_grobner();
-    void configure_grobner();
+    bool configure_grobner();
+    void reset_dep_intervals();
+    bool same_grobner_inputs(vector<dd::pdd> const& polys, ptr_vector<u_dependency> const& deps);
     bool influences_nl_var(lpvar) const;
     bool is_nl_var(lpvar) const;
     bool is_used_in_monic(lpvar) const;
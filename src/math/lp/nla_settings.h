@@ -36,6 +36,7 @@ namespace nla {
 
         // nra fields
         bool     run_nra = false;
+        bool     nra_subpaving = true;
     
         // expensive patching
         bool     expensive_patching = false;
@@ -8,6 +8,9 @@
 #include "nlsat/nlsat_solver.h"
 #include "math/polynomial/polynomial.h"
 #include "math/polynomial/algebraic_numbers.h"
+#include "math/subpaving/subpaving.h"
+#include "util/hwf.h"
+#include "util/f2n.h"
 #include "util/map.h"
 #include "math/lp/u_set.h"
 #include "math/lp/nla_core.h"
@@ -28,6 +31,7 @@ struct solver::imp {
     scoped_ptr<scoped_anum>   m_zero;
     mutable variable_map_type m_variable_values; // current model        
     nla::core&                m_nla_core;    
+    unsigned                  m_num_subpaving_conflicts = 0;
     imp(lp::lar_solver& s, reslimit& lim, params_ref const& p, nla::core& nla_core): 
         s(s), 
         m_limit(lim),
@@ -52,6 +56,8 @@ struct solver::imp {
     */
     lbool check() {        
         SASSERT(need_check());
+        if (m_nla_core.m_nla_settings.nra_subpaving && subpaving_check())
+            return l_false;
         m_zero = nullptr;
         m_nlsat = alloc(nlsat::solver, m_limit, m_params, false);
         m_zero = alloc(scoped_anum, am());
@@ -114,6 +120,124 @@ struct solver::imp {
         return r;
     }                
 
+    /**
+       \brief cheap pre-check before nlsat: interval branch and prune over doubles
+       with a small node budget. The constraints are the ones given to nlsat.
+       If every node of the paving is refuted, the linear constraints are
+       infeasible together with the monomial and term definitions, and the
+       conflict is explained by all linear constraints.
+    */
+    bool subpaving_check() {
+        unsynch_mpq_manager qm;
+        hwf_manager hm;
+        f2n<hwf_manager> fm(hm);
+        params_ref p;
+        p.set_uint("max_nodes", 64);
+        p.set_uint("max_depth", 16);
+        scoped_ptr<subpaving::context> ctx = subpaving::mk_hwf_context(m_limit, fm, qm, p);
+        u_map<subpaving::var> lp2sp;
+        auto var2sp = [&](lp::var_index v) {
+            subpaving::var r;
+            if (!lp2sp.find(v, r)) {
+                r = ctx->mk_var(is_int(v));
+                lp2sp.insert(v, r);
+            }
+            return r;
+        };
+        // assert c + sum as[i]*xs[i] is >= 0, <= 0, > 0, < 0 or = 0.
+        scoped_mpz_vector as(qm);
+        svector<subpaving::var> xs;
+        scoped_mpq zero(qm);
+        auto assert_sum = [&](rational const& c, lp::lconstraint_kind k) {
+            scoped_mpz _c(qm);
+            qm.set(_c, c.to_mpq().numerator());
+            subpaving::var y = ctx->mk_sum(_c, xs.size(), as.data(), xs.data());
+            auto add = [&](bool lower, bool open) {
+                subpaving::ineq* a = ctx->mk_ineq(y, zero, lower, open);
+                ctx->inc_ref(a);
+                ctx->add_clause(1, &a);
+                ctx->dec_ref(a);
+            };
+            switch (k) {
+            case lp::lconstraint_kind::LE: add(false, false); break;
+            case lp::lconstraint_kind::GE: add(true, false); break;
+            case lp::lconstraint_kind::LT: add(false, true); break;
+            case lp::lconstraint_kind::GT: add(true, true); break;
+            case lp::lconstraint_kind::EQ: add(false, false); add(true, false); break;
+            default: UNREACHABLE();
+            }
+        };
+        auto add_coeff = [&](rational const& a, lp::var_index v) {
+            if (a.is_zero())
+                return;
+            as.push_back(mpz());
+            qm.set(as.back(), a.to_mpq().numerator());
+            xs.push_back(var2sp(v));
+        };
+        try {
+            lp::u_set term_set;
+            for (lp::constraint_index ci : s.constraints().indices()) {
+                auto& c = s.constraints()[ci];
+                rational den = denominator(c.rhs());
+                for (auto kv : c.coeffs())
+                    den = lcm(den, denominator(kv.first));
+                as.reset();
+                xs.reset();
+                for (auto kv : c.coeffs()) {
+                    add_coeff(den * kv.first, kv.second);
+                    if (s.column_corresponds_to_term(kv.second) && !term_set.contains(kv.second)) {
+                        if (kv.second >= term_set.data_size())
+                            term_set.resize(kv.second + 1);
+                        term_set.insert(kv.second);
+                    }
+                }
+                if (!xs.empty())
+                    assert_sum(-den * c.rhs(), c.kind());
+            }
+            for (unsigned j : term_set) {
+                const lp::lar_term& t = s.get_term(lp::tv::raw(s.column_to_reported_index(j)));
+                rational den(1);
+                for (lp::lar_term::ival kv : t)
+                    den = lcm(den, denominator(kv.coeff()));
+                as.reset();
+                xs.reset();
+                for (lp::lar_term::ival kv : t)
+                    add_coeff(den * kv.coeff(), kv.column().index());
+                add_coeff(-den, j);
+                assert_sum(rational(0), lp::lconstraint_kind::EQ);
+            }
+            svector<subpaving::power> pws;
+            for (auto const& m : m_nla_core.emons()) {
+                pws.reset();
+                for (auto v : m.vars())
+                    pws.push_back(subpaving::power(var2sp(v), 1));
+                as.reset();
+                xs.reset();
+                as.push_back(mpz(1));
+                xs.push_back(ctx->mk_monomial(pws.size(), pws.data()));
+                add_coeff(rational(-1), m.var());
+                assert_sum(rational(0), lp::lconstraint_kind::EQ);
+            }
+            (*ctx)();
+        }
+        catch (subpaving::exception&) {
+            return false;
+        }
+        catch (f2n<hwf_manager>::exception&) {
+            return false;
+        }
+        if (!ctx->is_refuted())
+            return false;
+        TRACE("nra", tout << "refuted by subpaving\n"; ctx->display_constraints(tout););
+        ++m_num_subpaving_conflicts;
+        lp::explanation ex;
+        for (lp::constraint_index ci : s.constraints().indices())
+            ex.push_back(ci);
+        nla::new_lemma lemma(m_nla_core, __FUNCTION__);
+        lemma &= ex;
+        return true;
+    }
+
     void add_monic_eq(mon_eq const& m) {
         polynomial::manager& pm = m_nlsat->pm();
         svector<polynomial::var> vars;
@@ -285,4 +409,8 @@ void solver::updt_params(params_ref& p) {
     m_imp->updt_params(p);
 }
 
+unsigned solver::num_subpaving_conflicts() const {
+    return m_imp->m_num_subpaving_conflicts;
+}
+
 }
@@ -50,6 +50,11 @@ namespace nra {
 
         void updt_params(params_ref& p);
 
+        /*
+          \brief number of conflicts found by the subpaving pre-check
+        */
+        unsigned num_subpaving_conflicts() const;
+
         /*
           \brief display state
          */
@@ -54,6 +54,8 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
     remove_element(rowii, rowii[c.offset()]);
     scan_row_ii_to_offset_vector(rowii);
     unsigned prev_size_ii = rowii.size();
+    // only updated elements can become zero, new elements are non-zero
+    bool has_zero = false;
     // run over the pivot row and update row ii
     for (const auto & iv : m_rows[i]) {
         unsigned j = iv.var();
@@ -65,7 +67,9 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
             add_new_element(ii, j, alv);
         }
         else {
-            addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
+            T & coeff = rowii[j_offs].coeff();
+            addmul(coeff, iv.coeff(), alpha);
+            has_zero |= is_zero(coeff);
         }
     }
     // clean the work vector
@@ -74,9 +78,11 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
     }
 
     // remove zeroes
-    for (unsigned k = rowii.size(); k-- > 0;  ) {
-        if (is_zero(rowii[k].coeff()))
-            remove_element(rowii, rowii[k]);
+    if (has_zero) {
+        for (unsigned k = rowii.size(); k-- > 0;  ) {
+            if (is_zero(rowii[k].coeff()))
+                remove_element(rowii, rowii[k]);
+        }
     }
     return !rowii.empty();
 }
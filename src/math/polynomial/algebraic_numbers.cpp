@@ -1906,10 +1906,9 @@ namespace algebraic_numbers {
                   );
             if (V == 0)
                 return sign_zero;
-            if ((V < 0) == (sign_lower(cell_b) < 0))
-                return sign_neg;
-            else
-                return sign_pos;
+            ::sign r = (V < 0) == (sign_lower(cell_b) < 0) ? sign_neg : sign_pos;
+            separate_roots(a, b);
+            return r;
             
             // Here is an unexplored option for comparing numbers.
             //
@@ -1945,6 +1944,24 @@ namespace algebraic_numbers {
             //          (l1 - u2, u1 - l2) contains only one root of r(x)
         }
 
+        /**
+           \brief a and b are known to be distinct roots with overlapping intervals.
+           Refine both until the intervals are disjoint, so that comparing the same
+           numbers again is decided by the isolating intervals instead of
+           recomputing a Sturm-Tarski sequence. The number of refinements is bounded.
+        */
+        void separate_roots(numeral & a, numeral & b) {
+            for (unsigned i = 0; i < 64 && m_limit.inc(); ++i) {
+                algebraic_cell * cell_a = a.to_algebraic();
+                algebraic_cell * cell_b = b.to_algebraic();
+                if (bqm().le(upper(cell_a), lower(cell_b)) || bqm().ge(lower(cell_a), upper(cell_b)))
+                    return;
+                if (!refine(a) || !refine(b))
+                    return;
+                m_compare_refine++;
+            }
+        }
+
         ::sign compare(numeral & a, numeral & b) {
             TRACE("algebraic", tout << "comparing: "; display_interval(tout, a); tout << " "; display_interval(tout, b); tout << "\n";);
             if (a.is_basic()) {
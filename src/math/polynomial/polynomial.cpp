@@ -5464,6 +5464,7 @@ namespace polynomial {
             h = mk_one();
 
             while (true) {
+                checkpoint();
                 TRACE("resultant", tout << "A: " << A << "\nB: " << B << "\n";);
                 degA = degree(A, x);
                 degB = degree(B, x);
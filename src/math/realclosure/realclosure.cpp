@@ -3513,6 +3513,7 @@ namespace realclosure {
                 A.append(sz1, p1);
                 B.append(sz2, p2);
                 while (true) {
+                    checkpoint();
                     TRACE("rcf_gcd",
                           tout << "A: "; display_poly(tout, A.size(), A.data()); tout << "\n";
                           tout << "B: "; display_poly(tout, B.size(), B.data()); tout << "\n";);
@@ -3560,6 +3561,7 @@ namespace realclosure {
                 A.append(sz1, p1);
                 B.append(sz2, p2);
                 while (true) {
+                    checkpoint();
                     TRACE("rcf_gcd",
                           tout << "A: "; display_poly(tout, A.size(), A.data()); tout << "\n";
                           tout << "B: "; display_poly(tout, B.size(), B.data()); tout << "\n";);
@@ -3645,6 +3647,7 @@ namespace realclosure {
                   display_poly(tout, seq.size(sz-1), seq.coeffs(sz-1)); tout << "\n";);
             value_ref_buffer r(*this);
             while (true) {
+                checkpoint();
                 unsigned sz = seq.size();
                 if (m_use_prem) {
                     sprem(seq.size(sz-2), seq.coeffs(sz-2), seq.size(sz-1), seq.coeffs(sz-1), r);
@@ -4152,6 +4155,7 @@ namespace realclosure {
             polynomial const & d = v->den();
             unsigned _prec = prec;
             while (true) {
+                checkpoint();
                 VERIFY(refine_coeffs_interval(n, _prec)); // must return true because a transcendental never depends on an infinitesimal
                 VERIFY(refine_coeffs_interval(d, _prec)); // must return true because a transcendental never depends on an infinitesimal
                 refine_transcendental_interval(to_transcendental(v->ext()), _prec);
@@ -4175,6 +4179,7 @@ namespace realclosure {
             if (num_idx == 0 && den_idx == 0) {
                 unsigned _prec = prec;
                 while (true) {
+                    checkpoint();
                     refine_interval(numerator[num_idx],   _prec);
                     refine_interval(denominator[num_idx], _prec);
                     mpbqi const & num_i = interval(numerator[num_idx]);
@@ -4299,6 +4304,7 @@ namespace realclosure {
             SASSERT(is_denominator_one(v));
             unsigned _prec = prec;
             while (true) {
+                checkpoint();
                 if (!refine_coeffs_interval(n, _prec) ||
                     !refine_algebraic_interval(to_algebraic(v->ext()), _prec))
                     return false;
@@ -4433,6 +4439,7 @@ namespace realclosure {
             if (m < 0)
                 prec = static_cast<unsigned>(-m) + 1;
             while (contains_zero(v->interval())) {
+                checkpoint();
                 refine_transcendental_interval(v, prec);
                 prec++;
             }
@@ -4776,6 +4783,7 @@ namespace realclosure {
                 if (m < 0)
                     prec = static_cast<unsigned>(-m) + 1;
                 while (contains_zero(v->interval())) {
+                    checkpoint();
                     if (!refine_algebraic_interval(v, prec))
                         return expensive_determine_algebraic_sign(v);
                     prec++;
@@ -5348,6 +5356,7 @@ namespace realclosure {
             // until we have
             //    1 * h(alpha) = R(alpha)
             while (true) {
+                checkpoint();
                 // In every iteration of the loop we have
                 //   Q(alpha) * h(alpha) = R(alpha)
                 TRACE("inv_algebraic",
@@ -5697,16 +5706,35 @@ namespace realclosure {
                     return qm().lt(to_mpq(a), to_mpq(b)) ? -1 : 1;
             }
             else {
-                // FUTURE: try to refine interval before switching to sub+sign approach
+                int r = compare_intervals(a, b);
+                if (r != 0)
+                    return r;
+                value_ref diff(*this);
+                sub(a, b, diff);
+                return sign(diff);
+            }
+        }
+
+        /**
+           \brief Try to separate a and b by refining their intervals up to 1/2^m_ini_precision.
+           The values keep the refined intervals, so later comparisons involving a or b
+           start from the tightest approximation computed so far.
+           Return 0 if the intervals were not separated.
+        */
+        int compare_intervals(value * a, value * b) {
+            int m = std::max(magnitude(interval(a)), magnitude(interval(b)));
+            unsigned prec = m < 0 ? static_cast<unsigned>(-m) + 1 : 1;
+            while (true) {
                 if (bqim().before(interval(a), interval(b)))
                     return -1;
-                else if (bqim().before(interval(b), interval(a)))
+                if (bqim().before(interval(b), interval(a)))
                     return 1;
-                else {
-                    value_ref diff(*this);
-                    sub(a, b, diff);
-                    return sign(diff);
-                }
+                if (prec > m_ini_precision)
+                    return 0;
+                checkpoint();
+                if (!refine_interval(a, prec) || !refine_interval(b, prec))
+                    return 0;
+                prec++;
             }
         }
 
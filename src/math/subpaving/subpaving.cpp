@@ -53,6 +53,7 @@ namespace subpaving {
         void collect_param_descrs(param_descrs & r) override { m_ctx.collect_param_descrs(r); }
         void updt_params(params_ref const & p) override { m_ctx.updt_params(p); }
         void operator()() override { m_ctx(); }
+        bool is_refuted() const override { return m_ctx.is_refuted(); }
         void display_bounds(std::ostream & out) const override { m_ctx.display_bounds(out); }
     };
 
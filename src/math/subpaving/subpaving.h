@@ -107,6 +107,11 @@ public:
 
     virtual void operator()() = 0;
 
+    /**
+       \brief Return true if operator() refuted the constraints.
+    */
+    virtual bool is_refuted() const = 0;
+
     virtual void display_bounds(std::ostream & out) const = 0;
 };
 
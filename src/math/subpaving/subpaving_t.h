@@ -843,6 +843,12 @@ public:
     void collect_statistics(statistics & st) const;
 
     void operator()();
+
+    /**
+       \brief Return true if operator() showed that the constraints are infeasible,
+       that is, every leaf of the paving tree is inconsistent.
+    */
+    bool is_refuted() const;
 };
 
 };
@@ -22,6 +22,7 @@ Revision History:
 #include "ast/ast_util.h"
 #include "model/func_interp.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
 
 func_entry::func_entry(ast_manager & m, unsigned arity, expr * const * args, expr * result):
     m_args_are_values(true),
@@ -176,13 +177,60 @@ bool func_interp::is_constant() const {
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
 func_entry * func_interp::get_entry(expr * const * args) const {
-    for (func_entry* curr : m_entries) {
-        if (curr->eq_args(m(), m_arity, args))
-            return curr;
+    if (m_entries.size() < 16 || m_arity == 0) {
+        for (func_entry* curr : m_entries) {
+            if (curr->eq_args(m(), m_arity, args))
+                return curr;
+        }
+        return nullptr;
+    }
+    if (!m_entry_index_valid)
+        build_entry_index();
+    if (auto* e = m_entry_index.find_core(hash_args(args))) {
+        for (unsigned idx : e->get_data().m_value) {
+            func_entry * curr = m_entries[idx];
+            if (curr->eq_args(m(), m_arity, args))
+                return curr;
+        }
+    }
+    // are_equal coincides with pointer equality except for irrational algebraic numbers,
+    // whose representation is not canonical. Only then do we fall back to a scan.
+    for (unsigned i = 0; i < m_arity; ++i) {
+        if (is_app_of(args[i], arith_family_id, OP_IRRATIONAL_ALGEBRAIC_NUM)) {
+            for (func_entry* curr : m_entries) {
+                if (curr->eq_args(m(), m_arity, args))
+                    return curr;
+            }
+            return nullptr;
+        }
     }
     return nullptr;
 }
 
+unsigned func_interp::hash_args(expr * const * args) const {
+    unsigned h = m_arity;
+    for (unsigned i = 0; i < m_arity; ++i)
+        h = combine_hash(h, args[i]->get_id());
+    return h;
+}
+
+void func_interp::reset_entry_index() const {
+    m_entry_index.reset();
+    m_entry_index_valid = false;
+}
+
+void func_interp::build_entry_index() const {
+    m_entry_index.reset();
+    for (unsigned i = 0; i < m_entries.size(); ++i)
+        index_entry(i);
+    m_entry_index_valid = true;
+}
+
+void func_interp::index_entry(unsigned idx) const {
+    unsigned h = hash_args(m_entries[idx]->get_args());
+    m_entry_index.insert_if_not_there(h, unsigned_vector()).push_back(idx);
+}
+
 void func_interp::insert_entry(expr * const * args, expr * r) {
     reset_interp_cache();
     func_entry * entry = get_entry(args);
@@ -213,10 +261,13 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
     if (!new_entry->args_are_values())
         m_args_are_values = false;
     m_entries.push_back(new_entry);
+    if (m_entry_index_valid)
+        index_entry(m_entries.size() - 1);
 }
 
 void func_interp::del_entry(unsigned idx) {
     auto* e = m_entries[idx];
+    reset_entry_index();
     m_entries[idx] = m_entries.back();
     m_entries.pop_back();
     e->deallocate(m(), m_arity);
@@ -225,6 +276,10 @@ void func_interp::del_entry(unsigned idx) {
 bool func_interp::eval_else(expr * const * args, expr_ref & result) const {
     if (m_else == nullptr)
         return false;
+    if (is_ground(m_else)) {
+        result = m_else;
+        return true;
+    }
     var_subst s(m(), false);
     SASSERT(!s.std_order()); // (VAR 0) <- args[0], (VAR 1) <- args[1], ...
     result = s(m_else, m_arity, args);
@@ -276,6 +331,7 @@ void func_interp::compress() {
     }
     if (j < m_entries.size()) {
         reset_interp_cache();
+        reset_entry_index();
         m_entries.shrink(j);
     }
     // other compression, if else is a default branch.
@@ -302,6 +358,7 @@ void func_interp::compress() {
         }
         m_entries.reset();
         reset_interp_cache();
+        reset_entry_index();
         expr_ref new_else(m().mk_var(0, m_else->get_sort()), m());
         m().inc_ref(new_else);
         m().dec_ref(m_else);
@@ -31,6 +31,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/ast_translation.h"
+#include "util/map.h"
 
 class func_interp;
 
@@ -74,8 +75,18 @@ class func_interp {
 
     expr *                 m_array_interp; // <! interp with lambda abstraction
 
+    // Hash index over the arguments of m_entries. It is built on demand once the
+    // number of entries is large and maps the hash of an argument tuple to positions in m_entries.
+    mutable u_map<unsigned_vector> m_entry_index;
+    mutable bool           m_entry_index_valid = false;
+
     void reset_interp_cache();
 
+    unsigned hash_args(expr * const * args) const;
+    void reset_entry_index() const;
+    void build_entry_index() const;
+    void index_entry(unsigned idx) const;
+
     expr * get_interp_core() const;
 
     expr_ref get_array_interp_core(func_decl * f) const;
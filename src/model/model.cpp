@@ -591,6 +591,10 @@ void model::reset_eval_cache() {
     m_mev.reset();
 }
 
+void model::reset_eval_cache(func_decl * f) {
+    m_mev.invalidate(1, &f);
+}
+
 void model::add_rec_funs() {
     recfun::util u(m);
     func_decl_ref_vector recfuns = u.get_rec_funs();
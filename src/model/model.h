@@ -106,6 +106,11 @@ public:
     bool is_false(expr_ref_vector const& ts);
     bool are_equal(expr* s, expr* t);
     void reset_eval_cache();
+    /**
+       \brief Reset cached evaluations that depend on the interpretation of f.
+       Use after updating the interpretation of f.
+    */
+    void reset_eval_cache(func_decl * f);
     bool has_solver(); 
     void set_solver(expr_solver* solver);
     void add_rec_funs();
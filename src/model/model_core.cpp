@@ -129,6 +129,60 @@ void model_core::unregister_decl(func_decl * d) {
     }
 }
 
+/**
+   \brief Unregister a batch of declarations.
+   unregister_decl removes a declaration from m_decls in linear time,
+   so the declarations are removed here in a single pass instead.
+*/
+void model_core::unregister_decls(unsigned n, func_decl * const * ds) {
+    if (n <= 1) {
+        for (unsigned i = 0; i < n; ++i)
+            unregister_decl(ds[i]);
+        return;
+    }
+    obj_hashtable<func_decl> removed;
+    bool has_func = false;
+    for (unsigned i = 0; i < n; ++i) {
+        func_decl * d = ds[i];
+        if (removed.contains(d))
+            continue;
+        decl2expr::obj_map_entry * ec = m_interp.find_core(d);
+        if (ec) {
+            auto v = ec->get_data().m_value;
+            m_const_decls[v.first] = m_const_decls.back();
+            m_interp[m_const_decls.back()].first = v.first;
+            m_const_decls.pop_back();
+            m_interp.remove(d);
+            m.dec_ref(v.second);
+            removed.insert(d);
+            continue;
+        }
+        decl2finterp::obj_map_entry * ef = m_finterp.find_core(d);
+        if (ef) {
+            auto v = ef->get_data().m_value;
+            m_finterp.remove(d);
+            dealloc(v);
+            removed.insert(d);
+            has_func = true;
+        }
+    }
+    if (removed.empty())
+        return;
+    auto filter = [&](ptr_vector<func_decl> & decls) {
+        unsigned j = 0;
+        for (func_decl * d : decls) 
+            if (!removed.contains(d))
+                decls[j++] = d;
+        decls.shrink(j);
+    };
+    filter(m_decls);
+    if (has_func)
+        filter(m_func_decls);
+    // the declarations are released last, as they are keys of removed.
+    for (func_decl * d : removed)
+        m.dec_ref(d);
+}
+
 void model_core::add_lambda_defs() {
     unsigned sz = get_num_decls();
     for (unsigned i = sz; i-- > 0; ) {
@@ -70,6 +70,7 @@ public:
     void register_decl(func_decl * d, expr * v);
     void register_decl(func_decl * f, func_interp * fi);
     void unregister_decl(func_decl * d);
+    void unregister_decls(unsigned n, func_decl * const * ds);
     func_interp* update_func_interp(func_decl* f, func_interp* fi);
 
     void add_lambda_defs();
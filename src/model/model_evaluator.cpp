@@ -647,6 +647,83 @@ struct model_evaluator::imp : public rewriter_tpl<mev::evaluator_cfg> {
         m_cfg.reset();
         m_cfg.m_def_cache.reset();
     }
+
+    void invalidate(unsigned n, func_decl * const * decls) {
+        model_core & md = m_cfg.m_model;
+        array_util & ar = m_cfg.m_ar;
+        obj_hashtable<func_decl> dirty;
+        for (unsigned i = 0; i < n; ++i)
+            dirty.insert(decls[i]);
+        obj_map<expr, bool> memo;
+        ptr_buffer<expr> todo;
+        // e depends on a dirty declaration if one occurs in it, directly or as (_ as-array f)
+        auto depends = [&](expr * e) {
+            todo.push_back(e);
+            while (!todo.empty()) {
+                expr * t = todo.back();
+                if (memo.contains(t)) {
+                    todo.pop_back();
+                    continue;
+                }
+                unsigned sz = todo.size();
+                bool r = false;
+                if (is_app(t)) {
+                    func_decl * f = to_app(t)->get_decl(), * g = nullptr;
+                    r = dirty.contains(f) || (ar.is_as_array(f, g) && dirty.contains(g));
+                    for (unsigned i = 0; !r && i < to_app(t)->get_num_args(); ++i) {
+                        expr * arg = to_app(t)->get_arg(i);
+                        if (!memo.find(arg, r))
+                            todo.push_back(arg);
+                    }
+                }
+                else if (is_quantifier(t)) {
+                    expr * b = to_quantifier(t)->get_expr();
+                    if (!memo.find(b, r))
+                        todo.push_back(b);
+                }
+                if (r) {
+                    todo.shrink(sz - 1);
+                    memo.insert(t, true);
+                }
+                else if (todo.size() == sz) {
+                    todo.pop_back();
+                    memo.insert(t, false);
+                }
+            }
+            return memo[e];
+        };
+        auto interp_depends = [&](func_interp * fi) {
+            if (fi->get_else() && depends(fi->get_else()))
+                return true;
+            for (func_entry * fe : *fi) {
+                if (depends(fe->get_result()))
+                    return true;
+                for (unsigned i = 0; i < fi->get_arity(); ++i)
+                    if (depends(fe->get_arg(i)))
+                        return true;
+            }
+            return false;
+        };
+        // close the dirty set under interpretations that refer to dirty declarations
+        bool change = true;
+        while (change) {
+            change = false;
+            memo.reset();
+            for (unsigned i = 0; i < md.get_num_functions(); ++i) {
+                func_decl * f = md.get_function(i);
+                if (!dirty.contains(f) && interp_depends(md.get_func_interp(f))) 
+                    dirty.insert(f), change = true;
+            }
+            for (unsigned i = 0; i < md.get_num_constants(); ++i) {
+                func_decl * c = md.get_constant(i);
+                if (!dirty.contains(c) && depends(md.get_const_interp(c)))
+                    dirty.insert(c), change = true;
+            }
+        }
+        memo.reset();
+        filter_cache([&](expr * k) { return !depends(k); });
+        m_cfg.m_def_cache.reset();
+    }
 };
 
 model_evaluator::model_evaluator(model_core & md, params_ref const & p) {
@@ -699,6 +776,10 @@ void model_evaluator::reset(params_ref const & p) {
     updt_params(p);
 }
 
+void model_evaluator::invalidate(unsigned n, func_decl * const * decls) {
+    m_imp->invalidate(n, decls);
+}
+
 void model_evaluator::reset(model_core &model, params_ref const& p) {
     m_imp->~imp();
     new (m_imp) imp(model, p);
@@ -70,6 +70,13 @@ public:
     void reset(params_ref const & p = params_ref());
     void reset(model_core& model, params_ref const & p = params_ref());
 
+    /**
+       \brief Invalidate the cached evaluations that depend on the given
+       declarations, i.e., terms that contain them or that contain symbols whose
+       interpretation refers to them. Other cached evaluations are kept.
+    */
+    void invalidate(unsigned n, func_decl * const * decls);
+
     unsigned get_num_steps() const;
 };
 
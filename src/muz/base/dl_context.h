@@ -252,6 +252,7 @@ namespace datalog {
         bool dbg_fpr_nonempty_relation_signature() const;
         unsigned dl_profile_milliseconds_threshold() const;
         bool all_or_nothing_deltas() const;
+        bool incremental_saturation() const;
         bool compile_with_widening() const;
         bool unbound_compressor() const;
         void set_unbound_compressor(bool f);
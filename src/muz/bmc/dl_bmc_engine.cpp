@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 
+#include "util/scoped_ptr_vector.h"
 #include "ast/datatype_decl_plugin.h"
 #include "ast/dl_decl_plugin.h"
 #include "ast/ast_smt_pp.h"
@@ -24,6 +25,7 @@ Revision History:
 #include "ast/rewriter/bool_rewriter.h"
 #include "ast/rewriter/rewriter_def.h"
 #include "ast/scoped_proof.h"
+#include "ast/ast_translation.h"
 #include "smt/smt_solver.h"
 #include "tactic/fd_solver/fd_solver.h"
 #include "tactic/tactic.h"
@@ -35,6 +37,10 @@ Revision History:
 #include "muz/transforms/dl_transforms.h"
 #include "muz/transforms/dl_mk_rule_inliner.h"
 #include "muz/base/fp_params.hpp"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include "util/thread_pool.h"
+#endif
 
 
 namespace datalog {
@@ -1165,6 +1171,11 @@ namespace datalog {
         lbool check() {
             setup();
             unsigned max_depth = b.m_ctx.get_params().bmc_linear_unrolling_depth();
+#ifndef SINGLE_THREAD
+            unsigned num_threads = b.m_ctx.get_params().bmc_linear_threads();
+            if (num_threads > 1)
+                return check_parallel(max_depth, num_threads);
+#endif
             for (unsigned i = 0; i < max_depth; ++i) {
                 IF_VERBOSE(1, verbose_stream() << "level: " << i << "\n";);
                 b.checkpoint();
@@ -1183,16 +1194,103 @@ namespace datalog {
 
     private:
 
+#ifndef SINGLE_THREAD
+        /**
+           \brief check num_threads consecutive levels per round, each on its own
+           copy of the unrolling in its own thread. The copies are kept in sync
+           with the assertions of b.m_solver, so a round only translates the
+           levels it adds. The smallest satisfiable level of a round is the answer.
+        */
+        lbool check_parallel(unsigned max_depth, unsigned num_threads) {
+            // the copies keep the configuration from setup().
+            params_ref const& p = b.m_solver->get_params();
+            scoped_ptr_vector<ast_manager> pms;
+            sref_vector<solver> psolvers;
+            vector<expr_ref_vector> pqueries;
+            scoped_limits sl(m.limit());
+            for (unsigned i = 0; i < num_threads; ++i) {
+                ast_manager* pm = alloc(ast_manager, m, true);
+                pms.push_back(pm);
+                psolvers.push_back(b.m_solver->translate(*pm, p));
+                pqueries.push_back(expr_ref_vector(*pm));
+                sl.push_child(&pm->limit());
+            }
+            // translate copies the assertions that are already there.
+            unsigned num_synced = b.m_solver->get_num_assertions();
+            svector<lbool> results;
+            std::mutex mux;
+            for (unsigned level = 0; level < max_depth; level += num_threads) {
+                unsigned n = std::min(num_threads, max_depth - level);
+                IF_VERBOSE(1, verbose_stream() << "levels: " << level << " - " << (level + n - 1) << "\n";);
+                for (unsigned i = 0; i < n; ++i) {
+                    b.checkpoint();
+                    compile(level + i);
+                }
+                unsigned sz = b.m_solver->get_num_assertions();
+                for (unsigned i = 0; i < num_threads; ++i) {
+                    ast_translation tr(m, *pms[i]);
+                    for (unsigned j = num_synced; j < sz; ++j)
+                        psolvers[i]->assert_expr(tr(b.m_solver->get_assertion(j)));
+                    pqueries[i].reset();
+                    if (i < n)
+                        pqueries[i].push_back(tr(mk_level_predicate(b.m_query_pred, level + i).get()));
+                }
+                num_synced = sz;
+
+                results.reset();
+                results.resize(n, l_undef);
+                auto worker = [&](unsigned i) {
+                    lbool r = l_undef;
+                    try {
+                        r = psolvers[i]->check_sat(pqueries[i].size(), pqueries[i].data());
+                    }
+                    catch (z3_exception& ex) {
+                        IF_VERBOSE(1, verbose_stream() << "level: " << (level + i) << " " << ex.msg() << "\n";);
+                    }
+                    results[i] = r;
+                    if (r != l_true)
+                        return;
+                    // deeper levels are not needed once a shallower level is satisfiable.
+                    std::lock_guard<std::mutex> lock(mux);
+                    for (unsigned j = i + 1; j < n; ++j)
+                        pms[j]->limit().cancel();
+                };
+                thread_pool::run(n, worker);
+                b.checkpoint();
+
+                for (unsigned i = 0; i < n; ++i) {
+                    if (results[i] == l_false)
+                        continue;
+                    if (results[i] == l_undef)
+                        return l_undef;
+                    model_ref md;
+                    psolvers[i]->get_model(md);
+                    ast_translation tr(*pms[i], m);
+                    md = md->translate(tr);
+                    get_model(level + i, md);
+                    return l_true;
+                }
+                for (unsigned i = 0; i < n; ++i)
+                    pms[i]->limit().reset_cancel();
+            }
+            return l_undef;
+        }
+#endif
+
         void get_model(unsigned level) {
+            model_ref md;
+            b.m_solver->get_model(md);
+            get_model(level, md);
+        }
+
+        void get_model(unsigned level, model_ref& md) {
             if (!m.inc()) {
                 return;
             }
             rule_manager& rm = b.m_ctx.get_rule_manager();
             expr_ref level_query = mk_level_predicate(b.m_query_pred, level);
-            model_ref md;
             proof_ref pr(m);
             rule_unifier unifier(b.m_ctx);
-            b.m_solver->get_model(md);
             func_decl* pred = b.m_query_pred;
             SASSERT(m.is_true(md->get_const_interp(to_app(level_query)->get_decl())));
 
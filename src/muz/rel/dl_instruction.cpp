@@ -351,6 +351,15 @@ namespace datalog {
     }
 
 
+    /**
+       \brief A register is empty if it is not allocated or holds a relation that is known to be empty.
+       In semi-naive evaluation the delta registers are frequently empty, and joins with them can
+       be skipped without creating a result relation.
+    */
+    static bool is_empty_reg(execution_context & ctx, execution_context::reg_idx r) {
+        return !ctx.reg(r) || ctx.reg(r)->fast_empty();
+    }
+
     class instr_join : public instruction {
         typedef unsigned_vector column_vector;
         reg_idx m_rel1;
@@ -366,7 +375,7 @@ namespace datalog {
         bool perform(execution_context & ctx) override {
             log_verbose(ctx);            
             ++ctx.m_stats.m_join;
-            if (!ctx.reg(m_rel1) || !ctx.reg(m_rel2)) {
+            if (is_empty_reg(ctx, m_rel1) || is_empty_reg(ctx, m_rel2)) {
                 ctx.make_empty(m_res);
                 return true;
             }
@@ -824,7 +833,7 @@ namespace datalog {
         }
         bool perform(execution_context & ctx) override {
             log_verbose(ctx);            
-            if (!ctx.reg(m_rel1) || !ctx.reg(m_rel2)) {
+            if (is_empty_reg(ctx, m_rel1) || is_empty_reg(ctx, m_rel2)) {
                 ctx.make_empty(m_res);
                 return true;
             }
@@ -612,18 +612,23 @@ namespace datalog {
             }
             relation_manager& rm = rel->get_rmanager();
             func_decl * pred = t->get_decl();
+            unsigned rel_size_int = 0;
             if ( (m_context.saturation_was_run() && rm.try_get_relation(pred)) || rm.is_saturated(pred)) {
                 SASSERT(rm.try_get_relation(pred)); //if it is saturated, it should exist
-                unsigned rel_size_int = rel->get_relation(pred).get_size_estimate_rows();
-                if (rel_size_int != 0) {
-                    cost curr_size = static_cast<cost>(rel_size_int);
-                    for (expr* arg : *t) {
-                        if (!is_var(arg)) {
-                            curr_size /= get_domain_size(arg);
-                        }
+                rel_size_int = rel->get_relation(pred).get_size_estimate_rows();
+            }
+            else if (m_rs_aux_copy.get_predicate_rules(pred).empty()) {
+                // facts of extensional predicates are final before saturation.
+                rel->try_get_size(pred, rel_size_int);
+            }
+            if (rel_size_int != 0) {
+                cost curr_size = static_cast<cost>(rel_size_int);
+                for (expr* arg : *t) {
+                    if (!is_var(arg)) {
+                        curr_size /= get_domain_size(arg);
                     }
-                    return curr_size;
                 }
+                return curr_size;
             }
             cost res = 1;
             for (expr* arg : *t) {
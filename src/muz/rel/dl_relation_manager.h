@@ -148,6 +148,7 @@ namespace datalog {
 
         bool is_saturated(func_decl * pred) const { return m_saturated_rels.contains(pred); }
         void mark_saturated(func_decl * pred) { m_saturated_rels.insert(pred); }
+        void reset_saturated_mark(func_decl * pred) { m_saturated_rels.remove(pred); }
         void reset_saturated_marks() { 
             if(!m_saturated_rels.empty()) {
                 m_saturated_rels.reset();
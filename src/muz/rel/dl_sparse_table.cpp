@@ -591,6 +591,19 @@ namespace datalog {
         }
     }
 
+    void sparse_table::remove_offsets(svector<store_offset> & to_remove) {
+        if (to_remove.empty()) {
+            return;
+        }
+        //the largest offsets are at the end, so we can remove them one by one
+        while (!to_remove.empty()) {
+            store_offset removed_ofs = to_remove.back();
+            to_remove.pop_back();
+            m_data.remove_offset(removed_ofs);
+        }
+        reset_indexes();
+    }
+
     void sparse_table::remove_fact(const table_element*  f) {
         verbose_action  _va("remove_fact", 2);
         //first insert the fact so that we find it's original location and remove it
@@ -1037,6 +1050,74 @@ namespace datalog {
     }
 
 
+    class sparse_table_plugin::filter_equal_fn : public table_mutator_fn {
+        typedef sparse_table::store_offset store_offset;
+        const table_element m_value;
+        const unsigned m_col;
+    public:
+        filter_equal_fn(const table_element & value, unsigned col)
+            : m_value(value),
+            m_col(col) {}
+
+        void operator()(table_base & tb) override {
+            verbose_action  _va("filter_equal");
+            sparse_table & t = get(tb);
+            svector<store_offset> to_remove;
+            store_offset after_last = t.m_data.after_last_offset();
+            for (store_offset ofs = 0; ofs < after_last; ofs += t.m_fact_size) {
+                if (t.get_cell(ofs, m_col) != m_value) {
+                    to_remove.push_back(ofs);
+                }
+            }
+            t.remove_offsets(to_remove);
+        }
+    };
+
+    table_mutator_fn * sparse_table_plugin::mk_filter_equal_fn(const table_base & t, 
+            const table_element & value, unsigned col) {
+        if (t.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(filter_equal_fn, value, col);
+    }
+
+    class sparse_table_plugin::filter_identical_fn : public table_mutator_fn {
+        typedef sparse_table::store_offset store_offset;
+        const unsigned_vector m_identical_cols;
+    public:
+        filter_identical_fn(unsigned col_cnt, const unsigned * identical_cols)
+            : m_identical_cols(col_cnt, identical_cols) {
+            SASSERT(col_cnt >= 2);
+        }
+
+        void operator()(table_base & tb) override {
+            verbose_action  _va("filter_identical");
+            sparse_table & t = get(tb);
+            unsigned col_cnt = m_identical_cols.size();
+            svector<store_offset> to_remove;
+            store_offset after_last = t.m_data.after_last_offset();
+            for (store_offset ofs = 0; ofs < after_last; ofs += t.m_fact_size) {
+                table_element val = t.get_cell(ofs, m_identical_cols[0]);
+                for (unsigned i = 1; i < col_cnt; i++) {
+                    if (t.get_cell(ofs, m_identical_cols[i]) != val) {
+                        to_remove.push_back(ofs);
+                        break;
+                    }
+                }
+            }
+            t.remove_offsets(to_remove);
+        }
+    };
+
+    table_mutator_fn * sparse_table_plugin::mk_filter_identical_fn(const table_base & t, unsigned col_cnt, 
+            const unsigned * identical_cols) {
+        if (t.get_kind() != get_kind() || col_cnt < 2) {
+            return nullptr;
+        }
+        return alloc(filter_identical_fn, col_cnt, identical_cols);
+    }
+
+
     class sparse_table_plugin::rename_fn : public convenient_table_rename_fn {
         unsigned_vector m_out_of_cycle;
     public:
@@ -1234,13 +1315,7 @@ namespace datalog {
             }
 
 
-            //the largest offsets are at the end, so we can remove them one by one
-            while (!to_remove.empty()) {
-                store_offset removed_ofs = to_remove.back();
-                to_remove.pop_back();
-                tgt.m_data.remove_offset(removed_ofs);
-            }
-            tgt.reset_indexes();
+            tgt.remove_offsets(to_remove);
         }
 
     };
@@ -47,6 +47,8 @@ namespace datalog {
         class negation_filter_fn;
         class select_equal_and_project_fn;
         class negated_join_fn;
+        class filter_equal_fn;
+        class filter_identical_fn;
 
         typedef ptr_vector<sparse_table> sp_table_vector;
         typedef map<table_signature, sp_table_vector *, 
@@ -89,6 +91,10 @@ namespace datalog {
             const unsigned * permutation_cycle) override;
         table_transformer_fn * mk_select_equal_and_project_fn(const table_base & t,
             const table_element & value, unsigned col) override;
+        table_mutator_fn * mk_filter_equal_fn(const table_base & t, const table_element & value, 
+            unsigned col) override;
+        table_mutator_fn * mk_filter_identical_fn(const table_base & t, unsigned col_cnt, 
+            const unsigned * identical_cols) override;
         table_intersection_filter_fn * mk_filter_by_negation_fn(const table_base & t,
                 const table_base & negated_obj, unsigned joined_col_cnt,
                 const unsigned * t_cols, const unsigned * negated_cols) override;
@@ -308,6 +314,8 @@ namespace datalog {
         friend class sparse_table_plugin::project_fn;
         friend class sparse_table_plugin::negation_filter_fn;
         friend class sparse_table_plugin::select_equal_and_project_fn;
+        friend class sparse_table_plugin::filter_equal_fn;
+        friend class sparse_table_plugin::filter_identical_fn;
 
         class our_iterator_core;
         class key_indexer;
@@ -419,6 +427,12 @@ namespace datalog {
 
         void reset_indexes();
 
+        /**
+           \brief Remove the rows at offsets \c to_remove, which must be in increasing order.
+           The vector is emptied by the call.
+        */
+        void remove_offsets(svector<store_offset> & to_remove);
+
         static void copy_columns(const column_layout & src_layout, const column_layout & dest_layout, 
             unsigned start_index, unsigned after_last, const char * src, char * dest, 
             unsigned & dest_idx, unsigned & pre_projection_idx, const unsigned * & next_removed);
@@ -98,7 +98,8 @@ namespace datalog {
           m_answer(m), 
           m_last_result_relation(nullptr),
           m_ectx(ctx),
-          m_sw(0) {
+          m_sw(0),
+          m_saturated_rules(ctx.get_rule_manager()) {
 
         // register plugins for builtin tables
 
@@ -183,6 +184,8 @@ namespace datalog {
             VERIFY( termination_code.perform(m_ectx) || m_context.canceled());
 
             m_code.process_all_costs();
+            // the relation sizes of this run guide the join planner after a restart.
+            m_context.notify_saturation_was_run();
             sw.stop();
             m_sw += sw.get_seconds();
 
@@ -229,9 +232,60 @@ namespace datalog {
         return result;
     }
  
+    /**
+       \brief Drop the saturation marks of predicates whose relations may have changed
+       since the previous query. 
+
+       With datalog.incremental_saturation set and an unchanged rule set, only the
+       predicates that depend on a predicate that received new facts lose their mark,
+       so the compiler skips the strata that are still saturated. Otherwise all marks
+       are dropped and the fixpoint is recomputed from scratch.
+    */
+    void rel_context::reset_saturated_marks() {
+        relation_manager& rm = get_rmanager();
+        rule_set& rules = m_context.get_rules();
+        bool same_rules = m_context.incremental_saturation() && m_saturated_rules.size() == rules.get_num_rules();
+        for (unsigned i = 0; same_rules && i < rules.get_num_rules(); ++i) {
+            same_rules = m_saturated_rules.get(i) == rules.get_rule(i);
+        }
+        if (!same_rules) {
+            rm.reset_saturated_marks();
+            m_saturated_rules.reset();
+            for (rule* r : rules) {
+                m_saturated_rules.push_back(r);
+            }
+            m_modified_preds.reset();
+            return;
+        }
+        func_decl_set affected(m_modified_preds);
+        bool change = !affected.empty();
+        while (change) {
+            change = false;
+            for (rule* r : rules) {
+                func_decl* head = r->get_decl();
+                if (affected.contains(head)) {
+                    continue;
+                }
+                unsigned tsz = r->get_uninterpreted_tail_size();
+                for (unsigned k = 0; k < tsz; ++k) {
+                    if (affected.contains(r->get_tail(k)->get_decl())) {
+                        affected.insert(head);
+                        change = true;
+                        break;
+                    }
+                }
+            }
+        }
+        TRACE("dl", tout << "predicates affected by new facts: " << affected.size() << "\n";);
+        for (func_decl* p : affected) {
+            rm.reset_saturated_mark(p);
+        }
+        m_modified_preds.reset();
+    }
+ 
     lbool rel_context::query(unsigned num_rels, func_decl * const* rels) {
         setup_default_relation();
-        get_rmanager().reset_saturated_marks();
+        reset_saturated_marks();
         scoped_query _scoped_query(m_context);
         for (unsigned i = 0; i < num_rels; ++i) {
             m_context.set_output_predicate(rels[i]);
@@ -332,7 +386,7 @@ namespace datalog {
 
     lbool rel_context::query(expr* query) {
         setup_default_relation();
-        get_rmanager().reset_saturated_marks();
+        reset_saturated_marks();
         scoped_query _scoped_query(m_context);
         rule_manager& rm = m_context.get_rule_manager();
         func_decl_ref query_pred(m);
@@ -437,6 +491,10 @@ namespace datalog {
         func_decl_set::iterator it = depends_on_negation.begin(), end = depends_on_negation.end();
         for (; it != end; ++it) {
             func_decl* pred = *it;
+            if (get_rmanager().is_saturated(pred)) {
+                // not affected by new facts, see reset_saturated_marks.
+                continue;
+            }
             relation_base & rel = get_relation(pred);
             
             if (!rel.empty()) {
@@ -485,6 +543,7 @@ namespace datalog {
               tout << "\n";
               );
 
+        m_saturated_rules.reset();
         relation_manager & rmgr = get_rmanager();
         family_id target_kind = null_family_id;
         switch (relation_name_cnt) {
@@ -550,7 +609,8 @@ namespace datalog {
     }
  
     void rel_context::add_fact(func_decl* pred, relation_fact const& fact) {
-        get_rmanager().reset_saturated_marks();
+        get_rmanager().reset_saturated_mark(pred);
+        m_modified_preds.insert(pred);
         get_relation(pred).add_fact(fact);
         if (!m_context.print_aig().is_null()) {
             m_table_facts.push_back(std::make_pair(pred, fact));
@@ -558,7 +618,8 @@ namespace datalog {
     }
 
     void rel_context::add_fact(func_decl* pred, table_fact const& fact) {
-        get_rmanager().reset_saturated_marks();
+        get_rmanager().reset_saturated_mark(pred);
+        m_modified_preds.insert(pred);
         relation_base & rel0 = get_relation(pred);
         if (rel0.from_table()) {
             table_relation & rel = static_cast<table_relation &>(rel0);
@@ -41,10 +41,14 @@ namespace datalog {
         execution_context  m_ectx;
         instruction_block  m_code;
         double             m_sw;
+        func_decl_set      m_modified_preds;  // predicates that received facts since the last query
+        rule_ref_vector    m_saturated_rules; // rules the saturation marks were computed for
 
         class scoped_query;
 
         void reset_negated_tables();
+
+        void reset_saturated_marks();
         
         relation_plugin & get_ordinary_relation_plugin(symbol relation_name);
         
@@ -20,6 +20,7 @@ Revision History:
 
 #include "muz/rel/tbv.h"
 #include "util/hashtable.h"
+#include "util/bit_util.h"
 #include "ast/ast_util.h"
 
 
@@ -208,43 +209,57 @@ tbv& tbv_manager::set_or(tbv& dst,  tbv const& src) const {
     return dst;
 }
 bool tbv_manager::set_and(tbv& dst,  tbv const& src) const {
-    m.set_and(dst, src); 
-    return is_well_formed(dst);
+    return set_and(dst, dst, src);
 }
 
-bool tbv_manager::is_well_formed(tbv const& dst) const {
+// odd bits of w whose pair of bits is BIT_z.
+static inline unsigned z_bits(unsigned w) {
+    return ~(w | (w << 1)) & 0xAAAAAAAA;
+}
+
+/**
+   \brief dst := a & b in one pass over the words, also checking that
+   the result does not contain BIT_z. The loop has no early exit so that
+   it vectorizes.
+*/
+bool tbv_manager::set_and(tbv& dst, tbv const& a, tbv const& b) const {
     unsigned nw = m.num_words();
-    unsigned w;
+    if (nw == 0) return true;
+    unsigned z = 0;
     for (unsigned i = 0; i + 1 < nw; ++i) {
-        w = dst.get_word(i);
-        w = w | (w << 1) | 0x55555555;
-        if (w != 0xFFFFFFFF) return false;
+        unsigned w = a.m_data[i] & b.m_data[i];
+        dst.m_data[i] = w;
+        z |= z_bits(w);
     }
-    if (nw > 0) {        
-        w = m.last_word(dst);
-        w = w | (w << 1) | 0x55555555 | ~m.get_mask();
-        if (w != 0xFFFFFFFF) return false;
-    }
-    return true;
+    unsigned w = a.m_data[nw-1] & b.m_data[nw-1];
+    dst.m_data[nw-1] = w;
+    z |= z_bits(w) & m.get_mask();
+    return z == 0;
+}
+
+bool tbv_manager::is_well_formed(tbv const& dst) const {
+    unsigned nw = m.num_words();
+    if (nw == 0) return true;
+    unsigned z = 0;
+    for (unsigned i = 0; i + 1 < nw; ++i) 
+        z |= z_bits(dst.get_word(i));
+    z |= z_bits(m.last_word(dst)) & m.get_mask();
+    return z == 0;
 }
 
 void tbv_manager::complement(tbv const& src, ptr_vector<tbv>& result) {
     tbv* r;
-    unsigned n = num_tbits();
-    for (unsigned i = 0; i < n; ++i) {
-        switch (src.get(i)) {
-        case BIT_0:
-            r = allocate(src);
-            set(*r, i, BIT_1);
-            result.push_back(r);
-            break;
-        case BIT_1:
+    unsigned nw = m.num_words();
+    for (unsigned i = 0; i < nw; ++i) {
+        unsigned w = src.get_word(i);
+        // odd bits of the pairs that are BIT_0 or BIT_1.
+        unsigned fixed = (w ^ (w << 1)) & 0xAAAAAAAA;
+        if (i + 1 == nw) fixed &= m.get_mask();
+        for (; fixed; fixed &= fixed - 1) {
+            unsigned idx = (32*i + ntz_core(fixed)) / 2;
             r = allocate(src);
-            set(*r, i, BIT_0);
+            set(*r, idx, neg(src[idx]));
             result.push_back(r);
-            break;
-        default:
-            break;
         }
     }
 }
@@ -270,8 +285,7 @@ bool tbv_manager::contains(tbv const& a, unsigned_vector const& colsa,
 }
 
 bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& result) {
-    copy(result, a);
-    return set_and(result, b);
+    return set_and(result, a, b);
 }
 
 std::ostream& tbv_manager::display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const {
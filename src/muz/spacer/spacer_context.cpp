@@ -698,7 +698,8 @@ pred_transformer::pred_transformer(context& ctx, manager& pm, func_decl* head):
     m_reach_facts(), m_rf_init_sz(0),
     m_transition_clause(m), m_transition(m), m_init(m),
     m_extend_lit0(m), m_extend_lit(m),
-    m_all_init(false), m_has_quantified_frame(false)
+    m_all_init(false), m_has_quantified_frame(false),
+    m_mbp_cache_keys(m)
 {
     m_solver = alloc(prop_solver, m, ctx.mk_solver0(), ctx.mk_solver1(),
                      ctx.get_params(), head->get_name());
@@ -747,6 +748,9 @@ void pred_transformer::collect_statistics(statistics& st) const
 
     st.update("SPACER num ctp blocked", m_stats.m_num_ctp_blocked);
     st.update("SPACER num is_invariant", m_stats.m_num_is_invariant);
+    st.update("SPACER num batch propagations", m_stats.m_num_batch_propagations);
+    st.update("SPACER mbp cache hits", m_stats.m_num_mbp_cache_hits);
+    st.update("SPACER mbp cache misses", m_stats.m_num_mbp_cache_misses);
     st.update("SPACER num lemma jumped", m_stats.m_num_lemma_level_jump);
 
     // -- time in rule initialization
@@ -1322,7 +1326,44 @@ bool pred_transformer::is_qblocked (pob &n) {
 void pred_transformer::mbp(app_ref_vector &vars, expr_ref &fml, model &mdl,
                            bool reduce_all_selects, bool force) {
     scoped_watch _t_(m_mbp_watch);
+    unsigned flags = (reduce_all_selects ? 1 : 0) | (force ? 2 : 0);
+    auto same_vars = [&](app_ref_vector const &vs) {
+        if (vs.size() != vars.size()) return false;
+        for (unsigned i = 0, sz = vs.size(); i < sz; ++i)
+            if (vs.get(i) != vars.get(i)) return false;
+        return true;
+    };
+
+    unsigned_vector idxs;
+    if (m_mbp_cache.find(fml, idxs)) {
+        for (unsigned idx : idxs) {
+            mbp_cache_entry const &e = m_mbp_entries[idx];
+            // the projection implies (exists vars. fml), it is a valid
+            // projection for every model in which it is true
+            if (e.m_flags == flags && same_vars(e.m_vars) && mdl.is_true(e.m_result)) {
+                m_stats.m_num_mbp_cache_hits++;
+                fml = e.m_result;
+                vars.reset();
+                vars.append(e.m_rest);
+                return;
+            }
+        }
+    }
+    m_stats.m_num_mbp_cache_misses++;
+
+    if (m_mbp_entries.size() >= 1000) {
+        m_mbp_cache.reset();
+        m_mbp_entries.reset();
+        m_mbp_cache_keys.reset();
+    }
+    mbp_cache_entry e(m, vars, flags);
+    expr_ref key(fml);
     qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
+    e.m_result = fml;
+    e.m_rest.append(vars);
+    m_mbp_cache.insert_if_not_there(key, unsigned_vector()).push_back(m_mbp_entries.size());
+    m_mbp_entries.push_back(e);
+    m_mbp_cache_keys.push_back(key);
 }
 
 //
@@ -1519,6 +1560,48 @@ bool pred_transformer::is_invariant(unsigned level, lemma* lem,
     return r == l_false;
 }
 
+bool pred_transformer::is_invariant_batch(unsigned level, lemma_ref_vector &lemmas,
+                                          unsigned &solver_level)
+{
+    // if F_level & T & !(l_1 & ... & l_n)' is unsat, every l_i is inductive.
+    // a model only shows that the lemmas it falsifies cannot be pushed, so
+    // retry with the remaining ones.
+    while (lemmas.size() > 1) {
+        expr_ref_vector lits(m), cand(m), aux(m), conj(m);
+        for (lemma *lem : lemmas) lits.push_back(lem->get_expr());
+        cand.push_back(mk_not(m, mk_and(lits)));
+
+        prop_solver::scoped_level _sl(*m_solver, level);
+        prop_solver::scoped_subset_core _sc(*m_solver, true);
+        prop_solver::scoped_weakness _sw(*m_solver, 1, UINT_MAX);
+        model_ref mdl;
+        m_solver->set_core(nullptr);
+        m_solver->set_model(&mdl);
+
+        conj.push_back(m_extend_lit);
+        if (ctx.use_bg_invs()) get_pred_bg_invs(conj);
+
+        m_stats.m_num_is_invariant++;
+        lbool r = m_solver->check_assumptions(cand, aux, m_transition_clause,
+                                              conj.size(), conj.data(), 1);
+        if (r == l_false) {
+            solver_level = m_solver->uses_level();
+            SASSERT(level <= solver_level);
+            return true;
+        }
+        if (r != l_true || !mdl) return false;
+
+        unsigned j = 0;
+        for (unsigned i = 0, sz = lemmas.size(); i < sz; ++i) {
+            if (!mdl->is_false(lemmas.get(i)->get_expr()))
+                lemmas.set(j++, lemmas.get(i));
+        }
+        if (j == lemmas.size()) return false;
+        lemmas.shrink(j);
+    }
+    return false;
+}
+
 bool pred_transformer::check_inductive(unsigned level, expr_ref_vector& state,
                                        unsigned& uses_level, unsigned weakness)
 {
@@ -2082,6 +2165,27 @@ bool pred_transformer::frames::propagate_to_next_level (unsigned level)
     unsigned tgt_level = next_level (level);
     m_pt.ensure_level (tgt_level);
 
+    if (m_pt.get_context().use_propagate_batch()) {
+        lemma_ref_vector batch;
+        for (unsigned i = 0, sz = m_lemmas.size(); i < sz && m_lemmas [i]->level() <= level; ++i) {
+            lemma *lem = m_lemmas.get(i);
+            if (lem->level() == level && lem->is_ground() && !lem->is_blocked())
+                batch.push_back(lem);
+        }
+        unsigned solver_level;
+        if (m_pt.is_invariant_batch(tgt_level, batch, solver_level)) {
+            for (lemma *lem : batch) {
+                lem->set_level(solver_level);
+                lem->reset_ctp();
+                m_pt.add_lemma_core(lem);
+                ++m_pt.m_stats.m_num_propagations;
+                ++m_pt.m_stats.m_num_batch_propagations;
+            }
+            m_sorted = false;
+            sort();
+        }
+    }
+
     for (unsigned i = 0, sz = m_lemmas.size(); i < sz && m_lemmas [i]->level() <= level;) {
         if (m_lemmas [i]->level () < level) {++i; continue;}
 
@@ -2325,6 +2429,7 @@ void context::updt_params() {
     m_validate_lemmas = m_params.spacer_validate_lemmas();
     m_max_level = m_params.spacer_max_level ();
     m_use_propagate = m_params.spacer_propagate ();
+    m_use_propagate_batch = m_params.spacer_propagate_batch();
     m_reset_obligation_queue = m_params.spacer_reset_pob_queue();
     m_push_pob = m_params.spacer_push_pob();
     m_push_pob_max_depth = m_params.spacer_push_pob_max_depth();
@@ -210,6 +210,9 @@ class pred_transformer {
         unsigned m_num_invariants; // num of infty lemmas found
         unsigned m_num_ctp_blocked; // num of time ctp blocked lemma pushing
         unsigned m_num_is_invariant; // num of times lemmas are pushed
+        unsigned m_num_batch_propagations; // num of lemmas pushed by a batched query
+        unsigned m_num_mbp_cache_hits; // num of projections reused from the mbp cache
+        unsigned m_num_mbp_cache_misses;
         unsigned m_num_lemma_level_jump; // lemma learned at higher level than expected
         unsigned m_num_reach_queries;
 
@@ -409,6 +412,20 @@ class pred_transformer {
     stopwatch                    m_mbp_watch;
     bool                         m_has_quantified_frame; // True when a quantified lemma is in the frame
 
+    // cache of model based projections. A cached projection of a formula
+    // can be reused for any model that satisfies it.
+    struct mbp_cache_entry {
+        app_ref_vector m_vars;      // variables to eliminate
+        unsigned       m_flags;     // projection options
+        expr_ref       m_result;    // projected formula
+        app_ref_vector m_rest;      // variables that were not eliminated
+        mbp_cache_entry(ast_manager &m, app_ref_vector const &vars, unsigned flags) :
+            m_vars(vars), m_flags(flags), m_result(m), m_rest(m) {}
+    };
+    obj_map<expr, unsigned_vector> m_mbp_cache;
+    vector<mbp_cache_entry>      m_mbp_entries;
+    expr_ref_vector              m_mbp_cache_keys;
+
     void init_sig();
     app_ref mk_extend_lit();
     void ensure_level(unsigned level);
@@ -538,6 +555,11 @@ public:
                       unsigned& solver_level,
                       expr_ref_vector* core = nullptr);
 
+    /// Check whether all ground lemmas in \p lemmas are inductive at \p level
+    /// using one query. Lemmas that are falsified by a counterexample are removed.
+    bool is_invariant_batch(unsigned level, lemma_ref_vector &lemmas,
+                            unsigned &solver_level);
+
     bool is_invariant(unsigned level, expr* lem,
                       unsigned& solver_level, expr_ref_vector* core = nullptr) {
         // XXX only needed for legacy_frames to compile
@@ -963,6 +985,7 @@ class context {
     bool                 m_use_array_eq_gen;
     bool                 m_validate_lemmas;
     bool                 m_use_propagate;
+    bool                 m_use_propagate_batch;
     bool                 m_reset_obligation_queue;
     bool                 m_push_pob;
     bool                 m_use_lemma_as_pob;
@@ -1074,6 +1097,7 @@ public:
     bool use_lim_num_gen() const {return m_use_lim_num_gen;}
     bool simplify_pob() const {return m_simplify_pob;}
     bool use_ctp() const {return m_use_ctp;}
+    bool use_propagate_batch() const {return m_use_propagate_batch;}
     bool use_inc_clause() const {return m_use_inc_clause;}
     unsigned blast_term_ite_inflation() const {return m_blast_term_ite_inflation;}
     bool elim_aux() const {return m_elim_aux;}
@@ -1003,7 +1003,7 @@ namespace spacer {
         SASSERT(f->get_arity() == 0);
         model.unregister_decl(f);
         model.register_decl(f, model.get_manager().mk_true());
-        model.reset_eval_cache();
+        model.reset_eval_cache(f);
     }
 } // namespace spacer
 template class rewriter_tpl<spacer::adhoc_rewriter_cfg>;
@@ -76,16 +76,30 @@ namespace datalog {
         return res;
     }
 
+    /**
+       \brief Estimate the number of rows of \c lit that match a binding of \c bound_vars.
+       When the size of the relation is known, the rows are assumed to spread
+       uniformly over the values of the bound arguments.
+     */
     float mk_magic_sets::get_unbound_cost(app * lit, const var_idx_set & bound_vars) {
         func_decl * pred = lit->get_decl();
         float res = 1;
+        float bound_size = 1;
         unsigned n = lit->get_num_args();
         for (unsigned i = 0; i < n; i++) {
             const expr * arg = lit->get_arg(i);
+            float sz = static_cast<float>(m_context.get_sort_size_estimate(pred->get_domain(i)));
             if (is_var(arg) && !bound_vars.contains(to_var(arg)->get_idx())) {
-                res *= m_context.get_sort_size_estimate(pred->get_domain(i));
+                res *= sz;
+            }
+            else {
+                bound_size *= sz;
             }
-            //res-=1;
+        }
+        rel_context_base * rel = m_context.get_rel_context();
+        unsigned rel_size = 0;
+        if (rel && rel->try_get_size(pred, rel_size)) {
+            res = std::min(res, static_cast<float>(rel_size) / bound_size);
         }
         return res;
     }
@@ -144,6 +158,17 @@ namespace datalog {
         return res;
     }
     
+    bool mk_magic_sets::has_bound_adornment() const {
+        for (auto const& kv : m_adornments) {
+            for (a_flag f : kv.m_value) {
+                if (f == AD_BOUND) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     app * mk_magic_sets::create_magic_literal(app * l) {
         func_decl * l_pred = l->get_decl();
         SASSERT(m.is_bool(l_pred->get_range()));
@@ -365,6 +390,13 @@ namespace datalog {
             }
         }
 
+        if (!has_bound_adornment()) {
+            // no binding reaches an intentional predicate, so the magic predicates
+            // are all nullary and only add rules to the program.
+            TRACE("dl", tout << "magic sets: no bound arguments\n";);
+            return nullptr;
+        }
+
         app * adn_goal_head = adorn_literal(goal_head, empty_var_idx_set);
         app * mag_goal_head = create_magic_literal(adn_goal_head);
         SASSERT(mag_goal_head->is_ground());
@@ -116,6 +116,7 @@ namespace datalog {
         app * create_magic_literal(app * l);
         void create_magic_rules(app * head, unsigned tail_cnt, app * const * tail, bool const* negated, rule_set& result);
         app * adorn_literal(app * lit, const var_idx_set & bound_vars);
+        bool has_bound_adornment() const;
         void transform_rule(const adornment & head_adornment,  rule * r, rule_set& result);
         void create_transfer_rule(const adornment_desc & d, rule_set& result);
     public:
@@ -21,6 +21,7 @@ Revision History:
 #include "nlsat/nlsat_evaluator.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "util/ref_buffer.h"
+#include "util/map.h"
 
 namespace nlsat {
 
@@ -46,6 +47,19 @@ namespace nlsat {
         bool                    m_factor;
         bool                    m_signed_project;
 
+        // roots of polynomials isolated in add_cell_lits, reused while the
+        // values of the other variables of the polynomial are unchanged.
+        struct root_cache_entry {
+            polynomial_ref      m_p;
+            var_vector          m_vars;
+            scoped_anum_vector  m_values;
+            scoped_anum_vector  m_roots;
+            root_cache_entry(pmanager & pm, anum_manager & am):m_p(pm), m_values(am), m_roots(am) {}
+        };
+        u_map<root_cache_entry*> m_root_cache;
+        unsigned                m_root_cache_hits = 0;
+        unsigned                m_root_cache_misses = 0;
+
         struct todo_set {
             polynomial::cache  &    m_cache;
             polynomial_ref_vector   m_set;
@@ -155,6 +169,7 @@ namespace nlsat {
         }
         
         ~imp() {
+            reset_root_cache();
         }
 
         std::ostream& display(std::ostream & out, polynomial_ref const & p) const {
@@ -896,6 +911,55 @@ namespace nlsat {
                 We add literals
                     ! (y > root_i(p1)) or !(y < root_j(p2))
         */
+        void reset_root_cache() {
+            for (auto const & kv : m_root_cache)
+                dealloc(kv.m_value);
+            m_root_cache.reset();
+        }
+
+        /**
+           \brief Isolate the roots of p in its maximal variable y, where the other
+           variables of p are assigned in m_assignment.
+        */
+        void isolate_roots_cached(poly * p, var y, scoped_anum_vector & roots) {
+            roots.reset();
+            root_cache_entry * e = nullptr;
+            unsigned id = m_pm.id(p);
+            if (m_root_cache.find(id, e) && e->m_p.get() == p) {
+                bool same = true;
+                for (unsigned i = 0; same && i < e->m_vars.size(); ++i)
+                    same = m_assignment.is_assigned(e->m_vars[i]) && m_am.eq(m_assignment.value(e->m_vars[i]), e->m_values[i]);
+                if (same) {
+                    ++m_root_cache_hits;
+                    for (anum const & r : e->m_roots)
+                        roots.push_back(r);
+                    return;
+                }
+            }
+            ++m_root_cache_misses;
+            m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, y), roots);
+            if (!e || e->m_p.get() != p) {
+                if (m_root_cache.size() >= 4096)
+                    reset_root_cache();
+                e = alloc(root_cache_entry, m_pm, m_am);
+                e->m_p = p;
+                m_root_cache.insert(id, e);
+            }
+            e->m_vars.reset();
+            e->m_values.reset();
+            e->m_roots.reset();
+            var_vector xs;
+            m_pm.vars(p, xs);
+            for (var x : xs) {
+                if (x == y)
+                    continue;
+                e->m_vars.push_back(x);
+                e->m_values.push_back(m_assignment.value(x));
+            }
+            for (anum const & r : roots)
+                e->m_roots.push_back(r);
+        }
+
         void add_cell_lits(polynomial_ref_vector & ps, var y) {
             SASSERT(m_assignment.is_assigned(y));
             bool lower_inf = true;
@@ -916,10 +980,9 @@ namespace nlsat {
                 p = ps.get(k);
                 if (max_var(p) != y)
                     continue;
-                roots.reset();
                 // Variable y is assigned in m_assignment. We must temporarily unassign it.
                 // Otherwise, the isolate_roots procedure will assume p is a constant polynomial.
-                m_am.isolate_roots(p, undef_var_assignment(m_assignment, y), roots);
+                isolate_roots_cached(p, y, roots);
                 unsigned num_roots = roots.size();
                 for (unsigned i = 0; i < num_roots; i++) {
                     int s = m_am.compare(y_val, roots[i]);
@@ -1842,6 +1905,12 @@ namespace nlsat {
     void explain::reset() {
         m_imp->m_core1.reset();
         m_imp->m_core2.reset();
+        m_imp->reset_root_cache();
+    }
+
+    void explain::collect_statistics(statistics & st) const {
+        st.update("nlsat explain root cache hits", m_imp->m_root_cache_hits);
+        st.update("nlsat explain root cache misses", m_imp->m_root_cache_misses);
     }
 
     void explain::set_simplify_cores(bool f) {
@@ -2228,6 +2228,7 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            m_explain.collect_statistics(st);
         }
 
         void reset_statistics() {
@@ -2396,6 +2397,7 @@ namespace nlsat {
             // undo_until_size(0)
             undo_until_stage(null_var);
             m_cache.reset();               
+            m_explain.reset();
             DEBUG_CODE({
                 for (var x = 0; x < num_vars(); x++) {
                     SASSERT(m_watches[x].empty());
@@ -325,10 +325,15 @@ public:
             unsigned last_index = 0;
             unsigned index = 0;
             SASSERT(index < asms.size() || asms.empty());
-            IF_VERBOSE(10, verbose_stream() << "start hill climb " << index << " asms: " << asms.size() << "\n";);
+            // with mostly distinct weights, strata of equal weight are too small to be useful.
+            unsigned num_weights = 0;
+            for (unsigned i = 0; i < asms.size(); i = next_index(asms, i, false))
+                ++num_weights;
+            bool diverse = 2 * num_weights > asms.size();
+            IF_VERBOSE(10, verbose_stream() << "start hill climb " << index << " asms: " << asms.size() << " weights: " << num_weights << "\n";);
             while (index < asms.size() && is_sat == l_true) {
                 while (asms.size() > 20*(index - last_index) && index < asms.size()) {
-                    index = next_index(asms, index);
+                    index = next_index(asms, index, diverse);
                 }
                 last_index = index;
                 is_sat = check_sat(index, asms.data());
@@ -479,11 +484,19 @@ public:
             });
     }
 
-    unsigned next_index(expr_ref_vector const& asms, unsigned index) {
+    /**
+       \brief return the index of the first assumption of the next stratum in asms, 
+       which is sorted by decreasing weight. A stratum is formed by assumptions of equal weight,
+       or, if \c diverse is set, by assumptions whose weight is at least half of the weight 
+       of the first assumption in the stratum.
+    */
+    unsigned next_index(expr_ref_vector const& asms, unsigned index, bool diverse) {
         if (index < asms.size()) {
             rational w = get_weight(asms[index]);
+            if (diverse)
+                w /= rational(2);
             ++index;
-            for (; index < asms.size() && w == get_weight(asms[index]); ++index);
+            for (; index < asms.size() && w <= get_weight(asms[index]); ++index);
         }
         return index;
     }
@@ -25,6 +25,7 @@ Notes:
 #include "opt/maxsmt.h"
 #include "opt/maxcore.h"
 #include "opt/maxlex.h"
+#include "opt/maxsmt_portfolio.h"
 #include "opt/wmax.h"
 #include "opt/opt_params.hpp"
 #include "opt/opt_context.h"
@@ -167,6 +168,7 @@ namespace opt {
 
 
     void maxsmt_solver_base::trace_bounds(char const * solver) {
+        m_c.bounds_updated(m_index, m_lower, m_upper);
         IF_VERBOSE(1, 
                    rational l = m_c.adjust(m_index, m_lower);
                    rational u = m_c.adjust(m_index, m_upper);
@@ -187,7 +189,7 @@ namespace opt {
         TRACE("opt_verbose", s().display(tout << "maxsmt\n") << "\n";);
         if (optp.maxlex_enable() && is_maxlex(m_soft)) 
             m_msolver = mk_maxlex(m_c, m_index, m_soft);            
-        else if (m_soft.empty() || maxsat_engine == symbol("maxres") || maxsat_engine == symbol::null)             
+        else if (m_soft.empty() || maxsat_engine == symbol("maxres") || maxsat_engine == symbol("sat") || maxsat_engine == symbol::null)             
             m_msolver = mk_maxres(m_c, m_index, m_soft);            
         else if (maxsat_engine == symbol("maxres-bin"))             
             m_msolver = mk_maxres_binary(m_c, m_index, m_soft);
@@ -201,6 +203,8 @@ namespace opt {
             m_msolver = mk_wmax(m_c, m_soft, m_index);
         else if (maxsat_engine == symbol("sortmax")) 
             m_msolver = mk_sortmax(m_c, m_soft, m_index);
+        else if (maxsat_engine == symbol("portfolio")) 
+            m_msolver = mk_portfolio(m_c, m_index, m_soft);
         else {
             auto str = maxsat_engine.str();
             warning_msg("solver %s is not recognized, using default 'maxres'", str.c_str());
@@ -0,0 +1,299 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    maxsmt_portfolio.cpp
+
+Abstract:
+
+    Run several MaxSMT engines in parallel and use the first to finish.
+
+    Each configuration gets its own ast_manager, a copy of the hard
+    constraints in a fresh opt_solver and a copy of the soft constraints.
+    Models found by any configuration are costed against the original
+    soft constraints and shared as a global upper bound. The shared
+    upper bound is the cost cutoff of all configurations: once the lower
+    bound of a configuration reaches it, the best model found so far is
+    optimal and all configurations are cancelled. The first
+    configuration that finishes cancels the others. If the search is
+    interrupted, the best model of all configurations and the largest
+    lower bound of all configurations are reported.
+
+Notes:
+
+    Configurations: maxres, maxres with LNS, wmax and sortmax.
+
+--*/
+
+#include "ast/ast_translation.h"
+#include "ast/ast_pp.h"
+#include "util/scoped_ptr_vector.h"
+#include "opt/maxsmt_portfolio.h"
+#include "opt/maxcore.h"
+#include "opt/wmax.h"
+#include "opt/opt_context.h"
+#include "opt/opt_solver.h"
+
+#ifdef SINGLE_THREAD
+
+namespace opt {
+
+    maxsmt_solver_base* mk_portfolio(maxsat_context& c, unsigned id, vector<soft>& soft) {
+        return mk_maxres(c, id, soft);
+    }
+
+}
+
+#else
+
+#include <mutex>
+#include "util/thread_pool.h"
+
+namespace opt {
+
+    static char const* const g_portfolio_configs[] = { "maxres", "maxres-lns", "wmax", "sortmax" };
+
+    /**
+       \brief upper bound shared by all configurations.
+    */
+    struct portfolio_bound {
+        std::mutex          m_mux;
+        rational            m_upper;
+        bool                m_has_upper = false;
+        bool                m_cutoff = false;
+        ptr_vector<reslimit> m_limits;
+
+        // the caller holds m_mux.
+        void cancel_all() {
+            m_cutoff = true;
+            for (reslimit* r : m_limits)
+                r->cancel();
+        }
+    };
+
+    /**
+       \brief maxsat context of one configuration.
+    */
+    class portfolio_context : public maxsat_context {
+        ast_manager&                 m;
+        params_ref                   m_params;
+        ref<generic_model_converter> m_fm;
+        ref<opt_solver>              m_solver;
+        model_ref                    m_model;
+        symbol                       m_maxsat_engine;
+        vector<rational>             m_offsets;
+        portfolio_bound&             m_bound;
+        char const*                  m_name;
+        vector<soft>                 m_orig;
+        model_ref                    m_best;
+        rational                     m_best_cost;
+    public:
+        vector<soft>                 m_soft;
+
+        portfolio_context(ast_manager& m, params_ref const& p, portfolio_bound& b, char const* name):
+            m(m),
+            m_params(p),
+            m_fm(alloc(generic_model_converter, m, "portfolio")),
+            m_maxsat_engine(name),
+            m_bound(b),
+            m_name(name) {
+            m_solver = alloc(opt_solver, m, m_params, *m_fm);
+            m_solver->ensure_pb();
+        }
+
+        void init(ast_manager& src, expr_ref_vector const& fmls, model* mdl, vector<soft> const& softs) {
+            ast_translation tr(src, m);
+            for (expr* f : fmls)
+                m_solver->assert_expr(tr(f));
+            m_model = mdl->translate(tr);
+            for (soft const& s : softs) {
+                expr_ref e(tr(s.s.get()), m);
+                m_soft.push_back(soft(e, s.weight, false));
+                m_orig.push_back(soft(e, s.weight, false));
+            }
+        }
+
+        generic_model_converter& fm() override { return *m_fm.get(); }
+        bool sat_enabled() const override { return false; }
+        solver& get_solver() override { return *m_solver.get(); }
+        ast_manager& get_manager() const override { return m; }
+        params_ref& params() override { return m_params; }
+        void enable_sls(bool force) override { } // no op
+        symbol const& maxsat_engine() const override { return m_maxsat_engine; }
+        void get_base_model(model_ref& _m) override { _m = m_model; }
+        smt::context& smt_context() override { return m_solver->get_context(); }
+        unsigned num_objectives() override { return 1; }
+        bool verify_model(unsigned id, model* mdl, rational const& v) override { return true; }
+        void set_model(model_ref& _m) override { m_model = _m; }
+        rational adjust(unsigned id, rational const& r) override {
+            m_offsets.reserve(id+1);
+            return r + m_offsets[id];
+        }
+        void add_offset(unsigned id, rational const& r) override {
+            m_offsets.reserve(id+1);
+            m_offsets[id] += r;
+        }
+
+        void model_updated(model* mdl) override {
+            rational cost(0);
+            for (soft const& s : m_orig)
+                if (!mdl->is_true(s.s))
+                    cost += s.weight;
+            if (m_best && cost >= m_best_cost)
+                return;
+            m_best = mdl;
+            m_best_cost = cost;
+            std::lock_guard<std::mutex> lock(m_bound.m_mux);
+            if (m_bound.m_has_upper && cost >= m_bound.m_upper)
+                return;
+            m_bound.m_upper = cost;
+            m_bound.m_has_upper = true;
+            IF_VERBOSE(1, verbose_stream() << "(opt.portfolio " << m_name << " :upper " << cost << ")\n";);
+        }
+
+        /**
+           \brief prune against the shared upper bound.
+           If the lower bound of this configuration reaches the best cost
+           found by any configuration, the corresponding model is optimal.
+        */
+        void bounds_updated(unsigned id, rational const& lower, rational const& upper) override {
+            rational l = adjust(id, lower);
+            std::lock_guard<std::mutex> lock(m_bound.m_mux);
+            if (m_bound.m_cutoff || !m_bound.m_has_upper || l < m_bound.m_upper)
+                return;
+            IF_VERBOSE(1, verbose_stream() << "(opt.portfolio " << m_name << " :lower " << l << " :cutoff " << m_bound.m_upper << ")\n";);
+            m_bound.cancel_all();
+        }
+
+        model* best() const { return m_best.get(); }
+        rational const& best_cost() const { return m_best_cost; }
+    };
+
+    class portfolio : public maxsmt_solver_base {
+        statistics m_stats;
+    public:
+        portfolio(maxsat_context& c, unsigned index, vector<soft>& s):
+            maxsmt_solver_base(c, s, index) {}
+
+        lbool operator()() override {
+            unsigned num_configs = sizeof(g_portfolio_configs) / sizeof(g_portfolio_configs[0]);
+            if (m.has_trace_stream())
+                throw default_exception("trace streams have to be off in parallel mode");
+
+            expr_ref_vector fmls(m);
+            s().get_assertions(fmls);
+            portfolio_bound bound;
+            scoped_ptr_vector<ast_manager> pms;
+            scoped_ptr_vector<portfolio_context> pctxs;
+            scoped_ptr_vector<maxsmt_solver_base> psolvers;
+            svector<lbool> results(num_configs, l_undef);
+            scoped_limits sl(m.limit());
+            std::mutex mux;
+            unsigned winner = UINT_MAX;
+            m_lower.reset();
+            reset_upper();
+
+            for (unsigned i = 0; i < num_configs; ++i) {
+                char const* name = g_portfolio_configs[i];
+                ast_manager* pm = alloc(ast_manager, m, true);
+                pms.push_back(pm);
+                sl.push_child(&pm->limit());
+                bound.m_limits.push_back(&pm->limit());
+                params_ref p(m_params);
+                p.set_bool("enable_lns", i == 1);
+                pctxs.push_back(alloc(portfolio_context, *pm, p, bound, name));
+                portfolio_context& ctx = *pctxs.back();
+                ctx.init(m, fmls, m_model.get(), m_soft);
+                if (i == 2)
+                    psolvers.push_back(mk_wmax(ctx, ctx.m_soft, 0));
+                else if (i == 3)
+                    psolvers.push_back(mk_sortmax(ctx, ctx.m_soft, 0));
+                else
+                    psolvers.push_back(mk_maxres(ctx, 0, ctx.m_soft));
+                psolvers.back()->updt_params(ctx.params());
+            }
+
+            auto worker = [&](unsigned i) {
+                lbool r = l_undef;
+                try {
+                    r = (*psolvers[i])();
+                }
+                catch (z3_exception& ex) {
+                    IF_VERBOSE(1, verbose_stream() << "(opt.portfolio " << g_portfolio_configs[i] << " :exception " << ex.msg() << ")\n";);
+                }
+                results[i] = r;
+                if (r == l_undef)
+                    return;
+                std::lock_guard<std::mutex> lock(mux);
+                if (winner != UINT_MAX)
+                    return;
+                winner = i;
+                for (unsigned j = 0; j < num_configs; ++j)
+                    if (j != i)
+                        pms[j]->limit().cancel();
+            };
+
+            thread_pool::run(num_configs, worker);
+
+            // the threads are done, collect the final bounds and models.
+            // configurations that were cancelled are made usable again.
+            unsigned best = UINT_MAX;
+            for (unsigned i = 0; i < num_configs; ++i) {
+                portfolio_context& ctx = *pctxs[i];
+                pms[i]->limit().reset_cancel();
+                model_ref mdl;
+                svector<symbol> labels;
+                psolvers[i]->get_model(mdl, labels);
+                if (mdl)
+                    ctx.model_updated(mdl.get());
+                if (ctx.best() && (best == UINT_MAX || ctx.best_cost() < pctxs[best]->best_cost()))
+                    best = i;
+                rational lower = ctx.adjust(0, psolvers[i]->get_lower());
+                if (lower > m_lower)
+                    m_lower = lower;
+            }
+
+            if (winner != UINT_MAX) {
+                IF_VERBOSE(1, verbose_stream() << "(opt.portfolio :winner " << g_portfolio_configs[winner] << ")\n";);
+                psolvers[winner]->collect_statistics(m_stats);
+                pctxs[winner]->get_solver().collect_statistics(m_stats);
+                m_stats.update("maxsmt portfolio winner", winner);
+                if (results[winner] == l_false)
+                    return l_false;
+            }
+
+            if (best != UINT_MAX) {
+                portfolio_context& ctx = *pctxs[best];
+                model_ref mdl = ctx.best();
+                ctx.fm()(mdl);
+                ast_translation tr(*pms[best], m);
+                m_model = mdl->translate(tr);
+                m_upper = ctx.best_cost();
+                for (soft& s : m_soft)
+                    s.set_value(m_model->is_true(s.s));
+            }
+            if (m_lower > m_upper)
+                m_lower = m_upper;
+            trace_bounds("portfolio");
+
+            if (bound.m_cutoff)
+                m_stats.update("maxsmt portfolio cutoff", 1u);
+
+            if (winner != UINT_MAX && results[winner] == l_true)
+                return l_true;
+            return m_lower == m_upper ? l_true : l_undef;
+        }
+
+        void collect_statistics(statistics& st) const override {
+            st.copy(m_stats);
+        }
+    };
+
+    maxsmt_solver_base* mk_portfolio(maxsat_context& c, unsigned id, vector<soft>& soft) {
+        return alloc(portfolio, c, id, soft);
+    }
+
+}
+
+#endif
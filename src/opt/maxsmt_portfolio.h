@@ -0,0 +1,21 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    maxsmt_portfolio.h
+
+Abstract:
+
+    Run several MaxSMT engines in parallel and use the first to finish.
+
+--*/
+#pragma once
+
+#include "opt/maxsmt.h"
+
+namespace opt {
+
+    maxsmt_solver_base* mk_portfolio(maxsat_context& c, unsigned id, vector<soft>& soft);
+
+}
@@ -61,6 +61,7 @@ namespace opt {
         virtual void add_offset(unsigned id, rational const& o) = 0;
         virtual void set_model(model_ref& _m) = 0;
         virtual void model_updated(model* mdl) = 0;
+        virtual void bounds_updated(unsigned id, rational const& lower, rational const& upper) {} // notify about improved bounds.
     };
 
     /**
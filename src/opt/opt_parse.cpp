@@ -24,16 +24,37 @@ class opt_stream_buffer {
     std::istream & m_stream;
     int            m_val;
     unsigned       m_line;
+    // characters are taken from the stream buffer in blocks.
+    // Only characters that are available without blocking are taken,
+    // so pipes and terminals are read character by character.
+    char           m_buffer[1 << 16];
+    unsigned       m_pos = 0;
+    unsigned       m_size = 0;
+
+    int read() {
+        if (m_pos == m_size) {
+            std::streamsize avail = m_stream.rdbuf()->in_avail();
+            if (avail <= 0)
+                return m_stream.get();
+            if (avail > static_cast<std::streamsize>(sizeof(m_buffer)))
+                avail = sizeof(m_buffer);
+            m_size = static_cast<unsigned>(m_stream.rdbuf()->sgetn(m_buffer, avail));
+            m_pos = 0;
+            if (m_size == 0)
+                return m_stream.get();
+        }
+        return static_cast<unsigned char>(m_buffer[m_pos++]);
+    }
 public:    
     opt_stream_buffer(std::istream & s):
         m_stream(s),
         m_line(0) {
-        m_val = m_stream.get();
+        m_val = read();
     }
     int  operator *() const { return m_val;}
-    void operator ++() { m_val = m_stream.get(); }
+    void operator ++() { m_val = read(); }
     int ch() const { return m_val; }
-    void next() { m_val = m_stream.get(); }
+    void next() { m_val = read(); }
     bool eof() const { return ch() == EOF; }
     unsigned line() const { return m_line; }
     void skip_whitespace() {
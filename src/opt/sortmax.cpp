@@ -23,6 +23,8 @@ Notes:
 #include "smt/smt_theory.h"
 #include "smt/smt_context.h"
 #include "opt/opt_context.h"
+#include "opt/opt_params.hpp"
+#include "opt/totalizer.h"
 #include "util/sorting_network.h"
 #include "tactic/generic_model_converter.h"
 
@@ -47,6 +49,9 @@ namespace opt {
 
             lbool is_sat = l_true;
             m_filter = alloc(generic_model_converter, m, "sortmax");
+            opt_params p(m_params);
+            if (p.sortmax_totalizer())
+                return totalize();
             expr_ref_vector in(m);
             expr_ref tmp(m);
             ptr_vector<expr> out;
@@ -92,6 +97,62 @@ namespace opt {
                     TRACE("opt", model_smt2_pp(tout, m, *m_model.get(), 0););
                     m_upper = m_lower + rational(out.size() - first);
                     (*m_filter)(m_model);
+                    m_c.model_updated(m_model.get());
+                }
+            }
+            if (is_sat == l_false) {
+                is_sat = l_true;
+                m_lower = m_upper;
+            }
+            TRACE("opt", tout << "min cost: " << m_upper << "\n";);
+            return is_sat;
+        }
+
+        /**
+           \brief Bound the weight of falsified soft constraints using a totalizer
+           over the unary expansion of their negations. The totalizer is extended
+           on demand, so only outputs up to the initial upper bound are encoded.
+        */
+        lbool totalize() {
+            lbool is_sat = l_true;
+            expr_ref_vector in(m);
+            unsigned cost = 0;
+            for (auto const & [e, w, t] : m_soft) {
+                if (!w.is_unsigned()) {
+                    throw default_exception("sortmax can only handle unsigned weights. Use a different heuristic.");
+                }
+                expr_ref ne(m.mk_not(e), m);
+                for (unsigned n = w.get_unsigned(); n > 0; --n)
+                    in.push_back(ne);
+                if (t != l_true)
+                    cost += w.get_unsigned();
+            }
+            if (in.empty())
+                return l_true;
+            totalizer tot(in);
+            while (l_true == is_sat && cost > 0 && m_lower < m_upper) {
+                trace_bounds("sortmax");
+                expr* am = tot.at_least(cost);
+                for (expr* c : tot.clauses())
+                    s().assert_expr(c);
+                tot.clauses().reset();
+                for (auto const& [v, d] : tot.defs())
+                    m_filter->hide(to_app(v)->get_decl());
+                tot.defs().reset();
+                s().assert_expr(m.mk_not(am));
+                is_sat = s().check_sat(0, nullptr);
+                if (!m.inc()) {
+                    is_sat = l_undef;
+                }
+                if (is_sat == l_true) {
+                    s().get_model(m_model);
+                    update_assignment();
+                    cost = 0;
+                    for (soft const& sf : m_soft)
+                        if (!sf.is_true())
+                            cost += sf.weight.get_unsigned();
+                    m_upper = m_lower + rational(cost);
+                    (*m_filter)(m_model);
                 }
             }
             if (is_sat == l_false) {
@@ -25,8 +25,9 @@ namespace opt {
     
     void totalizer::ensure_bound(node* n, unsigned k) {
         auto& lits = n->m_literals;
-        if (k > lits.size())
-            return;
+        // sub-trees smaller than k are built completely, so that the
+        // first bound requested from the root need not be the smallest.
+        k = std::min(k, lits.size());
         auto* l = n->m_left;
         auto* r = n->m_right;
         if (l)
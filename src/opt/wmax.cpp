@@ -88,6 +88,9 @@ namespace opt {
                     if (wth().is_optimal()) {
                         m_upper = m_lower + wth().get_cost();
                         s().get_model(m_model);
+                        // report the improved solution while the search continues.
+                        if (m_model) 
+                            m_c.model_updated(m_model.get());
                     }
                     expr_ref fml = wth().mk_block();
                     //DEBUG_CODE(verify_cores(cores););
@@ -16,6 +16,7 @@ Author:
 Revision History:
 
 --*/
+#include <cstring>
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
 
@@ -50,6 +51,22 @@ namespace smt2 {
         m_spos++;
     }
 
+    /**
+       \brief skip characters in the buffer up to (not including) the next occurrence of ch.
+       The current character is not examined.
+       The skipped characters are accounted for in m_spos as if they were consumed by next().
+     */
+    void scanner::skip_buffer_until(char ch) {
+        if (m_interactive || m_cache_input)
+            return;
+        char const* begin = m_buffer + m_bpos;
+        char const* end = static_cast<char const*>(memchr(begin, ch, m_bend - m_bpos));
+        if (!end)
+            end = m_buffer + m_bend;
+        m_spos += static_cast<int>(end - begin);
+        m_bpos = static_cast<unsigned>(end - m_buffer);
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
@@ -62,6 +79,7 @@ namespace smt2 {
                 next();
                 return;
             }
+            skip_buffer_until('\n');
             next();
         }
     }
@@ -82,6 +82,10 @@ namespace qel {
         expr_ref_buffer  m_new_args;
         th_rewriter      m_rewriter;
         params_ref       m_params;
+        unsigned         m_max_rounds;
+        // m_occs[v] lists the conjuncts in which variable v occurs free.
+        vector<unsigned_vector> m_occs;
+        used_vars        m_used;
 
         bool is_sub_extract(unsigned idx, expr* t) {
             bool has_ground = false;            
@@ -614,40 +618,107 @@ namespace qel {
             }
         }
 
+        void get_free_vars(expr* e, unsigned_vector& vs) {
+            vs.reset();
+            if (is_ground(e))
+                return;
+            m_used(e);
+            for (unsigned v = 0; v < m_used.get_max_found_var_idx_plus_1(); ++v)
+                if (m_used.contains(v))
+                    vs.push_back(v);
+        }
+
+        void init_occs(expr_ref_vector const& conjs) {
+            unsigned_vector vs;
+            m_occs.reset();
+            for (unsigned i = 0; i < conjs.size(); ++i) {
+                get_free_vars(conjs.get(i), vs);
+                for (unsigned v : vs) {
+                    m_occs.reserve(v + 1);
+                    m_occs[v].push_back(i);
+                }
+            }
+        }
+
+        // conjuncts that were removed are replaced by true.
+        bool occurs_elsewhere(unsigned v, unsigned i, expr_ref_vector const& conjs) {
+            if (v >= m_occs.size())
+                return false;
+            for (unsigned j : m_occs[v])
+                if (j != i && !m.is_true(conjs.get(j)))
+                    return true;
+            return false;
+        }
+
         bool is_unconstrained(var* x, expr* t, unsigned i, expr_ref_vector const& conjs) {
             sort* s = x->get_sort();
             if (!m.is_fully_interp(s) || !s->get_num_elements().is_infinite()) return false;
-            bool occ = occurs_var(x->get_idx(), t);
-            for (unsigned j = 0; !occ && j < conjs.size(); ++j) {
-                occ = (i != j) && occurs_var(x->get_idx(), conjs[j]);
-            }
-            return !occ;
+            return !occurs_var(x->get_idx(), t) && !occurs_elsewhere(x->get_idx(), i, conjs);
         }
 
+        /**
+           \brief remove disequalities x != t where x occurs nowhere else.
+           Removing a disequality can make the other variables in it unconstrained,
+           so the conjuncts that share a variable with it are revisited.
+        */
         bool remove_unconstrained(expr_ref_vector& conjs) {
-            bool reduced = false, change = true;
+            bool reduced = false;
             expr *r = nullptr, *l = nullptr, *ne = nullptr;
-            while (change) {
-                change = false;
-                for (unsigned i = 0; i < conjs.size(); ++i) {
-                    if (m.is_not(conjs[i].get(), ne) && m.is_eq(ne, l, r)) {
-                        TRACE("qe_lite", tout << mk_pp(conjs[i].get(), m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
-                        if (is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                        else if (is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                    }
-                }
+            unsigned_vector todo, vs;
+            init_occs(conjs);
+            for (unsigned i = conjs.size(); i-- > 0; )
+                todo.push_back(i);
+            while (!todo.empty()) {
+                unsigned i = todo.back();
+                todo.pop_back();
+                if (!m.is_not(conjs.get(i), ne) || !m.is_eq(ne, l, r))
+                    continue;
+                TRACE("qe_lite", tout << mk_pp(conjs.get(i), m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
+                if (!(is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, i, conjs)) &&
+                    !(is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, i, conjs)))
+                    continue;
+                get_free_vars(conjs.get(i), vs);
+                conjs[i] = m.mk_true();
+                reduced = true;
+                for (unsigned v : vs)
+                    for (unsigned j : m_occs[v])
+                        if (j != i && !m.is_true(conjs.get(j)))
+                            todo.push_back(j);
             }
             return reduced;
         }
 
+        /**
+           \brief apply the substitution to the conjuncts that contain an
+           eliminated variable. The other conjuncts are kept as they are.
+        */
+        void apply_substitution(expr_ref_vector& conjs) {
+            expr_ref_vector result(m);
+            expr_ref new_c(m);
+            for (expr* c : conjs) {
+                if (is_ground(c)) {
+                    result.push_back(c);
+                    continue;
+                }
+                m_subst(c, new_c);
+                if (new_c == c) {
+                    result.push_back(c);
+                    continue;
+                }
+                m_rewriter(new_c);
+                if (m.is_false(new_c)) {
+                    conjs.reset();
+                    conjs.push_back(new_c);
+                    return;
+                }
+                flatten_and(new_c, result);
+            }
+            conjs.reset();
+            for (expr* c : result)
+                if (!m.is_true(c))
+                    conjs.push_back(c);
+        }
+
         bool reduce_var_set(expr_ref_vector& conjs) {
             unsigned def_count = 0;
             unsigned largest_vinx = 0;
@@ -662,13 +733,8 @@ namespace qel {
                 SASSERT(m_order.size() <= def_count); // some might be missing because of cycles
 
                 if (!m_order.empty()) {
-                    expr_ref r(m), new_r(m);
-                    r = m.mk_and(conjs.size(), conjs.data());
                     create_substitution(largest_vinx + 1);
-                    new_r = m_subst(r, m_subst_map.size(), m_subst_map.data());
-                    m_rewriter(new_r);
-                    conjs.reset();
-                    flatten_and(new_r, conjs);
+                    apply_substitution(conjs);
                     reduced = true;
                 }
             }
@@ -697,6 +763,7 @@ namespace qel {
             m_new_args(m),
             m_rewriter(m),
             m_params(p) {
+            m_max_rounds = p.get_uint("max_der_rounds", UINT_MAX);
         }
 
         void set_is_variable_proc(is_variable_proc& proc) { 
@@ -735,7 +802,8 @@ namespace qel {
         }
 
         void operator()(expr_ref_vector& r) {
-            while (reduce_var_set(r)) ;
+            for (unsigned rounds = 0; rounds < m_max_rounds && reduce_var_set(r); ++rounds)
+                checkpoint();
             m_new_exprs.reset();
         }
 
@@ -2471,7 +2539,7 @@ public:
     }
 
     void collect_param_descrs(param_descrs & r) override {
-        // m_imp->collect_param_descrs(r);
+        r.insert("max_der_rounds", CPK_UINT, "maximal number of destructive equality resolution rounds over a conjunction", "4294967295");
     }
 
     void operator()(goal_ref const & g,
@@ -0,0 +1,250 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    mbp_bv.cpp
+
+Abstract:
+
+    Model based projection for bit-vectors using invertibility conditions.
+
+    A variable x is eliminated by picking a term t that does not contain x
+    and substituting x by t in all literals. The term is taken from:
+
+    - an equality s[x] = r where x occurs once in s below invertible
+      operators (bvadd, bvxor, bvnot, bvneg, multiplication by an odd
+      constant, concat). s is inverted along the path to x, and the
+      invertibility conditions (the concat slices that do not contain x)
+      are added as literals.
+
+    - unsigned bounds, when every literal containing x is a bound on x.
+      x is replaced by the lower bound with the largest value in the
+      model, or by 0 if there are only upper bounds.
+
+    In both cases the result is true in the model and implies the
+    existential closure over x, so no case split over the values
+    of x is needed.
+
+--*/
+
+#include "ast/ast_pp.h"
+#include "ast/occurs.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "ast/rewriter/expr_safe_replace.h"
+#include "model/model_evaluator.h"
+#include "qe/mbp/mbp_bv.h"
+
+namespace mbp {
+
+    struct bv_project_plugin::imp {
+        ast_manager& m;
+        bv_util      bv;
+        th_rewriter  m_rw;
+
+        imp(ast_manager& m): m(m), bv(m), m_rw(m) {}
+
+        /**
+           \brief invert s = r with respect to x.
+           Return the term for x and add the invertibility conditions to side.
+        */
+        bool invert(app* x, expr* s, expr_ref& r, expr_ref_vector& side) {
+            while (s != x) {
+                if (!is_app(s))
+                    return false;
+                app* a = to_app(s);
+                expr* t = nullptr;
+                unsigned idx = 0;
+                for (unsigned i = 0; i < a->get_num_args(); ++i) {
+                    if (occurs(x, a->get_arg(i))) {
+                        if (t)
+                            return false;
+                        t = a->get_arg(i);
+                        idx = i;
+                    }
+                }
+                if (!t)
+                    return false;
+                expr_ref_vector others(m);
+                for (unsigned i = 0; i < a->get_num_args(); ++i)
+                    if (i != idx)
+                        others.push_back(a->get_arg(i));
+                rational c;
+                if (bv.is_bv_add(s)) {
+                    for (expr* o : others)
+                        r = bv.mk_bv_sub(r, o);
+                }
+                else if (bv.is_bv_xor(s)) {
+                    for (expr* o : others)
+                        r = bv.mk_bv_xor(r, o);
+                }
+                else if (bv.is_bv_not(s)) {
+                    r = bv.mk_bv_not(r);
+                }
+                else if (bv.is_bv_neg(s)) {
+                    r = bv.mk_bv_neg(r);
+                }
+                else if (bv.is_bv_mul(s) && others.size() == 1 && bv.is_numeral(others.get(0), c) && c.is_odd()) {
+                    unsigned sz = bv.get_bv_size(s);
+                    VERIFY(c.mult_inverse(sz, c));
+                    r = bv.mk_bv_mul(bv.mk_numeral(c, sz), r);
+                }
+                else if (bv.is_concat(s)) {
+                    // arguments are ordered from the most significant slice.
+                    unsigned hi = bv.get_bv_size(s);
+                    unsigned lo_t = 0, hi_t = 0;
+                    for (unsigned i = 0; i < a->get_num_args(); ++i) {
+                        expr* arg = a->get_arg(i);
+                        unsigned lo = hi - bv.get_bv_size(arg);
+                        if (i == idx) {
+                            lo_t = lo;
+                            hi_t = hi;
+                        }
+                        else
+                            side.push_back(m.mk_eq(bv.mk_extract(hi - 1, lo, r), arg));
+                        hi = lo;
+                    }
+                    r = bv.mk_extract(hi_t - 1, lo_t, r);
+                }
+                else
+                    return false;
+                s = t;
+            }
+            return true;
+        }
+
+        bool solve_eq(app* x, expr_ref_vector const& lits, unsigned& eq_idx, expr_ref& t, expr_ref_vector& side) {
+            expr* l = nullptr, *r = nullptr;
+            for (unsigned i = 0; i < lits.size(); ++i) {
+                if (!m.is_eq(lits.get(i), l, r) || !bv.is_bv(l))
+                    continue;
+                if (occurs(x, r))
+                    std::swap(l, r);
+                if (occurs(x, r) || !occurs(x, l))
+                    continue;
+                t = r;
+                side.reset();
+                if (invert(x, l, t, side)) {
+                    eq_idx = i;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+           \brief classify lit as a bound on x.
+           lower is set to true for t <= x and t < x. strict is set for t < x and x < t.
+        */
+        bool is_bound(app* x, expr* lit, expr*& t, bool& lower, bool& strict) {
+            expr* a = nullptr, *b = nullptr;
+            bool is_neg = m.is_not(lit, lit);
+            if (!bv.is_bv_ule(lit, a, b))
+                return false;
+            strict = is_neg;
+            if (is_neg)
+                std::swap(a, b);
+            // !is_neg: a <= b, is_neg: a < b.
+            if (a == x && !occurs(x, b)) {
+                t = b;
+                lower = false;
+                return true;
+            }
+            if (b == x && !occurs(x, a)) {
+                t = a;
+                lower = true;
+                return true;
+            }
+            return false;
+        }
+
+        bool solve_bounds(model& model, app* x, expr_ref_vector const& lits, expr_ref& t) {
+            model_evaluator eval(model);
+            eval.set_model_completion(true);
+            unsigned sz = bv.get_bv_size(x);
+            rational best, val;
+            expr_ref best_t(m);
+            for (expr* lit : lits) {
+                if (!occurs(x, lit))
+                    continue;
+                expr* b = nullptr;
+                bool lower = false, strict = false;
+                if (!is_bound(x, lit, b, lower, strict))
+                    return false;
+                if (!lower)
+                    continue;
+                expr_ref bt(b, m);
+                if (strict)
+                    bt = bv.mk_bv_add(b, bv.mk_numeral(rational::one(), sz));
+                if (!bv.is_numeral(eval(bt), val))
+                    return false;
+                if (!best_t || val > best) {
+                    best = val;
+                    best_t = bt;
+                }
+            }
+            t = best_t ? best_t : expr_ref(bv.mk_numeral(rational::zero(), sz), m);
+            return true;
+        }
+
+        void substitute(app* x, expr* t, expr_ref_vector& lits) {
+            expr_safe_replace sub(m);
+            sub.insert(x, t);
+            expr_ref tmp(m);
+            unsigned j = 0;
+            for (expr* lit : lits) {
+                sub(lit, tmp);
+                m_rw(tmp);
+                if (!m.is_true(tmp))
+                    lits[j++] = tmp;
+            }
+            lits.shrink(j);
+        }
+
+        bool operator()(model& model, app* x, app_ref_vector& vars, expr_ref_vector& lits) {
+            if (!bv.is_bv(x))
+                return false;
+            expr_ref t(m);
+            expr_ref_vector side(m);
+            unsigned eq_idx = 0;
+            if (solve_eq(x, lits, eq_idx, t, side)) {
+                m_rw(t);
+                TRACE("qe", tout << mk_pp(x, m) << " := " << t << " side: " << side << "\n";);
+                lits[eq_idx] = lits.back();
+                lits.pop_back();
+                substitute(x, t, lits);
+                for (expr* s : side) {
+                    expr_ref tmp(s, m);
+                    m_rw(tmp);
+                    if (!m.is_true(tmp))
+                        lits.push_back(tmp);
+                }
+                return true;
+            }
+            if (solve_bounds(model, x, lits, t)) {
+                TRACE("qe", tout << mk_pp(x, m) << " := " << t << "\n";);
+                substitute(x, t, lits);
+                return true;
+            }
+            return false;
+        }
+    };
+
+    bv_project_plugin::bv_project_plugin(ast_manager& m):
+        project_plugin(m) {
+        m_imp = alloc(imp, m);
+    }
+
+    bv_project_plugin::~bv_project_plugin() {
+        dealloc(m_imp);
+    }
+
+    bool bv_project_plugin::operator()(model& model, app* var, app_ref_vector& vars, expr_ref_vector& lits) {
+        return (*m_imp)(model, var, vars, lits);
+    }
+
+    family_id bv_project_plugin::get_family_id() {
+        return m_imp->bv.get_fid();
+    }
+
+}
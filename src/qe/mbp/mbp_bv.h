@@ -0,0 +1,31 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    mbp_bv.h
+
+Abstract:
+
+    Model based projection for bit-vectors using invertibility conditions.
+
+--*/
+
+#pragma once
+
+#include "ast/bv_decl_plugin.h"
+#include "qe/mbp/mbp_plugin.h"
+
+namespace mbp {
+
+    class bv_project_plugin : public project_plugin {
+        struct imp;
+        imp* m_imp;
+    public:
+        bv_project_plugin(ast_manager& m);
+        ~bv_project_plugin() override;
+        bool operator()(model& model, app* var, app_ref_vector& vars, expr_ref_vector& lits) override;
+        family_id get_family_id() override;
+    };
+
+};
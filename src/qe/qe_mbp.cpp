@@ -29,6 +29,7 @@ Revision History:
 #include "qe/qe_mbp.h"
 #include "qe/mbp/mbp_arith.h"
 #include "qe/mbp/mbp_arrays.h"
+#include "qe/mbp/mbp_bv.h"
 #include "qe/mbp/mbp_datatypes.h"
 #include "qe/lite/qe_lite.h"
 #include "model/model_pp.h"
@@ -242,6 +243,7 @@ public:
         add_plugin(alloc(mbp::arith_project_plugin, m));
         add_plugin(alloc(mbp::datatype_project_plugin, m));
         add_plugin(alloc(mbp::array_project_plugin, m));
+        add_plugin(alloc(mbp::bv_project_plugin, m));
         updt_params(p);
     }
 
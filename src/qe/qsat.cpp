@@ -598,13 +598,46 @@ namespace qe {
         
         struct stats {
             unsigned m_num_rounds;        
+            unsigned m_num_projections;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };        
+
+        /**
+           \brief time spent in the level solvers and in projection,
+           indexed by quantifier level.
+        */
+        struct level_stats {
+            vector<stopwatch>          m_check;
+            vector<stopwatch>          m_project;
+            stopwatch& check(unsigned level) { m_check.reserve(level + 1); return m_check[level]; }
+            stopwatch& project(unsigned level) { m_project.reserve(level + 1); return m_project[level]; }
+            void reset() { m_check.reset(); m_project.reset(); }
+            double total(vector<stopwatch> const& sws, unsigned parity) const {
+                double t = 0;
+                for (unsigned i = parity; i < sws.size(); i += 2)
+                    t += sws[i].get_seconds();
+                return t;
+            }
+            void collect_statistics(statistics& st) const {
+                st.update("qsat time exists", total(m_check, 0));
+                st.update("qsat time forall", total(m_check, 1));
+                st.update("qsat time project", total(m_project, 0) + total(m_project, 1));
+            }
+            void display(std::ostream& out) const {
+                for (unsigned i = 0; i < std::max(m_check.size(), m_project.size()); ++i) {
+                    out << "(qsat.level " << i;
+                    if (i < m_check.size()) out << " :check " << m_check[i].get_seconds();
+                    if (i < m_project.size()) out << " :project " << m_project[i].get_seconds();
+                    out << ")\n";
+                }
+            }
+        };
         
         ast_manager&               m;
         params_ref                 m_params;
         stats                      m_stats;
+        level_stats                m_level_stats;
         statistics                 m_st;
         qe::mbproj                 m_mbp;
         kernel                     m_fa;
@@ -642,7 +675,11 @@ namespace qe {
                 }
                 TRACE("qe", tout << asms << "\n";);
                 solver& s = get_kernel(m_level).s();
-                lbool res = s.check_sat(asms);
+                lbool res;
+                {
+                    scoped_watch _sw(m_level_stats.check(m_level));
+                    res = s.check_sat(asms);
+                }
                 switch (res) {
                 case l_true:
                     s.get_model(m_model);
@@ -901,6 +938,12 @@ namespace qe {
             m_pred_abs.set_expr_level(b, lvl);
         }
         
+        void project_core(model& mdl, expr_ref_vector& core) {
+            scoped_watch _sw(m_level_stats.project(m_level));
+            ++m_stats.m_num_projections;
+            m_mbp(force_elim(), m_avars, mdl, core);
+        }
+
         bool project_qe(expr_ref_vector& core) {
             SASSERT(m_level == 1);
             expr_ref fml(m);
@@ -911,7 +954,7 @@ namespace qe {
             SASSERT(validate_core(mdl, core));
             get_vars(m_level);
             SASSERT(validate_assumptions(mdl, core));
-            m_mbp(force_elim(), m_avars, mdl, core);
+            project_core(mdl, core);
             SASSERT(validate_defs("project_qe"));
             if (m_mode == qsat_maximize) {
                 maximize_core(core, mdl);
@@ -936,7 +979,7 @@ namespace qe {
             SASSERT(validate_core(mdl, core));
             get_vars(m_level-1);
             SASSERT(validate_project(mdl, core));
-            m_mbp(force_elim(), m_avars, mdl, core);
+            project_core(mdl, core);
             TRACE("qe", tout << "aux vars: " << m_avars << "\n";);
             for (app* v : m_avars) m_pred_abs.ensure_expr_level(v, m_level-1);
             m_free_vars.append(m_avars);
@@ -1309,6 +1352,7 @@ namespace qe {
             m_fa.assert_expr(m.mk_not(fml));
             TRACE("qe", tout << "ex: " << fml << "\n";);
             lbool is_sat = check_sat();
+            IF_VERBOSE(2, m_level_stats.display(verbose_stream()););
             switch (is_sat) {
             case l_false:
                 in->reset();
@@ -1350,11 +1394,14 @@ namespace qe {
             m_ex.collect_statistics(st);        
             m_pred_abs.collect_statistics(st);
             st.update("qsat num rounds", m_stats.m_num_rounds); 
+            st.update("qsat num projections", m_stats.m_num_projections);
+            m_level_stats.collect_statistics(st);
             m_pred_abs.collect_statistics(st);
         }
         
         void reset_statistics() override {
             m_stats.reset();
+            m_level_stats.reset();
             m_fa.reset_statistics();
             m_ex.reset_statistics();
         }
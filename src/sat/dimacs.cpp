@@ -20,6 +20,7 @@ Revision History:
 #undef max
 #undef min
 #include "sat/sat_solver.h"
+#include "sat/sat_maxsat.h"
 
 template<typename Buffer>
 static bool is_whitespace(Buffer & in) {
@@ -144,7 +145,20 @@ static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solv
             if (*in == EOF) {
                 break;
             }
-            else if (*in == 'c' || *in == 'p') {
+            else if (*in == 'p') {
+                ++in;
+                skip_whitespace(in);
+                if (*in == 'c') {
+                    // p cnf <vars> <clauses>: create the variables up front
+                    while (!is_whitespace(in) && *in != EOF)
+                        ++in;
+                    int num_vars = parse_int(in, err);
+                    while (num_vars >= 0 && static_cast<unsigned>(num_vars) >= solver.num_vars())
+                        solver.mk_var();
+                }
+                skip_line(in);
+            }
+            else if (*in == 'c') {
                 skip_line(in);
             }
             else {
@@ -165,6 +179,84 @@ bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
     return parse_dimacs_core(_in, err, solver);
 }
 
+template<typename Buffer>
+static uint64_t parse_weight(Buffer & in, std::ostream& err) {
+    uint64_t val = 0;
+    skip_whitespace(in);
+    if (*in < '0' || *in > '9') {
+        err << "(error, \"unexpected char: " << ((char)*in) << " line: " << in.line() << "\")\n";
+        throw dimacs::lex_error();
+    }
+    while (*in >= '0' && *in <= '9') {
+        val = val*10 + (*in - '0');
+        ++in;
+    }
+    return val;
+}
+
+template<typename Buffer>
+static bool parse_wcnf_core(Buffer & in, std::ostream& err, sat::solver & solver, sat::maxsat & ms) {
+    sat::literal_vector lits;
+    uint64_t top = UINT64_MAX;
+    // soft clauses are added after parsing, since they introduce
+    // variables that could clash with variables of later clauses.
+    vector<sat::literal_vector> soft;
+    svector<uint64_t> weights;
+    try {
+        while (true) {
+            skip_whitespace(in);
+            if (*in == EOF) {
+                break;
+            }
+            else if (*in == 'c') {
+                skip_line(in);
+            }
+            else if (*in == 'p') {
+                // p wcnf <vars> <clauses> [<top>]
+                ++in;
+                skip_whitespace(in);
+                while (!is_whitespace(in) && *in != EOF)
+                    ++in;
+                int num_vars = parse_int(in, err);
+                parse_int(in, err);
+                while (*in == ' ' || *in == '\t')
+                    ++in;
+                if (*in >= '0' && *in <= '9')
+                    top = parse_weight(in, err);
+                while (num_vars >= 0 && static_cast<unsigned>(num_vars) >= solver.num_vars())
+                    solver.mk_var();
+                skip_line(in);
+            }
+            else if (*in == 'h') {
+                ++in;
+                read_clause(in, err, solver, lits);
+                solver.mk_clause(lits.size(), lits.data());
+            }
+            else {
+                uint64_t w = parse_weight(in, err);
+                read_clause(in, err, solver, lits);
+                if (w >= top)
+                    solver.mk_clause(lits.size(), lits.data());
+                else if (w > 0) {
+                    soft.push_back(lits);
+                    weights.push_back(w);
+                }
+            }
+        }
+    }
+    catch (dimacs::lex_error) {
+        return false;
+    }
+    for (unsigned i = 0; i < soft.size(); ++i)
+        ms.add_soft(soft[i].size(), soft[i].data(), weights[i]);
+    return true;
+}
+
+bool parse_wcnf(std::istream & in, std::ostream& err, sat::solver & solver, sat::maxsat & ms) {
+    dimacs::stream_buffer _in(in);
+    return parse_wcnf_core(_in, err, solver, ms);
+}
+
 
 namespace dimacs {
 
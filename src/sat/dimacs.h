@@ -25,6 +25,15 @@ Revision History:
 
 bool parse_dimacs(std::istream & s, std::ostream& err, sat::solver & solver);
 
+namespace sat { class maxsat; }
+
+/**
+   \brief parse weighted CNF, in the format with a "p wcnf" header and
+   a weight for hard clauses or in the format with "h" for hard clauses.
+   Hard clauses are added to the solver, soft clauses to ms.
+*/
+bool parse_wcnf(std::istream & s, std::ostream& err, sat::solver & solver, sat::maxsat & ms);
+
 namespace dimacs {
     struct lex_error {};
 
@@ -32,12 +41,33 @@ namespace dimacs {
         std::istream & m_stream;
         int            m_val;
         unsigned       m_line;
+        // characters are taken from the stream buffer in blocks.
+        // Only characters that are available without blocking are taken,
+        // so pipes and terminals are read character by character.
+        char           m_buffer[1 << 16];
+        unsigned       m_pos = 0;
+        unsigned       m_size = 0;
+
+        int read() {
+            if (m_pos == m_size) {
+                std::streamsize avail = m_stream.rdbuf()->in_avail();
+                if (avail <= 0)
+                    return m_stream.get();
+                if (avail > static_cast<std::streamsize>(sizeof(m_buffer)))
+                    avail = sizeof(m_buffer);
+                m_size = static_cast<unsigned>(m_stream.rdbuf()->sgetn(m_buffer, avail));
+                m_pos = 0;
+                if (m_size == 0)
+                    return m_stream.get();
+            }
+            return static_cast<unsigned char>(m_buffer[m_pos++]);
+        }
     public:
         
     stream_buffer(std::istream & s):
         m_stream(s),
             m_line(0) {
-            m_val = m_stream.get();
+            m_val = read();
         }
         
         int  operator *() const { 
@@ -45,7 +75,7 @@ namespace dimacs {
         }
         
         void operator ++() { 
-            m_val = m_stream.get();
+            m_val = read();
             if (m_val == '\n') ++m_line;
         }
         
@@ -49,6 +49,7 @@ namespace sat {
         m_slow_glue_avg = p.restart_emaslowglue();
         m_restart_margin = p.restart_margin();
         m_restart_fast = p.restart_fast();
+        m_restart_save_trail = p.restart_save_trail();
         s = p.phase();
         if (s == symbol("always_false")) 
             m_phase = PS_ALWAYS_FALSE;
@@ -66,6 +67,7 @@ namespace sat {
             throw sat_param_exception("invalid phase selection strategy: always_false, always_true, basic_caching, caching, random");
 
         m_rephase_base      = p.rephase_base();
+        m_rephase_theory    = p.rephase_theory();
         m_reorder_base      = p.reorder_base();
         m_reorder_itau      = p.reorder_itau();
         m_activity_scale  = p.reorder_activity_scale();
@@ -79,6 +81,7 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_adaptive = p.inprocess_adaptive();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -91,6 +94,9 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_share_glue  = p.par_share_glue();
+        m_par_share_size  = p.par_share_size();
+        m_par_share_budget = p.par_share_budget();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -107,6 +113,7 @@ namespace sat {
         m_anf_delay         = p.anf_delay();
         m_anf_exlin         = p.anf_exlin();
         m_cut_simplify      = p.cut();
+        m_xor_gauss         = p.xor_gauss();
         m_cut_delay         = p.cut_delay();
         m_cut_aig           = p.cut_aig();
         m_cut_lut           = p.cut_lut();
@@ -115,6 +122,7 @@ namespace sat {
         m_cut_dont_cares    = p.cut_dont_cares();
         m_cut_redundancies  = p.cut_redundancies();
         m_cut_force         = p.cut_force();
+        m_cut_sweep         = p.cut_sweep();
         m_lookahead_simplify = p.lookahead_simplify();
         m_lookahead_double = p.lookahead_double();
         m_lookahead_simplify_bca = p.lookahead_simplify_bca();
@@ -182,6 +190,7 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_defrag_interval = std::max(1u, p.gc_defrag_interval());
 
         m_force_cleanup   = p.force_cleanup();
 
@@ -189,13 +198,18 @@ namespace sat {
         m_backtrack_init_conflicts = p.backtrack_conflicts();
 
         m_minimize_lemmas = p.minimize_lemmas();
+        m_shrink_lemmas   = p.shrink_lemmas();
+        m_lemma_subsumption = p.lemma_subsumption();
         m_core_minimize   = p.core_minimize();
         m_core_minimize_partial   = p.core_minimize_partial();
         m_drat_check_unsat  = p.drat_check_unsat();
         m_drat_check_sat  = p.drat_check_sat();
         m_drat_file       = p.drat_file();
+        m_stats_file      = p.stats_file();
+        m_stats_interval  = p.stats_interval();
         m_drat            = (m_drat_check_unsat || m_drat_file.is_non_empty_string() || m_drat_check_sat) && p.threads() == 1;
         m_drat_binary     = p.drat_binary();
+        m_drat_async      = p.drat_async();
         m_drat_activity   = p.drat_activity();
         m_drup_trim       = p.drup_trim();
         m_dyn_sub_res     = p.dyn_sub_res();
@@ -206,8 +220,11 @@ namespace sat {
             m_branching_heuristic = BH_VSIDS;
         else if (p.branching_heuristic() == symbol("chb")) 
             m_branching_heuristic = BH_CHB;
+        else if (p.branching_heuristic() == symbol("vmtf")) 
+            m_branching_heuristic = BH_VMTF;
         else 
-            throw sat_param_exception("invalid branching heuristic: accepted heuristics are 'vsids' or 'chb'");
+            throw sat_param_exception("invalid branching heuristic: accepted heuristics are 'vsids', 'chb' or 'vmtf'");
+        m_branching_mode_switch = p.branching_mode_switch();
 
         m_anti_exploration = p.branching_anti_exploration();
         m_step_size_init = 0.40;
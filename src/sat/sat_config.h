@@ -49,7 +49,8 @@ namespace sat {
 
     enum branching_heuristic {
         BH_VSIDS,
-        BH_CHB
+        BH_CHB,
+        BH_VMTF
     };
 
     enum pb_resolve {
@@ -90,12 +91,14 @@ namespace sat {
         unsigned           m_search_unsat_conflicts;
         bool               m_phase_sticky;
         unsigned           m_rephase_base;
+        bool               m_rephase_theory;
         unsigned           m_reorder_base;
         double             m_reorder_itau;
         unsigned           m_reorder_activity_scale;
         bool               m_propagate_prefetch;
         restart_strategy   m_restart;
         bool               m_restart_fast;
+        bool               m_restart_save_trail;
         unsigned           m_restart_initial;
         double             m_restart_factor; // for geometric case
         double             m_restart_margin; // for ema
@@ -105,12 +108,16 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_adaptive;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_share_glue;
+        unsigned           m_par_share_size;
+        unsigned           m_par_share_budget;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -120,6 +127,7 @@ namespace sat {
         bool               m_local_search_dbg_flips;
         bool               m_binspr;
         bool               m_cut_simplify;
+        bool               m_xor_gauss;
         unsigned           m_cut_delay;
         bool               m_cut_aig;
         bool               m_cut_lut;
@@ -128,6 +136,7 @@ namespace sat {
         bool               m_cut_dont_cares;
         bool               m_cut_redundancies;
         bool               m_cut_force;
+        bool               m_cut_sweep;
         bool               m_anf_simplify;
         unsigned           m_anf_delay;
         bool               m_anf_exlin;
@@ -161,6 +170,7 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_defrag_interval;
 
         bool               m_force_cleanup;
 
@@ -169,6 +179,8 @@ namespace sat {
         unsigned           m_backtrack_init_conflicts;
 
         bool               m_minimize_lemmas;
+        bool               m_shrink_lemmas;
+        unsigned           m_lemma_subsumption;
         bool               m_dyn_sub_res;
         bool               m_core_minimize;
         bool               m_core_minimize_partial;
@@ -176,7 +188,10 @@ namespace sat {
         // drat proofs
         bool               m_drat;
         bool               m_drat_binary;
+        bool               m_drat_async;
         symbol             m_drat_file;
+        symbol             m_stats_file;
+        unsigned           m_stats_interval;
         bool               m_drat_check_unsat;
         bool               m_drat_check_sat;
         bool               m_drup_trim;
@@ -189,6 +204,7 @@ namespace sat {
         
         // branching heuristic settings.
         branching_heuristic m_branching_heuristic;
+        unsigned           m_branching_mode_switch;
         bool               m_anti_exploration;
         double             m_step_size_init;
         double             m_step_size_dec;
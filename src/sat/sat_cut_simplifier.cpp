@@ -282,6 +282,7 @@ namespace sat {
         cuts2equiv(cuts);
         cuts2implies(cuts);
         simulate_eqs();
+        sweep_eqs();
     }
 
     void cut_simplifier::cuts2equiv(vector<cut_set> const& cuts) {
@@ -505,6 +506,120 @@ namespace sat {
         IF_VERBOSE(2, verbose_stream() << "(sat.cut-simplifier num simulated eqs " << num_eqs << ")\n");
     }
 
+    /**
+     * SAT sweeping: literals with the same signature under random
+     * simulation of the AIG form candidate equivalence classes.
+     * Each candidate is checked against the first literal of its class
+     * by a copy of the solver with a conflict budget. A counterexample
+     * separates the remaining candidates whose value differs from the
+     * representative, they form a new class that is swept in turn.
+     * Proven equivalences are merged by elim_eqs.
+     */
+    void cut_simplifier::sweep_eqs() {
+        if (!s.m_config.m_cut_sweep || s.m_config.m_drat || s.m_ext || s.inconsistent()) 
+            return;
+        auto var2val = m_aig_cuts.simulate(4);
+
+        // literals are normalized so that their signature has the first bit unset.
+        u64_map<unsigned> val2class;
+        vector<literal_vector> classes;
+        for (unsigned v = 0; v < var2val.size() && v < s.num_vars(); ++v) {
+            if (s.was_eliminated(v) || s.value(v) != l_undef) 
+                continue;
+            uint64_t t = var2val[v].m_t;
+            literal lit(v, false);
+            if (t & 1) {
+                t = ~t;
+                lit.neg();
+            }
+            unsigned idx = 0;
+            if (!val2class.find(t, idx)) {
+                idx = classes.size();
+                val2class.insert(t, idx);
+                classes.push_back(literal_vector());
+            }
+            classes[idx].push_back(lit);
+        }
+
+        params_ref p;
+        p.set_bool("cut", false);
+        p.set_bool("drat.check_unsat", false);
+        p.set_sym("drat.file", symbol());
+        p.set_uint("max_conflicts", m_config.m_sweep_conflicts);
+        solver checker(p, s.rlimit());
+        checker.copy(s, false);
+
+        union_find_default_ctx ctx;
+        union_find<> uf(ctx);
+        for (unsigned i = 2*s.num_vars(); i--> 0; ) uf.mk_var();
+        bool new_eq = false;
+        unsigned num_checks = 0;
+        vector<model> cexs;
+        literal_vector rest;
+        auto value_of = [](model const& mdl, literal lit) { 
+            return lit.sign() ? ~mdl[lit.var()] : mdl[lit.var()]; 
+        };
+        for (unsigned idx = 0; idx < classes.size(); ++idx) {
+            literal_vector cls(classes[idx]);
+            while (cls.size() > 1 && num_checks < m_config.m_sweep_max_checks && !checker.inconsistent() && s.rlimit().inc()) {
+                literal a = cls[0];
+                rest.reset();
+                cexs.reset();
+                for (unsigned i = 1; i < cls.size(); ++i) {
+                    literal b = cls[i];
+                    bool separated = false;
+                    for (model const& mdl : cexs) 
+                        separated |= value_of(mdl, a) != value_of(mdl, b);
+                    if (separated) {
+                        rest.push_back(b);
+                        continue;
+                    }
+                    if (num_checks >= m_config.m_sweep_max_checks) 
+                        break;
+                    ++num_checks;
+                    ++m_stats.m_num_sweep_checks;
+                    switch (check_equiv(checker, a, b)) {
+                    case l_false:
+                        TRACE("cut_simplifier", tout << "sweep " << a << " == " << b << "\n";);
+                        validate_eq(a, b);
+                        uf.merge(a.index(), b.index());
+                        uf.merge((~a).index(), (~b).index());
+                        ++m_stats.m_num_sweep_eqs;
+                        new_eq = true;
+                        break;
+                    case l_true:
+                        cexs.push_back(checker.get_model());
+                        rest.push_back(b);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                cls.swap(rest);
+            }
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.cut-simplifier :sweep-checks " << num_checks << ")\n");
+        if (checker.inconsistent()) 
+            s.set_conflict();
+        else if (new_eq) 
+            uf2equiv(uf);
+    }
+
+    /**
+     * Check whether a and b are equivalent in the checker.
+     * Return l_false if they are, l_true if a model distinguishes them
+     * and l_undef if the checker exceeded its budget.
+     */
+    lbool cut_simplifier::check_equiv(solver& checker, literal a, literal b) {
+        literal lits[2] = { a, ~b };
+        lbool r = checker.check(2, lits);
+        if (r != l_false) 
+            return r;
+        lits[0] = ~a;
+        lits[1] = b;
+        return checker.check(2, lits);
+    }
+
     void cut_simplifier::track_binary(bin_rel const& p) {
         if (!s.m_config.m_drat) 
             return;
@@ -733,6 +848,8 @@ namespace sat {
         st.update("sat-cut.xxors", m_stats.m_xxors);
         st.update("sat-cut.xluts", m_stats.m_xluts);
         st.update("sat-cut.dc-reduce", m_stats.m_num_dont_care_reductions);
+        st.update("sat-cut.sweep-checks", m_stats.m_num_sweep_checks);
+        st.update("sat-cut.sweep-eqs", m_stats.m_num_sweep_eqs);
     }
 
     void cut_simplifier::validate_unit(literal lit) {
@@ -30,6 +30,7 @@ namespace sat {
             unsigned m_num_eqs, m_num_units, m_num_cuts, m_num_xors, m_num_ands, m_num_ites;
             unsigned m_xxors, m_xands, m_xites, m_xluts;                         // extrated gates
             unsigned m_num_calls, m_num_dont_care_reductions, m_num_learned_implies;
+            unsigned m_num_sweep_checks, m_num_sweep_eqs;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -41,6 +42,8 @@ namespace sat {
             bool m_validate_cuts;           // enable direct validation of generated cuts
             bool m_validate_lemmas;         // enable direct validation of learned lemmas 
             bool m_simulate_eqs;            // use symbolic simulation to control size of cutsets.
+            unsigned m_sweep_conflicts;     // conflict budget of each equivalence check by sweeping.
+            unsigned m_sweep_max_checks;    // maximal number of equivalence checks per sweep.
             config():
                 m_enable_units(true),
                 m_enable_dont_cares(true),
@@ -48,7 +51,9 @@ namespace sat {
                 m_learned2aig(true),
                 m_validate_cuts(false), 
                 m_validate_lemmas(false),
-                m_simulate_eqs(false) {}
+                m_simulate_eqs(false),
+                m_sweep_conflicts(1000),
+                m_sweep_max_checks(10000) {}
         };
     private:
         struct report;
@@ -124,6 +129,8 @@ namespace sat {
         void clauses2aig();
         void aig2clauses();
         void simulate_eqs();
+        void sweep_eqs();
+        lbool check_equiv(solver& checker, literal a, literal b);
         void cuts2equiv(vector<cut_set> const& cuts);
         void cuts2implies(vector<cut_set> const& cuts);
         void uf2equiv(union_find<> const& uf);
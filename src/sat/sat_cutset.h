@@ -112,7 +112,19 @@ namespace sat {
 
         uint64_t shift_table(cut const& other) const;
 
+        /**
+           \brief a and b have more distinct elements than a cut can hold
+           if the union of their filters has more bits than max_cut_size.
+           This rejects most failing merges without visiting the elements.
+        */
+        static bool exceeds_max_size(cut const& a, cut const& b) {
+            return get_num_1bits(a.m_filter | b.m_filter) > max_cut_size();
+        }
+
         bool merge(cut const& a, cut const& b) {
+            if (exceeds_max_size(a, b)) {
+                return false;
+            }
             unsigned i = 0, j = 0;
             unsigned x = a[i];
             unsigned y = b[j];
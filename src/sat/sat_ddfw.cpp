@@ -196,6 +196,7 @@ namespace sat {
         m_parsync_next = m_config.m_parsync_base;
 
         m_min_sz = m_unsat.size();
+        m_best_phase.reset();
         m_flips = 0;
         m_last_flips = 0;
         m_shifts = 0;
@@ -411,6 +412,9 @@ namespace sat {
             }
         }
         if (m_unsat.size() < m_min_sz) {
+            m_best_phase.reserve(num_vars());
+            for (unsigned v = 0; v < num_vars(); ++v) 
+                m_best_phase[v] = value(v);
             m_models.reset();
             // skip saving the first model.
             for (unsigned v = 0; v < num_vars(); ++v) {
@@ -95,6 +95,7 @@ namespace sat {
         uint64_t         m_restart_next{ 0 }, m_reinit_next{ 0 }, m_parsync_next{ 0 };
         uint64_t         m_flips{ 0 }, m_last_flips{ 0 }, m_shifts{ 0 };
         unsigned         m_min_sz{ 0 };
+        bool_vector      m_best_phase;   // assignment with the fewest unsatisfied clauses
         hashtable<unsigned, unsigned_hash, default_eq<unsigned>> m_models;
         stopwatch        m_stopwatch;
 
@@ -220,6 +221,8 @@ namespace sat {
         void collect_statistics(statistics& st) const override {} 
 
         double get_priority(bool_var v) const override { return m_probs[v]; }
+
+        lbool get_best_value(bool_var v) const override { return v < m_best_phase.size() ? to_lbool(m_best_phase[v]) : l_undef; }
     };
 }
 
@@ -20,11 +20,115 @@ Notes:
 
 --*/
 
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
 #include "util/rational.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
 
 namespace sat {
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief Stream buffer that hands filled blocks to a background thread
+       which writes them to the proof file. The solver thread only copies
+       bytes into memory; the file system calls happen off the search path.
+    */
+    class drat::async_writer : public std::streambuf {
+        static const size_t block_size = 1 << 20;
+        static const size_t max_pending = 64;
+        std::ostream*                  m_out;
+        std::vector<char>              m_block;
+        std::deque<std::vector<char>>  m_pending;
+        std::vector<std::vector<char>> m_free;
+        std::mutex                     m_mux;
+        std::condition_variable        m_cv;
+        bool                           m_done = false;
+        std::thread                    m_thread;
+
+        void reset_block() {
+            m_block.resize(block_size);
+            setp(m_block.data(), m_block.data() + m_block.size());
+        }
+
+        void hand_off() {
+            size_t n = pptr() - pbase();
+            if (n == 0)
+                return;
+            m_block.resize(n);
+            std::vector<char> next;
+            {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_cv.wait(lock, [&]() { return m_pending.size() < max_pending; });
+                m_pending.push_back(std::move(m_block));
+                if (!m_free.empty()) {
+                    next = std::move(m_free.back());
+                    m_free.pop_back();
+                }
+            }
+            m_cv.notify_all();
+            m_block = std::move(next);
+            reset_block();
+        }
+
+        void run() {
+            std::vector<char> block;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mux);
+                    m_cv.wait(lock, [&]() { return m_done || !m_pending.empty(); });
+                    if (m_pending.empty())
+                        break;
+                    block = std::move(m_pending.front());
+                    m_pending.pop_front();
+                }
+                m_cv.notify_all();
+                m_out->write(block.data(), block.size());
+                block.clear();
+                std::lock_guard<std::mutex> lock(m_mux);
+                if (m_free.size() < 4)
+                    m_free.push_back(std::move(block));
+            }
+            m_out->flush();
+        }
+
+    public:
+        async_writer(std::ostream* out): m_out(out) {
+            reset_block();
+            m_thread = std::thread([this]() { run(); });
+        }
+
+        ~async_writer() override {
+            hand_off();
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_done = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+            dealloc(m_out);
+        }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            hand_off();
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            hand_off();
+            return 0;
+        }
+    };
+#endif
     
     drat::drat(solver& s) :
         s(s)
@@ -32,6 +136,13 @@ namespace sat {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
             m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+#ifndef SINGLE_THREAD
+            // without threads the proof is written synchronously.
+            if (s.get_config().m_drat_async) {
+                m_writer = alloc(async_writer, m_out);
+                m_out = alloc(std::ostream, m_writer);
+            }
+#endif
             if (s.get_config().m_drat_binary) 
                 std::swap(m_out, m_bout);            
         }
@@ -42,6 +153,10 @@ namespace sat {
         if (m_bout) m_bout->flush();
         dealloc(m_out);
         dealloc(m_bout);
+#ifndef SINGLE_THREAD
+        dealloc(m_writer);
+        m_writer = nullptr;
+#endif
         for (auto & [c, st] : m_proof) 
             m_alloc.del_clause(&c);            
         m_proof.reset();
@@ -73,12 +73,14 @@ namespace sat {
             watched_clause(clause* c, literal l1, literal l2):
                 m_clause(c), m_l1(l1), m_l2(l2) {}
         };
+        class async_writer;
         svector<watched_clause>   m_watched_clauses;
         typedef svector<unsigned> watch;
         solver& s;
         clause_allocator        m_alloc;
         std::ostream*           m_out = nullptr;
         std::ostream*           m_bout = nullptr;
+        async_writer*           m_writer = nullptr;
         svector<std::pair<clause&, status>> m_proof;
         svector<std::pair<literal, clause*>> m_units;
         vector<watch>           m_watches;
@@ -19,6 +19,7 @@ Revision History:
 
 
 #include "sat/sat_solver.h"
+#include "util/scoped_profile.h"
 
 #define ENABLE_TERNARY true
 
@@ -38,6 +39,7 @@ namespace sat {
 
     void solver::do_gc() {
         if (!should_gc()) return;
+        scoped_profile _profile("sat.gc");
         TRACE("sat", tout << m_conflicts_since_gc << " " << m_gc_threshold << "\n";);
         unsigned gc = m_stats.m_gc_clause;
         m_conflicts_since_gc = 0;
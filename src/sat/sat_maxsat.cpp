@@ -0,0 +1,170 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    sat_maxsat.cpp
+
+Abstract:
+
+    Weighted MaxSAT over the clauses of a sat::solver.
+
+  --*/
+
+#include "sat/sat_maxsat.h"
+
+namespace sat {
+
+    void maxsat::add_soft(unsigned n, literal const* lits, uint64_t w) {
+        SASSERT(w > 0);
+        m_soft.push_back(soft());
+        m_soft.back().m_clause.append(n, lits);
+        m_soft.back().m_weight = w;
+        if (n == 0) {
+            m_lower += w;
+            return;
+        }
+        literal a(s.mk_var(true, true), false);
+        literal_vector clause(n, lits);
+        clause.push_back(~a);
+        s.mk_clause(clause.size(), clause.data());
+        add_assumption(a, w);
+    }
+
+    void maxsat::add_assumption(literal a, uint64_t w) {
+        if (a.index() >= m_weight.size() || m_weight[a.index()] == 0)
+            m_asms.push_back(a);
+        m_weight.reserve(a.index() + 1, 0);
+        m_totalizer_of.reserve(a.index() + 1, UINT_MAX);
+        m_output_of.reserve(a.index() + 1, 0);
+        m_weight[a.index()] += w;
+    }
+
+    /**
+       \brief totalizer over in, only the clauses that force outputs up are added.
+       An assumption ~out[k] then bounds the number of inputs that hold by k.
+    */
+    void maxsat::mk_totalizer(literal_vector const& in, literal_vector& out) {
+        if (in.size() == 1) {
+            out.push_back(in[0]);
+            return;
+        }
+        unsigned half = in.size() / 2;
+        literal_vector left(half, in.data()), right(in.size() - half, in.data() + half);
+        literal_vector lo, ro;
+        mk_totalizer(left, lo);
+        mk_totalizer(right, ro);
+        for (unsigned k = 0; k < in.size(); ++k)
+            out.push_back(literal(s.mk_var(true, true), false));
+        for (unsigned i = 0; i < lo.size(); ++i)
+            s.mk_clause(~lo[i], out[i]);
+        for (unsigned j = 0; j < ro.size(); ++j)
+            s.mk_clause(~ro[j], out[j]);
+        for (unsigned i = 0; i < lo.size(); ++i)
+            for (unsigned j = 0; j < ro.size(); ++j)
+                s.mk_clause(~lo[i], ~ro[j], out[i + j + 1]);
+    }
+
+    void maxsat::process_core(literal_vector const& core) {
+        m_stats.m_num_cores++;
+        uint64_t wmin = UINT64_MAX;
+        for (literal a : core)
+            wmin = std::min(wmin, weight(a));
+        SASSERT(0 < wmin && wmin < UINT64_MAX);
+        m_lower += wmin;
+        literal_vector in;
+        for (literal a : core) {
+            m_weight[a.index()] -= wmin;
+            in.push_back(~a);
+            unsigned t = m_totalizer_of[a.index()];
+            if (t == UINT_MAX)
+                continue;
+            unsigned k = m_output_of[a.index()] + 1;
+            literal_vector const& outputs = m_totalizers[t].m_outputs;
+            if (k < outputs.size()) {
+                add_assumption(~outputs[k], wmin);
+                m_totalizer_of[(~outputs[k]).index()] = t;
+                m_output_of[(~outputs[k]).index()] = k;
+            }
+        }
+        if (in.size() == 1) {
+            s.mk_clause(1, in.data());
+            return;
+        }
+        m_stats.m_num_totalizers++;
+        unsigned t = m_totalizers.size();
+        m_totalizers.push_back(totalizer());
+        literal_vector outputs;
+        mk_totalizer(in, outputs);
+        m_totalizers[t].m_outputs.append(outputs);
+        literal a = ~outputs[1];
+        add_assumption(a, wmin);
+        m_totalizer_of[a.index()] = t;
+        m_output_of[a.index()] = 1;
+    }
+
+    void maxsat::update_model() {
+        model const& mdl = s.get_model();
+        uint64_t cost = 0;
+        for (soft const& sf : m_soft) {
+            bool is_sat = false;
+            for (literal l : sf.m_clause)
+                is_sat |= value_at(l, mdl) == l_true;
+            if (!is_sat)
+                cost += sf.m_weight;
+        }
+        if (m_model.empty() || cost < m_upper) {
+            m_upper = cost;
+            m_model = mdl;
+            m_stats.m_num_improvements++;
+            IF_VERBOSE(1, verbose_stream() << "(sat.maxsat :lower " << m_lower << " :upper " << m_upper << ")\n";);
+        }
+    }
+
+    uint64_t maxsat::next_stratum(uint64_t stratum) const {
+        uint64_t next = 0;
+        for (literal a : m_asms) {
+            uint64_t w = weight(a);
+            if (w < stratum && w > next)
+                next = w;
+        }
+        return next;
+    }
+
+    lbool maxsat::operator()() {
+        lbool r = s.check();
+        if (r != l_true)
+            return r;
+        update_model();
+        uint64_t stratum = next_stratum(UINT64_MAX);
+        literal_vector asms;
+        while (m_lower < m_upper && stratum > 0) {
+            asms.reset();
+            for (literal a : m_asms)
+                if (weight(a) >= stratum)
+                    asms.push_back(a);
+            r = s.check(asms.size(), asms.data());
+            if (r == l_undef)
+                return l_undef;
+            if (r == l_true) {
+                update_model();
+                stratum = next_stratum(stratum);
+                m_stats.m_num_strata++;
+                continue;
+            }
+            literal_vector core(s.get_core());
+            if (core.empty())
+                break;
+            process_core(core);
+        }
+        return l_true;
+    }
+
+    void maxsat::collect_statistics(statistics& st) const {
+        s.collect_statistics(st);
+        st.update("sat maxsat cores", m_stats.m_num_cores);
+        st.update("sat maxsat totalizers", m_stats.m_num_totalizers);
+        st.update("sat maxsat strata", m_stats.m_num_strata);
+        st.update("sat maxsat improvements", m_stats.m_num_improvements);
+    }
+}
@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    sat_maxsat.h
+
+Abstract:
+
+    Weighted MaxSAT over the clauses of a sat::solver.
+
+    Core-guided search in the style of OLL with stratification.
+    Each soft clause is guarded by an assumption literal. A core
+    lowers the weights of its assumptions by the minimal weight in
+    the core and adds a totalizer, in clause form, over the violated
+    assumptions. The outputs of the totalizer become assumptions that
+    are relaxed one at a time when they occur in later cores.
+
+  Notes:
+
+    The problem is purely propositional and never gets translated
+    to expressions, so it avoids the overhead of opt::context for
+    weighted CNF input.
+
+  --*/
+#pragma once
+
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    class maxsat {
+    public:
+        struct stats {
+            unsigned m_num_cores, m_num_totalizers, m_num_strata, m_num_improvements;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+    private:
+        struct soft {
+            literal_vector m_clause;
+            uint64_t       m_weight;
+        };
+
+        // the outputs of a totalizer: m_outputs[k] holds if more than k inputs hold
+        struct totalizer {
+            literal_vector m_outputs;
+        };
+
+        solver&           s;
+        vector<soft>      m_soft;
+        vector<totalizer> m_totalizers;
+        // per assumption literal: its remaining weight and, for outputs of
+        // totalizers, the totalizer and the output index.
+        svector<uint64_t> m_weight;
+        unsigned_vector   m_totalizer_of;
+        unsigned_vector   m_output_of;
+        literal_vector    m_asms;
+        uint64_t          m_lower = 0;
+        uint64_t          m_upper = 0;
+        model             m_model;
+        stats             m_stats;
+
+        void add_assumption(literal a, uint64_t w);
+        void mk_totalizer(literal_vector const& in, literal_vector& out);
+        void process_core(literal_vector const& core);
+        void update_model();
+        uint64_t next_stratum(uint64_t stratum) const;
+        uint64_t weight(literal a) const { return a.index() < m_weight.size() ? m_weight[a.index()] : 0; }
+
+    public:
+        maxsat(solver& s): s(s) {}
+
+        /**
+           \brief add a soft clause of positive weight.
+        */
+        void add_soft(unsigned n, literal const* lits, uint64_t w);
+
+        /**
+           \brief l_true if an optimal model was found, l_false if the hard
+           clauses are unsatisfiable and l_undef if the search was interrupted.
+           The bounds on the cost are valid in all cases.
+        */
+        lbool operator()();
+
+        uint64_t lower() const { return m_lower; }
+        uint64_t upper() const { return m_upper; }
+        model const& get_model() const { return m_model; }
+        void collect_statistics(statistics& st) const;
+    };
+}
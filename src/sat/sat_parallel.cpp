@@ -90,7 +90,13 @@ namespace sat {
         return false;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): 
+        m_share_glue(s.get_config().m_par_share_glue),
+        m_share_size(s.get_config().m_par_share_size),
+        m_share_budget(s.get_config().m_par_share_budget),
+        m_num_clauses(0), 
+        m_consumer_ready(false), 
+        m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         for (unsigned i = 0; i < m_solvers.size(); ++i) {            
@@ -118,6 +124,12 @@ namespace sat {
         s.m_params.set_sym("phase", saved_phase);        
     }
 
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_pool.reserve(num_owners, sz);
+        m_exports.reset();
+        m_exports.resize(num_owners);
+    }
+
     void parallel::push_child(reslimit& rl) {
         m_scoped_rlimit.push_child(&rl);            
     }
@@ -143,40 +155,68 @@ namespace sat {
         }
     }
 
+    bool parallel::enable_export(solver& s) {
+        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) 
+            return false;
+        export_buffer& b = m_exports[s.m_par_id];
+        if (m_share_budget > 0 && b.m_num_clauses >= m_share_budget) {
+            ++b.m_num_dropped;
+            return false;
+        }
+        return true;
+    }
+
+    void parallel::export_clause(solver& s, unsigned n, literal const* lits) {
+        export_buffer& b = m_exports[s.m_par_id];
+        b.m_data.push_back(n);
+        for (unsigned i = 0; i < n; ++i) 
+            b.m_data.push_back(lits[i].index());
+        ++b.m_num_clauses;
+    }
+
     void parallel::share_clause(solver& s, literal l1, literal l2) {        
-        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
-        flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
+        if (!enable_export(s)) return;
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        export_clause(s, 2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
-        flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
-        }
-        m_pool.end_add_vector();        
+        if (!enable_add(c) || !enable_export(s)) return;
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        export_clause(s, c.size(), c.begin());
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         lock_guard lock(m_mux);
+        _flush(s);
         _get_clauses(s);        
     }
 
+    /**
+       \brief move the clauses buffered by s into the shared pool.
+       The caller holds m_mux.
+     */
+    void parallel::_flush(solver& s) {
+        unsigned owner = s.m_par_id;
+        export_buffer& b = m_exports[owner];
+        unsigned_vector const& data = b.m_data;
+        for (unsigned i = 0; i < data.size(); ) {
+            unsigned n = data[i++];
+            m_pool.begin_add_vector(owner, n);
+            for (unsigned j = 0; j < n; ++j) 
+                m_pool.add_vector_elem(data[i++]);
+            m_pool.end_add_vector();
+        }
+        IF_VERBOSE(2, if (b.m_num_clauses > 0 || b.m_num_dropped > 0) 
+                          verbose_stream() << "(sat-parallel :id " << owner << " :exported " << b.m_num_clauses << " :dropped " << b.m_num_dropped << ")\n";);
+        b.m_data.reset();
+        b.m_num_clauses = 0;
+        b.m_num_dropped = 0;
+    }
+
     void parallel::_get_clauses(solver& s) {
         unsigned n;
         unsigned const* ptr;
@@ -199,7 +239,7 @@ namespace sat {
 
     bool parallel::enable_add(clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        return (c.size() <= m_share_size && c.glue() <= m_share_glue) || c.glue() <= 2;
     }
 
     void parallel::_from_solver(solver& s) {
@@ -221,6 +261,10 @@ namespace sat {
         for (bool_var v = 0; v < m_priorities.size(); ++v) {
             s.update_activity(v, m_priorities[v]);
         }
+        for (bool_var v = 0; v < m_phases.size() && v < s.num_vars(); ++v) {
+            if (m_phases[v] != l_undef) 
+                s.m_best_phase[v] = m_phases[v] == l_true;
+        }
         return true;
     }
 
@@ -236,8 +280,10 @@ namespace sat {
 
     void parallel::_to_solver(i_local_search& s) {        
         m_priorities.reset();
+        m_phases.reset();
         for (bool_var v = 0; m_solver_copy && v < m_solver_copy->num_vars(); ++v) {
             m_priorities.push_back(s.get_priority(v));
+            m_phases.push_back(s.get_best_value(v));
         }
     }
 
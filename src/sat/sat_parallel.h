@@ -48,7 +48,19 @@ namespace sat {
             bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
         };
 
+        // per-thread buffer of learned clauses that have not yet been
+        // published to the shared pool. Each buffer is only accessed by its owner
+        // outside of flush, so adding lemmas does not contend on m_mux.
+        struct export_buffer {
+            unsigned_vector m_data;         // sequence of (length, literal indices)
+            unsigned        m_num_clauses { 0 };
+            unsigned        m_num_dropped { 0 };
+        };
+
         bool enable_add(clause const& c) const;
+        bool enable_export(solver& s);
+        void export_clause(solver& s, unsigned n, literal const* lits);
+        void _flush(solver& s);
         void _get_clauses(solver& s);
         void _from_solver(solver& s);
         bool _to_solver(solver& s);
@@ -61,12 +73,17 @@ namespace sat {
         literal_vector m_lits;
         vector_pool    m_pool;
         mutex          m_mux;
+        vector<export_buffer> m_exports;
+        unsigned       m_share_glue;
+        unsigned       m_share_size;
+        unsigned       m_share_budget;
 
         // for exchange with local search:
         unsigned           m_num_clauses;
         scoped_ptr<solver> m_solver_copy;
         bool               m_consumer_ready;
         svector<double>    m_priorities;
+        svector<lbool>     m_phases;      // best assignment found by local search
 
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
@@ -83,7 +100,7 @@ namespace sat {
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -92,12 +109,12 @@ namespace sat {
         // exchange unit literals
         void exchange(solver& s, literal_vector const& in, unsigned& limit, literal_vector& out);
 
-        // add clause to shared clause pool
+        // add clause to the export buffer of s.
         void share_clause(solver& s, clause const& c);
 
         void share_clause(solver& s, literal l1, literal l2);
         
-        // receive clauses from shared clause pool
+        // publish exported clauses of s and receive clauses from shared clause pool
         void get_clauses(solver& s);
 
         // exchange from solver state to local search and back.
@@ -1854,6 +1854,45 @@ namespace sat {
         return res;
     }
 
+    /**
+       \brief Count the non-tautological resolvents of m_pos_cls and m_neg_cls
+       on l without producing them. The literals of each positive clause are
+       marked once for all its partners. Counting stops after max_count.
+    */
+    unsigned simplifier::num_resolvents(literal l, unsigned max_count) {
+        if (m_visited.size() <= 2*s.num_vars())
+            m_visited.resize(2*s.num_vars(), false);
+        literal not_l = ~l;
+        unsigned count = 0;
+        for (clause_wrapper const& c1 : m_pos_cls) {
+            if (c1.was_removed())
+                continue;
+            SASSERT(c1.contains(l));
+            unsigned sz1 = c1.size();
+            for (unsigned i = 0; i < sz1; ++i)
+                if (c1[i] != l)
+                    m_visited[c1[i].index()] = true;
+            m_elim_counter -= sz1;
+            for (clause_wrapper const& c2 : m_neg_cls) {
+                if (c2.was_removed())
+                    continue;
+                SASSERT(c2.contains(not_l));
+                unsigned sz2 = c2.size();
+                m_elim_counter -= sz2;
+                bool tautology = false;
+                for (unsigned i = 0; i < sz2 && !tautology; ++i)
+                    tautology = c2[i] != not_l && m_visited[(~c2[i]).index()];
+                if (!tautology && ++count > max_count)
+                    break;
+            }
+            for (unsigned i = 0; i < sz1; ++i)
+                m_visited[c1[i].index()] = false;
+            if (count > max_count)
+                break;
+        }
+        return count;
+    }
+
     void simplifier::save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs) {
         for (auto & e : cs) {
             s.m_mc.insert(mc_entry, e);
@@ -1963,20 +2002,10 @@ namespace sat {
 
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
-        unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
-                m_new_cls.reset();
-                if (resolve(c1, c2, pos_l, m_new_cls)) {
-                    TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
-                          for (literal l : m_new_cls) tout << l << " "; tout << "\n";);
-                    after_clauses++;
-                    if (after_clauses > before_clauses) {
-                        TRACE("sat_simplifier", tout << "too many after clauses: " << after_clauses << "\n";);
-                        return false;
-                    }
-                }
-            }
+        unsigned after_clauses  = num_resolvents(pos_l, before_clauses);
+        if (after_clauses > before_clauses) {
+            TRACE("sat_simplifier", tout << "too many after clauses: " << after_clauses << "\n";);
+            return false;
         }
         TRACE("sat_simplifier", tout << "eliminate " << v << ", before: " << before_clauses << " after: " << after_clauses << "\n";
               tout << "pos\n";
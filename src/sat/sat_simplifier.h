@@ -199,6 +199,7 @@ namespace sat {
         clause_wrapper_vector m_neg_cls;
         literal_vector m_new_cls;
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
+        unsigned num_resolvents(literal l, unsigned max_count);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
         void add_non_learned_binary_clause(literal l1, literal l2);
         void remove_bin_clauses(literal l);
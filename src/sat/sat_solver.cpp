@@ -26,6 +26,8 @@ Revision History:
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/thread_pool.h"
+#include "util/scoped_profile.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
@@ -108,6 +110,10 @@ namespace sat {
     }
 
     void solver::set_extension(extension* ext) {
+        if (m_xor_gauss && ext != m_xor_gauss) {
+            m_xor_gauss->detach();
+            m_xor_gauss = nullptr;
+        }
         m_ext = ext;
         if (ext) {
             ext->set_solver(this);
@@ -711,10 +717,12 @@ namespace sat {
     }
 
     void solver::defrag_clauses() {
-        m_defrag_threshold = 2;
+        m_defrag_threshold = m_config.m_gc_defrag_interval;
         if (memory_pressure()) return;
         pop(scope_lvl());
-        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
+        IF_VERBOSE(2, verbose_stream() << "(sat-defrag :clauses " << m_clauses.size() << " :learned " << m_learned.size() 
+                   << " :bytes " << cls_allocator().get_allocation_size() << ")\n");
+
         clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
         ptr_vector<clause> new_clauses, new_learned;
         for (clause* c : m_clauses) c->unmark_used();
@@ -756,18 +764,42 @@ namespace sat {
         for (clause* c : m_clauses) {
             if (!c->was_used()) {
                 SASSERT(c->size() == 3);
-                new_clauses.push_back(alloc.copy_clause(*c));
+                clause* c2 = alloc.copy_clause(*c);
+                new_clauses.push_back(c2);
+                c->mark_used();
+                c->set_new_offset(get_offset(*c2));
             }
-            dealloc_clause(c);
         }
 
         for (clause* c : m_learned) {
             if (!c->was_used()) {
                 SASSERT(c->size() == 3);
-                new_learned.push_back(alloc.copy_clause(*c));
+                clause* c2 = alloc.copy_clause(*c);
+                new_learned.push_back(c2);
+                c->mark_used();
+                c->set_new_offset(get_offset(*c2));
             }
-            dealloc_clause(c);
         }
+
+        // clause reasons of base level literals refer to the allocator that is released below.
+        // They are relocated with their clauses, so the reasons seen by proof checking
+        // and drup trimming are unchanged. A reason that is not among the clauses is
+        // turned into a unit justification, as is done by assign_unit.
+        for (literal lit : m_trail) {
+            justification& j = m_justification[lit.var()];
+            if (!j.is_clause())
+                continue;
+            clause& c = get_clause(j);
+            if (c.was_used())
+                j = justification(j.level(), c.get_new_offset());
+            else
+                j = justification(0);
+        }
+
+        for (clause* c : m_clauses)
+            dealloc_clause(c);
+        for (clause* c : m_learned)
+            dealloc_clause(c);
         m_clauses.swap(new_clauses);
         m_learned.swap(new_learned);
 
@@ -961,6 +993,7 @@ namespace sat {
         
         switch (m_config.m_branching_heuristic) {
         case BH_VSIDS: 
+        case BH_VMTF:
             break;
         case BH_CHB:
             m_last_propagation[v] = m_stats.m_conflict;
@@ -993,6 +1026,9 @@ namespace sat {
         SASSERT(l.sign()  || value(v) == l_true);
         SASSERT(value(l) == l_true);
         SASSERT(value(~l) == l_false);
+
+        if (!m_saved_trail.empty())
+            replay_saved_trail(l);
     }
 
     lbool solver::status(clause const & c) const {
@@ -1040,6 +1076,7 @@ namespace sat {
     }
 
     bool solver::propagate(bool update) {
+        scoped_profile _profile("sat.propagate");
         unsigned qhead = m_qhead;
         bool r = propagate_core(update);
         if (m_config.m_branching_heuristic == BH_CHB) {
@@ -1146,7 +1183,18 @@ namespace sat {
                 unsigned assign_level = curr_level;
                 unsigned max_index = 1;
                 for (; l_it != l_end; ++l_it) {
-                    if (value(*l_it) != l_false) {
+                    lbool val = value(*l_it);
+                    if (val == l_true && lvl(*l_it) <= curr_level) {
+                        // the clause is satisfied at a level that is not above not_l:
+                        // keep watching not_l, but use the true literal as blocker so
+                        // that the next visit neither touches the clause memory nor
+                        // moves the watch. Backtracking cannot unassign the blocker
+                        // without also unassigning not_l.
+                        it2->set_clause(*l_it, cls_off);
+                        it2++;
+                        goto end_clause_case;
+                    }
+                    if (val != l_false) {
                         c[1] = *l_it;
                         *l_it = not_l;
                         DEBUG_CODE(for (auto const& w : m_watches[(~c[1]).index()]) VERIFY(!w.is_clause() || w.get_clause_offset() != cls_off););
@@ -1276,6 +1324,7 @@ namespace sat {
     //
     // -----------------------
     lbool solver::check(unsigned num_lits, literal const* lits) {
+        scoped_profile _profile("sat.check");
         init_reason_unknown();
         pop_to_base_level();
         m_stats.m_units = init_trail_size();
@@ -1550,13 +1599,7 @@ namespace sat {
             return l_undef;
         }
 
-        vector<std::thread> threads(num_threads);
-        for (int i = 0; i < num_threads; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (auto & th : threads) {
-            th.join();
-        }
+        thread_pool::run(num_threads, worker_thread);
         
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
@@ -1663,7 +1706,7 @@ namespace sat {
     }
     
     bool solver::guess(bool_var next) {
-        lbool lphase = m_ext ? m_ext->get_phase(next) : l_undef;
+        lbool lphase = (m_ext && !m_config.m_rephase_theory) ? m_ext->get_phase(next) : l_undef;
 
         if (lphase != l_undef)
             return lphase == l_true;
@@ -1766,6 +1809,7 @@ namespace sat {
     }
 
     lbool solver::final_check() {
+        scoped_profile _profile("sat.final_check");
         if (m_ext) {
             switch (m_ext->check()) {
             case check_result::CR_DONE:
@@ -1950,7 +1994,7 @@ namespace sat {
         m_restart_threshold       = m_config.m_restart_initial;
         m_luby_idx                = 1;
         m_gc_threshold            = m_config.m_gc_initial;
-        m_defrag_threshold        = 2;
+        m_defrag_threshold        = m_config.m_gc_defrag_interval;
         m_restarts                = 0;
         m_last_position_log       = 0;
         m_restart_logs            = 0;
@@ -1962,12 +2006,16 @@ namespace sat {
         if (m_learned.size() <= 2*m_clauses.size())
             m_conflicts_since_gc      = 0;
         m_restart_next_out        = 0;
+        m_mode_switch_interval    = m_config.m_branching_mode_switch;
+        m_next_mode_switch        = m_mode_switch_interval;
         m_asymm_branch.init_search();
         m_stopwatch.reset();
         m_stopwatch.start();
+        m_next_stats_snapshot     = 0;
         m_core.reset();
         m_min_core_valid = false;
         m_min_core.reset();
+        reset_saved_trail();
         m_simplifier.init_search();
         m_mc.init_search(*this);
         if (m_ext)
@@ -1978,6 +2026,61 @@ namespace sat {
     bool solver::should_simplify() const {
         return m_conflicts_since_init >= m_next_simplify && m_simplify_enabled;
     }
+
+    void solver::get_inprocess_size(inprocess_size& sz) const {
+        sz.m_units = m_trail.size();
+        sz.m_clauses = m_clauses.size() + m_learned.size();
+        sz.m_eliminated = 0;
+        for (bool e : m_eliminated)
+            sz.m_eliminated += e;
+        sz.m_literals = 0;
+        for (clause* c : m_clauses)
+            sz.m_literals += c->size();
+        for (clause* c : m_learned)
+            sz.m_literals += c->size();
+    }
+
+    /**
+       \brief run an inprocessing technique and account for its cost and yield.
+       The yield is the sum of new units, removed clauses, eliminated variables
+       and removed literals. Each is counted separately, so clauses added by a
+       technique do not cancel out clauses it removed.
+       With inprocess.adaptive, a technique without yield is skipped for a
+       number of rounds that doubles with every unproductive run.
+    */
+    template<typename F>
+    void solver::inprocess(inprocess_kind k, F const& f) {
+        inprocess_info& info = m_inprocess[k];
+        if (m_config.m_inprocess_adaptive && m_simplifications < info.m_next) {
+            info.m_skips++;
+            return;
+        }
+        inprocess_size sz, new_sz;
+        get_inprocess_size(sz);
+        stopwatch sw;
+        sw.start();
+        f();
+        sw.stop();
+        get_inprocess_size(new_sz);
+        auto inc = [](unsigned a, unsigned b) { return a > b ? a - b : 0; };
+        unsigned units = inc(new_sz.m_units, sz.m_units);
+        unsigned clauses = inc(sz.m_clauses, new_sz.m_clauses);
+        unsigned eliminated = inc(new_sz.m_eliminated, sz.m_eliminated);
+        unsigned literals = inc(sz.m_literals, new_sz.m_literals);
+        unsigned yield = units + clauses + eliminated + literals;
+        info.m_runs++;
+        info.m_units += units;
+        info.m_clauses += clauses;
+        info.m_eliminated += eliminated;
+        info.m_literals += literals;
+        info.m_yield += yield;
+        info.m_time += sw.get_seconds();
+        if (yield > 0)
+            info.m_backoff = 0;
+        else
+            info.m_backoff = std::min(64u, std::max(1u, 2 * info.m_backoff));
+        info.m_next = m_simplifications + info.m_backoff + 1;
+    }
     /**
        \brief Apply all simplifications.
     */
@@ -1985,12 +2088,15 @@ namespace sat {
         if (!should_simplify()) {
             return;
         }
+        scoped_profile _profile("sat.simplify");
         log_stats();
         m_simplifications++;
 
         TRACE("sat", tout << "simplify\n";);
 
         pop(scope_lvl());
+        // inprocessing removes clauses and eliminates variables the saved reasons refer to.
+        reset_saved_trail();
         struct report {
             solver&   s;
             stopwatch m_watch;
@@ -2010,22 +2116,23 @@ namespace sat {
         m_cleaner(m_config.m_force_cleanup);
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_scc();
+        inprocess(ip_scc, [&]() { m_scc(); });
         CASSERT("sat_simplify_bug", check_invariant());
 
         if (m_ext) {
             m_ext->pre_simplify();
         }
       
-        m_simplifier(false);
-
-        CASSERT("sat_simplify_bug", check_invariant());
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        if (!m_learned.empty()) {
-            m_simplifier(true);
-            CASSERT("sat_missed_prop", check_missed_propagation());
+        inprocess(ip_simplify, [&]() {
+            m_simplifier(false);
             CASSERT("sat_simplify_bug", check_invariant());
-        }
+            CASSERT("sat_missed_prop", check_missed_propagation());
+            if (!m_learned.empty()) {
+                m_simplifier(true);
+                CASSERT("sat_missed_prop", check_missed_propagation());
+                CASSERT("sat_simplify_bug", check_invariant());
+            }
+        });
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
 
@@ -2036,10 +2143,10 @@ namespace sat {
             m_ext->simplify();
         }
 
-        m_probing();
+        inprocess(ip_probing, [&]() { m_probing(); });
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        inprocess(ip_asymm_branch, [&]() { m_asymm_branch(false); });
 
         if (m_config.m_lookahead_simplify && !m_ext) {
             lookahead lh(*this);
@@ -2067,20 +2174,31 @@ namespace sat {
         }
 
         if (m_config.m_binspr && !inconsistent()) {
-            m_binspr();
+            inprocess(ip_binspr, [&]() { m_binspr(); });
         }
 
         if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
-            anf_simplifier anf(*this);
-            anf_simplifier::config cfg;
-            cfg.m_enable_exlin = m_config.m_anf_exlin;
-            anf();
-            anf.collect_statistics(m_aux_stats);
-            // TBD: throttle anf_delay based on yield
+            inprocess(ip_anf, [&]() {
+                anf_simplifier anf(*this);
+                anf_simplifier::config cfg;
+                cfg.m_enable_exlin = m_config.m_anf_exlin;
+                anf();
+                anf.collect_statistics(m_aux_stats);
+            });
         }
         
         if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
-            (*m_cut_simplifier)();
+            inprocess(ip_cut, [&]() { (*m_cut_simplifier)(); });
+        }
+
+        if (m_config.m_xor_gauss && !m_ext && !m_config.m_drat && m_user_scope_literals.empty() && !inconsistent()) {
+            xor_gauss* xg = alloc(xor_gauss, *this);
+            if (xg->init()) {
+                set_extension(xg);
+                m_xor_gauss = xg;
+            }
+            else 
+                dealloc(xg);
         }
 
         if (m_config.m_inprocess_out.is_non_empty_string()) {
@@ -2309,9 +2427,34 @@ namespace sat {
         IF_VERBOSE(1, verbose_stream() << str);            
     }
 
-    void solver::do_restart(bool to_base) {        
+    /**
+       \brief append the statistics, including the rates of conflicts and
+       propagations since the start of the search, as a JSON line to
+       the file given by sat.stats.file.
+    */
+    void solver::snapshot_stats() {
+        double secs = m_stopwatch.get_current_seconds();
+        if (!m_config.m_stats_file.is_non_empty_string() || secs < m_next_stats_snapshot)
+            return;
+        m_next_stats_snapshot = secs + m_config.m_stats_interval / 1000.0;
+        statistics st;
+        collect_statistics(st);
+        get_memory_statistics(st);
+        st.update("time", secs);
+        if (secs > 0) {
+            st.update("conflicts/s", m_stats.m_conflict / secs);
+            st.update("propagations/s", m_stats.m_propagate / secs);
+        }
+        std::ofstream out(m_config.m_stats_file.str(), std::ios::app);
+        out << "{\"solver\": \"sat\", \"stats\": ";
+        st.display_json(out) << "}\n";
+    }
+
+    void solver::do_restart(bool to_base) {
+        scoped_profile _profile("sat.restart");
         m_stats.m_restart++;
         m_restarts++;
+        snapshot_stats();
         if (m_conflicts_since_init >= m_restart_next_out && get_verbosity_level() >= 1) {
             if (0 == m_restart_next_out) {
                 m_restart_next_out = 1;
@@ -2324,10 +2467,32 @@ namespace sat {
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
         IF_VERBOSE(30, display_status(verbose_stream()););
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
+        if (should_switch_mode())
+            do_switch_mode();
+        flet<bool> _save_trail(m_save_trail, m_config.m_restart_save_trail);
         pop_reinit(restart_level(to_base));
         set_next_restart();        
     }
 
+    bool solver::should_switch_mode() const {
+        return
+            m_config.m_branching_heuristic == BH_VMTF &&
+            m_mode_switch_interval > 0 &&
+            m_conflicts_since_init >= m_next_mode_switch;
+    }
+
+    /**
+       \brief Alternate between VMTF, which focuses on the variables of recent
+       conflicts, and VSIDS, which is more stable.
+    */
+    void solver::do_switch_mode() {
+        m_case_split_queue.set_vmtf(!m_case_split_queue.is_vmtf());
+        m_mode_switch_interval *= 2;
+        m_next_mode_switch = m_conflicts_since_init + m_mode_switch_interval;
+        m_stats.m_mode_switch++;
+        IF_VERBOSE(2, verbose_stream() << "(sat.switch-mode " << (m_case_split_queue.is_vmtf() ? "vmtf" : "vsids") << ")\n");
+    }
+
     unsigned solver::restart_level(bool to_base) {
         SASSERT(!m_case_split_queue.empty());
         if (to_base || scope_lvl() == search_lvl()) 
@@ -2352,6 +2517,9 @@ namespace sat {
             unsigned n = search_lvl();
             for (; n < scope_lvl() && m_case_split_queue.more_active(scope_literal(n).var(), next); ++n) {
             }
+            // with trail saving, keep the prefix of decisions that are more active than next.
+            if (m_config.m_restart_save_trail)
+                return scope_lvl() - n;
             return n - search_lvl();
         }
     }
@@ -2391,6 +2559,7 @@ namespace sat {
     // -----------------------
 
     bool solver::resolve_conflict() {
+        scoped_profile _profile("sat.conflict");
         while (true) {
             lbool r = resolve_conflict_core();
             CASSERT("sat_check_marks", check_marks());
@@ -2408,6 +2577,11 @@ namespace sat {
         m_conflicts_since_restart++;
         m_conflicts_since_gc++;
         m_stats.m_conflict++;
+        if ((m_conflicts_since_gc & 0x3F) == 0 && m_conflicts_since_gc <= m_gc_threshold && memory::under_pressure()) {
+            // collect learned clauses early instead of running into the memory limit.
+            m_conflicts_since_gc = m_gc_threshold + 1;
+            m_stats.m_gc_memory++;
+        }
         if (m_step_size > m_config.m_step_size_min) {
             m_step_size -= m_config.m_step_size_dec;
         }
@@ -2581,6 +2755,8 @@ namespace sat {
         
         if (m_config.m_minimize_lemmas) {
             minimize_lemma();
+            if (m_config.m_shrink_lemmas)
+                shrink_lemma();
             reset_lemma_var_marks();
             if (m_config.m_dyn_sub_res)
                 dyn_sub_res();
@@ -2625,6 +2801,7 @@ namespace sat {
             ++m_stats.m_backtracks;
             pop_reinit(m_scope_lvl - backtrack_lvl + 1);
         }
+        unsigned num_learned = m_learned.size();
         clause * lemma = mk_clause_core(m_lemma.size(), m_lemma.data(), sat::status::redundant());
         if (lemma) {
             lemma->set_glue(glue);
@@ -2632,6 +2809,8 @@ namespace sat {
         if (m_par && lemma) {
             m_par->share_clause(*this, *lemma);
         }
+        if (m_config.m_lemma_subsumption > 0)
+            subsume_recent_lemmas(num_learned);
         m_lemma.reset();
         TRACE("sat_conflict_detail", tout << "consistent " << (!m_inconsistent) << " scopes: " << scope_lvl() << " backtrack: " << backtrack_lvl << " backjump: " << backjump_lvl << "\n";);
         decay_activity();
@@ -2655,6 +2834,9 @@ namespace sat {
         if (!is_marked(var)) {
             mark(var);
             m_unmark.push_back(var);
+            if (value(var) != l_undef && lvl(var) == m_conflict_lvl) {
+                m_num_core_marks++;
+            }
             if (is_assumption(antecedent)) {
                 m_core.push_back(antecedent);
             }
@@ -2739,6 +2921,7 @@ namespace sat {
 
         unsigned old_size = m_unmark.size();
         int idx = skip_literals_above_conflict_level();
+        m_num_core_marks = 0;
 
         literal consequent = m_not_l;
         if (m_not_l != null_literal) {
@@ -2761,6 +2944,11 @@ namespace sat {
         int init_sz = init_trail_size();
         while (true) {
             process_consequent_for_unsat_core(consequent, js);
+            // stop as soon as every marked literal at the conflict level
+            // is resolved instead of scanning the rest of the trail.
+            if (m_num_core_marks == 0) {
+                break;
+            }
             while (idx >= init_sz) {
                 consequent = m_trail[idx];
                 if (is_marked(consequent.var()) && lvl(consequent) == m_conflict_lvl)
@@ -2771,6 +2959,8 @@ namespace sat {
                 break;
             }
             SASSERT(lvl(consequent) == m_conflict_lvl);
+            SASSERT(m_num_core_marks > 0);
+            m_num_core_marks--;
             js = m_justification[consequent.var()];
             idx--;
         }
@@ -2863,6 +3053,7 @@ namespace sat {
             mark(var);
             switch (m_config.m_branching_heuristic) {
             case BH_VSIDS:
+            case BH_VMTF:
                 inc_activity(var);
                 break;
             case BH_CHB:
@@ -2995,6 +3186,14 @@ namespace sat {
             UNREACHABLE();
             break;
         }
+        if (m_config.m_rephase_theory && m_ext && (m_rephase_inc / std::max(1u, m_config.m_rephase_base)) % 2 == 1) {
+            // overlay the phases suggested by the theories, e.g., the current arithmetic model.
+            for (bool_var v = 0; v < num_vars(); ++v) {
+                lbool ph = m_ext->get_phase(v);
+                if (ph != l_undef)
+                    m_phase[v] = ph == l_true;
+            }
+        }
         m_rephase_inc += m_config.m_rephase_base;
         m_rephase_lim += m_rephase_inc;
     }
@@ -3302,11 +3501,143 @@ namespace sat {
         return j < sz;
     }
 
+    /**
+       \brief Shrink m_lemma: the literals of a decision level below the conflict level
+       are replaced by the unique implication point of that level, when they can be
+       resolved to it using only reasons whose other literals are at the same level,
+       at the base level, or already in the lemma.
+       See Fleury and Biere, Efficient All-UIP Learned Clause Minimization, SAT 2021.
+    */
+    void solver::shrink_lemma() {
+        unsigned sz = m_lemma.size();
+        if (sz <= 2)
+            return;
+        // the literals of each level form a block, the highest level first.
+        std::sort(m_lemma.begin() + 1, m_lemma.end(), [&](literal a, literal b) { return lvl(a) > lvl(b); });
+        unsigned j = 1;
+        for (unsigned i = 1; i < sz; ) {
+            unsigned level = lvl(m_lemma[i]);
+            unsigned k = i + 1;
+            while (k < sz && lvl(m_lemma[k]) == level)
+                ++k;
+            literal uip = (k - i > 1 && level > 0) ? shrink_level(level, i, k) : null_literal;
+            if (uip == null_literal) {
+                for (; i < k; ++i)
+                    m_lemma[j++] = m_lemma[i];
+                continue;
+            }
+            for (; i < k; ++i)
+                if (m_lemma[i].var() != uip.var())
+                    reset_mark(m_lemma[i].var());
+            if (!is_marked(uip.var()))
+                mark(uip.var());
+            m_lemma[j++] = ~uip;
+        }
+        m_stats.m_shrunk_lits += sz - j;
+        m_lemma.shrink(j);
+    }
+
+    /**
+       \brief Return the unique implication point of the lemma literals m_lemma[begin..end)
+       assigned at level, or null_literal if it cannot be reached.
+    */
+    literal solver::shrink_level(unsigned level, unsigned begin, unsigned end) {
+        init_visited();
+        for (unsigned i = begin; i < end; ++i)
+            mark_visited(m_lemma[i].var());
+        unsigned open = end - begin;
+        auto visit = [&](literal antecedent) {
+            bool_var w = antecedent.var();
+            unsigned l = lvl(w);
+            if (l == 0 || is_visited(w))
+                return true;
+            if (l == level) {
+                mark_visited(w);
+                ++open;
+                return true;
+            }
+            return is_marked(w);
+        };
+        unsigned lo = m_scopes[level - 1].m_trail_lim;
+        unsigned hi = level < scope_lvl() ? m_scopes[level].m_trail_lim : m_trail.size();
+        for (unsigned idx = hi; idx-- > lo; ) {
+            literal t = m_trail[idx];
+            bool_var v = t.var();
+            if (lvl(v) != level || !is_visited(v))
+                continue;
+            if (open == 1)
+                return t;
+            --open;
+            justification js = m_justification[v];
+            switch (js.get_kind()) {
+            case justification::NONE:
+                return null_literal;
+            case justification::BINARY:
+                if (!visit(js.get_literal()))
+                    return null_literal;
+                break;
+            case justification::TERNARY:
+                if (!visit(js.get_literal1()) || !visit(js.get_literal2()))
+                    return null_literal;
+                break;
+            case justification::CLAUSE: {
+                clause& c = get_clause(js);
+                for (literal l : c)
+                    if (l != t && !visit(l))
+                        return null_literal;
+                break;
+            }
+            case justification::EXT_JUSTIFICATION:
+                fill_ext_antecedents(t, js, false);
+                for (literal l : m_ext_antecedents)
+                    if (!visit(l))
+                        return null_literal;
+                break;
+            }
+        }
+        return null_literal;
+    }
+
+    /**
+       \brief Delete the clauses among the last m_config.m_lemma_subsumption clauses
+       of m_learned[0..num_learned) that are subsumed by the new lemma.
+       The lemma is added first, so the deletions are valid for DRAT.
+    */
+    void solver::subsume_recent_lemmas(unsigned num_learned) {
+        unsigned lo = num_learned - std::min(num_learned, m_config.m_lemma_subsumption);
+        if (lo == num_learned)
+            return;
+        for (literal l : m_lemma)
+            mark_lit(l);
+        unsigned j = lo;
+        for (unsigned i = lo; i < m_learned.size(); ++i) {
+            clause* c = m_learned[i];
+            bool subsumed = false;
+            if (i < num_learned && c->size() >= m_lemma.size() && !c->frozen() && !c->was_removed()) {
+                unsigned num_marked = 0;
+                for (literal l : *c)
+                    num_marked += is_marked_lit(l);
+                subsumed = num_marked == m_lemma.size() && can_delete(*c);
+            }
+            if (subsumed) {
+                detach_clause(*c);
+                del_clause(*c);
+                m_stats.m_subsumed_lemmas++;
+            }
+            else {
+                m_learned[j++] = c;
+            }
+        }
+        m_learned.shrink(j);
+        for (literal l : m_lemma)
+            unmark_lit(l);
+    }
+
     /**
        \brief Reset the mark of the variables in the current lemma.
     */
     void solver::reset_lemma_var_marks() {
-        if (m_config.m_branching_heuristic == BH_VSIDS) {
+        if (m_config.m_branching_heuristic != BH_CHB) {
             update_lrb_reasoned();
         }        
         literal_vector::iterator it  = m_lemma.begin();
@@ -3619,6 +3950,11 @@ namespace sat {
         unsigned new_lvl = scope_lvl() - num_scopes;
         scope & s        = m_scopes[new_lvl];
         m_inconsistent   = false; // TBD: use model seems to make this redundant: s.m_inconsistent;
+        // saved literals must not refer to variables that are freed for reuse.
+        if (m_save_trail && m_vars_to_free.empty())
+            save_trail(new_lvl);
+        else if (!m_saved_trail.empty())
+            reset_saved_trail();
         unassign_vars(s.m_trail_lim, new_lvl);
         for (bool_var v : m_vars_to_free)
             m_case_split_queue.del_var_eh(v);
@@ -3662,6 +3998,105 @@ namespace sat {
         m_replay_assign.reset();
     }
 
+    /**
+       \brief Save the literals assigned above new_lvl with their justifications.
+       After the restart they are assigned again by replay_saved_trail.
+    */
+    void solver::save_trail(unsigned new_lvl) {
+        reset_saved_trail();
+        m_saved_index.reserve(num_vars(), UINT_MAX);
+        for (unsigned i = m_scopes[new_lvl].m_trail_lim; i < m_trail.size(); ++i) {
+            literal l = m_trail[i];
+            if (lvl(l) <= new_lvl)
+                continue;
+            m_saved_index[l.var()] = m_saved_trail.size();
+            m_saved_trail.push_back(std::make_pair(l, m_justification[l.var()]));
+        }
+    }
+
+    void solver::reset_saved_trail() {
+        for (auto const& p : m_saved_trail)
+            m_saved_index[p.first.var()] = UINT_MAX;
+        m_saved_trail.reset();
+    }
+
+    /**
+       \brief l was assigned. If l is on the saved trail, assign the literals that
+       follow it up to the next decision, as long as their reasons are unit again.
+       The reasons are checked directly, so propagation does not need to find them.
+    */
+    void solver::replay_saved_trail(literal l) {
+        bool_var v = l.var();
+        if (v >= m_saved_index.size())
+            return;
+        unsigned i = m_saved_index[v];
+        if (i == UINT_MAX || m_saved_trail[i].first != l)
+            return;
+        m_saved_index[v] = UINT_MAX;
+        for (++i; i < m_saved_trail.size(); ++i) {
+            literal lit = m_saved_trail[i].first;
+            justification js = m_saved_trail[i].second;
+            if (js.is_none())
+                break;
+            if (value(lit) == l_true)
+                continue;
+            unsigned level = 0;
+            if (value(lit) == l_false || was_eliminated(lit) || !is_unit_reason(lit, js, level))
+                break;
+            m_saved_index[lit.var()] = UINT_MAX;
+            switch (js.get_kind()) {
+            case justification::BINARY:
+                js = justification(level, js.get_literal());
+                break;
+            case justification::TERNARY:
+                js = justification(level, js.get_literal1(), js.get_literal2());
+                break;
+            default:
+                js = justification(level, js.get_clause_offset());
+                break;
+            }
+            ++m_stats.m_trail_replay;
+            assign_core(lit, js);
+        }
+    }
+
+    /**
+       \brief Check that the saved justification js of l is unit under the current assignment:
+       the other literals of its clause are false. Set level to their maximal level.
+    */
+    bool solver::is_unit_reason(literal l, justification const& js, unsigned& level) {
+        switch (js.get_kind()) {
+        case justification::BINARY:
+            if (was_eliminated(js.get_literal()) || value(js.get_literal()) != l_false)
+                return false;
+            level = lvl(js.get_literal());
+            return true;
+        case justification::TERNARY:
+            if (was_eliminated(js.get_literal1()) || was_eliminated(js.get_literal2()) ||
+                value(js.get_literal1()) != l_false || value(js.get_literal2()) != l_false)
+                return false;
+            level = std::max(lvl(js.get_literal1()), lvl(js.get_literal2()));
+            return true;
+        case justification::CLAUSE: {
+            clause const& c = get_clause(js);
+            // conflict analysis expects the consequent among the watched literals.
+            if (c.was_removed() || (c[0] != l && c[1] != l))
+                return false;
+            level = 0;
+            for (literal lit : c) {
+                if (lit == l)
+                    continue;
+                if (value(lit) != l_false)
+                    return false;
+                level = std::max(level, lvl(lit));
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
     void solver::reinit_clauses(unsigned old_sz) {
         unsigned sz = m_clauses_to_reinit.size();
         SASSERT(old_sz <= sz);
@@ -3757,6 +4192,7 @@ namespace sat {
     void solver::updt_params(params_ref const & p) {
         m_params.append(p);
         m_config.updt_params(p);
+        m_case_split_queue.set_vmtf(m_config.m_branching_heuristic == BH_VMTF);
         m_simplifier.updt_params(p);
         m_asymm_branch.updt_params(p);
         m_probing.updt_params(p);
@@ -3794,10 +4230,43 @@ namespace sat {
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
         st.copy(m_aux_stats);
+#define INPROCESS_NAMES(k)                                                  \
+        { "sat inprocess " k " runs", "sat inprocess " k " skips",          \
+          "sat inprocess " k " units", "sat inprocess " k " removed clauses", \
+          "sat inprocess " k " eliminated vars", "sat inprocess " k " removed literals", \
+          "sat inprocess " k " yield", "sat inprocess " k " time" }
+        static char const* names[ip_num_kinds][8] = {
+            INPROCESS_NAMES("scc"),
+            INPROCESS_NAMES("simplify"),
+            INPROCESS_NAMES("probing"),
+            INPROCESS_NAMES("asymm"),
+            INPROCESS_NAMES("binspr"),
+            INPROCESS_NAMES("anf"),
+            INPROCESS_NAMES("cut"),
+        };
+#undef INPROCESS_NAMES
+        for (unsigned k = 0; k < ip_num_kinds; ++k) {
+            inprocess_info const& info = m_inprocess[k];
+            if (info.m_runs == 0 && info.m_skips == 0)
+                continue;
+            st.update(names[k][0], info.m_runs);
+            st.update(names[k][1], info.m_skips);
+            st.update(names[k][2], info.m_units);
+            st.update(names[k][3], info.m_clauses);
+            st.update(names[k][4], info.m_eliminated);
+            st.update(names[k][5], info.m_literals);
+            st.update(names[k][6], info.m_yield);
+            st.update(names[k][7], info.m_time);
+        }
     }
 
     void solver::reset_statistics() {
         m_stats.reset();
+        for (inprocess_info& info : m_inprocess) {
+            info.m_runs = info.m_skips = info.m_yield = 0;
+            info.m_units = info.m_clauses = info.m_eliminated = info.m_literals = 0;
+            info.m_time = 0;
+        }
         m_cleaner.reset_statistics();
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
@@ -3812,7 +4281,7 @@ namespace sat {
     // -----------------------
 
     void solver::rescale_activity() {
-        SASSERT(m_config.m_branching_heuristic == BH_VSIDS);
+        SASSERT(m_config.m_branching_heuristic != BH_CHB);
         for (unsigned& act : m_activity) {
             act >>= 14;
         }
@@ -4151,6 +4620,7 @@ namespace sat {
         if (m_conflicts_since_init == 0 && !force)
             return false;
         if (at_base_lvl() && !inconsistent() && m_cleaner(force)) {
+            reset_saved_trail();
             if (m_ext)
                 m_ext->clauses_modifed();
             return true;
@@ -4161,6 +4631,7 @@ namespace sat {
     void solver::simplify(bool redundant) {
         if (!at_base_lvl() || inconsistent())
             return;
+        reset_saved_trail();
         m_simplifier(redundant);
         m_simplifier.finalize();
         if (m_ext)
@@ -4170,6 +4641,7 @@ namespace sat {
     unsigned solver::scc_bin() {
         if (!at_base_lvl() || inconsistent())
             return 0;
+        reset_saved_trail();
         unsigned r = m_scc();
         if (r > 0 && m_ext)
             m_ext->clauses_modifed();
@@ -4771,6 +5243,7 @@ namespace sat {
         st.update("sat mk clause nary", m_mk_clause);
         st.update("sat mk var", m_mk_var);
         st.update("sat gc clause", m_gc_clause);
+        st.update("sat gc memory", m_gc_memory);
         st.update("sat del clause", m_del_clause);
         st.update("sat conflicts", m_conflict);
         st.update("sat decisions", m_decision);
@@ -4786,6 +5259,10 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat trail replays", m_trail_replay);
+        st.update("sat mode switches", m_mode_switch);
+        st.update("sat shrunk lits", m_shrunk_lits);
+        st.update("sat subsumed lemmas", m_subsumed_lemmas);
     }
 
     void stats::reset() {
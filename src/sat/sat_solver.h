@@ -39,6 +39,7 @@ Revision History:
 #include "sat/sat_scc.h"
 #include "sat/sat_asymm_branch.h"
 #include "sat/sat_cut_simplifier.h"
+#include "sat/sat_xor_gauss.h"
 #include "sat/sat_probing.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_binspr.h"
@@ -68,6 +69,7 @@ namespace sat {
         unsigned m_decision;
         unsigned m_restart;
         unsigned m_gc_clause;
+        unsigned m_gc_memory;
         unsigned m_del_clause;
         unsigned m_minimized_lits;
         unsigned m_dyn_sub_res;
@@ -77,6 +79,10 @@ namespace sat {
         unsigned m_elim_var_bdd;
         unsigned m_units;
         unsigned m_backtracks;
+        unsigned m_trail_replay;
+        unsigned m_mode_switch;
+        unsigned m_shrunk_lits;
+        unsigned m_subsumed_lemmas;
         unsigned m_backjumps;
         stats() { reset(); }
         void reset();
@@ -98,6 +104,7 @@ namespace sat {
         stats                   m_stats;
         scoped_ptr<extension>   m_ext;
         scoped_ptr<cut_simplifier> m_cut_simplifier;
+        xor_gauss*              m_xor_gauss { nullptr }; // owned by m_ext when attached
         parallel*               m_par;
         drat                    m_drat;          // DRAT for generating proofs
         clause_allocator        m_cls_allocator[2];
@@ -137,6 +144,10 @@ namespace sat {
         unsigned_vector         m_touched;
         unsigned                m_touch_index;
         literal_vector          m_replay_assign;
+        // literals popped by the last restart, with their justifications.
+        svector<std::pair<literal, justification>> m_saved_trail;
+        unsigned_vector         m_saved_index;  // variable -> position in m_saved_trail
+        bool                    m_save_trail { false };
         // branch variable selection:
         svector<unsigned>       m_activity;
         unsigned                m_activity_inc;
@@ -205,6 +216,30 @@ namespace sat {
 
         statistics              m_aux_stats;
 
+        // cost and yield of the inprocessing techniques run by do_simplify.
+        enum inprocess_kind {
+            ip_scc, ip_simplify, ip_probing, ip_asymm_branch, ip_binspr, ip_anf, ip_cut, ip_num_kinds
+        };
+        struct inprocess_size {
+            unsigned m_units { 0 };
+            unsigned m_clauses { 0 };
+            unsigned m_eliminated { 0 };
+            unsigned m_literals { 0 };
+        };
+        struct inprocess_info {
+            unsigned m_runs { 0 };
+            unsigned m_skips { 0 };
+            unsigned m_units { 0 };      // new units
+            unsigned m_clauses { 0 };    // removed clauses
+            unsigned m_eliminated { 0 }; // eliminated variables
+            unsigned m_literals { 0 };   // removed literals
+            unsigned m_yield { 0 };
+            unsigned m_backoff { 0 };
+            unsigned m_next { 0 };    // first simplification round where the technique runs again
+            double   m_time { 0 };
+        };
+        inprocess_info          m_inprocess[ip_num_kinds];
+
         void del_clauses(clause_vector& clauses);
 
         friend class integrity_checker;
@@ -288,7 +323,7 @@ namespace sat {
         inline clause_allocator& cls_allocator() { return m_cls_allocator[m_cls_allocator_idx]; }
         inline clause_allocator const& cls_allocator() const { return m_cls_allocator[m_cls_allocator_idx]; }
         inline clause * alloc_clause(unsigned num_lits, literal const * lits, bool learned) { return cls_allocator().mk_clause(num_lits, lits, learned); }
-        inline void dealloc_clause(clause* c) { cls_allocator().del_clause(c); }
+        inline void dealloc_clause(clause* c) { if (!m_saved_trail.empty()) reset_saved_trail(); cls_allocator().del_clause(c); }
         struct cmp_activity;
         void defrag_clauses();
         bool should_defrag();
@@ -528,6 +563,8 @@ namespace sat {
         unsigned m_conflicts_since_init { 0 };
         unsigned m_restarts { 0 };
         unsigned m_restart_next_out { 0 };
+        unsigned m_mode_switch_interval { 0 };
+        unsigned m_next_mode_switch { 0 };
         unsigned m_conflicts_since_restart { 0 };
         bool     m_force_conflict_analysis { false };
         unsigned m_simplifications { 0 };
@@ -565,6 +602,9 @@ namespace sat {
         bool is_assumption(literal l) const;
         bool should_simplify() const;
         void do_simplify();
+        void get_inprocess_size(inprocess_size& sz) const;
+        template<typename F>
+        void inprocess(inprocess_kind k, F const& f);
         void mk_model();
         bool check_model(model const & m) const;
         void do_restart(bool to_base);
@@ -572,7 +612,11 @@ namespace sat {
         unsigned m_last_position_log;
         unsigned m_restart_logs;
         unsigned restart_level(bool to_base);
+        bool should_switch_mode() const;
+        void do_switch_mode();
         void log_stats();
+        double m_next_stats_snapshot { 0 };
+        void snapshot_stats();
         bool should_cancel();
         bool should_restart() const;
         void set_next_restart();
@@ -637,6 +681,7 @@ namespace sat {
         // -----------------------
     protected:
         unsigned       m_conflict_lvl;
+        unsigned       m_num_core_marks { 0 }; // marked literals at conflict level not yet visited by core extraction
         literal_vector m_lemma;
         literal_vector m_ext_antecedents;
         bool use_backjumping(unsigned num_scopes) const;
@@ -682,6 +727,9 @@ namespace sat {
         void reset_unmark(unsigned old_size);
         void updt_lemma_lvl_set();
         bool minimize_lemma();
+        void shrink_lemma();
+        void subsume_recent_lemmas(unsigned num_learned);
+        literal shrink_level(unsigned level, unsigned begin, unsigned end);
         bool minimize_lemma_binres();
         void reset_lemma_var_marks();
         bool dyn_sub_res();
@@ -698,6 +746,10 @@ namespace sat {
         void pop_vars(unsigned num_scopes);
 
         void unassign_vars(unsigned old_sz, unsigned new_lvl);
+        void save_trail(unsigned new_lvl);
+        void reset_saved_trail();
+        void replay_saved_trail(literal l);
+        bool is_unit_reason(literal l, justification const& js, unsigned& level);
         void reinit_clauses(unsigned old_sz);
 
         literal_vector m_user_scope_literals;
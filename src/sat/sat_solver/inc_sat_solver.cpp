@@ -369,6 +369,7 @@ public:
         m_params.set_sym("pb.solver", p1.pb_solver());
         m_solver.updt_params(m_params);
         m_solver.set_incremental(is_incremental() && !override_incremental());
+        m_preprocess = nullptr;
         if (p1.euf() && !get_euf()) 
             ensure_euf();        
     }
@@ -613,11 +614,14 @@ public:
     }
 
     void init_preprocess() {
-        if (m_preprocess) {
-            m_preprocess->reset();
-        }
         if (!m_bb_rewriter) {
             m_bb_rewriter = alloc(bit_blaster_rewriter, m, m_params);
+            m_preprocess = nullptr;
+        }
+        if (m_preprocess) {
+            // the tactic is rebuilt only when parameters change.
+            m_preprocess->reset();
+            return;
         }
         params_ref simp1_p = m_params;
         simp1_p.set_bool("som", true);
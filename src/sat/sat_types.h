@@ -91,6 +91,7 @@ namespace sat {
         virtual model const& get_model() const = 0;
         virtual void collect_statistics(statistics& st) const = 0;        
         virtual double get_priority(bool_var v) const { return 0; }
+        virtual lbool get_best_value(bool_var v) const { return l_undef; }
 
     };
 
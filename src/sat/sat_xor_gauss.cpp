@@ -0,0 +1,301 @@
+/*++
+  Copyright (c) 2024 Microsoft Corporation
+
+  Module Name:
+
+   sat_xor_gauss.cpp
+
+  Abstract:
+
+    Propagation of XOR constraints by Gauss-Jordan elimination.
+
+  --*/
+
+#include "sat/sat_xor_gauss.h"
+#include "sat/sat_xor_finder.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    xor_gauss::xor_gauss(solver& s):
+        extension(symbol("xor-gauss"), 0),
+        m_max_matrix_size(1 << 24) {
+        set_solver(&s);
+    }
+
+    xor_gauss::~xor_gauss() {
+    }
+
+    bool xor_gauss::init() {
+        std::function<void(literal_vector const&)> on_xor =
+            [&](literal_vector const& lits) {
+            add_xor(lits);
+        };
+        clause_vector clauses(s().clauses());
+        xor_finder xf(s());
+        xf.set(on_xor);
+        xf(clauses);
+        if (m_xors.empty())
+            return false;
+        eliminate();
+        return true;
+    }
+
+    /**
+       \brief the xor finder reports lits such that the xor of lits is true.
+    */
+    void xor_gauss::add_xor(literal_vector const& lits) {
+        row r;
+        r.m_rhs = true;
+        for (literal l : lits) {
+            r.m_vars.push_back(l.var());
+            r.m_rhs ^= l.sign();
+            m_is_xor_var.reserve(l.var() + 1, false);
+            m_is_xor_var[l.var()] = true;
+        }
+        m_xors.push_back(r);
+        m_stats.m_num_xors++;
+    }
+
+    void xor_gauss::watch(bool_var v, unsigned idx) {
+        s().get_wlist(literal(v, false)).push_back(watched(idx));
+        s().get_wlist(literal(v, true)).push_back(watched(idx));
+    }
+
+    void xor_gauss::unwatch(bool_var v, unsigned idx) {
+        s().get_wlist(literal(v, false)).erase(watched(idx));
+        s().get_wlist(literal(v, true)).erase(watched(idx));
+    }
+
+    void xor_gauss::clear_watches() {
+        for (unsigned i = 0; i < m_rows.size(); ++i) {
+            unwatch(m_rows[i].m_vars[0], i);
+            unwatch(m_rows[i].m_vars[1], i);
+        }
+        m_rows.reset();
+    }
+
+    void xor_gauss::detach() {
+        clear_watches();
+    }
+
+    void xor_gauss::simplify() {
+        if (s().at_base_lvl() && !s().inconsistent())
+            eliminate();
+    }
+
+    /**
+       \brief replace variables fixed at base level by their values and
+       reduce each set of xors that share variables independently.
+    */
+    void xor_gauss::eliminate() {
+        SASSERT(s().at_base_lvl());
+        clear_watches();
+        unsigned n = s().num_vars();
+        unsigned_vector parent(n);
+        for (unsigned v = 0; v < n; ++v)
+            parent[v] = v;
+        auto find = [&](unsigned v) {
+            while (parent[v] != v)
+                v = parent[v] = parent[parent[v]];
+            return v;
+        };
+        vector<row> folded;
+        for (row const& x : m_xors) {
+            row r;
+            r.m_rhs = x.m_rhs;
+            for (bool_var v : x.m_vars) {
+                switch (s().value(v)) {
+                case l_true: r.m_rhs = !r.m_rhs; break;
+                case l_false: break;
+                default:
+                    if (!r.m_vars.empty())
+                        parent[find(v)] = find(r.m_vars[0]);
+                    r.m_vars.push_back(v);
+                    break;
+                }
+            }
+            if (!r.m_vars.empty())
+                folded.push_back(r);
+            else if (r.m_rhs) {
+                s().set_conflict();
+                return;
+            }
+        }
+        u_map<unsigned> root2group;
+        vector<unsigned_vector> groups;
+        for (unsigned i = 0; i < folded.size(); ++i) {
+            unsigned root = find(folded[i].m_vars[0]);
+            unsigned g = 0;
+            if (!root2group.find(root, g)) {
+                g = groups.size();
+                root2group.insert(root, g);
+                groups.push_back(unsigned_vector());
+            }
+            groups[g].push_back(i);
+        }
+        unsigned_vector col(n, UINT_MAX);
+        bool_var_vector vars;
+        for (unsigned_vector const& g : groups) {
+            vars.reset();
+            for (unsigned i : g)
+                for (bool_var v : folded[i].m_vars)
+                    if (col[v] == UINT_MAX) {
+                        col[v] = vars.size();
+                        vars.push_back(v);
+                    }
+            if (g.size() * (vars.size() + 1) > m_max_matrix_size) {
+                for (unsigned i : g)
+                    add_row(folded[i].m_vars, folded[i].m_rhs);
+            }
+            else {
+                unsigned nc = vars.size();
+                vector<bit_vector> m(g.size());
+                for (unsigned i = 0; i < g.size(); ++i) {
+                    m[i].resize(nc + 1, false);
+                    for (bool_var v : folded[g[i]].m_vars)
+                        m[i].set(col[v]);
+                    m[i].set(nc, folded[g[i]].m_rhs);
+                }
+                unsigned rank = 0;
+                for (unsigned c = 0; c < nc && rank < m.size(); ++c) {
+                    unsigned p = rank;
+                    while (p < m.size() && !m[p].get(c))
+                        ++p;
+                    if (p == m.size())
+                        continue;
+                    m[p].swap(m[rank]);
+                    for (unsigned r = 0; r < m.size(); ++r)
+                        if (r != rank && m[r].get(c))
+                            m[r] ^= m[rank];
+                    ++rank;
+                    m_stats.m_num_eliminations++;
+                }
+                bool_var_vector row_vars;
+                for (unsigned r = 0; r < m.size(); ++r) {
+                    row_vars.reset();
+                    for (unsigned c = 0; c < nc; ++c)
+                        if (m[r].get(c))
+                            row_vars.push_back(vars[c]);
+                    if (!row_vars.empty())
+                        add_row(row_vars, m[r].get(nc));
+                    else if (m[r].get(nc)) {
+                        s().set_conflict();
+                        return;
+                    }
+                }
+            }
+            for (bool_var v : vars)
+                col[v] = UINT_MAX;
+            if (s().inconsistent())
+                return;
+        }
+        m_stats.m_num_rows = m_rows.size();
+        TRACE("sat_xor", display(tout););
+    }
+
+    void xor_gauss::add_row(bool_var_vector const& vars, bool rhs) {
+        SASSERT(!vars.empty());
+        if (vars.size() == 1) {
+            literal lit(vars[0], !rhs);
+            if (s().value(lit) == l_false)
+                s().set_conflict();
+            else if (s().value(lit) == l_undef) {
+                s().assign_unit(lit);
+                m_stats.m_num_units++;
+            }
+            return;
+        }
+        unsigned idx = m_rows.size();
+        m_rows.push_back(row());
+        m_rows.back().m_vars.append(vars);
+        m_rows.back().m_rhs = rhs;
+        watch(vars[0], idx);
+        watch(vars[1], idx);
+    }
+
+    bool xor_gauss::parity(row const& r, unsigned start) const {
+        bool p = false;
+        for (unsigned i = start; i < r.m_vars.size(); ++i)
+            p ^= s().value(r.m_vars[i]) == l_true;
+        return p;
+    }
+
+    /**
+       \brief l was assigned and its variable is watched by row idx.
+       Either move the watch to an unassigned variable or propagate
+       the remaining watched variable.
+       Inferences at base level are not justified by the row, as rows
+       are recomputed at base level.
+    */
+    bool xor_gauss::propagated(literal l, ext_constraint_idx idx) {
+        row& r = m_rows[idx];
+        bool_var_vector& vars = r.m_vars;
+        if (vars[0] == l.var())
+            std::swap(vars[0], vars[1]);
+        SASSERT(vars[1] == l.var());
+        for (unsigned i = 2; i < vars.size(); ++i) {
+            if (s().value(vars[i]) == l_undef) {
+                std::swap(vars[1], vars[i]);
+                s().get_wlist(~l).erase(watched(idx));
+                watch(vars[1], static_cast<unsigned>(idx));
+                return false;
+            }
+        }
+        bool val = r.m_rhs ^ parity(r, 1);
+        literal lit(vars[0], !val);
+        justification js = s().at_base_lvl() ? justification(0) : justification::mk_ext_justification(s().scope_lvl(), idx);
+        switch (s().value(lit)) {
+        case l_undef:
+            m_stats.m_num_propagations++;
+            s().assign(lit, js);
+            break;
+        case l_false:
+            m_stats.m_num_conflicts++;
+            s().set_conflict(js);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    /**
+       \brief the antecedents of an inference by a row are the assigned
+       literals of the row other than the propagated one.
+    */
+    void xor_gauss::get_antecedents(literal l, ext_justification_idx idx, literal_vector& r, bool probing) {
+        for (bool_var v : m_rows[idx].m_vars) {
+            if (l != null_literal && v == l.var())
+                continue;
+            SASSERT(s().value(v) != l_undef);
+            r.push_back(literal(v, s().value(v) == l_false));
+        }
+    }
+
+    std::ostream& xor_gauss::display(std::ostream& out) const {
+        for (unsigned i = 0; i < m_rows.size(); ++i)
+            display_constraint(out, i) << "\n";
+        return out;
+    }
+
+    std::ostream& xor_gauss::display_justification(std::ostream& out, ext_justification_idx idx) const {
+        return display_constraint(out, idx);
+    }
+
+    std::ostream& xor_gauss::display_constraint(std::ostream& out, ext_constraint_idx idx) const {
+        row const& r = m_rows[idx];
+        for (unsigned i = 0; i < r.m_vars.size(); ++i)
+            out << (i > 0 ? " ^ " : "") << r.m_vars[i];
+        return out << " = " << (r.m_rhs ? 1 : 0);
+    }
+
+    void xor_gauss::collect_statistics(statistics& st) const {
+        st.update("sat xor gauss xors", m_stats.m_num_xors);
+        st.update("sat xor gauss rows", m_stats.m_num_rows);
+        st.update("sat xor gauss units", m_stats.m_num_units);
+        st.update("sat xor gauss eliminations", m_stats.m_num_eliminations);
+        st.update("sat xor gauss propagations", m_stats.m_num_propagations);
+        st.update("sat xor gauss conflicts", m_stats.m_num_conflicts);
+    }
+}
@@ -0,0 +1,90 @@
+/*++
+  Copyright (c) 2024 Microsoft Corporation
+
+  Module Name:
+
+   sat_xor_gauss.h
+
+  Abstract:
+
+    Propagation of XOR constraints by Gauss-Jordan elimination.
+
+    XORs extracted from the clauses by the xor_finder are partitioned
+    into independent sets of variables. Each set is reduced to row
+    echelon form over the variables that are unassigned at base level
+    and the reduced rows are propagated using two watched variables.
+    The rows are recomputed when the solver simplifies at base level.
+
+  Notes:
+
+    The defining clauses of the XORs are kept, the extension only adds
+    propagation strength. Variables of XORs are external, so they are
+    not eliminated while the extension is attached.
+
+  --*/
+
+#pragma once
+
+#include "util/bit_vector.h"
+#include "util/vector.h"
+#include "sat/sat_extension.h"
+
+namespace sat {
+
+    class solver;
+
+    class xor_gauss : public extension {
+    public:
+        struct stats {
+            unsigned m_num_xors, m_num_rows, m_num_units, m_num_propagations, m_num_conflicts, m_num_eliminations;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+    private:
+        // xor of m_vars equals m_rhs. The first two variables are watched.
+        struct row {
+            bool_var_vector m_vars;
+            bool            m_rhs;
+        };
+
+        vector<row>       m_xors;       // extracted xors
+        vector<row>       m_rows;       // reduced rows
+        bool_vector       m_is_xor_var;
+        unsigned          m_max_matrix_size;
+        stats             m_stats;
+
+        void add_xor(literal_vector const& lits);
+        void eliminate();
+        void add_row(bool_var_vector const& vars, bool rhs);
+        void watch(bool_var v, unsigned idx);
+        void unwatch(bool_var v, unsigned idx);
+        void clear_watches();
+        bool parity(row const& r, unsigned start) const;
+
+    public:
+        xor_gauss(solver& s);
+        ~xor_gauss() override;
+
+        /**
+           \brief extract xors from the clauses of the solver.
+           Return false if none were found.
+        */
+        bool init();
+
+        bool propagated(literal l, ext_constraint_idx idx) override;
+        bool unit_propagate() override { return false; }
+        bool is_external(bool_var v) override { return v < m_is_xor_var.size() && m_is_xor_var[v]; }
+        void get_antecedents(literal l, ext_justification_idx idx, literal_vector& r, bool probing) override;
+        check_result check() override { return check_result::CR_DONE; }
+        void push() override {}
+        void pop(unsigned n) override {}
+        void simplify() override;
+        std::ostream& display(std::ostream& out) const override;
+        std::ostream& display_justification(std::ostream& out, ext_justification_idx idx) const override;
+        std::ostream& display_constraint(std::ostream& out, ext_constraint_idx idx) const override;
+        void collect_statistics(statistics& st) const override;
+        extension* copy(solver* s) override { return nullptr; }
+        void detach();
+    };
+}
@@ -78,6 +78,8 @@ namespace arith {
         m_stats.collect_statistics(st);
         lp().settings().stats().collect_statistics(st);
         if (m_nla) m_nla->collect_statistics(st);
+        st.update("arith lia time", m_lia_watch.get_seconds());
+        st.update("arith nla time", m_nla_watch.get_seconds());
     }
 
     void solver::explain_assumptions() {
@@ -1139,7 +1139,11 @@ namespace arith {
         if (!check_idiv_bounds())
             return l_false;
 
-        auto cr = m_lia->check(&m_explanation);
+        lp::lia_move cr;
+        {
+            scoped_watch _sw(m_lia_watch);
+            cr = m_lia->check(&m_explanation);
+        }
         if (cr != lp::lia_move::sat && ctx.get_config().m_arith_ignore_int) 
             return l_undef;
 
@@ -1468,7 +1472,11 @@ namespace arith {
             return l_true;
 
         m_a1 = nullptr; m_a2 = nullptr;
-        lbool r = m_nla->check(m_nla_lemma_vector);
+        lbool r;
+        {
+            scoped_watch _sw(m_nla_watch);
+            r = m_nla->check(m_nla_lemma_vector);
+        }
         switch (r) {
         case l_false: 
             for (const nla::lemma& l : m_nla_lemma_vector)
@@ -17,6 +17,7 @@ Author:
 #pragma once
 
 #include "util/obj_pair_set.h"
+#include "util/stopwatch.h"
 #include "ast/ast_trail.h"
 #include "ast/arith_decl_plugin.h"
 #include "math/lp/lp_solver.h"
@@ -185,6 +186,8 @@ namespace arith {
 
         unsigned                                          m_num_conflicts{ 0 };
         lp_api::stats                                     m_stats;
+        stopwatch                                         m_lia_watch;   // time in integer checks (branches and cuts)
+        stopwatch                                         m_nla_watch;   // time in non-linear checks
         svector<scope>                                    m_scopes;
 
         // non-linear arithmetic
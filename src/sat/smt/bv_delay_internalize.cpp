@@ -96,6 +96,10 @@ namespace bv {
         if (!check_mul_invertibility(e, args, r1))
             return false;
 
+        // known low-order zero bits of the product
+        if (!check_mul_trailing_zeros(e, args, r1))
+            return false;
+
         // Some other possible approaches:
         // algebraic rules:
         // x*(y+z), and there are nodes for x*y or x*z -> x*(y+z) = x*y + x*z
@@ -115,11 +119,103 @@ namespace bv {
         if (m_cheap_axioms)
             return true;
 
+        if (!check_mul_low_bits(e, args, r1, r2))
+            return false;
+
         set_delay_internalize(e, internalize_mode::no_delay_i);
         internalize_circuit(e);
         return false;
     }
 
+    /**
+     * The product has at least as many trailing zeros as the arguments together:
+     * 
+     *   x[a-1:0] = 0 & y[b-1:0] = 0 => z[a+b-1:0] = 0
+     * 
+     * The lemma is added for the lowest bit of the multiplier value that violates it.
+     */
+    bool solver::check_mul_trailing_zeros(app* n, expr_ref_vector const& arg_values, expr* value) {
+        if (arg_values.size() != 2)
+            return true;
+        unsigned sz = bv.get_bv_size(n);
+        rational vz, vx, vy;
+        VERIFY(bv.is_numeral(value, vz));
+        VERIFY(bv.is_numeral(arg_values[0], vx));
+        VERIFY(bv.is_numeral(arg_values[1], vy));
+        if (vx.is_zero() || vy.is_zero() || vz.is_zero())
+            return true;
+        unsigned a = vx.trailing_zeros(), b = vy.trailing_zeros();
+        unsigned j = vz.trailing_zeros();
+        if (a + b <= j || a + b == 0)
+            return true;
+        sat::literal_vector const& zs = m_bits[expr2enode(n)->get_th_var(get_id())];
+        sat::literal_vector const& xs = m_bits[expr2enode(n->get_arg(0))->get_th_var(get_id())];
+        sat::literal_vector const& ys = m_bits[expr2enode(n->get_arg(1))->get_th_var(get_id())];
+        if (zs.size() != sz || xs.size() != sz || ys.size() != sz)
+            return true;
+        sat::literal_vector lits;
+        for (unsigned i = 0; i < a; ++i)
+            lits.push_back(xs[i]);
+        for (unsigned i = 0; i < b; ++i)
+            lits.push_back(ys[i]);
+        lits.push_back(~zs[j]);
+        TRACE("bv", tout << "trailing zeros " << mk_bounded_pp(n, m) << " " << a << " + " << b << " > " << j << "\n";);
+        add_clause(lits);
+        return false;
+    }
+
+    /**
+     * Refine the multiplier from the low-order bits (Hensel lifting).
+     * The bits 0..k of x*y only depend on the bits 0..k of x and y. For the lowest bit k
+     * where the value of the multiplier differs from the product of the argument values
+     * add the lemma
+     * 
+     *   x[k:0] = vx[k:0] & y[k:0] = vy[k:0] => z[k] = (vx*vy)[k]
+     * 
+     * which is falsified by the current assignment. The number of refinements per 
+     * multiplier is bounded by its bit-width, after that the full circuit is bit-blasted.
+     */
+    bool solver::check_mul_low_bits(app* n, expr_ref_vector const& arg_values, expr* mul_value, expr* arg_value) {
+        if (arg_values.size() != 2)
+            return true;
+        unsigned sz = bv.get_bv_size(n);
+        unsigned count = 0;
+        if (!m_mul_refinements.find(n, count))
+            ctx.push(insert_obj_map<expr, unsigned>(m_mul_refinements, n));
+        if (count >= sz)
+            return true;
+        m_mul_refinements.insert(n, count + 1);
+
+        sat::literal_vector const& zs = m_bits[expr2enode(n)->get_th_var(get_id())];
+        sat::literal_vector const& xs = m_bits[expr2enode(n->get_arg(0))->get_th_var(get_id())];
+        sat::literal_vector const& ys = m_bits[expr2enode(n->get_arg(1))->get_th_var(get_id())];
+        if (zs.size() != sz || xs.size() != sz || ys.size() != sz)
+            return true;
+
+        rational vz, vp, vx, vy;
+        VERIFY(bv.is_numeral(mul_value, vz));
+        VERIFY(bv.is_numeral(arg_value, vp));
+        VERIFY(bv.is_numeral(arg_values[0], vx));
+        VERIFY(bv.is_numeral(arg_values[1], vy));
+        unsigned k = 0;
+        while (k < sz && vz.get_bit(k) == vp.get_bit(k))
+            ++k;
+        SASSERT(k < sz);
+        if (k == sz)
+            return true;
+
+        sat::literal_vector lits;
+        for (unsigned i = 0; i <= k; ++i) {
+            lits.push_back(vx.get_bit(i) ? ~xs[i] : xs[i]);
+            lits.push_back(vy.get_bit(i) ? ~ys[i] : ys[i]);
+        }
+        lits.push_back(vp.get_bit(k) ? zs[k] : ~zs[k]);
+        TRACE("bv", tout << "refine " << mk_bounded_pp(n, m) << " at bit " << k << "\n";);
+        ++m_stats.m_num_mul_refinements;
+        add_clause(lits);
+        return false;
+    }
+
     /**
      * Add invertibility condition for multiplication
      * 
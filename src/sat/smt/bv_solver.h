@@ -46,6 +46,7 @@ namespace bv {
             unsigned   m_num_diseq_static, m_num_diseq_dynamic,  m_num_conflicts;
             unsigned   m_num_bit2eq, m_num_bit2ne, m_num_eq2bit, m_num_ne2bit;
             unsigned   m_ackerman;
+            unsigned   m_num_mul_refinements;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -271,6 +272,7 @@ namespace bv {
         };
 
         obj_map<expr, internalize_mode> m_delay_internalize;
+        obj_map<expr, unsigned> m_mul_refinements;
         bool m_cheap_axioms{ true };
         bool should_bit_blast(app * n);
         bool check_delay_internalized(expr* e);
@@ -278,6 +280,8 @@ namespace bv {
         bool check_mul_invertibility(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_mul_zero(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
         bool check_mul_one(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
+        bool check_mul_trailing_zeros(app* n, expr_ref_vector const& arg_values, expr* value);
+        bool check_mul_low_bits(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
         bool check_umul_no_overflow(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_bv_eval(euf::enode* n);
         bool check_bool_eval(euf::enode* n);
@@ -51,6 +51,7 @@ namespace euf {
                 }
                 m_clauses.pop_back();
                 m_roots.pop_back();
+                m_blockers.pop_back();
                 m_alloc.del_clause(c);
                 break;
             }
@@ -91,6 +92,7 @@ namespace euf {
         unsigned sz = m_clauses.size();
         m_clauses.push_back(cl);
         m_roots.push_back(true);
+        m_blockers.push_back(sat::null_literal);
         m_trail.push_back(std::make_pair(update::add_clause, 0));
         for (sat::literal lit : *cl) {
             ctx.s().set_external(lit.var());
@@ -113,6 +115,7 @@ namespace euf {
         unsigned sz = m_clauses.size();
         m_clauses.push_back(cl);
         m_roots.push_back(false);
+        m_blockers.push_back(sat::null_literal);
         m_trail.push_back(std::make_pair(update::add_clause, 0));
         for (sat::literal lit : *cl) {
             ctx.s().set_external(lit.var());
@@ -180,9 +183,13 @@ namespace euf {
         for (auto idx : occurs(lit)) {
             if (!m_roots[idx])
                 continue;
+            if (is_blocked(idx, lit))
+                continue;
             for (sat::literal lit2 : *m_clauses[idx]) 
-                if (lit2 != lit && ctx.s().value(lit2) == l_true && is_relevant(lit2))
+                if (lit2 != lit && ctx.s().value(lit2) == l_true && is_relevant(lit2)) {
+                    set_blocker(idx, lit2);
                     goto next;  
+                }
             set_relevant(lit);
             add_to_propagation_queue(lit);
             return;
@@ -259,12 +266,16 @@ namespace euf {
         for (auto idx : occurs(~lit)) {
             if (m_roots[idx])
                 continue;
+            if (is_blocked(idx, sat::null_literal))
+                continue;
             sat::clause* cl = m_clauses[idx];
             sat::literal true_lit = sat::null_literal;
             for (sat::literal lit2 : *cl) {
                 if (ctx.s().value(lit2) == l_true) {
-                    if (is_relevant(lit2))
+                    if (is_relevant(lit2)) {
+                        set_blocker(idx, lit2);
                         goto next;
+                    }
                     true_lit = lit2;
                 }
             }
@@ -281,6 +292,15 @@ namespace euf {
         }
     }
 
+    /**
+    * The blocker of clause idx is a relevant true literal different from except.
+    * Then the clause does not change relevancy and need not be traversed.
+    */
+    bool relevancy::is_blocked(unsigned idx, sat::literal except) {
+        sat::literal b = m_blockers[idx];
+        return b != sat::null_literal && b != except && ctx.s().value(b) == l_true && is_relevant(b);
+    }
+
     void relevancy::propagate_relevant(euf::enode* n) {
         m_todo.push_back(n);
         while (!m_todo.empty()) {
@@ -89,6 +89,9 @@ Can a literal that is not in a root be set relevant?
 Do we need full watch lists instead of 2-watch lists?
  - probably, but unclear. The dual SAT solver only uses 2-watch lists, but uses a large clause for tracking 
    roots.
+ - each clause caches the last relevant true literal found in it as a blocker, similar to 
+   blocking literals in watch lists. It is checked before the clause is traversed. 
+   Stale blockers are harmless because they are checked against the current assignment.
 
 
    State machine for literals: relevant(lit), assigned(lit)
@@ -125,6 +128,7 @@ namespace euf {
         sat::clause_allocator                m_alloc;
         sat::clause_vector                   m_clauses;           // clauses
         bool_vector                          m_roots;             // indicate if clause is a root
+        sat::literal_vector                  m_blockers;          // last relevant true literal found in clause
         vector<unsigned_vector>              m_occurs;            // where do literals occur
         unsigned                             m_qhead = 0;         // queue head for relevancy
         svector<std::pair<sat::literal, euf::enode*>> m_queue;    // propagation queue for relevancy
@@ -147,6 +151,10 @@ namespace euf {
 
         void propagate_relevant(euf::enode* n);
 
+        bool is_blocked(unsigned idx, sat::literal except);
+
+        void set_blocker(unsigned idx, sat::literal lit) { m_blockers[idx] = lit; }
+
     public:
         relevancy(euf::solver& ctx): ctx(ctx) {}
 
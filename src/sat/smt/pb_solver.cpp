@@ -1961,14 +1961,23 @@ namespace pb {
         VERIFY(index <= bound);
         VERIFY(c[index] == alit);
         
-        // find a literal to swap with:
-        for (unsigned i = bound + 1; i < sz; ++i) {
+        // find a literal to swap with.
+        // The search is circular, starting where the previous search succeeded, 
+        // so that false literals at the front of the unwatched part are not revisited
+        // on every propagation of wide cardinality constraints.
+        unsigned i = c.search_pos();
+        if (i <= bound || i >= sz)
+            i = bound + 1;
+        for (unsigned n = bound + 1; n < sz; ++n) {
             literal lit2 = c[i];
             if (value(lit2) != l_false) {
                 c.swap(index, i);
                 c.watch_literal(*this, lit2);
+                c.set_search_pos(i);
                 return l_undef;
             }
+            if (++i == sz)
+                i = bound + 1;
         }
 
         // conflict
@@ -387,6 +387,8 @@ namespace q {
     bool ematch::flush_prop_queue() {
         if (m_prop_queue.empty())
             return false;
+        // propagate is also reached from the instantiation queue, which is timed by its callers.
+        scoped_watch _sw(m_inst_watch);
         for (unsigned i = 0; i < m_prop_queue.size(); ++i) {
             auto const& [is_conflict, idx, j_idx] = m_prop_queue[i];
             propagate(is_conflict, idx, j_idx);
@@ -637,8 +639,16 @@ namespace q {
     }
 
 
+    bool ematch::propagate_inst_queue() {
+        scoped_watch _sw(m_inst_watch);
+        return m_inst_queue.propagate();
+    }
+
     bool ematch::propagate(bool flush) {
-        m_mam->propagate();
+        {
+            scoped_watch _sw(m_match_watch);
+            m_mam->propagate();
+        }
         bool propagated = flush_prop_queue();
         if (flush) {
             for (auto* c : m_clauses)
@@ -646,7 +656,7 @@ namespace q {
         }
         else {
             if (m_qhead >= m_clause_queue.size())
-                return m_inst_queue.propagate() || propagated;
+                return propagate_inst_queue() || propagated;
             ctx.push(value_trail<unsigned>(m_qhead));
             for (; m_qhead < m_clause_queue.size() && m.inc(); ++m_qhead) {
                 unsigned idx = m_clause_queue[m_qhead];
@@ -657,7 +667,7 @@ namespace q {
         m_clause_in_queue.reset();
         m_node_in_queue.reset();
         m_in_queue_set = true;
-        if (m_inst_queue.propagate())
+        if (propagate_inst_queue())
             propagated = true;
         return propagated;
     }
@@ -666,8 +676,10 @@ namespace q {
         TRACE("q", m_mam->display(tout););
         if (propagate(false))
             return true;
-        if (m_lazy_mam) 
+        if (m_lazy_mam) {
+            scoped_watch _sw(m_match_watch);
             m_lazy_mam->propagate();
+        }
         if (propagate(false))
             return true;        
         for (unsigned i = 0; i < m_clauses.size(); ++i)
@@ -675,8 +687,11 @@ namespace q {
                 insert_clause_in_queue(i);
         if (propagate(true))
             return true;
-        if (m_inst_queue.lazy_propagate())
-            return true;
+        {
+            scoped_watch _sw(m_inst_watch);
+            if (m_inst_queue.lazy_propagate())
+                return true;
+        }
         for (unsigned i = 0; i < m_clauses.size(); ++i)
             if (m_clauses[i]->m_bindings) {
                 IF_VERBOSE(0, verbose_stream() << "missed propagation " << i << "\n");
@@ -694,6 +709,8 @@ namespace q {
         st.update("q unit propagations",     m_stats.m_num_propagations);
         st.update("q conflicts", m_stats.m_num_conflicts);
         st.update("q delayed bindings", m_stats.m_num_delayed_bindings);
+        st.update("q ematch time", m_match_watch.get_seconds());
+        st.update("q instantiation time", m_inst_watch.get_seconds());
     }
 
     std::ostream& ematch::display(std::ostream& out) const {
@@ -17,6 +17,7 @@ Author:
 #pragma once
 
 #include "util/nat_set.h"
+#include "util/stopwatch.h"
 #include "ast/quantifier_stat.h"
 #include "ast/pattern/pattern_inference.h"
 #include "ast/normal_forms/nnf.h"
@@ -50,6 +51,9 @@ namespace q {
             }
         };
 
+        stopwatch                     m_match_watch;    // time spent matching patterns
+        stopwatch                     m_inst_watch;     // time spent instantiating clauses
+
         struct prop {
             bool is_conflict;
             unsigned idx;
@@ -118,6 +122,7 @@ namespace q {
         lit clausify_literal(expr* arg);
 
         bool flush_prop_queue();
+        bool propagate_inst_queue();
         void propagate(bool is_conflict, unsigned idx, sat::ext_justification_idx j_idx);
 
         bool propagate(bool flush);
@@ -76,6 +76,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
     bool                        m_default_external;
     bool                        m_euf { false };
     bool                        m_drat { false };
+    bool                        m_gate_cache { false };
+    unsigned                    m_cache_head { 0 };
     bool                        m_is_redundant { false };
     bool                        m_top_level { false };
     sat::literal_vector         aig_lits;
@@ -107,6 +109,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         m_max_memory = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_euf = sp.euf();
         m_drat = sp.drat_file().is_non_empty_string();
+        m_gate_cache = sp.gate_cache();
     }
 
     void throw_op_not_handled(std::string const& s) {
@@ -247,6 +250,24 @@ struct goal2sat::imp : public sat::sat_internalizer {
         }
         m_cache_trail.shrink(k);
         m_cache_lim.shrink(m_cache_lim.size() - n);    
+        m_cache_head = std::min(m_cache_head, k);
+    }
+
+    /**
+       \brief the gate cache survives a call only in incremental mode, where
+       atoms are external. The cached definitions are made external as well
+       so that the simplifier does not eliminate them before they are reused.
+    */
+    bool keep_cache() const {
+        return m_gate_cache && m_default_external && !m_euf;
+    }
+
+    void freeze_cache() {
+        sat::literal lit;
+        for (unsigned i = m_cache_head; i < m_cache_trail.size(); ++i) 
+            if (m_app2lit.find(m_cache_trail.get(i), lit))
+                m_solver.set_external(lit.var());
+        m_cache_head = m_cache_trail.size();
     }
 
     // remove non-external literals from cache.
@@ -899,6 +920,10 @@ struct goal2sat::imp : public sat::sat_internalizer {
         scoped_reset(imp& i) :i(i) {}
         ~scoped_reset() {
             i.m_interface_vars.reset();
+            if (i.keep_cache()) {
+                i.freeze_cache();
+                return;
+            }
             i.m_app2lit.reset();
             i.m_lit2app.reset();
         }
@@ -5,9 +5,12 @@ Copyright (c) 2020 Microsoft Corporation
 
 #include<iostream>
 #include<fstream>
+#include<unordered_map>
+#include<cstring>
 #include "ast/bv_decl_plugin.h"
 #include "util/memory_manager.h"
 #include "util/statistics.h"
+#include "util/stopwatch.h"
 #include "sat/dimacs.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
@@ -525,11 +528,474 @@ static void verify_smt(char const* drat_file, char const* smt_file) {
 }
 
 
+/**
+   \brief Backward checker for propositional DRUP/DRAT proofs of DIMACS problems.
+
+   The proof is first replayed forward to the empty clause without any checks.
+   Lemmas are then revisited in reverse order and only those that contributed
+   to a conflict (the core) are verified. Unit propagation visits core clauses
+   before other clauses so that conflicts are found with few new dependencies.
+*/
+class drup_checker {
+    static const unsigned null_clause = UINT_MAX;
+
+    struct clause_info {
+        sat::literal_vector m_lits;
+        sat::literal        m_pivot = sat::null_literal;
+        bool                m_active = false;
+        bool                m_core = false;
+        unsigned            m_gen = 0;
+    };
+
+    struct step {
+        unsigned m_clause;
+        bool     m_deleted;
+    };
+
+    struct watch_entry {
+        unsigned m_clause;
+        unsigned m_gen;
+    };
+
+    struct lits_hash {
+        size_t operator()(unsigned_vector const& v) const {
+            size_t h = v.size();
+            for (unsigned u : v)
+                h = h * 31 + u;
+            return h;
+        }
+    };
+
+    struct lits_eq {
+        bool operator()(unsigned_vector const& a, unsigned_vector const& b) const {
+            return a == b;
+        }
+    };
+
+    std::vector<clause_info>               m_clauses;
+    std::vector<step>                      m_steps;
+    std::vector<std::vector<watch_entry>>  m_watches;
+    std::unordered_map<unsigned_vector, unsigned_vector, lits_hash, lits_eq> m_lookup;
+    unsigned_vector                        m_units;
+    svector<signed char>                   m_value;
+    unsigned_vector                        m_reason;
+    sat::literal_vector                    m_trail;
+    unsigned                               m_head_core = 0;
+    unsigned                               m_head_all = 0;
+    bool                                   m_has_empty = false;
+    bool                                   m_empty_input = false;
+    svector<bool>                          m_seen;
+    unsigned                               m_num_lemmas = 0;
+    unsigned                               m_num_checked = 0;
+    unsigned                               m_num_rat = 0;
+    unsigned                               m_num_missing_deletes = 0;
+
+    signed char value(sat::literal l) const { return m_value[l.index()]; }
+
+    void reserve(sat::literal l) {
+        unsigned n = 2 * l.var() + 2;
+        if (n > m_value.size()) {
+            m_value.resize(n, 0);
+            m_watches.resize(n);
+            m_reason.resize(l.var() + 1, null_clause);
+            m_seen.resize(l.var() + 1, false);
+        }
+    }
+
+    unsigned_vector key(sat::literal_vector const& lits) const {
+        unsigned_vector k;
+        for (sat::literal l : lits)
+            k.push_back(l.index());
+        std::sort(k.begin(), k.end());
+        return k;
+    }
+
+    void attach(unsigned idx) {
+        clause_info& c = m_clauses[idx];
+        c.m_active = true;
+        ++c.m_gen;
+        if (c.m_lits.size() == 1)
+            m_units.push_back(idx);
+        else if (c.m_lits.size() >= 2) {
+            m_watches[c.m_lits[0].index()].push_back({ idx, c.m_gen });
+            m_watches[c.m_lits[1].index()].push_back({ idx, c.m_gen });
+        }
+    }
+
+    void assign(sat::literal l, unsigned reason) {
+        m_value[l.index()] = 1;
+        m_value[(~l).index()] = -1;
+        m_reason[l.var()] = reason;
+        m_trail.push_back(l);
+    }
+
+    void reset_assignment() {
+        for (sat::literal l : m_trail) {
+            m_value[l.index()] = 0;
+            m_value[(~l).index()] = 0;
+            m_reason[l.var()] = null_clause;
+        }
+        m_trail.reset();
+        m_head_core = m_head_all = 0;
+    }
+
+    // visit the clauses watching the literal l that just became false.
+    unsigned propagate(sat::literal l, bool core) {
+        auto& ws = m_watches[l.index()];
+        unsigned i = 0, j = 0, sz = static_cast<unsigned>(ws.size());
+        unsigned conflict = null_clause;
+        for (; i < sz && conflict == null_clause; ++i) {
+            watch_entry we = ws[i];
+            clause_info& c = m_clauses[we.m_clause];
+            if (!c.m_active || c.m_gen != we.m_gen)
+                continue;
+            if (c.m_core != core) {
+                ws[j++] = we;
+                continue;
+            }
+            auto& lits = c.m_lits;
+            if (lits[0] == l)
+                std::swap(lits[0], lits[1]);
+            if (value(lits[0]) == 1) {
+                ws[j++] = we;
+                continue;
+            }
+            bool moved = false;
+            for (unsigned k = 2; k < lits.size(); ++k) {
+                if (value(lits[k]) != -1) {
+                    std::swap(lits[1], lits[k]);
+                    m_watches[lits[1].index()].push_back(we);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved)
+                continue;
+            ws[j++] = we;
+            if (value(lits[0]) == -1)
+                conflict = we.m_clause;
+            else
+                assign(lits[0], we.m_clause);
+        }
+        for (; i < sz; ++i)
+            ws[j++] = ws[i];
+        ws.resize(j);
+        return conflict;
+    }
+
+    // core-first unit propagation
+    unsigned propagate() {
+        while (true) {
+            if (m_head_core < m_trail.size()) {
+                unsigned c = propagate(~m_trail[m_head_core++], true);
+                if (c != null_clause)
+                    return c;
+            }
+            else if (m_head_all < m_trail.size()) {
+                unsigned c = propagate(~m_trail[m_head_all++], false);
+                if (c != null_clause)
+                    return c;
+            }
+            else
+                return null_clause;
+        }
+    }
+
+    // mark the clauses that justify the assignment of the literals in todo.
+    void mark_core(sat::literal_vector& todo) {
+        sat::bool_var_vector seen;
+        while (!todo.empty()) {
+            sat::literal l = todo.back();
+            todo.pop_back();
+            if (m_seen[l.var()])
+                continue;
+            m_seen[l.var()] = true;
+            seen.push_back(l.var());
+            unsigned r = m_reason[l.var()];
+            if (r == null_clause)
+                continue;
+            m_clauses[r].m_core = true;
+            for (sat::literal l2 : m_clauses[r].m_lits)
+                todo.push_back(l2);
+        }
+        for (auto v : seen)
+            m_seen[v] = false;
+    }
+
+    /**
+       \brief check that lits follows by unit propagation from the active clauses
+       and mark the clauses used in the refutation.
+    */
+    bool is_rup(sat::literal_vector const& lits) {
+        reset_assignment();
+        sat::literal_vector todo;
+        unsigned conflict = null_clause;
+        for (unsigned u : m_units) {
+            clause_info const& c = m_clauses[u];
+            if (!c.m_active)
+                continue;
+            sat::literal l = c.m_lits[0];
+            if (value(l) == -1) {
+                conflict = u;
+                break;
+            }
+            if (value(l) == 0)
+                assign(l, u);
+        }
+        for (unsigned i = 0; conflict == null_clause && i < lits.size(); ++i) {
+            sat::literal l = lits[i];
+            if (value(l) == 1) {
+                todo.push_back(l);
+                mark_core(todo);
+                reset_assignment();
+                return true;
+            }
+            if (value(l) == 0)
+                assign(~l, null_clause);
+        }
+        if (conflict == null_clause)
+            conflict = propagate();
+        if (conflict == null_clause) {
+            reset_assignment();
+            return false;
+        }
+        m_clauses[conflict].m_core = true;
+        for (sat::literal l : m_clauses[conflict].m_lits)
+            todo.push_back(l);
+        mark_core(todo);
+        reset_assignment();
+        return true;
+    }
+
+    bool is_rat(unsigned idx) {
+        sat::literal pivot = m_clauses[idx].m_pivot;
+        if (pivot == sat::null_literal)
+            return false;
+        unsigned_vector candidates;
+        for (unsigned i = 0; i < m_clauses.size(); ++i)
+            if (m_clauses[i].m_active && m_clauses[i].m_lits.contains(~pivot))
+                candidates.push_back(i);
+        for (unsigned i : candidates) {
+            sat::literal_vector resolvent(m_clauses[idx].m_lits);
+            bool is_taut = false;
+            for (sat::literal l : m_clauses[i].m_lits) {
+                if (l == ~pivot || resolvent.contains(l))
+                    continue;
+                is_taut |= resolvent.contains(~l);
+                resolvent.push_back(l);
+            }
+            if (is_taut)
+                continue;
+            if (!is_rup(resolvent))
+                return false;
+            m_clauses[i].m_core = true;
+        }
+        return true;
+    }
+
+    unsigned mk_clause(sat::literal_vector const& lits) {
+        unsigned idx = static_cast<unsigned>(m_clauses.size());
+        m_clauses.push_back(clause_info());
+        clause_info& c = m_clauses.back();
+        for (sat::literal l : lits) {
+            reserve(l);
+            if (!c.m_lits.contains(l))
+                c.m_lits.push_back(l);
+        }
+        if (!lits.empty())
+            c.m_pivot = lits[0];
+        m_lookup[key(c.m_lits)].push_back(idx);
+        return idx;
+    }
+
+public:
+
+    void add_input(sat::literal_vector const& lits) {
+        unsigned idx = mk_clause(lits);
+        if (lits.empty())
+            m_has_empty = m_empty_input = true;
+        attach(idx);
+    }
+
+    void add_lemma(sat::literal_vector const& lits) {
+        if (m_has_empty)
+            return;
+        ++m_num_lemmas;
+        unsigned idx = mk_clause(lits);
+        m_steps.push_back({ idx, false });
+        if (lits.empty()) {
+            m_has_empty = true;
+            return;
+        }
+        attach(idx);
+    }
+
+    void del_clause(sat::literal_vector const& lits) {
+        if (m_has_empty)
+            return;
+        sat::literal_vector norm;
+        for (sat::literal l : lits)
+            if (!norm.contains(l))
+                norm.push_back(l);
+        auto it = m_lookup.find(key(norm));
+        if (it == m_lookup.end() || it->second.empty()) {
+            ++m_num_missing_deletes;
+            return;
+        }
+        unsigned idx = it->second.back();
+        // unit clauses are kept, following the convention of drat-trim.
+        if (m_clauses[idx].m_lits.size() <= 1)
+            return;
+        it->second.pop_back();
+        m_clauses[idx].m_active = false;
+        m_steps.push_back({ idx, true });
+    }
+
+    /**
+       \brief Verify the proof. The empty clause must follow by unit propagation
+       from the clauses active where the proof ends (or where it first derives
+       the empty clause).
+    */
+    bool check(std::ostream& out) {
+        sat::literal_vector empty;
+        if (m_empty_input) {
+            out << "s VERIFIED\n";
+            return true;
+        }
+        if (!is_rup(empty)) {
+            out << "s NOT VERIFIED\nc the proof does not derive the empty clause\n";
+            return false;
+        }
+        for (unsigned i = m_steps.size(); i-- > 0; ) {
+            step const& s = m_steps[i];
+            clause_info& c = m_clauses[s.m_clause];
+            if (s.m_deleted) {
+                attach(s.m_clause);
+                continue;
+            }
+            c.m_active = false;
+            if (!c.m_core)
+                continue;
+            ++m_num_checked;
+            if (is_rup(c.m_lits))
+                continue;
+            if (is_rat(s.m_clause)) {
+                ++m_num_rat;
+                continue;
+            }
+            out << "s NOT VERIFIED\nc lemma " << c.m_lits << " is neither RUP nor RAT\n";
+            return false;
+        }
+        out << "s VERIFIED\n";
+        return true;
+    }
+
+    void display_statistics(std::ostream& out) const {
+        out << "c lemmas: " << m_num_lemmas << " checked: " << m_num_checked << " rat: " << m_num_rat << "\n";
+        if (m_num_missing_deletes > 0)
+            out << "c ignored deletions of unknown clauses: " << m_num_missing_deletes << "\n";
+    }
+};
+
+static bool is_binary_proof(std::istream& in) {
+    char buffer[64];
+    in.read(buffer, sizeof(buffer));
+    std::streamsize n = in.gcount();
+    in.clear();
+    in.seekg(0);
+    for (std::streamsize i = 0; i < n; ++i) {
+        unsigned char ch = static_cast<unsigned char>(buffer[i]);
+        if (ch == 0 || ch >= 128 || (ch < 32 && ch != '\n' && ch != '\r' && ch != '\t'))
+            return true;
+    }
+    return false;
+}
+
+static void read_binary_proof(std::istream& in, drup_checker& checker) {
+    sat::literal_vector lits;
+    int ch;
+    while ((ch = in.get()) != EOF) {
+        if (ch != 'a' && ch != 'd')
+            throw default_exception("unexpected tag in binary DRAT proof");
+        bool is_delete = ch == 'd';
+        lits.reset();
+        while (true) {
+            unsigned v = 0, shift = 0;
+            do {
+                ch = in.get();
+                if (ch == EOF)
+                    throw default_exception("unexpected end of binary DRAT proof");
+                v |= (ch & 127) << shift;
+                shift += 7;
+            }
+            while (ch & 128);
+            if (v == 0)
+                break;
+            lits.push_back(sat::literal(v >> 1, (v & 1) != 0));
+        }
+        if (is_delete)
+            checker.del_clause(lits);
+        else
+            checker.add_lemma(lits);
+    }
+}
+
+static unsigned verify_dimacs(char const* drat_file, char const* cnf_file) {
+    stopwatch sw;
+    sw.start();
+    drup_checker checker;
+    std::ifstream cnf_in(cnf_file);
+    if (cnf_in.bad() || cnf_in.fail()) {
+        std::cerr << "(error \"failed to open file '" << cnf_file << "'\")\n";
+        return 1;
+    }
+    dimacs::drat_parser cnf(cnf_in, std::cerr);
+    for (auto const& r : cnf)
+        if (r.m_tag == dimacs::drat_record::tag_t::is_clause)
+            checker.add_input(r.m_lits);
+
+    std::ifstream proof_in(drat_file, std::ios_base::in | std::ios_base::binary);
+    if (proof_in.bad() || proof_in.fail()) {
+        std::cerr << "(error \"failed to open file '" << drat_file << "'\")\n";
+        return 1;
+    }
+    try {
+        if (is_binary_proof(proof_in))
+            read_binary_proof(proof_in, checker);
+        else {
+            dimacs::drat_parser proof(proof_in, std::cerr);
+            for (auto const& r : proof) {
+                if (r.m_tag != dimacs::drat_record::tag_t::is_clause)
+                    continue;
+                if (r.m_status.is_deleted())
+                    checker.del_clause(r.m_lits);
+                else
+                    checker.add_lemma(r.m_lits);
+            }
+        }
+    }
+    catch (default_exception& ex) {
+        std::cerr << "(error \"" << ex.msg() << "\")\n";
+        return 1;
+    }
+    bool ok = checker.check(std::cout);
+    checker.display_statistics(std::cout);
+    std::cout << "c time: " << sw.get_current_seconds() << "\n";
+    return ok ? 0 : 1;
+}
+
+static bool is_dimacs_file(char const* file) {
+    char const* ext = strrchr(file, '.');
+    return ext && (strcmp(ext, ".cnf") == 0 || strcmp(ext, ".dimacs") == 0);
+}
+
 unsigned read_drat(char const* drat_file, char const* problem_file) {
     if (!problem_file) {
         std::cerr << "No smt2 file provided to checker\n";
         return -1;
     }
+    if (is_dimacs_file(problem_file))
+        return verify_dimacs(drat_file, problem_file);
     verify_smt(drat_file, problem_file);
     return 0;
 }
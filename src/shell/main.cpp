@@ -47,6 +47,8 @@ Revision History:
 typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_MPS, IN_DRAT } input_kind;
 
 static char const * g_input_file          = nullptr;
+static char const * g_prelude_file        = nullptr;
+static bool         g_server              = false;
 static char const * g_drat_input_file     = nullptr;
 static bool         g_standard_input      = false;
 static input_kind   g_input_kind          = IN_UNSPECIFIED;
@@ -86,6 +88,8 @@ void display_usage() {
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
     std::cout << "  -in         read formula from standard input.\n";
+    std::cout << "  -prelude:file  read SMT 2 commands from file before the input.\n";
+    std::cout << "  -server     read names of SMT 2 files from standard input, one per line, and process each in its own scope on top of the prelude.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
     std::cout << "  -h, -?      prints this message.\n";
@@ -225,6 +229,14 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "file") == 0) {
                 g_input_file = opt_arg;
             }
+            else if (strcmp(opt_name, "prelude") == 0) {
+                if (!opt_arg)
+                    error("option argument (-prelude:file) is missing.");
+                g_prelude_file = opt_arg;
+            }
+            else if (strcmp(opt_name, "server") == 0) {
+                g_server = true;
+            }
             else if (strcmp(opt_name, "T") == 0) {
                 if (!opt_arg)
                     error("option argument (-T:timeout) is missing.");
@@ -330,6 +342,15 @@ int STD_CALL main(int argc, char ** argv) {
         if (g_input_file && g_standard_input) {
             error("using standard input to read formula.");
         }
+        if (g_server) {
+            if (g_input_file || g_standard_input)
+                error("server mode reads the names of input files from standard input.");
+            memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
+            return_value = serve_smtlib2_commands(g_prelude_file);
+            disable_timeout();
+            memory::finalize();
+            return return_value;
+        }
         if (!g_input_file && !g_standard_input) {
             error("input file was not specified.");
         }
@@ -368,7 +389,7 @@ int STD_CALL main(int argc, char ** argv) {
         switch (g_input_kind) {
         case IN_SMTLIB_2:
             memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
-            return_value = read_smtlib2_commands(g_input_file);
+            return_value = read_smtlib2_commands(g_input_file, g_prelude_file);
             break;
         case IN_DIMACS:
             return_value = read_dimacs(g_input_file);
@@ -20,11 +20,16 @@ Copyright (c) 2015 Microsoft Corporation
 #include "opt/opt_context.h"
 #include "shell/opt_frontend.h"
 #include "opt/opt_parse.h"
+#include "opt/opt_params.hpp"
+#include "sat/dimacs.h"
+#include "sat/sat_maxsat.h"
 
 extern bool g_display_statistics;
 extern bool g_display_model;
 static bool g_first_interrupt = true;
 static opt::context* g_opt = nullptr;
+static sat::maxsat* g_maxsat = nullptr;
+static reslimit* g_sat_limit = nullptr;
 static double g_start_time = 0;
 static unsigned_vector g_handles;
 static mutex *display_stats_mux = new mutex;
@@ -63,9 +68,12 @@ static void display_model() {
 
 static void display_statistics() {
     lock_guard lock(*display_stats_mux);
-    if (g_display_statistics && g_opt) {
+    if (g_display_statistics && (g_opt || g_maxsat)) {
         ::statistics stats;
-        g_opt->collect_statistics(stats);
+        if (g_opt)
+            g_opt->collect_statistics(stats);
+        else
+            g_maxsat->collect_statistics(stats);
         stats.display(std::cout);
         double end_time = static_cast<double>(clock());
         std::cout << "time:                " << (end_time - g_start_time)/CLOCKS_PER_SEC << " secs\n";
@@ -77,6 +85,10 @@ static void STD_CALL on_ctrl_c(int) {
         g_opt->get_manager().limit().cancel();
         g_first_interrupt = false;
     }
+    else if (g_sat_limit && g_first_interrupt) {
+        g_sat_limit->cancel();
+        g_first_interrupt = false;
+    }
     else {
         signal (SIGINT, SIG_DFL);
         display_statistics();
@@ -89,7 +101,60 @@ static void on_timeout() {
     _Exit(0);
 }
 
+/**
+   \brief solve weighted CNF directly on the SAT core, without
+   translating the clauses to expressions.
+*/
+static unsigned solve_wcnf_sat(std::istream& in) {
+    params_ref p = gparams::get_module("sat");
+    p.set_bool("produce_models", true);
+    reslimit limit;
+    sat::solver solver(p, limit);
+    sat::maxsat ms(solver);
+    if (!parse_wcnf(in, std::cerr, solver, ms)) {
+        std::cerr << "(error \"failed to parse weighted CNF\")\n";
+        return 0;
+    }
+    unsigned num_vars = solver.num_vars();
+    g_maxsat = &ms;
+    g_sat_limit = &limit;
+    lbool r = l_undef;
+    {
+        cancel_eh<reslimit> eh(limit);
+        unsigned timeout = std::stoul(gparams::get_value("timeout"));
+        unsigned rlimit = std::stoi(gparams::get_value("rlimit"));
+        scoped_timer timer(timeout, &eh);
+        scoped_rlimit _rlimit(limit, rlimit);
+        r = ms();
+    }
+    switch (r) {
+    case l_true:  std::cout << "sat\n"; break;
+    case l_false: std::cout << "unsat\n"; break;
+    case l_undef: std::cout << "unknown\n"; break;
+    }
+    display_statistics();
+    if (r != l_false && g_display_model) {
+        sat::model const& mdl = ms.get_model();
+        std::cout << "v ";
+        for (unsigned v = 1; v < num_vars && v < mdl.size(); ++v)
+            if (mdl[v] != l_undef)
+                std::cout << (mdl[v] == l_false ? "-" : "") << v << " ";
+        std::cout << "\n";
+    }
+    if (r != l_false) {
+        if (ms.lower() == ms.upper())
+            std::cout << "   " << ms.upper() << "\n";
+        else
+            std::cout << "  [" << ms.lower() << ":" << ms.upper() << "]\n";
+    }
+    g_maxsat = nullptr;
+    g_sat_limit = nullptr;
+    return 0;
+}
+
 static unsigned parse_opt(std::istream& in, opt_format f) {
+    if (f == wcnf_t && opt_params(gparams::get_module("opt")).maxsat_engine() == symbol("sat"))
+        return solve_wcnf_sat(in);
     ast_manager m;
     reg_decl_plugins(m);
     opt::context opt(m);
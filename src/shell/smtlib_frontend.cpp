@@ -115,12 +115,7 @@ void help_probes() {
         std::cout << "- " << cmd->get_name() << " " << cmd->get_descr() << "\n";
 }
 
-unsigned read_smtlib2_commands(char const * file_name) {
-    g_start_time = clock();
-    register_on_timeout_proc(on_timeout);
-    signal(SIGINT, on_ctrl_c);
-    cmd_context ctx;
-
+static void init_cmd_context(cmd_context & ctx) {
     ctx.set_solver_factory(mk_smt_strategic_solver_factory());
     install_dl_cmds(ctx);
     install_dbg_cmds(ctx);
@@ -128,20 +123,36 @@ unsigned read_smtlib2_commands(char const * file_name) {
     install_subpaving_cmds(ctx);
     install_opt_cmds(ctx);
     install_smt2_extra_cmds(ctx);
+}
+
+static bool parse_smt2_file(cmd_context & ctx, char const * file_name, bool exit_on_error) {
+    std::ifstream in(file_name);
+    if (in.bad() || in.fail()) {
+        std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+        if (exit_on_error)
+            exit(ERR_OPEN_FILE);
+        return false;
+    }
+    return parse_smt2_commands(ctx, in);
+}
+
+unsigned read_smtlib2_commands(char const * file_name, char const * prelude_file) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+    init_cmd_context(ctx);
 
     g_cmd_context = &ctx;
     signal(SIGINT, on_ctrl_c);
 
     bool result = true;
-    if (file_name) {
-        std::ifstream in(file_name);
-        if (in.bad() || in.fail()) {
-            std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
-            exit(ERR_OPEN_FILE);
-        }
-        result = parse_smt2_commands(ctx, in);
+    if (prelude_file) 
+        result = parse_smt2_file(ctx, prelude_file, true);
+    if (result && file_name) {
+        result = parse_smt2_file(ctx, file_name, true);
     }
-    else {
+    else if (result) {
         result = parse_smt2_commands(ctx, std::cin, true);
     }
 
@@ -151,3 +162,51 @@ unsigned read_smtlib2_commands(char const * file_name) {
     return result ? 0 : 1;
 }
 
+/**
+   \brief Read names of SMT2 scripts from standard input, one per line, and
+   process each of them in a fresh scope on top of the prelude.
+   The prelude is parsed and asserted once. The solver is kept between
+   queries, so it is not re-internalized either.
+   A query that resets the context or pops the scope of the prelude
+   causes the prelude to be loaded again.
+   "(done)" is printed after each query.
+*/
+unsigned serve_smtlib2_commands(char const * prelude_file) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    cmd_context ctx;
+    init_cmd_context(ctx);
+
+    g_cmd_context = &ctx;
+    signal(SIGINT, on_ctrl_c);
+
+    unsigned base_lvl = 0;
+    auto load_prelude = [&]() {
+        if (prelude_file && !parse_smt2_file(ctx, prelude_file, false))
+            return false;
+        base_lvl = ctx.num_scopes();
+        return true;
+    };
+
+    bool result = load_prelude();
+    std::string line;
+    while (result && std::getline(std::cin, line)) {
+        if (line.empty())
+            continue;
+        ctx.push();
+        // errors in a query are reported by the parser and do not end the session.
+        parse_smt2_file(ctx, line.c_str(), false);
+        if (ctx.num_scopes() > base_lvl) {
+            ctx.pop(ctx.num_scopes() - base_lvl);
+        }
+        else {
+            ctx.reset();
+            result = load_prelude();
+        }
+        ctx.regular_stream() << "(done)" << std::endl;
+    }
+
+    display_statistics();
+    g_cmd_context = nullptr;
+    return result ? 0 : 1;
+}
@@ -19,7 +19,8 @@ Revision History:
 #pragma once
 
 unsigned read_smtlib_file(char const * benchmark_file);
-unsigned read_smtlib2_commands(char const * command_file);
+unsigned read_smtlib2_commands(char const * command_file, char const * prelude_file = nullptr);
+unsigned serve_smtlib2_commands(char const * prelude_file);
 void help_tactics();
 void help_probes();
 void help_tactic(char const* name);
@@ -178,6 +178,10 @@ class dl_graph {
     
     vector<edge_id_vector>  m_out_edges;  // per var
     vector<edge_id_vector>  m_in_edges;   // per var
+    // per var: enabled out edges in the order they were enabled. Edges are disabled
+    // in reverse order on backtracking, so the lists behave as stacks. Searches that
+    // only follow enabled edges use these lists to skip the (usually many) disabled atoms.
+    vector<edge_id_vector>  m_enabled_out_edges;
 
     struct scope {
         unsigned m_edges_lim;
@@ -384,12 +388,10 @@ private:
                 return false;
             }
             
-            for (edge_id e_id : m_out_edges[source]) {
+            for (edge_id e_id : m_enabled_out_edges[source]) {
                 edge & e     = m_edges[e_id];
                 SASSERT(e.get_source() == source);
-                if (!e.is_enabled()) {
-                    continue;
-                }
+                SASSERT(e.is_enabled());
                 set_gamma(e, gamma);
                 
                 if (gamma.is_neg()) {
@@ -478,6 +480,7 @@ public:
             m_assignment .push_back(numeral());
             m_out_edges  .push_back(edge_id_vector());
             m_in_edges   .push_back(edge_id_vector());
+            m_enabled_out_edges.push_back(edge_id_vector());
             m_gamma      .push_back(numeral());
             m_mark       .push_back(DL_UNMARKED);
             m_parent     .push_back(null_edge_id);
@@ -519,6 +522,7 @@ public:
             e.enable(m_timestamp);
             m_last_enabled_edge = id;
             m_timestamp++;
+            m_enabled_out_edges[e.get_source()].push_back(id);
             if (!is_feasible(e)) {
                 r = make_feasible(id);
             }
@@ -875,7 +879,10 @@ public:
         scope & s              = m_trail_stack[new_lvl];
         for (unsigned i = m_enabled_edges.size(); i > s.m_enabled_edges_lim; ) {
             --i;
-            m_edges[m_enabled_edges[i]].disable();
+            edge & e = m_edges[m_enabled_edges[i]];
+            e.disable();
+            SASSERT(m_enabled_out_edges[e.get_source()].back() == m_enabled_edges[i]);
+            m_enabled_out_edges[e.get_source()].pop_back();
         }
         m_enabled_edges.shrink(s.m_enabled_edges_lim);
         unsigned old_num_edges = s.m_edges_lim;
@@ -1177,6 +1184,7 @@ public:
         m_edges             .reset();
         m_in_edges          .reset();
         m_out_edges         .reset();
+        m_enabled_out_edges .reset();
         m_trail_stack       .reset();
         m_gamma             .reset();
         m_mark              .reset();
@@ -1397,13 +1405,11 @@ public:
             int parent_idx  = head;
             dl_var v = curr.m_var;
             TRACE("dl_bfs", tout << "processing: " << v << "\n";);
-            edge_id_vector & edges = m_out_edges[v];
+            edge_id_vector & edges = m_enabled_out_edges[v];
             for (edge_id e_id : edges) {
                 edge & e     = m_edges[e_id];
                 SASSERT(e.get_source() == v);
-                if (!e.is_enabled()) {
-                    continue;
-                }
+                SASSERT(e.is_enabled());
                 set_gamma(e, gamma);
                 TRACE("dl_bfs", display_edge(tout << "processing edge: ", e) << " gamma: " << gamma << "\n";);
                 if (is_connected(gamma, zero_edge, e, timestamp)) {
@@ -1854,9 +1860,9 @@ public:
             m_mark[v] = DL_PROCESSED;
             TRACE("diff_logic", tout << v << "\n";);
 
-            for (edge_id e_id : m_out_edges[v]) {
+            for (edge_id e_id : m_enabled_out_edges[v]) {
                 edge const& e = m_edges[e_id];
-                if (!e.is_enabled() || e.get_timestamp() > timestamp) {
+                if (e.get_timestamp() > timestamp) {
                     continue;
                 }
                 dl_var w = e.get_target();
@@ -165,7 +165,8 @@ namespace smt {
     dyn_ack_manager::dyn_ack_manager(context & ctx, dyn_ack_params & p):
         m_context(ctx),
         m(ctx.get_manager()),
-        m_params(p) {
+        m_params(p),
+        m_threshold(p.m_dack_threshold) {
     }
 
     dyn_ack_manager::~dyn_ack_manager() {
@@ -189,6 +190,8 @@ namespace smt {
         m_qhead = 0;
         m_num_instances = 0;
         m_num_propagations_since_last_gc = 0;
+        m_threshold = m_params.m_dack_threshold;
+        m_sketch.reset();
 
         m_triple.m_app2num_occs.reset();
         reset_app_triples();
@@ -210,12 +213,15 @@ namespace smt {
             return;
         }
         unsigned num_occs = 0;
+        bool is_new = false;
         if (m_app_pair2num_occs.find(n1, n2, num_occs)) {
             TRACE("dyn_ack", tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
             num_occs++;
         }
         else {
-            num_occs = 1;
+            if (!track(hash_u_u(n1->get_id(), n2->get_id()), num_occs))
+                return;
+            is_new = true;
             m.inc_ref(n1);
             m.inc_ref(n2);
             m_app_pairs.push_back(p);
@@ -226,7 +232,7 @@ namespace smt {
         unsigned num_occs2 = 0;
         SASSERT(m_app_pair2num_occs.find(n1, n2, num_occs2) && num_occs == num_occs2);
 #endif
-        if (num_occs == m_params.m_dack_threshold) {
+        if (num_occs == m_threshold || (is_new && num_occs > m_threshold)) {
             TRACE("dyn_ack", tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
             m_to_instantiate.push_back(p);
         }
@@ -245,13 +251,16 @@ namespace smt {
             return;
         }
         unsigned num_occs = 0;
+        bool is_new = false;
         if (m_triple.m_app2num_occs.find(n1, n2, r, num_occs)) {
             TRACE("dyn_ack", tout << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\n"
                   << mk_pp(r, m) << "\n" << "\nnum_occs: " << num_occs << "\n";);
             num_occs++;
         }
         else {
-            num_occs = 1;
+            if (!track(hash_u_u(hash_u_u(n1->get_id(), n2->get_id()), r->get_id()), num_occs))
+                return;
+            is_new = true;
             m.inc_ref(n1);
             m.inc_ref(n2);
             m.inc_ref(r);
@@ -263,7 +272,7 @@ namespace smt {
         unsigned num_occs2 = 0;
         SASSERT(m_triple.m_app2num_occs.find(n1, n2, r, num_occs2) && num_occs == num_occs2);
 #endif
-        if (num_occs == m_params.m_dack_threshold) {
+        if (num_occs == m_threshold || (is_new && num_occs > m_threshold)) {
             TRACE("dyn_ack", tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) 
                   << "\n" << mk_pp(r, m) 
                   << "\nnum_occs: " << num_occs << "\n";);
@@ -272,6 +281,39 @@ namespace smt {
         
     }
 
+    /**
+       \brief Determine the initial count of a pair (or triple) with hash code h that is not
+       tracked exactly. Without the sketch every pair is tracked from its first use.
+       Otherwise the use is recorded in the sketch and the pair is tracked only
+       when its estimated number of uses reaches half the threshold.
+    */
+    bool dyn_ack_manager::track(unsigned h, unsigned & num_occs) {
+        if (!m_params.m_dack_sketch) {
+            num_occs = 1;
+            return true;
+        }
+        num_occs = m_sketch.inc(h);
+        return 2 * num_occs >= m_threshold;
+    }
+
+    unsigned dyn_ack_manager::occs_sketch::inc(unsigned h) {
+        if (m_counts.empty())
+            m_counts.resize(c_depth << c_log_width, 0u);
+        unsigned r = UINT_MAX;
+        for (unsigned row = 0; row < c_depth; ++row) {
+            unsigned & c = m_counts[idx(row, h)];
+            if (c < UINT_MAX)
+                c++;
+            r = std::min(r, c);
+        }
+        return r;
+    }
+
+    void dyn_ack_manager::occs_sketch::decay(double f) {
+        for (unsigned & c : m_counts)
+            c = static_cast<unsigned>(c * f);
+    }
+
     struct app_pair_lt { 
         typedef std::pair<app *, app *>          app_pair;
         typedef obj_pair_map<app, app, unsigned> app_pair2num_occs;
@@ -329,7 +371,7 @@ namespace smt {
             ++it2;
             SASSERT(num_occs > 0);
             m_app_pair2num_occs.insert(p.first, p.second, num_occs);
-            if (num_occs >= m_params.m_dack_threshold)
+            if (num_occs >= m_threshold)
                 m_to_instantiate.push_back(p);
         }
         m_app_pairs.set_end(it2);
@@ -337,9 +379,52 @@ namespace smt {
         // app_pair_lt is not a total order on pairs of expressions.
         // So, we should use stable_sort to avoid different behavior in different platforms.
         std::stable_sort(m_to_instantiate.begin(), m_to_instantiate.end(), f);
+        m_sketch.decay(m_params.m_dack_gc_inv_decay);
+        gc_lemmas();
         // IF_VERBOSE(10, if (num_deleted > 0) verbose_stream() << "dynamic ackermann GC: " << num_deleted << "\n";);
     }
 
+    /**
+       \brief Demote Ackermann lemmas that were not used in any conflict since the
+       previous garbage collection. Demoted lemmas are moved to the local tier, so the
+       lemma garbage collector of the context deletes them unless conflict resolution
+       uses them again (which recomputes their glue).
+       The threshold for instantiating new lemmas is raised when most lemmas are useless
+       and lowered back towards dack.threshold when most are useful.
+    */
+    void dyn_ack_manager::gc_lemmas() {
+        if (!m_params.m_dack_lemma_gc || m_clause2usage.empty())
+            return;
+        unsigned num_useful = 0, num_useless = 0;
+        ptr_buffer<clause> demoted;
+        for (auto & kv : m_clause2usage) {
+            lemma_usage & u = kv.m_value;
+            if (u.m_uses > 0) {
+                num_useful++;
+                u.m_uses = 0;
+                u.m_mature = true;
+            }
+            else if (!u.m_mature) {
+                u.m_mature = true;
+            }
+            else {
+                num_useless++;
+                demoted.push_back(kv.m_key);
+            }
+        }
+        for (clause * cls : demoted) {
+            cls->set_glue(UINT_MAX);
+            m_clause2usage.erase(cls);
+        }
+        m_context.m_stats.m_num_useful_dyn_ack += num_useful;
+        m_context.m_stats.m_num_demoted_dyn_ack += num_useless;
+        if (num_useless > 2 * num_useful && m_threshold < 4 * m_params.m_dack_threshold)
+            m_threshold++;
+        else if (num_useful > num_useless && m_threshold > m_params.m_dack_threshold)
+            m_threshold--;
+        TRACE("dyn_ack", tout << "useful: " << num_useful << " demoted: " << num_useless << " threshold: " << m_threshold << "\n";);
+    }
+
     class dyn_ack_clause_del_eh : public clause_del_eh {
         dyn_ack_manager & m;
     public:
@@ -355,6 +440,7 @@ namespace smt {
 
     void dyn_ack_manager::del_clause_eh(clause * cls) {
         m_context.m_stats.m_num_del_dyn_ack++;
+        m_clause2usage.remove(cls);
         app_pair p((app*)nullptr,(app*)nullptr);
         if (m_clause2app_pair.find(cls, p)) {
             SASSERT(p.first && p.second);
@@ -439,12 +525,15 @@ namespace smt {
         }
         TRACE("dyn_ack_clause", tout << "new clause:\n"; m_context.display_clause_detail(tout, cls); tout << "\n";);
         m_clause2app_pair.insert(cls, p);
+        if (m_params.m_dack_lemma_gc)
+            m_clause2usage.insert(cls, lemma_usage());
     }
 
     void dyn_ack_manager::reset() {
         init_search_eh();
         m_instantiated.reset();
         m_clause2app_pair.reset();
+        m_clause2usage.reset();
         m_triple.m_instantiated.reset();
         m_triple.m_clause2apps.reset();
     }
@@ -495,6 +584,8 @@ namespace smt {
         }
         TRACE("dyn_ack_clause", ctx.display_clause_detail(tout << "new clause:\n", cls); tout << "\n";);
         m_triple.m_clause2apps.insert(cls, tr);
+        if (m_params.m_dack_lemma_gc)
+            m_clause2usage.insert(cls, lemma_usage());
     }
 
 
@@ -557,7 +648,7 @@ namespace smt {
             ++it2;
             SASSERT(num_occs > 0);
             m_triple.m_app2num_occs.insert(p.first, p.second, p.third, num_occs);
-            if (num_occs >= m_params.m_dack_threshold)
+            if (num_occs >= m_threshold)
                 m_triple.m_to_instantiate.push_back(p);
         }
         m_triple.m_apps.set_end(it2);
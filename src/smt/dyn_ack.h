@@ -42,6 +42,34 @@ namespace smt {
         typedef obj_triple_hashtable<app, app, app>      app_triple_set;
         typedef obj_map<clause, app_triple>         clause2app_triple;
 
+        /**
+           \brief Count-min sketch of the number of times pairs (and triples)
+           were used. It bounds the memory spent on pairs that are seen only a
+           few times: they are counted in the sketch and only move to the
+           exact maps once their estimated count is high enough.
+        */
+        class occs_sketch {
+            static const unsigned c_depth     = 4;
+            static const unsigned c_log_width = 12;
+            unsigned_vector m_counts;
+            unsigned idx(unsigned row, unsigned h) const {
+                return (row << c_log_width) + (hash_u_u(h, row) & ((1u << c_log_width) - 1));
+            }
+        public:
+            unsigned inc(unsigned h);
+            void decay(double f);
+            void reset() { m_counts.reset(); }
+        };
+
+        /**
+           \brief Conflicts an Ackermann lemma was used in since the last garbage collection.
+        */
+        struct lemma_usage {
+            unsigned m_uses   = 0;
+            bool     m_mature = false;
+        };
+        typedef obj_map<clause, lemma_usage>       clause2usage;
+
         context &                                  m_context;
         ast_manager &                              m;
         dyn_ack_params &                           m_params;
@@ -53,6 +81,9 @@ namespace smt {
         unsigned                                   m_num_propagations_since_last_gc;
         app_pair_set                               m_instantiated;
         clause2app_pair                            m_clause2app_pair;
+        occs_sketch                                m_sketch;
+        clause2usage                               m_clause2usage;
+        unsigned                                   m_threshold;
 
         struct _triple {
             app_triple2num_occs                    m_app2num_occs;
@@ -69,12 +100,14 @@ namespace smt {
 
 
         void gc();
+        void gc_lemmas();
         void reset_app_pairs();
         friend class dyn_ack_clause_del_eh;
         void del_clause_eh(clause * cls);
         void instantiate(app * n1, app * n2);
         literal mk_eq(expr * n1, expr * n2);
         void cg_eh(app * n1, app * n2);
+        bool track(unsigned h, unsigned & num_occs);
 
         void eq_eh(app * n1, app * n2, app* r);
         void instantiate(app * n1, app * n2, app* r);
@@ -118,6 +151,17 @@ namespace smt {
         }
 
         
+        /**
+           \brief This method is invoked when a theory lemma is used during conflict resolution.
+        */
+        void used_clause_eh(clause * cls) {
+            if (m_params.m_dack_lemma_gc) {
+                auto * e = m_clause2usage.find_core(cls);
+                if (e)
+                    e->get_data().m_value.m_uses++;
+            }
+        }
+
         /**
            \brief This method is invoked when it is safe to expand the new ackermann rule entries.
         */
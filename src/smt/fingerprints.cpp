@@ -20,16 +20,21 @@ Revision History:
 
 namespace smt {
 
-    fingerprint::fingerprint(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args):
+    fingerprint::fingerprint(void * d, unsigned d_h, expr* def, unsigned n, enode * const * args, unsigned h):
         m_data(d), 
-        m_data_hash(d_h),
         m_def(def),
-        m_num_args(n), 
-        m_args(nullptr) {
-        m_args = new (r) enode*[n];
+        m_args(reinterpret_cast<enode**>(this + 1)),
+        m_data_hash(d_h),
+        m_num_args(n),
+        m_hash(h) {
         memcpy(m_args, args, sizeof(enode*) * n);
     }
 
+    fingerprint * fingerprint::mk(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args, unsigned h) {
+        void * mem = r.allocate(get_obj_size(n));
+        return new (mem) fingerprint(d, d_h, def, n, args, h);
+    }
+
     bool fingerprint_set::fingerprint_eq_proc::operator()(fingerprint const * f1, fingerprint const * f2) const {
         if (f1->get_data() != f2->get_data()) 
             return false;
@@ -49,6 +54,7 @@ namespace smt {
         m_dummy.m_data_hash = data_hash;
         m_dummy.m_num_args  = num_args;
         m_dummy.m_args      = m_tmp.data();
+        m_dummy.m_hash      = mk_hash(&m_dummy);
         return &m_dummy;
     }
 
@@ -68,12 +74,14 @@ namespace smt {
             return nullptr;
         for (unsigned i = 0; i < num_args; i++)
             d->m_args[i] = d->m_args[i]->get_root();
+        d->m_hash = mk_hash(d);
         if (m_set.contains(d)) {
             TRACE("fingerprint_bug", tout << "failed: " << *d;);
             return nullptr;
         }
         TRACE("fingerprint_bug", tout << "inserting @" << m_scopes.size() << " " << *d;);
-        fingerprint * f = new (m_region) fingerprint(m_region, data, data_hash, def, num_args, d->m_args);
+        fingerprint * f = fingerprint::mk(m_region, data, data_hash, def, num_args, d->m_args, d->m_hash);
+        m_num_bytes += fingerprint::get_obj_size(num_args);
         m_fingerprints.push_back(f);
         m_defs.push_back(def);
         m_set.insert(f);
@@ -86,6 +94,7 @@ namespace smt {
             return true;
         for (unsigned i = 0; i < num_args; i++)
             d->m_args[i] = d->m_args[i]->get_root();
+        d->m_hash = mk_hash(d);
         if (m_set.contains(d))
             return true;
         return false;
@@ -95,6 +104,7 @@ namespace smt {
         m_set.reset();
         m_fingerprints.reset();
         m_defs.reset();
+        m_num_bytes = 0;
     }
         
     void fingerprint_set::push_scope() {
@@ -107,8 +117,10 @@ namespace smt {
         unsigned new_lvl  = lvl - num_scopes;
         unsigned old_size = m_scopes[new_lvl];
         unsigned size     = m_fingerprints.size();
-        for (unsigned i = old_size; i < size; i++) 
+        for (unsigned i = old_size; i < size; i++) {
             m_set.erase(m_fingerprints[i]);
+            m_num_bytes -= fingerprint::get_obj_size(m_fingerprints[i]->get_num_args());
+        }
         m_fingerprints.shrink(old_size);
         m_defs.shrink(old_size);
         m_scopes.shrink(new_lvl);
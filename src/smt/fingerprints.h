@@ -23,21 +23,30 @@ Revision History:
 
 namespace smt {
 
+    /**
+       \brief A fingerprint and its arguments are allocated as one block:
+       the arguments follow the fingerprint. The hash of the fingerprint is
+       cached, so it is not recomputed when the set of fingerprints grows.
+    */
     class fingerprint {
     protected:
         void*         m_data{ nullptr };
-        unsigned      m_data_hash{ 0 };
         expr*         m_def{ nullptr };
-        unsigned      m_num_args{ 0 };
         enode**       m_args{ nullptr };
+        unsigned      m_data_hash{ 0 };
+        unsigned      m_num_args{ 0 };
+        unsigned      m_hash{ 0 };
 
         friend class fingerprint_set;
         fingerprint() {}
+        fingerprint(void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args, unsigned h);
     public:
-        fingerprint(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
+        static fingerprint * mk(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args, unsigned h);
+        static size_t get_obj_size(unsigned n) { return sizeof(fingerprint) + n * sizeof(enode*); }
         void * get_data() const { return m_data; }
         expr * get_def() const { return m_def; }
         unsigned get_data_hash() const { return m_data_hash; }
+        unsigned get_hash() const { return m_hash; }
         unsigned get_num_args() const { return m_num_args;  }
         enode * const * get_args() const { return m_args; }
         enode * get_arg(unsigned idx) const { SASSERT(idx < m_num_args); return m_args[idx]; }
@@ -55,10 +64,12 @@ namespace smt {
             unsigned operator()(fingerprint const * f, unsigned idx) const { return f->get_arg(idx)->hash(); }
         };
         struct fingerprint_hash_proc {
-            unsigned operator()(fingerprint const * f) const {
-                return get_composite_hash<fingerprint *, fingerprint_khasher, fingerprint_chasher>(const_cast<fingerprint*>(f), f->get_num_args());
-            }
+            unsigned operator()(fingerprint const * f) const { return f->get_hash(); }
         };
+
+        static unsigned mk_hash(fingerprint const * f) {
+            return get_composite_hash<fingerprint *, fingerprint_khasher, fingerprint_chasher>(const_cast<fingerprint*>(f), f->get_num_args());
+        }
         struct fingerprint_eq_proc { bool operator()(fingerprint const * f1, fingerprint const * f2) const; };
         typedef ptr_hashtable<fingerprint, fingerprint_hash_proc, fingerprint_eq_proc> set;
 
@@ -69,6 +80,7 @@ namespace smt {
         unsigned_vector          m_scopes;
         ptr_vector<enode>        m_tmp;
         fingerprint              m_dummy;
+        size_t                   m_num_bytes = 0;
 
         fingerprint * mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
 
@@ -76,6 +88,7 @@ namespace smt {
         fingerprint_set(ast_manager& m, region & r): m_region(r), m_defs(m) {}
         fingerprint * insert(void * data, unsigned data_hash, unsigned num_args, enode * const * args, expr* def);
         unsigned size() const { return m_fingerprints.size(); }
+        size_t num_bytes() const { return m_num_bytes; }
         bool contains(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
         void reset();
         void push_scope();
@@ -385,6 +385,7 @@ namespace {
         bool                       m_filter_candidates;
         unsigned                   m_num_regs;
         unsigned                   m_num_choices;
+        unsigned                   m_num_matches;
         instruction *              m_root;
         enode_vector               m_candidates;
 #ifdef Z3DEBUG
@@ -474,6 +475,7 @@ namespace {
             m_filter_candidates(filter_candidates),
             m_num_regs(num_args + 1),
             m_num_choices(0),
+            m_num_matches(0),
             m_root(nullptr) {
             DEBUG_CODE(m_context = 0;);
 #ifdef _PROFILE_MAM
@@ -514,6 +516,10 @@ namespace {
             return m_num_choices;
         }
 
+        void inc_num_matches() {
+            m_num_matches++;
+        }
+
         func_decl * get_root_lbl() const {
             return m_root_lbl;
         }
@@ -568,7 +574,8 @@ namespace {
 #endif
             out << "\n";
             out << "num. regs:    " << m_num_regs << "\n"
-                << "num. choices: " << m_num_choices << "\n";
+                << "num. choices: " << m_num_choices << "\n"
+                << "num. matches: " << m_num_matches << "\n";
             display_seq(out, m_root, 0);
         }
     };
@@ -1845,6 +1852,11 @@ namespace {
         unsigned            m_top { 0 };
         const instruction * m_pc;
 
+        // statistics
+        unsigned            m_num_executions { 0 };
+        unsigned            m_num_backtracks { 0 };
+        unsigned            m_num_matches { 0 };
+
         // auxiliary temporary variables
         unsigned            m_max_generation;  // the maximum generation of an app enode processed.
         unsigned            m_curr_max_generation;  // temporary var used to store a copy of m_max_generation
@@ -2038,6 +2050,12 @@ namespace {
         // init(t) must be invoked before execute_core
         bool execute_core(code_tree * t, enode * n);
 
+        void collect_statistics(::statistics & st) const {
+            st.update("mam executions", m_num_executions);
+            st.update("mam backtracks", m_num_backtracks);
+            st.update("mam matches", m_num_matches);
+        }
+
         // Return the min, max generation of the enodes in m_pattern_instances.
 
         void get_min_max_top_generation(unsigned& min, unsigned& max) {
@@ -2289,6 +2307,7 @@ namespace {
         // It doesn't make sense to process an irrelevant enode.
         TRACE("mam_execute_core", tout << "EXEC " << t->get_root_lbl()->get_name() << "\n";);
         SASSERT(m_context.is_relevant(n));
+        m_num_executions++;
         m_pattern_instances.reset();
         m_min_top_generation.reset();
         m_max_top_generation.reset();
@@ -2534,6 +2553,8 @@ namespace {
             if (m_context.get_cancel_flag()) {                          \
                 return false;                                           \
             }                                                           \
+            m_num_matches++;                                            \
+            t->inc_num_matches();                                       \
             m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                      \
                            static_cast<const yield *>(m_pc)->m_pat,                                     \
                            NUM,                                                                         \
@@ -2686,6 +2707,7 @@ namespace {
 
     backtrack:
         TRACE("mam_int", tout << "backtracking.\n";);
+        m_num_backtracks++;
         if (m_top == 0) {
             TRACE("mam_int", tout << "no more alternatives.\n";);
 #ifdef _PROFILE_MAM
@@ -2949,6 +2971,14 @@ namespace {
         ptr_vector<code_tree>::iterator end_code_trees() {
             return m_trees.end();
         }
+
+        ptr_vector<code_tree>::const_iterator begin_code_trees() const {
+            return m_trees.begin();
+        }
+
+        ptr_vector<code_tree>::const_iterator end_code_trees() const {
+            return m_trees.end();
+        }
     };
 
     // ------------------------------------
@@ -3871,6 +3901,15 @@ namespace {
             m_tmp_region.reset();
         }
 
+        void collect_statistics(::statistics & st) const override {
+            unsigned num_trees = 0;
+            for (auto it = m_trees.begin_code_trees(), end = m_trees.end_code_trees(); it != end; ++it)
+                if (*it)
+                    num_trees++;
+            st.update("mam code trees", num_trees);
+            m_interpreter.collect_statistics(st);
+        }
+
         void display(std::ostream& out) override {
             out << "mam:\n";
             m_lbl_hasher.display(out);
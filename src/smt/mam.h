@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/statistics.h"
 #include "smt/smt_types.h"
 #include <tuple>
 
@@ -59,6 +60,8 @@ namespace smt {
         virtual void reset() = 0;
 
         virtual void display(std::ostream& out) = 0;
+
+        virtual void collect_statistics(::statistics & st) const = 0;
         
         virtual void on_match(quantifier * q, app * pat, unsigned num_bindings, enode * const * bindings, unsigned max_generation, vector<std::tuple<enode *, enode *>> & used_enodes) = 0;
         
@@ -27,7 +27,10 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_relevancy_lvl = p.relevancy();
     m_ematching   = p.ematching();
     m_induction   = p.induction();
-    m_clause_proof = p.clause_proof();
+    m_clause_proof_file = p.clause_proof_file();
+    m_stats_file = p.stats_file();
+    m_stats_interval = p.stats_interval();
+    m_clause_proof = p.clause_proof() || m_clause_proof_file.is_non_empty_string();
     m_phase_selection = static_cast<phase_selection>(p.phase_selection());
     if (m_phase_selection > PS_THEORY) throw default_exception("illegal phase selection numeral");
     m_phase_caching_on = p.phase_caching_on();
@@ -35,11 +38,18 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
     if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
+    m_restart_stable = p.restart_stable();
+    m_restart_stable_conflicts = p.restart_stable_conflicts();
+    m_lemma_subsumption_budget = p.lemma_gc_subsumption_budget();
+    m_lemma_gc_core_glue = p.lemma_gc_core_glue();
+    m_lemma_gc_tier2_glue = std::max(p.lemma_gc_tier2_glue(), m_lemma_gc_core_glue);
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
     m_theory_case_split = p.theory_case_split();
     m_theory_aware_branching = p.theory_aware_branching();
     m_delay_units = p.delay_units();
     m_delay_units_threshold = p.delay_units_threshold();
+    m_backtrack_scopes = p.backtrack_scopes();
+    m_backtrack_conflicts = p.backtrack_conflicts();
     m_preprocess = _p.get_bool("preprocess", true); // hidden parameter
     m_max_conflicts = p.max_conflicts();
     m_restart_max   = p.restart_max();
@@ -47,10 +57,12 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_deterministic  = p.threads_deterministic();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
     validate_string_solver(m_string_solver);
+    m_fp_lazy = p.fp_lazy();
     if (_p.get_bool("arith.greatest_error_pivot", false))
         m_arith_pivot_strategy = arith_pivot_strategy::ARITH_PIVOT_GREATEST_ERROR;
     else if (_p.get_bool("arith.least_error_pivot", false))
@@ -114,6 +126,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_deterministic);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
@@ -121,6 +134,9 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_ematching);
     DISPLAY_PARAM(m_induction);
     DISPLAY_PARAM(m_clause_proof);
+    DISPLAY_PARAM(m_clause_proof_file);
+    DISPLAY_PARAM(m_stats_file);
+    DISPLAY_PARAM(m_stats_interval);
 
     DISPLAY_PARAM(m_case_split_strategy);
     DISPLAY_PARAM(m_rel_case_split_order);
@@ -128,12 +144,16 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_delay_units);
     DISPLAY_PARAM(m_delay_units_threshold);
+    DISPLAY_PARAM(m_backtrack_scopes);
+    DISPLAY_PARAM(m_backtrack_conflicts);
 
     DISPLAY_PARAM(m_theory_resolve);
 
     DISPLAY_PARAM(m_restart_strategy);
     DISPLAY_PARAM(m_restart_initial);
     DISPLAY_PARAM(m_restart_factor);
+    DISPLAY_PARAM(m_restart_stable);
+    DISPLAY_PARAM(m_restart_stable_conflicts);
     DISPLAY_PARAM(m_restart_adaptive);
     DISPLAY_PARAM(m_agility_factor);
     DISPLAY_PARAM(m_restart_agility_threshold);
@@ -149,10 +169,14 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_new_clause_relevancy);
     DISPLAY_PARAM(m_old_clause_relevancy);
     DISPLAY_PARAM(m_inv_clause_decay);
+    DISPLAY_PARAM(m_lemma_subsumption_budget);
+    DISPLAY_PARAM(m_lemma_gc_core_glue);
+    DISPLAY_PARAM(m_lemma_gc_tier2_glue);
 
     DISPLAY_PARAM(m_smtlib_dump_lemmas);
     DISPLAY_PARAM(m_logic);
     DISPLAY_PARAM(m_string_solver);
+    DISPLAY_PARAM(m_fp_lazy);
 
     DISPLAY_PARAM(m_profile_res_sub);
     DISPLAY_PARAM(m_display_bool_var2expr);
@@ -69,7 +69,8 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
-    CS_ACTIVITY_THEORY_AWARE_BRANCHING // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_AWARE_BRANCHING, // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_SCORE // activity scaled by scores supplied by theory solvers (arithmetic conflicts)
 };
 
 struct smt_params : public preprocessor_params,
@@ -105,6 +106,7 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads;
     unsigned         m_threads_max_conflicts;
     unsigned         m_threads_cube_frequency;
+    bool             m_threads_deterministic;
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
@@ -112,6 +114,9 @@ struct smt_params : public preprocessor_params,
     bool             m_ematching;
     bool             m_induction;
     bool             m_clause_proof;
+    symbol           m_clause_proof_file;
+    symbol           m_stats_file;
+    unsigned         m_stats_interval = 1000;
 
     // -----------------------------------
     //
@@ -132,6 +137,14 @@ struct smt_params : public preprocessor_params,
     bool             m_delay_units;
     unsigned         m_delay_units_threshold;
 
+    // -----------------------------------
+    //
+    // Chronological backtracking
+    //
+    // -----------------------------------
+    unsigned         m_backtrack_scopes;
+    unsigned         m_backtrack_conflicts;
+
     // -----------------------------------
     //
     // Conflict resolution
@@ -147,6 +160,8 @@ struct smt_params : public preprocessor_params,
     restart_strategy m_restart_strategy;
     unsigned         m_restart_initial;
     double           m_restart_factor;
+    bool             m_restart_stable;            //!< alternate focused and stable (target phase) search.
+    unsigned         m_restart_stable_conflicts;
     bool             m_restart_adaptive;
     double           m_agility_factor;
     double           m_restart_agility_threshold;
@@ -167,6 +182,9 @@ struct smt_params : public preprocessor_params,
     unsigned          m_new_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     unsigned          m_old_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     double            m_inv_clause_decay;     //!< clause activity decay
+    unsigned          m_lemma_subsumption_budget; //!< literals visited by lemma subsumption per garbage collection
+    unsigned          m_lemma_gc_core_glue;   //!< lemmas with glue <= core glue are never deleted.
+    unsigned          m_lemma_gc_tier2_glue;  //!< lemmas with glue <= tier2 glue are deleted after lemmas of the local tier.
 
     // -----------------------------------
     //
@@ -237,6 +255,13 @@ struct smt_params : public preprocessor_params,
     // -----------------------------------
     symbol m_string_solver;
 
+    // -----------------------------------
+    //
+    // Floating point
+    //
+    // -----------------------------------
+    bool m_fp_lazy = false;
+
     smt_params(params_ref const & p = params_ref()):
         m_display_proof(false),
         m_display_dot_proof(false),
@@ -260,6 +285,7 @@ struct smt_params : public preprocessor_params,
         m_threads(1),
         m_threads_max_conflicts(UINT_MAX),
         m_threads_cube_frequency(2),
+        m_threads_deterministic(false),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
@@ -274,10 +300,14 @@ struct smt_params : public preprocessor_params,
         m_theory_aware_branching(false),
         m_delay_units(false),
         m_delay_units_threshold(32),
+        m_backtrack_scopes(0),
+        m_backtrack_conflicts(4000),
         m_theory_resolve(false),
         m_restart_strategy(restart_strategy::RS_IN_OUT_GEOMETRIC),
         m_restart_initial(100),
         m_restart_factor(1.1),
+        m_restart_stable(false),
+        m_restart_stable_conflicts(10000),
         m_restart_adaptive(true),
         m_agility_factor(0.9999),
         m_restart_agility_threshold(0.18),
@@ -292,6 +322,9 @@ struct smt_params : public preprocessor_params,
         m_new_clause_relevancy(45),
         m_old_clause_relevancy(6),
         m_inv_clause_decay(1),
+        m_lemma_subsumption_budget(0),
+        m_lemma_gc_core_glue(0),
+        m_lemma_gc_tier2_glue(0),
         m_smtlib_dump_lemmas(false),
         m_logic(symbol::null),
         m_profile_res_sub(false),
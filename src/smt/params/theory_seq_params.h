@@ -24,6 +24,10 @@ struct theory_seq_params {
      */
     bool m_split_w_len = false;
     bool m_seq_validate = false;
+    /*
+     * Solve the length abstraction before word equations in final check
+     */
+    bool m_seq_length_first = false;
 
     theory_seq_params(params_ref const & p = params_ref()) {
         updt_params(p);
@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include "util/warning.h"
 #include "util/stats.h"
+#include "util/stopwatch.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/rewriter/var_subst.h"
@@ -147,6 +148,11 @@ namespace smt {
         m_new_entries.push_back(entry(f, cost, generation));
     }
 
+    bool qi_queue::eager_limit_reached(quantifier * q) {
+        return m_params.m_qi_max_eager_instances != UINT_MAX && 
+            m_qm.get_stat(q)->get_num_instances_curr_search() >= m_params.m_qi_max_eager_instances;
+    }
+
     void qi_queue::instantiate() {
         unsigned since_last_check = 0;
         for (entry & curr : m_new_entries) {
@@ -156,7 +162,7 @@ namespace smt {
             fingerprint * f    = curr.m_qb;
             quantifier * qa    = static_cast<quantifier*>(f->get_data());
 
-            if (curr.m_cost <= m_eager_cost_threshold) {
+            if (curr.m_cost <= m_eager_cost_threshold && !eager_limit_reached(qa)) {
                 instantiate(curr);
             }
             else if (m_params.m_qi_promote_unsat && m_checker.is_unsat(qa->get_expr(), f->get_num_args(), f->get_args())) {
@@ -193,6 +199,19 @@ namespace smt {
     }
 
     void qi_queue::instantiate(entry & ent) {
+        if (!m_params.m_qi_profile) {
+            instantiate_core(ent);
+            return;
+        }
+        stopwatch sw;
+        {
+            scoped_watch _sw(sw);
+            instantiate_core(ent);
+        }
+        m_qm.get_stat(static_cast<quantifier*>(ent.m_qb->get_data()))->add_instantiation_time(sw.get_seconds());
+    }
+
+    void qi_queue::instantiate_core(entry & ent) {
         // set temporary flag to enable quantifier-specific tracing in within smt_internalizer.
         flet<bool> _coming_from_quant(m_context.m_coming_from_quant, true);
 
@@ -75,6 +75,8 @@ namespace smt {
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
+        void instantiate_core(entry & ent);
+        bool eager_limit_reached(quantifier * q);
         void get_min_max_costs(float & min, float & max) const;
         void display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation);
 
@@ -30,7 +30,8 @@ namespace smt {
         ctx(th.get_context()),
         m(th.get_manager()),
         m_state_to_expr(m),
-        m_state_graph(state_graph::state_pp(this, pp_state)) { }
+        m_state_graph(state_graph::state_pp(this, pp_state)),
+        m_derivative_trail(m) { }
 
     seq_util& seq_regex::u() { return th.m_util; }
     class seq_util::rex& seq_regex::re() { return th.m_util.re; }
@@ -428,6 +429,25 @@ namespace smt {
         return result;
     }
 
+    expr_ref seq_regex::mk_symbolic_derivative(expr* r) {
+        expr* d = nullptr;
+        if (m_derivative_cache.find(r, d)) {
+            ++m_num_derivative_hits;
+            return expr_ref(d, m);
+        }
+        ++m_num_derivative_misses;
+        expr_ref der = seq_rw().mk_derivative(r);
+        if (m_derivative_cache.size() >= m_max_derivative_cache_size) {
+            STRACE("seq_regex_brief", tout << "(DERIVATIVE CACHE RESET) ";);
+            m_derivative_cache.reset();
+            m_derivative_trail.reset();
+        }
+        m_derivative_trail.push_back(r);
+        m_derivative_trail.push_back(der);
+        m_derivative_cache.insert(r, der);
+        return der;
+    }
+
     /*
        First creates a derivatrive of r wrt x=(:var 0) and then replaces x by ele.
        This will create a cached entry for the generic derivative of r that is independent of ele.
@@ -437,7 +457,7 @@ namespace smt {
 
         // Uses canonical variable (:var 0) for the derivative element
         // Substitute (:var 0) with the actual element
-        expr_ref der = seq_rw().mk_derivative(r);
+        expr_ref der = mk_symbolic_derivative(r);
         var_subst subst(m);
         der = subst(der, ele);
 
@@ -650,7 +670,7 @@ namespace smt {
     */
     void seq_regex::get_derivative_targets(expr* r, expr_ref_vector& targets) {
         // constructs the derivative wrt (:var 0)
-        expr_ref d(seq_rw().mk_derivative(r), m);
+        expr_ref d = mk_symbolic_derivative(r);
 
         // use DFS to collect all the targets (leaf regexes) in d.
         expr* _1 = nullptr, * e1 = nullptr, * e2 = nullptr;
@@ -117,6 +117,20 @@ namespace smt {
         /* map from uninterpreted regex constants to assigned regex expressions by EQ */
         // expr_map                       m_const_to_expr;
         unsigned                       m_max_state_graph_size { 10000 };
+
+        /*
+            Symbolic derivatives with respect to (:var 0) indexed by regex.
+            Regexes are hash-consed, so an entry is shared by all membership
+            constraints over the same regex. Unlike the operation cache of the
+            rewriter it is not flushed by unrelated rewrites and it persists
+            across check-sat calls.
+        */
+        ptr_addr_map<expr, expr*>      m_derivative_cache;
+        expr_ref_vector                m_derivative_trail;
+        unsigned                       m_max_derivative_cache_size { 100000 };
+        unsigned                       m_num_derivative_hits { 0 };
+        unsigned                       m_num_derivative_misses { 0 };
+        expr_ref mk_symbolic_derivative(expr* r);
         // Convert between expressions and states (IDs)
         unsigned get_state_id(expr* e);
         expr* get_expr_from_id(unsigned id);
@@ -191,6 +205,11 @@ namespace smt {
         void push_scope() {}
         void pop_scope(unsigned num_scopes) {}
         bool can_propagate() const { return false; }
+
+        void collect_statistics(::statistics& st) const {
+            st.update("seq regex derivative cache hits", m_num_derivative_hits);
+            st.update("seq regex derivative cache misses", m_num_derivative_misses);
+        }
         bool propagate() const { return false; }
 
         void propagate_in_re(literal lit);
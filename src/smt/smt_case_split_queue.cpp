@@ -62,6 +62,20 @@ namespace {
 
     typedef heap<theory_aware_act_lt> theory_aware_act_queue;
 
+    struct theory_score_lt {
+        svector<double> const & m_activity;
+        svector<double> const & m_score;
+        theory_score_lt(svector<double> const & act, svector<double> const & score):m_activity(act), m_score(score) {}
+        double priority(bool_var v) const {
+            return v < static_cast<bool_var>(m_score.size()) ? m_activity[v] * (1.0 + m_score[v]) : m_activity[v];
+        }
+        bool operator()(bool_var v1, bool_var v2) const {
+            return priority(v1) > priority(v2);
+        }
+    };
+
+    typedef heap<theory_score_lt> theory_score_queue;
+
     /**
        \brief Case split queue based on activity and random splits.
     */
@@ -1249,6 +1263,151 @@ namespace {
     };
 }
 
+namespace {
+
+    /**
+       \brief Case split queue based on activity where theory solvers supply scores.
+       The priority of a variable is its activity multiplied by 1 + its score, 
+       so scores are not affected when activities are rescaled. 
+       Scores are stored in a vector indexed by variables, and batches of 
+       score updates rebuild the heap when that is cheaper than repositioning 
+       every updated variable.
+    */
+    class theory_score_case_split_queue : public case_split_queue {
+        context &          m_context;
+        smt_params &       m_params;
+        svector<double>    m_score;
+        svector<lbool>     m_phase;
+        theory_score_queue m_queue;
+        bool_var_vector    m_vars;
+
+        void set_score(bool_var v, double score) {
+            m_score.reserve(v + 1, 0.0);
+            double old_score = m_score[v];
+            m_score[v] = score;
+            if (!m_queue.contains(v))
+                return;
+            if (score > old_score)
+                m_queue.decreased(v);
+            else if (score < old_score)
+                m_queue.increased(v);
+        }
+
+        void rebuild() {
+            m_vars.reset();
+            for (bool_var v : m_queue)
+                m_vars.push_back(v);
+            m_queue.reset();
+            for (bool_var v : m_vars)
+                m_queue.insert(v);
+        }
+
+    public:
+        theory_score_case_split_queue(context & ctx, smt_params & p):
+            m_context(ctx),
+            m_params(p),
+            m_queue(1024, theory_score_lt(ctx.get_activity_vector(), m_score)) {
+        }
+
+        void activity_increased_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.decreased(v);
+        }
+
+        void activity_decreased_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.increased(v);
+        }
+
+        void mk_var_eh(bool_var v) override {
+            m_queue.reserve(v+1);
+            m_queue.insert(v);
+        }
+
+        void del_var_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.erase(v);
+            if (v < static_cast<bool_var>(m_score.size())) {
+                m_score[v] = 0.0;
+                m_phase.reserve(v + 1, l_undef);
+                m_phase[v] = l_undef;
+            }
+        }
+
+        void unassign_var_eh(bool_var v) override {
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        void relevant_eh(expr * n) override {}
+
+        void init_search_eh() override {}
+
+        void end_search_eh() override {}
+
+        void reset() override {
+            m_queue.reset();
+        }
+
+        void push_scope() override {}
+
+        void pop_scope(unsigned num_scopes) override {}
+
+        void next_case_split(bool_var & next, lbool & phase) override {
+            phase = l_undef;
+            if (m_context.get_random_value() < static_cast<int>(m_params.m_random_var_freq * random_gen::max_value())) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized(); 
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+            while (!m_queue.empty()) {
+                next = m_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef) {
+                    if (next < static_cast<bool_var>(m_phase.size()))
+                        phase = m_phase[next];
+                    return;
+                }
+            }
+            next = null_bool_var;
+        }
+
+        void add_theory_aware_branching_info(bool_var v, double priority, lbool phase) override {
+            m_phase.reserve(v + 1, l_undef);
+            m_phase[v] = phase;
+            set_score(v, std::max(priority, 0.0));
+        }
+
+        void set_theory_scores(unsigned n, bool_var const* vs, double const* scores) override {
+            unsigned sz = static_cast<unsigned>(m_queue.end() - m_queue.begin());
+            if (n < 8 || n * log2(static_cast<double>(sz + 1)) < sz) {
+                for (unsigned i = 0; i < n; ++i)
+                    set_score(vs[i], std::max(scores[i], 0.0));
+                return;
+            }
+            for (unsigned i = 0; i < n; ++i) {
+                m_score.reserve(vs[i] + 1, 0.0);
+                m_score[vs[i]] = std::max(scores[i], 0.0);
+            }
+            rebuild();
+        }
+
+        void display(std::ostream & out) override {
+            bool first = true;
+            for (unsigned v : m_queue) {
+                if (m_context.get_assignment(v) == l_undef) {
+                    if (first) {
+                        out << "remaining case-splits:\n";
+                        first = false;
+                    }
+                    out << "#" << m_context.bool_var2expr(v)->get_id() << " ";
+                }
+            }
+            if (!first)
+                out << "\n";
+        }
+    };
+}
+
 namespace smt {
     case_split_queue * mk_case_split_queue(context & ctx, smt_params & p) {
         if (ctx.relevancy_lvl() < 2 && (p.m_case_split_strategy == CS_RELEVANCY || p.m_case_split_strategy == CS_RELEVANCY_ACTIVITY || 
@@ -1274,6 +1433,8 @@ namespace smt {
             return alloc(rel_goal_case_split_queue, ctx, p);
         case CS_ACTIVITY_THEORY_AWARE_BRANCHING:
             return alloc(theory_aware_branching_queue, ctx, p);
+        case CS_ACTIVITY_THEORY_SCORE:
+            return alloc(theory_score_case_split_queue, ctx, p);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
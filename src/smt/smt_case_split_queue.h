@@ -49,6 +49,9 @@ namespace smt {
 
         // theory-aware branching hint
         virtual void add_theory_aware_branching_info(bool_var v, double priority, lbool phase) {}
+
+        // batch update of theory scores
+        virtual void set_theory_scores(unsigned n, bool_var const* vs, double const* scores) {}
     };
 
     case_split_queue * mk_case_split_queue(context & ctx, smt_params & p);
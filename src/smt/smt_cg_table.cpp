@@ -51,6 +51,11 @@ namespace smt {
         return c;
     }
 
+    cg_table::cg_entry::cg_entry(enode * n):
+        m_node(n),
+        m_hash(cg_hash()(n)) {
+    }
+
     bool cg_table::cg_eq::operator()(enode * n1, enode * n2) const {
         SASSERT(n1->get_decl() == n2->get_decl());
         unsigned num = n1->get_num_args();
@@ -197,8 +202,8 @@ namespace smt {
     void cg_table::display_nary(std::ostream& out, void* t) const {
         table* tb = UNTAG(table*, t);
         out << "nary ";
-        for (enode* n : *tb) {
-            out << n->get_owner_id() << " ";
+        for (cg_entry const& e : *tb) {
+            out << e.m_node->get_owner_id() << " ";
         }
         out << "\n";
     }
@@ -225,7 +230,7 @@ namespace smt {
             n_prime = UNTAG(comm_table*, t)->insert_if_not_there(n);
             return enode_bool_pair(n_prime, m_commutativity);
         default:
-            n_prime = UNTAG(table*, t)->insert_if_not_there(n);
+            n_prime = UNTAG(table*, t)->insert_if_not_there(cg_entry(n)).m_node;
             return enode_bool_pair(n_prime, false);
         }
     }
@@ -245,7 +250,7 @@ namespace smt {
             UNTAG(comm_table*, t)->erase(n);
             break;
         default:
-            UNTAG(table*, t)->erase(n);
+            UNTAG(table*, t)->erase(cg_entry(n));
             break;
         }
     }
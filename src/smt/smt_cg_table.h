@@ -105,15 +105,33 @@ namespace smt {
 
         typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
 
+        /**
+           \brief Entries of n-ary tables cache the hash of the signature of the enode.
+           The signature does not change while the enode is in the table, so rehashing 
+           does not traverse the arguments, and entries with different hashes are 
+           distinguished without comparing arguments.
+        */
+        struct cg_entry {
+            enode *  m_node = nullptr;
+            unsigned m_hash = 0;
+            cg_entry() = default;
+            cg_entry(enode * n);
+            friend std::ostream& operator<<(std::ostream& out, cg_entry const& e) { return out << e.m_node->get_owner_id(); }
+        };
+
         struct cg_hash {
             unsigned operator()(enode * n) const;
+            unsigned operator()(cg_entry const& e) const { return e.m_hash; }
         };
 
         struct cg_eq {
             bool operator()(enode * n1, enode * n2) const;
+            bool operator()(cg_entry const& e1, cg_entry const& e2) const { 
+                return e1.m_hash == e2.m_hash && (*this)(e1.m_node, e2.m_node); 
+            }
         };
 
-        typedef chashtable<enode*, cg_hash, cg_eq> table;
+        typedef chashtable<cg_entry, cg_hash, cg_eq> table;
 
         ast_manager &                 m_manager;
         bool                          m_commutativity; //!< true if the last found congruence used commutativity
@@ -163,7 +181,7 @@ namespace smt {
             case BINARY_COMM:
                 return UNTAG(comm_table*, t)->contains(n);
             default:
-                return UNTAG(table*, t)->contains(n);
+                return UNTAG(table*, t)->contains(cg_entry(n));
             }
         }
 
@@ -178,8 +196,10 @@ namespace smt {
                 return UNTAG(binary_table*, t)->find(n, r) ? r : nullptr;
             case BINARY_COMM:
                 return UNTAG(comm_table*, t)->find(n, r) ? r : nullptr;
-            default:
-                return UNTAG(table*, t)->find(n, r) ? r : nullptr;
+            default: {
+                cg_entry e;
+                return UNTAG(table*, t)->find(cg_entry(n), e) ? e.m_node : nullptr;
+            }
             }
         }
 
@@ -194,8 +214,10 @@ namespace smt {
                 return UNTAG(binary_table*, t)->find(n, r) && n == r;
             case BINARY_COMM:
                 return UNTAG(comm_table*, t)->find(n, r) && n == r;
-            default:
-                return UNTAG(table*, t)->find(n, r) && n == r;
+            default: {
+                cg_entry e;
+                return UNTAG(table*, t)->find(cg_entry(n), e) && n == e.m_node;
+            }
             }
         }
 
@@ -18,7 +18,22 @@ Revision History:
 #include "ast/ast_ll_pp.h"
 
 namespace smt {
-    clause_proof::clause_proof(context& ctx): ctx(ctx), m(ctx.get_manager()), m_lits(m) {}
+    clause_proof::clause_proof(context& ctx): ctx(ctx), m(ctx.get_manager()), m_lits(m), m_pp(m) {}
+
+    std::ostream* clause_proof::get_stream() {
+        if (!m_stream_init) {
+            m_stream_init = true;
+            symbol const& file = ctx.get_fparams().m_clause_proof_file;
+            if (file.is_non_empty_string()) {
+                m_out = alloc(std::ofstream, file.str());
+                if (!*m_out) {
+                    warning_msg("could not open clause proof file %s", file.str().c_str());
+                    m_out = nullptr;
+                }
+            }
+        }
+        return m_out.get();
+    }
 
     clause_proof::status clause_proof::kind2st(clause_kind k) {
         switch (k) {
@@ -91,7 +106,7 @@ namespace smt {
             m_lits.push_back(ctx.literal2expr(lit1));
             m_lits.push_back(ctx.literal2expr(lit2));
             proof* pr = justification2proof(j);
-            m_trail.push_back(info(kind2st(k), m_lits, pr));
+            update(kind2st(k), m_lits, pr);
         }
     }
 
@@ -103,6 +118,14 @@ namespace smt {
     void clause_proof::update(status st, expr_ref_vector& v, proof* p) {
         TRACE("clause_proof", tout << m_trail.size() << " " << st << " " << v << "\n";);
         IF_VERBOSE(3, verbose_stream() << st << " " << v << "\n");
+        if (std::ostream* out = get_stream()) {
+            expr_ref fml = mk_or(v);
+            m_pp.collect(fml);
+            m_pp.display_decls(*out);
+            *out << "(" << st << " ";
+            m_pp.display_expr(*out, fml) << ")\n";
+            return;
+        }
         m_trail.push_back(info(st, v, p));
     }
 
@@ -121,6 +144,8 @@ namespace smt {
         if (!ctx.get_fparams().m_clause_proof) {
             return proof_ref(m);
         }
+        if (m_out)
+            m_out->flush();
         proof_ref_vector ps(m);
         for (auto& info : m_trail) {
             expr_ref fact = mk_or(info.m_clause);
@@ -26,6 +26,8 @@ Revision History:
 --*/
 #pragma once
 
+#include <fstream>
+#include "ast/ast_pp_util.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_clause.h"
 
@@ -54,6 +56,12 @@ namespace smt {
         ast_manager& m;
         expr_ref_vector m_lits;
         vector<info> m_trail;
+        // when smt.clause_proof_file is set, records are written as they are
+        // produced and the in-memory trail stays empty.
+        scoped_ptr<std::ofstream> m_out;
+        ast_pp_util  m_pp;
+        bool         m_stream_init = false;
+        std::ostream* get_stream();
         void update(status st, expr_ref_vector& v, proof* p);
         void update(clause& c, status st, proof* p);
         status kind2st(clause_kind k);
@@ -520,8 +520,16 @@ namespace smt {
             case b_justification::CLAUSE: {
                 clause * cls = js.get_clause();
                 TRACE("conflict_smt2", m_ctx.display_clause_smt2(tout, *cls););
-                if (cls->is_lemma())
+                if (cls->is_lemma()) {
                     cls->inc_clause_activity();
+                    if (cls->is_th_lemma())
+                        m_dyn_ack_manager.used_clause_eh(cls);
+                    if (m_params.m_lemma_gc_tier2_glue > 0 && cls->get_glue() > m_params.m_lemma_gc_core_glue) {
+                        unsigned glue = m_ctx.compute_glue(cls->get_num_literals(), cls->begin());
+                        if (glue < cls->get_glue())
+                            cls->set_glue(glue);
+                    }
+                }
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
@@ -23,6 +23,7 @@ Revision History:
 #include "ast/datatype_decl_plugin.h"
 #include "model/model_pp.h"
 #include "smt/smt_context.h"
+#include "smt/smt_parallel.h"
 
 namespace smt {
 
@@ -274,6 +275,11 @@ namespace smt {
                                     expr_ref_vector& conseq, 
                                     expr_ref_vector& unfixed) {
 
+        if (m_fparams.m_threads > 1 && vars0.size() > 1 && !m.has_trace_stream()) {
+            parallel p(*this);
+            return p.get_consequences(assumptions0, vars0, conseq, unfixed);
+        }
+
         m_antecedents.reset();
         m_antecedents.insert(true_literal.var(), index_set());
         pop_to_base_lvl();
@@ -20,6 +20,7 @@ Revision History:
 #include "util/luby.h"
 #include "util/warning.h"
 #include "util/timeit.h"
+#include "util/scoped_profile.h"
 #include "util/union_find.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -119,8 +120,14 @@ namespace smt {
     }
 
     void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
+        ast_translation tr(src_ctx.get_manager(), dst_ctx.get_manager(), false);
+        copy(src_ctx, dst_ctx, tr, override_base);
+    }
+
+    void context::copy(context& src_ctx, context& dst_ctx, ast_translation& tr, bool override_base) {
         ast_manager& dst_m = dst_ctx.get_manager();
         ast_manager& src_m = src_ctx.get_manager();
+        SASSERT(&tr.from() == &src_m && &tr.to() == &dst_m);
         src_ctx.pop_to_base_lvl();
 
         if (!override_base && src_ctx.m_base_lvl > 0) {
@@ -128,8 +135,6 @@ namespace smt {
         }
         SASSERT(src_ctx.m_base_lvl == 0 || override_base);
 
-        ast_translation tr(src_m, dst_m, false);
-
         dst_ctx.set_logic(src_ctx.m_setup.get_logic());
         dst_ctx.copy_plugins(src_ctx, dst_ctx);
 
@@ -1692,6 +1697,7 @@ namespace smt {
        congruences cannot be retracted to a consistent state.
      */
     bool context::propagate() {
+        scoped_profile _profile("smt.propagate");
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
         while (true) {
             if (inconsistent())
@@ -1784,6 +1790,8 @@ namespace smt {
         bool_var_data & d = m_bdata[var];
         if (d.try_true_first())
             return true;
+        if (m_stable_search && var < m_target_phase.size() && m_target_phase[var] != l_undef)
+            return m_target_phase[var] == l_true;
         switch (m_fparams.m_phase_selection) {
         case PS_THEORY:
             if (m_phase_cache_on && d.m_phase_available) {
@@ -1918,6 +1926,43 @@ namespace smt {
         }
     }
 
+    /**
+       \brief In stable mode, record the assignment below the current decision level
+       as target phase when it is the longest conflict free trail seen so far.
+    */
+    void context::update_target_phase() {
+        if (!m_stable_search || m_scope_lvl == 0)
+            return;
+        unsigned head = m_scopes[m_scope_lvl - 1].m_assigned_literals_lim;
+        if (head <= m_target_phase_size)
+            return;
+        m_target_phase_size = head;
+        for (unsigned i = 0; i < head; ++i) {
+            literal l = m_assigned_literals[i];
+            m_target_phase.setx(l.var(), l.sign() ? l_false : l_true, l_undef);
+        }
+    }
+
+    /**
+       \brief Switch between focused search, which restarts according to restart_strategy,
+       and stable search, which restarts following a scaled luby sequence and uses target phases.
+    */
+    void context::toggle_search_mode() {
+        m_stable_search = !m_stable_search;
+        m_target_phase_size = 0;
+        if (m_stable_search) {
+            m_focused_restart_threshold = m_restart_threshold;
+            m_restart_threshold = static_cast<unsigned>(10 * get_luby(m_stable_luby_idx) * m_fparams.m_restart_initial);
+        }
+        else {
+            m_restart_threshold = m_focused_restart_threshold;
+            m_mode_switch_inc += m_fparams.m_restart_stable_conflicts;
+        }
+        m_mode_switch_lim = m_num_conflicts + m_mode_switch_inc;
+        m_stats.m_num_mode_switches++;
+        IF_VERBOSE(2, verbose_stream() << "(smt.search-mode " << (m_stable_search ? "stable" : "focused") << ")\n");
+    }
+
     /**
        \brief Create an internal backtracking point
     */
@@ -1954,7 +1999,7 @@ namespace smt {
        \brief Execute generic undo-objects.
     */
     void context::undo_trail_stack(unsigned old_size) {
-        ::undo_trail_stack(m_trail_stack, old_size);
+        m_trail_stack.undo(old_size);
     }
 
     /**
@@ -2707,8 +2752,18 @@ namespace smt {
         SASSERT(check_clauses(m_lemmas) && check_clauses(m_aux_clauses));
     }
 
+    /**
+       \brief Order lemmas by tier (core, tier2, local) and then by decreasing activity.
+    */
     struct clause_lt {
-        bool operator()(clause * cls1, clause * cls2) const { return cls1->get_activity() > cls2->get_activity(); }
+        context const & m_ctx;
+        clause_lt(context const & ctx): m_ctx(ctx) {}
+        bool operator()(clause * cls1, clause * cls2) const { 
+            unsigned t1 = m_ctx.lemma_tier(cls1), t2 = m_ctx.lemma_tier(cls2);
+            if (t1 != t2)
+                return t1 < t2;
+            return cls1->get_activity() > cls2->get_activity(); 
+        }
     };
 
     /**
@@ -2717,7 +2772,10 @@ namespace smt {
     inline void context::del_inactive_lemmas() {
         if (m_fparams.m_lemma_gc_strategy == LGC_NONE)
             return;
-        else if (m_fparams.m_lemma_gc_half)
+        scoped_profile _profile("smt.gc");
+        if (m_fparams.m_lemma_subsumption_budget > 0)
+            subsume_lemmas();
+        if (m_fparams.m_lemma_gc_half)
             del_inactive_lemmas1();
         else
             del_inactive_lemmas2();
@@ -2727,6 +2785,99 @@ namespace smt {
             m_lemma_gc_threshold = static_cast<unsigned>(m_lemma_gc_threshold * m_fparams.m_lemma_gc_factor);
     }
 
+    /**
+       \brief Delete lemmas of the current base level that are subsumed by
+       another lemma of the same level. Lemmas are processed by increasing size
+       and candidates are taken from the occurrence list of the least frequent
+       literal. The number of literals visited is bounded by m_lemma_subsumption_budget.
+    */
+    void context::subsume_lemmas() {
+        unsigned sz            = m_lemmas.size();
+        unsigned start_at      = m_base_lvl == 0 ? 0 : m_base_scopes[m_base_lvl - 1].m_lemmas_lim;
+        if (start_at + 1 >= sz)
+            return;
+        unsigned num_lits = 2 * get_num_bool_vars();
+        vector<clause_vector> occs;
+        occs.resize(num_lits);
+        clause_vector cands;
+        for (unsigned i = start_at; i < sz; i++) {
+            clause * cls = m_lemmas[i];
+            if (cls->deleted())
+                continue;
+            cands.push_back(cls);
+            for (literal l : *cls)
+                occs[l.index()].push_back(cls);
+        }
+        std::stable_sort(cands.begin(), cands.end(), 
+                         [](clause* a, clause* b) { return a->get_num_literals() < b->get_num_literals(); });
+        
+        ptr_addr_hashtable<clause> subsumed;
+        svector<bool> marked(num_lits, false);
+        unsigned budget = m_fparams.m_lemma_subsumption_budget;
+        for (clause * d : cands) {
+            if (budget == 0)
+                break;
+            if (subsumed.contains(d))
+                continue;
+            unsigned d_sz = d->get_num_literals();
+            literal best = d->get_literal(0);
+            for (literal l : *d) {
+                marked[l.index()] = true;
+                if (occs[l.index()].size() < occs[best.index()].size())
+                    best = l;
+            }
+            for (clause * c : occs[best.index()]) {
+                if (c == d || c->get_num_literals() < d_sz || subsumed.contains(c))
+                    continue;
+                unsigned c_sz = c->get_num_literals();
+                budget = budget > c_sz ? budget - c_sz : 0;
+                unsigned num_marked = 0;
+                for (literal l : *c)
+                    if (marked[l.index()])
+                        num_marked++;
+                if (num_marked == d_sz && can_delete(c)) 
+                    subsumed.insert(c);
+                if (budget == 0)
+                    break;
+            }
+            for (literal l : *d)
+                marked[l.index()] = false;
+        }
+        if (subsumed.empty())
+            return;
+
+        unsigned j = start_at;
+        for (unsigned i = start_at; i < sz; i++) {
+            clause * cls = m_lemmas[i];
+            if (subsumed.contains(cls)) 
+                del_clause(true, cls);
+            else
+                m_lemmas[j++] = cls;
+        }
+        m_lemmas.shrink(j);
+        m_stats.m_num_subsumed_lemmas += subsumed.size();
+        IF_VERBOSE(2, verbose_stream() << "(smt.subsume-lemmas :num-subsumed " << subsumed.size() << ")\n";);
+    }
+
+    /**
+       \brief Release memory before the high watermark or the memory limit is reached:
+       delete half of the inactive lemmas, flush the rewriter caches, drop the models
+       of the previous check and return unused chunks of the allocator and the ast table.
+       Fingerprints of instances are scoped with the search and are kept.
+    */
+    void context::reclaim_memory() {
+        scoped_profile _profile("smt.reclaim_memory");
+        IF_VERBOSE(2, verbose_stream() << "(smt.reclaim-memory :memory " << memory::get_allocation_size() << ")\n";);
+        m_reclaim_memory_conflicts = m_num_conflicts;
+        m_stats.m_num_memory_gcs++;
+        if (m_fparams.m_lemma_gc_strategy != LGC_NONE)
+            del_inactive_lemmas1();
+        m_rewriter.reset();
+        m_asserted_formulas.flush_cache();
+        reset_model();
+        m.compact_memory();
+    }
+
     /**
        \brief Delete (approx.) half of low activity lemmas
     */
@@ -2740,7 +2891,7 @@ namespace smt {
         SASSERT (m_fparams.m_recent_lemmas_size < sz);
         unsigned end_at        = sz - m_fparams.m_recent_lemmas_size;
         SASSERT(start_at < end_at);
-        std::stable_sort(m_lemmas.begin() + start_at, m_lemmas.begin() + end_at, clause_lt());
+        std::stable_sort(m_lemmas.begin() + start_at, m_lemmas.begin() + end_at, clause_lt(*this));
         unsigned start_del_at  = (start_at + end_at) / 2;
         unsigned i             = start_del_at;
         unsigned j             = i;
@@ -2749,7 +2900,7 @@ namespace smt {
               << ", start_del_at: " << start_del_at << "\n";);
         for (; i < end_at; i++) {
             clause * cls = m_lemmas[i];
-            if (can_delete(cls)) {
+            if (can_delete(cls) && (cls->deleted() || lemma_tier(cls) != 0)) {
                 TRACE("del_inactive_lemmas", tout << "deleting: "; display_clause(tout, cls); tout << ", activity: " <<
                       cls->get_activity() << "\n";);
                 del_clause(true, cls);
@@ -2810,12 +2961,16 @@ namespace smt {
                     num_del_cls++;
                     continue;
                 }
+                unsigned tier = lemma_tier(cls);
                 // A clause is deleted if it has low activity and the number of unknowns is greater than a threshold.
                 // The activity threshold depends on how old the clause is.
                 unsigned act_threshold = m_fparams.m_old_clause_activity -
                     (m_fparams.m_old_clause_activity - m_fparams.m_new_clause_activity) * ((i - start_at) / real_sz);
-                if (cls->get_activity() < act_threshold) {
+                // Core lemmas are kept, and lemmas in tier2 get a more permissive relevancy threshold.
+                if (tier != 0 && cls->get_activity() < act_threshold) {
                     unsigned rel_threshold = (i >= new_first_idx ? m_fparams.m_new_clause_relevancy : m_fparams.m_old_clause_relevancy);
+                    if (tier == 1)
+                        rel_threshold *= 2;
                     if (more_than_k_unassigned_literals(cls, rel_threshold)) {
                         del_clause(true, cls);
                         num_del_cls++;
@@ -2832,6 +2987,29 @@ namespace smt {
         IF_VERBOSE(2, verbose_stream() << " :num-deleted-clauses " << num_del_cls << ")" << std::endl;);
     }
 
+    unsigned context::compute_glue(unsigned num_lits, literal const * lits) {
+        if (m_glue_lvl_stamp.size() <= m_scope_lvl) 
+            m_glue_lvl_stamp.resize(m_scope_lvl + 1, 0);
+        if (++m_glue_stamp == 0) {
+            m_glue_lvl_stamp.fill(0);
+            m_glue_stamp = 1;
+        }
+        unsigned glue = 0;
+        for (unsigned i = 0; i < num_lits; i++) {
+            literal l = lits[i];
+            if (get_assignment(l) == l_undef) {
+                glue++;
+                continue;
+            }
+            unsigned lvl = get_assign_level(l);
+            if (m_glue_lvl_stamp[lvl] != m_glue_stamp) {
+                m_glue_lvl_stamp[lvl] = m_glue_stamp;
+                glue++;
+            }
+        }
+        return glue;
+    }
+
     /**
        \brief Return true if "cls" has more than (or equal to) k unassigned literals.
     */
@@ -3093,6 +3271,10 @@ namespace smt {
         m_case_split_queue->add_theory_aware_branching_info(v, priority, phase);
     }
 
+    void context::set_theory_scores(unsigned n, bool_var const* vs, double const* scores) {
+        m_case_split_queue->set_theory_scores(n, vs, scores);
+    }
+
     void context::undo_th_case_split(literal l) {
         m_all_th_case_split_literals.remove(l.index());
         if (m_literal2casesplitsets.contains(l.index())) {
@@ -3647,6 +3829,7 @@ namespace smt {
         m_qmanager->init_search_eh();
         m_incomplete_theories.reset();
         m_num_conflicts                = 0;
+        m_reclaim_memory_conflicts     = 0;
         m_num_conflicts_since_restart  = 0;
         m_num_conflicts_since_lemma_gc = 0;
         m_num_restarts                 = 0;
@@ -3661,8 +3844,15 @@ namespace smt {
         m_dyn_ack_manager              .init_search_eh();
         m_final_check_idx              = 0;
         m_phase_default                = false;
+        m_stable_search                = false;
+        m_mode_switch_inc              = m_fparams.m_restart_stable_conflicts;
+        m_mode_switch_lim              = m_mode_switch_inc;
+        m_stable_luby_idx              = 1;
+        m_target_phase_size            = 0;
+        m_target_phase                 .reset();
         m_case_split_queue             ->init_search_eh();
         m_next_progress_sample         = 0;
+        m_next_stats_snapshot          = m_timer.get_seconds();
         TRACE("literal_occ", display_literal_num_occs(tout););
     }
 
@@ -3671,6 +3861,14 @@ namespace smt {
     }
 
     void context::inc_limits() {
+        if (m_stable_search) {
+            if (m_num_conflicts_since_restart >= m_restart_threshold) {
+                m_stable_luby_idx++;
+                m_restart_threshold = static_cast<unsigned>(10 * get_luby(m_stable_luby_idx) * m_fparams.m_restart_initial);
+            }
+            m_num_conflicts_since_restart = 0;
+            return;
+        }
         if (m_num_conflicts_since_restart >= m_restart_threshold) {
             switch (m_fparams.m_restart_strategy) {
             case RS_GEOMETRIC:
@@ -3701,6 +3899,7 @@ namespace smt {
 
 
     lbool context::search() {
+        scoped_profile _profile("smt.search");
         if (m_asserted_formulas.inconsistent()) {
             asserted_inconsistent();
             return l_false;
@@ -3746,6 +3945,7 @@ namespace smt {
     }
 
     bool context::restart(lbool& status, unsigned curr_lvl) {
+        scoped_profile _profile("smt.restart");
         SASSERT(status != l_true || !inconsistent());
 
         reset_model();
@@ -3781,10 +3981,13 @@ namespace smt {
             status = l_undef;
             return false;
         }
+        if (m_fparams.m_restart_stable && m_num_conflicts >= m_mode_switch_lim)
+            toggle_search_mode();
         inc_limits();
         if (status == l_true || !m_fparams.m_restart_adaptive || m_agility < m_fparams.m_restart_agility_threshold) {
             SASSERT(!inconsistent());
             log_stats();
+            snapshot_stats();
             // execute the restart
             m_stats.m_num_restarts++;
             m_num_restarts++;
@@ -3879,6 +4082,11 @@ namespace smt {
                     del_inactive_lemmas();
                 }
 
+                if (m_num_conflicts >= m_reclaim_memory_conflicts + m_fparams.m_recent_lemmas_size &&
+                    memory::under_pressure()) {
+                    reclaim_memory();
+                }
+
                 m_dyn_ack_manager.propagate_eh();
                 CASSERT("dyn_ack", check_clauses(m_lemmas) && check_clauses(m_aux_clauses));
             }
@@ -3950,6 +4158,7 @@ namespace smt {
     }
 
     final_check_status context::final_check() {
+        scoped_profile _profile("smt.final_check");
         TRACE("final_check", tout << "final_check inconsistent: " << inconsistent() << "\n"; display(tout); display_normalized_enodes(tout););
         CASSERT("relevancy", check_relevancy());
         
@@ -4046,11 +4255,26 @@ namespace smt {
     }
 
 
+    /**
+       \brief Return true if the context should backtrack only one level below the
+       conflict level instead of backjumping to new_lvl.
+       Unit lemmas are excluded: they are asserted at the base level.
+    */
+    bool context::use_chrono_backtrack(unsigned num_lits, unsigned conflict_lvl, unsigned new_lvl) const {
+        return
+            m_fparams.m_backtrack_scopes > 0 &&
+            num_lits > 1 &&
+            conflict_lvl > new_lvl + m_fparams.m_backtrack_scopes &&
+            m_stats.m_num_conflicts > m_fparams.m_backtrack_conflicts;
+    }
+
     bool context::resolve_conflict() {
+        scoped_profile _profile("smt.conflict");
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
         m_num_conflicts_since_lemma_gc ++;
+        update_target_phase();
         switch (m_conflict.get_kind()) {
         case b_justification::CLAUSE:
         case b_justification::BIN_CLAUSE:
@@ -4093,6 +4317,14 @@ namespace smt {
             if (delay_forced_restart) {
                 new_lvl = conflict_lvl - 1;
             }
+            else if (use_chrono_backtrack(num_lits, conflict_lvl, new_lvl)) {
+                // The lemma is asserting at conflict_lvl - 1, so its first literal
+                // is assigned at that level instead of the lower backjump level.
+                // This keeps the assignments of the levels in between, which
+                // would otherwise be undone and propagated again.
+                new_lvl = conflict_lvl - 1;
+                m_stats.m_num_chrono_backtracks++;
+            }
 
             // Some of the literals/enodes of the conflict clause will be destroyed during
             // backtracking, and will need to be recreated. However, I want to keep
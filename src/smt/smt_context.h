@@ -52,6 +52,8 @@ Revision History:
 #include "solver/assertions/asserted_formulas.h"
 #include <tuple>
 
+class ast_translation;
+
 // there is a significant space overhead with allocating 1000+ contexts in
 // the case that each context only references a few expressions.
 // Using a map instead of a vector for the literals can compress space
@@ -94,6 +96,7 @@ namespace smt {
         mutable unsigned            m_lemma_id;
         progress_callback *         m_progress_callback;
         unsigned                    m_next_progress_sample;
+        double                      m_next_stats_snapshot = 0;
         clause_proof                m_clause_proof;
         region                      m_region;
         fingerprint_set             m_fingerprints;
@@ -173,6 +176,8 @@ namespace smt {
         svector<double>             m_activity;
         clause_vector               m_aux_clauses;
         clause_vector               m_lemmas;
+        unsigned_vector             m_glue_lvl_stamp; //!< per scope level, used by compute_glue
+        unsigned                    m_glue_stamp = 0;
         vector<clause_vector>       m_clauses_to_reinit;
         expr_ref_vector             m_units_to_reassert;
         svector<char>               m_units_to_reassert_sign;
@@ -456,6 +461,12 @@ namespace smt {
             return get_assign_level(l.var());
         }
 
+        /**
+           \brief Return the number of distinct scope levels of the given literals.
+           Unassigned literals count as a level of their own.
+        */
+        unsigned compute_glue(unsigned num_lits, literal const * lits);
+
         /**
            \brief Return the scope level when v was internalized.
         */
@@ -601,8 +612,7 @@ namespace smt {
         //
         // -----------------------------------
     protected:
-        typedef ptr_vector<trail >   trail_stack;
-        trail_stack                           m_trail_stack;
+        typed_trail                           m_trail_stack;
 #ifdef Z3DEBUG
         bool                                  m_trail_enabled { true };
 #endif
@@ -611,11 +621,12 @@ namespace smt {
         template<typename TrailObject>
         void push_trail(const TrailObject & obj) {
             SASSERT(m_trail_enabled);
-            m_trail_stack.push_back(new (m_region) TrailObject(obj));
+            if (!m_trail_stack.push_typed(obj))
+                m_trail_stack.push_ptr(new (m_region) TrailObject(obj));
         }
 
         void push_trail_ptr(trail * ptr) {
-            m_trail_stack.push_back(ptr);
+            m_trail_stack.push_ptr(ptr);
         }
 
     protected:
@@ -956,6 +967,8 @@ namespace smt {
          */
         void add_theory_aware_branching_info(bool_var v, double priority, lbool phase);
 
+        void set_theory_scores(unsigned n, bool_var const* vs, double const* scores);
+
     public:
 
         // helper function for trail
@@ -996,8 +1009,17 @@ namespace smt {
         unsigned           m_restart_threshold;
         unsigned           m_restart_outer_threshold;
         unsigned           m_luby_idx;
+        // stable mode: rare restarts and target phases taken from the longest conflict-free trail
+        bool               m_stable_search { false };
+        unsigned           m_mode_switch_lim { 0 };
+        unsigned           m_mode_switch_inc { 0 };
+        unsigned           m_stable_luby_idx { 1 };
+        unsigned           m_focused_restart_threshold { 0 };
+        unsigned           m_target_phase_size { 0 };
+        svector<lbool>     m_target_phase;
         double             m_agility;
         unsigned           m_lemma_gc_threshold;
+        unsigned           m_reclaim_memory_conflicts { 0 };
 
         void assign_core(literal l, b_justification j, bool decision = false);
         void trace_assign(literal l, b_justification j, bool decision) const;
@@ -1147,6 +1169,10 @@ namespace smt {
 
         void update_phase_cache_counter();
 
+        void update_target_phase();
+
+        void toggle_search_mode();
+
 #define ACTIVITY_LIMIT 1e100
 #define INV_ACTIVITY_LIMIT 1e-100
 
@@ -1195,10 +1221,29 @@ namespace smt {
 
         void del_inactive_lemmas();
 
+        void reclaim_memory();
+
+    public:
+        /**
+           \brief Return 0, 1 and 2 for lemmas in the core, tier2 and local tier respectively.
+        */
+        unsigned lemma_tier(clause const * cls) const {
+            unsigned glue = cls->get_glue();
+            if (glue <= m_fparams.m_lemma_gc_core_glue)
+                return 0;
+            if (glue <= m_fparams.m_lemma_gc_tier2_glue)
+                return 1;
+            return 2;
+        }
+
+    protected:
+
         void del_inactive_lemmas1();
 
         void del_inactive_lemmas2();
 
+        void subsume_lemmas();
+
         bool more_than_k_unassigned_literals(clause * cls, unsigned k);
 
 
@@ -1244,6 +1289,8 @@ namespace smt {
 
         void forget_phase_of_vars_in_current_level();
 
+        bool use_chrono_backtrack(unsigned num_lits, unsigned conflict_lvl, unsigned new_lvl) const;
+
         virtual bool resolve_conflict();
 
 
@@ -1584,6 +1631,8 @@ namespace smt {
 
         void log_stats();
 
+        void snapshot_stats();
+
         void copy_user_propagator(context& src, bool copy_registered);
 
     public:
@@ -1603,6 +1652,13 @@ namespace smt {
 
         static void copy(context& src, context& dst, bool override_base = false);
 
+        /**
+           \brief Copy src into dst using the translation tr from the manager of src
+           to the manager of dst. The cache of tr is reused when further terms are
+           translated between the two contexts.
+        */
+        static void copy(context& src, context& dst, ast_translation& tr, bool override_base);
+
         /**
            \brief Translate context to use new manager m.
          */
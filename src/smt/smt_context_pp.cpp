@@ -412,15 +412,29 @@ namespace smt {
         st.update("propagations", m_stats.m_num_propagations + m_stats.m_num_bin_propagations);
         st.update("binary propagations", m_stats.m_num_bin_propagations);
         st.update("restarts", m_stats.m_num_restarts);
+        if (m_stats.m_num_chrono_backtracks > 0)
+            st.update("chronological backtracks", m_stats.m_num_chrono_backtracks);
+        if (m_stats.m_num_mode_switches > 0)
+            st.update("search mode switches", m_stats.m_num_mode_switches);
         st.update("final checks", m_stats.m_num_final_checks);
+        if (m_fingerprints.size() > 0) {
+            st.update("fingerprints", m_fingerprints.size());
+            st.update("fingerprint bytes", static_cast<double>(m_fingerprints.num_bytes()));
+        }
         st.update("added eqs", m_stats.m_num_add_eq);
         st.update("mk clause", m_stats.m_num_mk_clause);
         st.update("mk clause binary", m_stats.m_num_mk_bin_clause);        
         st.update("del clause", m_stats.m_num_del_clause);
+        st.update("memory pressure gc", m_stats.m_num_memory_gcs);
         st.update("dyn ack", m_stats.m_num_dyn_ack);
+        if (m_stats.m_num_useful_dyn_ack > 0)
+            st.update("dyn ack useful", m_stats.m_num_useful_dyn_ack);
+        if (m_stats.m_num_demoted_dyn_ack > 0)
+            st.update("dyn ack demoted", m_stats.m_num_demoted_dyn_ack);
         st.update("interface eqs", m_stats.m_num_interface_eqs);
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
+        st.update("subsumed lemmas", m_stats.m_num_subsumed_lemmas);
         st.update("num checks", m_stats.m_num_checks);
         st.update("mk bool var", m_stats.m_num_mk_bool_var ? m_stats.m_num_mk_bool_var - 1 : 0);
         m_qmanager->collect_statistics(st);
@@ -773,5 +787,27 @@ namespace smt {
         IF_VERBOSE(1, verbose_stream() << str);
     }
 
+    /**
+       \brief append the statistics, including the theories and the rates
+       of conflicts and propagations, as a JSON line to smt.stats.file.
+    */
+    void context::snapshot_stats() {
+        double secs = m_timer.get_seconds();
+        if (!m_fparams.m_stats_file.is_non_empty_string() || secs < m_next_stats_snapshot)
+            return;
+        m_next_stats_snapshot = secs + m_fparams.m_stats_interval / 1000.0;
+        ::statistics st;
+        collect_statistics(st);
+        get_memory_statistics(st);
+        st.update("time", secs);
+        if (secs > 0) {
+            st.update("conflicts/s", m_stats.m_num_conflicts / secs);
+            st.update("propagations/s", m_stats.m_num_propagations / secs);
+        }
+        std::ofstream out(m_fparams.m_stats_file.str(), std::ios::app);
+        out << "{\"solver\": \"smt\", \"stats\": ";
+        st.display_json(out) << "}\n";
+    }
+
 };
 
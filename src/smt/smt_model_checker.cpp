@@ -49,6 +49,7 @@ namespace smt {
         m_iteration_idx(0),
         m_curr_model(nullptr),
         m_fresh_exprs(m),
+        m_valid_bodies_pinned(m),
         m_pinned_exprs(m) {
     }
 
@@ -157,20 +158,31 @@ namespace smt {
     }
 
     /**
-       \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
-
-       The variables are replaced by skolem constants. These constants are stored in sks.
+       \brief Apply the interpretation in m_curr_model to the uninterpreted symbols in the body of q.
     */
-
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
-        expr_ref tmp(m);
-        
+    bool model_checker::eval_q_m(quantifier * q, expr_ref & result) {
         TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
-
-        if (!m_curr_model->eval(q->get_expr(), tmp, true)) {
+        if (!m_curr_model->eval(q->get_expr(), result, true)) {
             return false;
         }
-        TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(tmp, m) << "\n";);
+        TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(result, m) << "\n";);
+        return true;
+    }
+
+    bool model_checker::has_finite_sort(quantifier * q) const {
+        for (unsigned i = 0; i < q->get_num_decls(); i++) 
+            if (m_curr_model->is_finite(q->get_decl_sort(i)))
+                return true;
+        return false;
+    }
+
+    /**
+       \brief Assert the negation of body, the result of eval_q_m.
+
+       The variables are replaced by skolem constants. These constants are stored in sks.
+    */
+
+    void model_checker::assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks) {
         ptr_buffer<expr> subst_args;
         unsigned num_decls = q->get_num_decls();
         subst_args.resize(num_decls, nullptr);
@@ -186,12 +198,11 @@ namespace smt {
         }
 
         var_subst s(m);
-        expr_ref sk_body = s(tmp, subst_args.size(), subst_args.data());
+        expr_ref sk_body = s(body, subst_args.size(), subst_args.data());
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE("model_checker", tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
         m_aux_context->assert_expr(r);
-        return true;
     }
 
     bool model_checker::add_instance(quantifier * q, model * cex, expr_ref_vector & sks, bool use_inv) {
@@ -335,20 +346,35 @@ namespace smt {
 
     bool model_checker::check(quantifier * q) {
         SASSERT(!m_aux_context->relevancy());
-        scoped_ctx_push _push(m_aux_context.get());
-
         quantifier * flat_q = get_flat_quantifier(q);
         TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
-        expr_ref_vector sks(m);
-
-        if (!assert_neg_q_m(flat_q, sks))
+        expr_ref body(m);
+        if (!eval_q_m(flat_q, body))
             return false;
+        if (m.is_true(body) || m_valid_bodies.contains(body)) {
+            TRACE("model_checker", tout << "body is known to be valid\n";);
+            return true;
+        }
+
+        scoped_ctx_push _push(m_aux_context.get());
+        expr_ref_vector sks(m);
+        assert_neg_q_m(flat_q, body, sks);
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
         flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
         lbool r = m_aux_context->check();
         
         TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
+        if (r == l_false && !has_finite_sort(flat_q)) {
+            // without universe restrictions the result only depends on body
+            unsigned const max_valid_bodies = 10000;
+            if (m_valid_bodies_pinned.size() >= max_valid_bodies) {
+                m_valid_bodies.reset();
+                m_valid_bodies_pinned.reset();
+            }
+            m_valid_bodies.insert(body);
+            m_valid_bodies_pinned.push_back(body);
+        }
         if (r != l_true) {
             return r == l_false; // quantifier is satisfied by m_curr_model
         }
@@ -531,6 +557,8 @@ namespace smt {
 
     void model_checker::reset() {
         reset_new_instances();
+        m_valid_bodies.reset();
+        m_valid_bodies_pinned.reset();
     }
 
     void model_checker::assert_new_instances() {
@@ -53,6 +53,11 @@ namespace smt {
         proto_model *                               m_curr_model;
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
+        // quantifier bodies, after applying a model, whose negation was shown unsat.
+        // the satisfiability of the negation does not depend on the model, so the entries
+        // remain valid across rounds.
+        obj_hashtable<expr>                         m_valid_bodies;
+        expr_ref_vector                             m_valid_bodies_pinned;
 
         friend class model_instantiation_set;
 
@@ -62,7 +67,9 @@ namespace smt {
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
         void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        bool eval_q_m(quantifier * q, expr_ref & result);
+        void assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks);
+        bool has_finite_sort(quantifier * q) const;
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
@@ -60,16 +60,65 @@ namespace smt {
         //
         // -----------------------------------
 
+        /**
+           \brief Check whether ground terms contain model values.
+           Instantiation sets are rebuilt in every model-based instantiation round,
+           mostly from the same ground terms, so the results are kept across rounds.
+        */
+        class model_value_checker {
+            ast_manager&         m;
+            obj_map<expr, bool>  m_cache;
+            expr_ref_vector      m_pinned;
+            expr_mark            m_visited;
+        public:
+            model_value_checker(ast_manager& m): m(m), m_pinned(m) {}
+
+            struct is_model_value {};
+            void operator()(expr* n) {
+                if (m.is_model_value(n)) {
+                    throw is_model_value();
+                }
+            }
+
+            bool contains_model_value(expr* n) {
+                if (m.is_model_value(n)) {
+                    return true;
+                }
+                if (is_app(n) && to_app(n)->get_num_args() == 0) {
+                    return false;
+                }
+                bool r = false;
+                if (m_cache.find(n, r)) {
+                    return r;
+                }
+                m_visited.reset();
+                try {
+                    for_each_expr(*this, m_visited, n);
+                }
+                catch (const is_model_value&) {
+                    r = true;
+                }
+                m_pinned.push_back(n);
+                m_cache.insert(n, r);
+                return r;
+            }
+
+            void reset() {
+                m_cache.reset();
+                m_pinned.reset();
+            }
+        };
+
         /**
            \brief Instantiation sets are the S_{k,j} sets in the Complete quantifier instantiation paper.
         */
         class instantiation_set {
             ast_manager&            m;
+            model_value_checker&    m_checker;
             obj_map<expr, unsigned> m_elems; // and the associated generation
             obj_map<expr, expr*>    m_inv;
-            expr_mark               m_visited;
         public:
-            instantiation_set(ast_manager& m) :m(m) {}
+            instantiation_set(ast_manager& m, model_value_checker& checker) :m(m), m_checker(checker) {}
 
             ~instantiation_set() {
                 for (auto const& kv : m_elems) {
@@ -147,28 +196,8 @@ namespace smt {
                 return m_inv;
             }
 
-            struct is_model_value {};
-            void operator()(expr* n) {
-                if (m.is_model_value(n)) {
-                    throw is_model_value();
-                }
-            }
-
             bool contains_model_value(expr* n) {
-                if (m.is_model_value(n)) {
-                    return true;
-                }
-                if (is_app(n) && to_app(n)->get_num_args() == 0) {
-                    return false;
-                }
-                m_visited.reset();
-                try {
-                    for_each_expr(*this, m_visited, n);
-                }
-                catch (const is_model_value&) {
-                    return true;
-                }
-                return false;
+                return m_checker.contains_model_value(n);
             }
         };
 
@@ -286,10 +315,10 @@ namespace smt {
                 return get_root()->m_signed_proj;
             }
 
-            void mk_instantiation_set(ast_manager& m) {
+            void mk_instantiation_set(ast_manager& m, model_value_checker& checker) {
                 SASSERT(is_root());
                 SASSERT(!m_set);
-                m_set = alloc(instantiation_set, m);
+                m_set = alloc(instantiation_set, m, checker);
             }
 
             void insert(expr* n, unsigned generation) {
@@ -403,6 +432,7 @@ namespace smt {
             expr_ref_vector*          m_new_constraints{ nullptr };
             random_gen                m_rand;
             func_decl_set             m_specrels;
+            model_value_checker       m_model_values;  // persists across rounds
 
 
             void reset_sort2k() {
@@ -460,7 +490,8 @@ namespace smt {
                 m_array(m),
                 m_ks(m),
                 m_eval_cache_range(m),
-                m_rand(static_cast<unsigned>(m.limit().count())) {
+                m_rand(static_cast<unsigned>(m.limit().count())),
+                m_model_values(m) {
                 m.limit().inc();
             }
 
@@ -482,6 +513,12 @@ namespace smt {
                 reset_sort2k();
             }
 
+            void reset_model_values() {
+                m_model_values.reset();
+            }
+
+            model_value_checker& get_model_value_checker() { return m_model_values; }
+
             void set_specrels(context& c) {
                 m_specrels.reset();
                 c.get_specrels(m_specrels);
@@ -520,7 +557,7 @@ namespace smt {
             void mk_instantiation_sets() {
                 for (node* curr : m_nodes) {
                     if (curr->is_root()) {
-                        curr->mk_instantiation_set(m);
+                        curr->mk_instantiation_set(m, m_model_values);
                     }
                 }
             }
@@ -1170,7 +1207,7 @@ namespace smt {
             virtual void populate_inst_sets2(quantifier* q, auf_solver& s, context* ctx) {}
 
             // Macro/Hint support
-            virtual void populate_inst_sets(quantifier* q, func_decl* mhead, ptr_vector<instantiation_set>& uvar_inst_sets, context* ctx) {}
+            virtual void populate_inst_sets(quantifier* q, func_decl* mhead, ptr_vector<instantiation_set>& uvar_inst_sets, auf_solver& s, context* ctx) {}
         };
 
         class f_var : public qinfo {
@@ -1235,20 +1272,20 @@ namespace smt {
                 }
             }
 
-            void populate_inst_sets(quantifier* q, func_decl* mhead, ptr_vector<instantiation_set>& uvar_inst_sets, context* ctx) override {
+            void populate_inst_sets(quantifier* q, func_decl* mhead, ptr_vector<instantiation_set>& uvar_inst_sets, auf_solver& s, context* ctx) override {
                 if (m_f != mhead)
                     return;
                 uvar_inst_sets.reserve(m_var_j + 1, 0);
                 if (uvar_inst_sets[m_var_j] == 0)
-                    uvar_inst_sets[m_var_j] = alloc(instantiation_set, ctx->get_manager());
-                instantiation_set* s = uvar_inst_sets[m_var_j];
-                SASSERT(s != nullptr);
+                    uvar_inst_sets[m_var_j] = alloc(instantiation_set, ctx->get_manager(), s.get_model_value_checker());
+                instantiation_set* S = uvar_inst_sets[m_var_j];
+                SASSERT(S != nullptr);
 
                 for (enode* n : ctx->enodes_of(m_f)) {
                     if (ctx->is_relevant(n)) {
                         enode* e_arg = n->get_arg(m_arg_i);
                         expr* arg = e_arg->get_expr();
-                        s->insert(arg, e_arg->get_generation());
+                        S->insert(arg, e_arg->get_generation());
                     }
                 }
             }
@@ -1367,7 +1404,7 @@ namespace smt {
                 }
             }
 
-            void populate_inst_sets(quantifier* q, func_decl* mhead, ptr_vector<instantiation_set>& uvar_inst_sets, context* ctx) override {
+            void populate_inst_sets(quantifier* q, func_decl* mhead, ptr_vector<instantiation_set>& uvar_inst_sets, auf_solver& s, context* ctx) override {
                 // ignored when in macro
             }
 
@@ -1755,23 +1792,23 @@ namespace smt {
             }
 
 
-            void populate_macro_based_inst_sets(context* ctx, evaluator& ev) {
+            void populate_macro_based_inst_sets(context* ctx, auf_solver& s) {
                 SASSERT(m_the_one != 0);
                 if (m_uvar_inst_sets != nullptr)
                     return;
                 m_uvar_inst_sets = alloc(ptr_vector<instantiation_set>);
                 for (qinfo* qi : m_qinfo_vect)
-                    qi->populate_inst_sets(m_flat_q, m_the_one, *m_uvar_inst_sets, ctx);
-                for (instantiation_set* s : *m_uvar_inst_sets) {
-                    if (s != nullptr)
-                        s->mk_inverse(ev);
+                    qi->populate_inst_sets(m_flat_q, m_the_one, *m_uvar_inst_sets, s, ctx);
+                for (instantiation_set* S : *m_uvar_inst_sets) {
+                    if (S != nullptr)
+                        S->mk_inverse(s);
                 }
             }
 
-            instantiation_set* get_macro_based_inst_set(unsigned vidx, context* ctx, evaluator& ev) {
+            instantiation_set* get_macro_based_inst_set(unsigned vidx, context* ctx, auf_solver& s) {
                 if (m_the_one == nullptr)
                     return nullptr;
-                populate_macro_based_inst_sets(ctx, ev);
+                populate_macro_based_inst_sets(ctx, s);
                 return m_uvar_inst_sets->get(vidx, 0);
             }
 
@@ -2390,12 +2427,14 @@ namespace smt {
         scope& s = m_scopes[new_lvl];
         restore_quantifiers(s.m_quantifiers_lim);
         m_scopes.shrink(new_lvl);
+        m_auf_solver->reset_model_values();
     }
 
     void model_finder::reset() {
         m_scopes.reset();
         m_dependencies.reset();
         restore_quantifiers(0);
+        m_auf_solver->reset_model_values();
         SASSERT(m_q2info.empty());
         SASSERT(m_quantifiers.empty());
     }
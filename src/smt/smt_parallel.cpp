@@ -31,11 +31,18 @@ namespace smt {
     lbool parallel::operator()(expr_ref_vector const& asms) {
         return l_undef;
     }
+
+    lbool parallel::get_consequences(expr_ref_vector const& asms, expr_ref_vector const& vars, 
+                                     expr_ref_vector& conseq, expr_ref_vector& unfixed) {
+        flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
+        return ctx.get_consequences(asms, vars, conseq, unfixed);
+    }
 }
 
 #else
 
 #include <thread>
+#include "util/thread_pool.h"
 
 namespace smt {
     
@@ -46,6 +53,7 @@ namespace smt {
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
+        bool deterministic = ctx.get_fparams().m_threads_deterministic;
 
         // try first sequential with a low conflict budget to make super easy problems cheap
         unsigned max_c = std::min(thread_max_conflicts, 40u);
@@ -63,6 +71,9 @@ namespace smt {
         vector<smt_params> smt_params;
         scoped_ptr_vector<ast_manager> pms;
         scoped_ptr_vector<context> pctxs;
+        // translations to and from each worker are kept for all rounds,
+        // so terms shared between rounds are translated only once.
+        scoped_ptr_vector<ast_translation> to_worker, from_worker;
         vector<expr_ref_vector> pasms;
 
         ast_manager& m = ctx.m;
@@ -85,9 +96,11 @@ namespace smt {
             pms.push_back(new_m);
             pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
             context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
+            to_worker.push_back(alloc(ast_translation, m, *new_m));
+            from_worker.push_back(alloc(ast_translation, *new_m, m));
+            ast_translation& tr = *to_worker.back();
+            context::copy(ctx, new_ctx, tr, true);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
             pasms.push_back(tr(asms));
             sl.push_child(&(new_m->limit()));
         }
@@ -111,7 +124,7 @@ namespace smt {
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
                 pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
+                ast_translation& tr = *from_worker[i];
                 unsigned sz = pctx.assigned_literals().size();
                 for (unsigned j = unit_lim[i]; j < sz; ++j) {
                     literal lit = pctx.assigned_literals()[j];
@@ -128,7 +141,7 @@ namespace smt {
             unsigned sz = unit_trail.size();
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
+                ast_translation& tr = *to_worker[i];
                 for (unsigned j = unit_lim[i]; j < sz; ++j) {
                     expr_ref src(ctx.m), dst(pctx.m);
                     dst = tr(unit_trail.get(j));
@@ -171,6 +184,21 @@ namespace smt {
                 bool first = false;
                 {
                     std::lock_guard<std::mutex> lock(mux);
+                    if (deterministic) {
+                        // threads are not canceled, so every thread completes the round 
+                        // and the winner does not depend on scheduling: definite results 
+                        // take precedence over undef, ties go to the lowest thread id.
+                        bool better = 
+                            finished_id == UINT_MAX ||
+                            (r != l_undef && result == l_undef) ||
+                            ((r != l_undef) == (result != l_undef) && i < (int)finished_id);
+                        if (better) {
+                            finished_id = i;
+                            result = r;
+                        }
+                        done = true;
+                        return;
+                    }
                     if (finished_id == UINT_MAX) {
                         finished_id = i;
                         first = true;
@@ -215,13 +243,7 @@ namespace smt {
         // for debugging:  num_threads = 1;
 
         while (true) {
-            vector<std::thread> threads(num_threads);
-            for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (auto & th : threads) {
-                th.join();
-            }
+            thread_pool::run(num_threads, worker_thread);
             if (done) break;
 
             collect_units();
@@ -243,7 +265,7 @@ namespace smt {
 
         model_ref mdl;        
         context& pctx = *pctxs[finished_id];
-        ast_translation tr(*pms[finished_id], m);
+        ast_translation& tr = *from_worker[finished_id];
         switch (result) {
         case l_true: 
             pctx.get_model(mdl);
@@ -262,5 +284,132 @@ namespace smt {
         return result;
     }
 
+    /**
+       \brief Compute the consequences of vars by partitioning them across copies of ctx.
+       The variables that are not fixed in a first model of ctx are filtered out up front,
+       so only the remaining candidates are distributed. Each copy then filters its
+       candidates using the models it finds.
+    */
+    lbool parallel::get_consequences(expr_ref_vector const& asms, expr_ref_vector const& vars, 
+                                     expr_ref_vector& conseq, expr_ref_vector& unfixed) {
+        ast_manager& m = ctx.m;
+        unsigned num_threads = std::min((unsigned) std::thread::hardware_concurrency(), ctx.get_fparams().m_threads);
+        flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
+        num_threads = std::min(num_threads, vars.size());
+        if (num_threads <= 1)
+            return ctx.get_consequences(asms, vars, conseq, unfixed);
+
+        lbool r = ctx.check(asms.size(), asms.data());
+        if (r != l_true)
+            return r;
+        model_ref mdl;
+        ctx.get_model(mdl);
+        if (!mdl)
+            return ctx.get_consequences(asms, vars, conseq, unfixed);
+        expr_ref_vector candidates(m);
+        {
+            model::scoped_model_completion _scm(*mdl, false);
+            for (expr* v : vars) {
+                expr_ref val = (*mdl)(v);
+                if (m.is_value(val))
+                    candidates.push_back(v);
+                else
+                    unfixed.push_back(v);
+            }
+        }
+        num_threads = std::min(num_threads, candidates.size());
+        if (num_threads <= 1) 
+            return ctx.get_consequences(asms, candidates, conseq, unfixed);
+
+        scoped_ptr_vector<ast_manager> pms;
+        scoped_ptr_vector<context> pctxs;
+        scoped_ptr_vector<ast_translation> to_worker;
+        vector<expr_ref_vector> pasms, pvars, pconseq, punfixed;
+        scoped_limits sl(m.limit());
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            pms.push_back(new_m);
+            pctxs.push_back(alloc(context, *new_m, ctx.get_fparams(), ctx.get_params()));
+            context& new_ctx = *pctxs.back();
+            to_worker.push_back(alloc(ast_translation, m, *new_m));
+            ast_translation& tr = *to_worker.back();
+            context::copy(ctx, new_ctx, tr, true);
+            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+            pasms.push_back(tr(asms));
+            pvars.push_back(expr_ref_vector(*new_m));
+            for (unsigned j = i; j < candidates.size(); j += num_threads)
+                pvars.back().push_back(tr(candidates.get(j)));
+            pconseq.push_back(expr_ref_vector(*new_m));
+            punfixed.push_back(expr_ref_vector(*new_m));
+            sl.push_child(&(new_m->limit()));
+        }
+
+        std::mutex mux;
+        lbool result = l_true;
+        std::string ex_msg;
+        unsigned error_code = 0;
+        bool has_error = false;
+        auto cancel = [&]() {
+            for (ast_manager* pm : pms)
+                pm->limit().cancel();
+        };
+
+        auto worker_thread = [&](unsigned i) {
+            try {
+                lbool r = pctxs[i]->get_consequences(pasms[i], pvars[i], pconseq[i], punfixed[i]);
+                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :consequences " << pconseq[i].size() << ")\n");
+                if (r == l_true)
+                    return;
+                std::lock_guard<std::mutex> lock(mux);
+                if (result == l_true)
+                    result = r;
+                cancel();
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!has_error)
+                    error_code = err.error_code();
+                has_error = true;
+                cancel();
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!has_error)
+                    ex_msg = ex.msg();
+                has_error = true;
+                cancel();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!has_error)
+                    ex_msg = "unknown exception";
+                has_error = true;
+                cancel();
+            }
+        };
+
+        thread_pool::run(num_threads, worker_thread);
+
+        for (context* c : pctxs) 
+            c->collect_statistics(ctx.m_aux_stats);
+
+        if (has_error) {
+            if (error_code != 0)
+                throw z3_error(error_code);
+            throw default_exception(std::move(ex_msg));
+        }
+        if (result != l_true)
+            return result;
+
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_translation tr(*pms[i], m);
+            for (expr* e : pconseq[i])
+                conseq.push_back(tr(e));
+            for (expr* e : punfixed[i])
+                unfixed.push_back(tr(e));
+        }
+        return l_true;
+    }
+
 }
 #endif
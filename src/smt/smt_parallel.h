@@ -29,6 +29,9 @@ namespace smt {
 
         lbool operator()(expr_ref_vector const& asms);
 
+        lbool get_consequences(expr_ref_vector const& asms, expr_ref_vector const& vars, 
+                               expr_ref_vector& conseq, expr_ref_vector& unfixed);
+
     };
 
 }
@@ -185,7 +185,11 @@ namespace smt {
                 out.width(3);
                 out << num_instances_checker_sat << " : ";
                 out.width(3);
-                out << max_generation << " : " << max_cost << "\n";
+                out << max_generation << " : " << max_cost;
+                double time = s->get_instantiation_time();
+                if (time > 0) 
+                    out << " : " << time << " secs, " << static_cast<unsigned>(num_instances / time) << " inst/sec";
+                out << "\n";
             }
         }
 
@@ -564,6 +568,7 @@ namespace smt {
 
     void quantifier_manager::collect_statistics(::statistics & st) const {
         m_imp->m_qi_queue.collect_statistics(st);
+        m_imp->m_plugin->collect_statistics(st);
     }
 
     void quantifier_manager::reset_statistics() {
@@ -663,6 +668,11 @@ namespace smt {
             m_model_finder->pop_scope(num_scopes);            
         }
 
+        void collect_statistics(::statistics & st) const override {
+            m_mam->collect_statistics(st);
+            m_lazy_mam->collect_statistics(st);
+        }
+
         void init_search_eh() override {
             m_lazy_matching_idx = 0;
             m_model_finder->init_search_eh();
@@ -18,6 +18,7 @@ Notes:
 --*/
 
 #include "util/dec_ref_util.h"
+#include "util/scoped_timer.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/for_each_expr.h"
 #include "ast/ast_smt2_pp.h"
@@ -262,20 +263,62 @@ namespace {
             }
         };
 
+        struct core_timeout_eh : public event_handler {
+            ast_manager&      m;
+            std::atomic<bool> m_canceled;
+            core_timeout_eh(ast_manager& m): m(m), m_canceled(false) {}
+            ~core_timeout_eh() override {
+                if (m_canceled) 
+                    m.limit().dec_cancel();
+            }
+            void operator()(event_handler_caller_t caller_id) override {
+                m_canceled = true;
+                m.limit().inc_cancel();
+            }
+        };
+
+        /**
+           \brief Check the core r again with only its own literals as assumptions.
+           The core produced by the check is often smaller. Repeat until the core 
+           does not shrink, at most num_rounds times.
+        */
+        void trim_core(expr_ref_vector & r, unsigned num_rounds, unsigned max_conflicts) {
+            flet<unsigned> _mc(m_smt_params.m_max_conflicts, max_conflicts);
+            for (unsigned i = 0; i < num_rounds && r.size() > 1 && m.inc(); ++i) {
+                if (l_false != check_sat(r))
+                    return;
+                unsigned sz = m_context.get_unsat_core_size();
+                if (sz >= r.size()) 
+                    return;
+                IF_VERBOSE(12, verbose_stream() << "(smt.trim-core " << r.size() << " -> " << sz << ")\n";);
+                r.reset();
+                for (unsigned j = 0; j < sz; j++) 
+                    r.push_back(m_context.get_unsat_core_expr(j));
+            }
+        }
+
         void get_unsat_core(expr_ref_vector & r) override {
             unsigned sz = m_context.get_unsat_core_size();
             for (unsigned i = 0; i < sz; i++) {
                 r.push_back(m_context.get_unsat_core_expr(i));
             }
 
-            if (!m_minimizing_core && smt_params_helper(get_params()).core_minimize()) {
+            smt_params_helper p(get_params());
+            if (!m_minimizing_core && (p.core_minimize() || p.core_trim() > 0)) {
                 scoped_minimize_core scm(*this);
-                mus mus(*this);
-                mus.add_soft(r.size(), r.data());
-                expr_ref_vector r2(m);
-                if (l_true == mus.get_mus(r2)) {
-                    r.reset();
-                    r.append(r2);
+                core_timeout_eh eh(m);
+                scoped_timer timer(p.core_timeout(), &eh);
+                if (p.core_trim() > 0) 
+                    trim_core(r, p.core_trim(), p.core_trim_conflicts());
+                if (p.core_minimize() && m.inc()) {
+                    mus mus(*this);
+                    mus.set_divide(p.core_minimize_divide());
+                    mus.add_soft(r.size(), r.data());
+                    expr_ref_vector r2(m);
+                    if (l_true == mus.get_mus(r2)) {
+                        r.reset();
+                        r.append(r2);
+                    }
                 }
             }
 
@@ -28,6 +28,8 @@ namespace smt {
         unsigned m_num_decisions;
         unsigned m_num_add_eq;
         unsigned m_num_restarts;
+        unsigned m_num_chrono_backtracks;
+        unsigned m_num_mode_switches;
         unsigned m_num_final_checks;
         unsigned m_num_mk_bool_var;
         unsigned m_num_del_bool_var;
@@ -39,12 +41,16 @@ namespace smt {
         unsigned m_num_mk_lits;
         unsigned m_num_dyn_ack;
         unsigned m_num_del_dyn_ack;
+        unsigned m_num_useful_dyn_ack;
+        unsigned m_num_demoted_dyn_ack;
         unsigned m_num_interface_eqs;
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
         unsigned m_num_checks;
         unsigned m_num_simplifications;
         unsigned m_num_del_clauses;
+        unsigned m_num_subsumed_lemmas;
+        unsigned m_num_memory_gcs;
         statistics() {
             reset();
         }
@@ -406,12 +406,42 @@ namespace smt {
         unsigned num_vars = get_num_vars();
         for (unsigned v = 0; v < num_vars; v++) {
             var_data * d = m_var_data[v];
-            if (d->m_prop_upward && instantiate_axiom2b_for(v))
-                r = FC_CONTINUE;
+            if (!d->m_prop_upward)
+                continue;
+            // only instances that are violated by the current congruence
+            // closure are needed; the others are revisited in the next final check.
+            for (enode * store : d->m_parent_stores) {
+                for (enode * select : d->m_parent_selects) {
+                    if (is_axiom2b_satisfied(select, store))
+                        m_stats.m_num_axiom2b_sat++;
+                    else if (instantiate_axiom2b(select, store))
+                        r = FC_CONTINUE;
+                }
+            }
         }
         return r;
     }
 
+    /**
+       \brief Return true if select(a, j) and select(store(a, i, v), j) both
+       exist and are congruent, where store = store(a, i, v) and select = select(b, j).
+       The instance of the upward axiom for the pair is then satisfied.
+    */
+    bool theory_array::is_axiom2b_satisfied(enode * select, enode * store) {
+        unsigned num_args = select->get_num_args();
+        ptr_buffer<enode> args;
+        args.push_back(store->get_arg(0));
+        for (unsigned i = 1; i < num_args; ++i)
+            args.push_back(select->get_arg(i));
+        func_decl * f = select->get_decl();
+        enode * sel_a = ctx.get_enode_eq_to(f, num_args, args.data());
+        if (!sel_a)
+            return false;
+        args[0] = store;
+        enode * sel_s = ctx.get_enode_eq_to(f, num_args, args.data());
+        return sel_s && sel_s->get_root() == sel_a->get_root();
+    }
+
     final_check_status theory_array::mk_interface_eqs_at_final_check() {
         unsigned n = mk_interface_eqs();
         m_stats.m_num_eq_splits += n;
@@ -470,6 +500,7 @@ namespace smt {
         st.update("array ax1", m_stats.m_num_axiom1);
         st.update("array ax2", m_stats.m_num_axiom2a);
         st.update("array exp ax2", m_stats.m_num_axiom2b);
+        st.update("array exp ax2 sat", m_stats.m_num_axiom2b_sat);
         st.update("array ext ax", m_stats.m_num_extensionality);
         st.update("array splits", m_stats.m_num_eq_splits);
     }
@@ -25,7 +25,7 @@ Revision History:
 namespace smt {
 
     struct theory_array_stats {
-        unsigned   m_num_axiom1, m_num_axiom2a, m_num_axiom2b, m_num_extensionality, m_num_eq_splits;
+        unsigned   m_num_axiom1, m_num_axiom2a, m_num_axiom2b, m_num_axiom2b_sat, m_num_extensionality, m_num_eq_splits;
         unsigned   m_num_map_axiom, m_num_default_map_axiom;
         unsigned   m_num_select_const_axiom, m_num_default_store_axiom, m_num_default_const_axiom, m_num_default_as_array_axiom;
         unsigned   m_num_select_as_array_axiom, m_num_default_lambda_axiom;
@@ -87,6 +87,7 @@ namespace smt {
         void instantiate_extensionality(enode * a1, enode * a2);
         void instantiate_congruent(enode * a1, enode * a2);
         bool instantiate_axiom2b_for(theory_var v);
+        bool is_axiom2b_satisfied(enode * select, enode * store);
         
         virtual final_check_status assert_delayed_axioms();
         final_check_status mk_interface_eqs_at_final_check();
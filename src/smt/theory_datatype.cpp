@@ -271,6 +271,13 @@ namespace smt {
         ctx.attach_th_var(n, this, r);
         if (is_constructor(n)) {
             d->m_constructor = n;
+            for (expr* arg : *n->get_expr()) {
+                sort* s = arg->get_sort(), *se = nullptr;
+                if ((m_autil.is_array(s) && m_util.is_datatype(get_array_range(s))) ||
+                    (m_sutil.is_seq(s, se) && m_util.is_datatype(se)))
+                    m_oc_full = true;
+            }
+            oc_touch(n);
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) {
@@ -483,13 +490,15 @@ namespace smt {
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
         final_check_st _guard(this); 
+        if (!m_oc_full && occurs_check_touched())
+            return FC_CONTINUE;
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
                 enode * node = get_enode(v);
                 sort* s = node->get_sort();
                 if (!m_util.is_datatype(s))
                     continue;
-                if (m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
+                if (m_oc_full && m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
                     // conflict was detected... 
                     // return...
                     return FC_CONTINUE;
@@ -508,6 +517,32 @@ namespace smt {
         return r;
     }
 
+    void theory_datatype::oc_touch(enode * n) {
+        if (m_oc_full)
+            return;
+        m_oc_todo.push_back(n);
+        ctx.push_trail(push_back_vector<ptr_vector<enode>>(m_oc_todo));
+    }
+
+    /**
+       \brief Run the occurs check from the classes that changed since the last
+       acyclic state. A new cycle passes through a class that was merged or
+       received a constructor, so it is reachable from one of them.
+    */
+    bool theory_datatype::occurs_check_touched() {
+        for (unsigned i = m_oc_head; i < m_oc_todo.size(); ++i) {
+            enode * node = m_oc_todo[i]->get_root();
+            sort * s = node->get_sort();
+            if (m_util.is_datatype(s) && m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node))
+                return true;
+        }
+        if (m_oc_head < m_oc_todo.size()) {
+            ctx.push_trail(value_trail<unsigned>(m_oc_head));
+            m_oc_head = m_oc_todo.size();
+        }
+        return false;
+    }
+
     // Assuming `app` is equal to a constructor term, return the constructor enode
     inline enode * theory_datatype::oc_get_cstor(enode * app) {
         theory_var v = app->get_root()->get_th_var(get_id());
@@ -743,6 +778,9 @@ namespace smt {
         m_trail_stack.reset();
         std::for_each(m_var_data.begin(), m_var_data.end(), delete_proc<var_data>());
         m_var_data.reset();
+        m_oc_todo.reset();
+        m_oc_head = 0;
+        m_oc_full = false;
         theory::reset_eh();
         m_util.reset();
         m_stats.reset();
@@ -858,6 +896,7 @@ namespace smt {
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
         var_data * d1 = m_var_data[v1];
         var_data * d2 = m_var_data[v2];
+        oc_touch(get_enode(v1));
         if (d2->m_constructor != nullptr) {
             if (d1->m_constructor != nullptr && d1->m_constructor->get_decl() != d2->m_constructor->get_decl()) {
                 region & r    = ctx.get_region();
@@ -83,6 +83,15 @@ namespace smt {
         svector<stack_entry>  m_stack; // stack for DFS for occurs_check
         literal_vector        m_lits;
 
+        // classes whose constructor edges changed since the last final check
+        // that found the constructor graph acyclic. Backtracking only removes
+        // edges, so the occurs check can start from these classes.
+        ptr_vector<enode>     m_oc_todo;
+        unsigned              m_oc_head = 0;
+        bool                  m_oc_full = false; // constructors with array or sequence arguments
+        void oc_touch(enode * n);
+        bool occurs_check_touched();
+
         void clear_mark();
 
         void oc_mark_on_stack(enode * n);
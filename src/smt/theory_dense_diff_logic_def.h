@@ -517,7 +517,7 @@ namespace smt {
                         if (x != y) {
                             new_dist  = d_y_s;
                             new_dist += target->m_new_distance;
-                            cell & y_x = m_matrix[y][x];
+                            cell & y_x = r[x];
                             if (y_x.m_edge_id == null_edge_id || new_dist < y_x.m_distance) {
                                 m_cell_trail.push_back(cell_trail(y, x, y_x.m_edge_id, y_x.m_distance));
                                 y_x.m_edge_id  = new_edge_id;
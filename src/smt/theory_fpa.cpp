@@ -34,11 +34,13 @@ namespace smt {
         m_fpa_util(m_converter.fu()),
         m_bv_util(m_converter.bu()),
         m_arith_util(m_converter.au()),
-        m_is_initialized(true)
+        m_is_initialized(true),
+        m_abstracted(ctx.get_manager())
     {
         params_ref p;
         p.set_bool("arith_lhs", true);
         m_th_rw.updt_params(p);
+        m_converter.set_lazy(ctx.get_fparams().m_fp_lazy && !m.proofs_enabled());
     }
 
     theory_fpa::~theory_fpa()
@@ -189,6 +191,7 @@ namespace smt {
             m.inc_ref(e);
             m.inc_ref(res);
             m_trail_stack.push(insert_ref2_map<ast_manager, expr, expr>(m, m_conversions, e, res.get()));
+            register_abstractions();
         }
 
         return res;
@@ -226,6 +229,114 @@ namespace smt {
         ctx.mk_th_axiom(get_id(), 1, &lit);
     }
 
+    void theory_fpa::register_abstractions() {
+        for (expr* t : m_converter.m_abstracted) {
+            if (m_is_abstracted.contains(t))
+                continue;
+            m_abstracted.push_back(t);
+            m_trail_stack.push(push_back_vector<expr_ref_vector>(m_abstracted));
+            m_is_abstracted.insert(t);
+            m_trail_stack.push(insert_obj_trail<expr>(m_is_abstracted, t));
+            ++m_stats.m_num_abstractions;
+        }
+        m_converter.m_abstracted.reset();
+    }
+
+    /**
+       \brief Retrieve the value the bit-vector theory assigned to the bvwrap of \c e.
+    */
+    bool theory_fpa::get_wrapped_value(expr * e, expr_ref & val) {
+        app_ref w = m_converter.wrap(e);
+        rational r;
+        if (!m_bv_util.is_numeral(w, r)) {
+            theory_bv* th = dynamic_cast<theory_bv*>(ctx.get_theory(m_bv_util.get_family_id()));
+            if (!th || !ctx.e_internalized(w) || ctx.get_enode(w)->get_th_var(th->get_id()) == null_theory_var)
+                return false;
+            if (!th->get_fixed_value(w.get(), r))
+                return false;
+        }
+        val = m_bv_util.mk_numeral(r, m_bv_util.get_bv_size(w));
+        return true;
+    }
+
+    bool theory_fpa::get_rm_value(expr * e, mpf_rounding_mode & rm) {
+        expr_ref val(m);
+        if (m_fpa_util.is_rm_numeral(e, rm))
+            return true;
+        if (!get_wrapped_value(e, val))
+            return false;
+        expr_ref v(m_converter.bv2rm_value(val), m);
+        return m_fpa_util.is_rm_numeral(v, rm);
+    }
+
+    bool theory_fpa::get_fp_value(expr * e, mpf & r) {
+        scoped_mpf v(m_fpa_util.fm());
+        if (!m_fpa_util.is_numeral(e, v)) {
+            expr_ref val(m);
+            if (!get_wrapped_value(e, val))
+                return false;
+            expr_ref ve(m_converter.bv2fpa_value(e->get_sort(), val), m);
+            if (!m_fpa_util.is_numeral(ve, v))
+                return false;
+        }
+        m_fpa_util.fm().set(r, v);
+        return true;
+    }
+
+    /**
+       \brief Check whether the bits assigned to the abstraction of \c t agree
+       with the result of evaluating \c t on the values of its arguments.
+    */
+    bool theory_fpa::check_abstraction(app * t) {
+        mpf_manager & mpfm = m_fpa_util.fm();
+        mpf_rounding_mode rm = MPF_ROUND_NEAREST_TEVEN;
+        scoped_mpf a(mpfm), b(mpfm), c(mpfm), r(mpfm), v(mpfm);
+        mpf* args[3] = { &a.get(), &b.get(), &c.get() };
+        fpa_op_kind k = (fpa_op_kind)t->get_decl_kind();
+        unsigned i = 0;
+        if (k != OP_FPA_REM) {
+            if (!get_rm_value(t->get_arg(0), rm))
+                return false;
+            i = 1;
+        }
+        for (unsigned j = 0; i < t->get_num_args(); ++i, ++j)
+            if (!get_fp_value(t->get_arg(i), *args[j]))
+                return false;
+        if (!get_fp_value(t, v))
+            return false;
+        switch (k) {
+        case OP_FPA_MUL: mpfm.mul(rm, a, b, r); break;
+        case OP_FPA_DIV: mpfm.div(rm, a, b, r); break;
+        case OP_FPA_REM: mpfm.rem(a, b, r); break;
+        case OP_FPA_FMA: mpfm.fma(rm, a, b, c, r); break;
+        case OP_FPA_SQRT: mpfm.sqrt(rm, a, r); break;
+        default: UNREACHABLE(); return false;
+        }
+        if (mpfm.is_nan(r) || mpfm.is_nan(v))
+            return mpfm.is_nan(r) && mpfm.is_nan(v);
+        return mpfm.eq(r, v) && mpfm.sgn(r) == mpfm.sgn(v);
+    }
+
+    /**
+       \brief Tie the abstraction of \c t to its bit-blasted encoding.
+    */
+    void theory_fpa::refine_abstraction(app * t) {
+        TRACE("t_fpa", tout << "refine " << mk_ismt2_pp(t, m) << "\n";);
+        expr_ref_vector args(m);
+        for (expr* arg : *t)
+            args.push_back(convert(arg));
+        expr_ref abs = convert(t), full(m), c(m);
+        proof_ref pr(m);
+        VERIFY(BR_DONE == m_rw.m_cfg.reduce_app(t->get_decl(), args.size(), args.data(), full, pr));
+        m_converter.mk_eq(abs, full, c);
+        c = m.mk_and(c, mk_side_conditions());
+        m_th_rw(c);
+        assert_cnstr(c);
+        m_refined.insert(t);
+        m_trail_stack.push(insert_obj_trail<expr>(m_refined, t));
+        ++m_stats.m_num_refinements;
+    }
+
     void theory_fpa::attach_new_th_var(enode * n) {
         theory_var v = mk_var(n);
         ctx.attach_th_var(n, this, v);
@@ -245,6 +356,7 @@ namespace smt {
         ctx.set_var_theory(l.var(), get_id());
 
         expr_ref bv_atom(m_rw.convert_atom(m_th_rw, atom));
+        register_abstractions();
         expr_ref bv_atom_w_side_c(m), atom_eq(m);
         bv_atom_w_side_c = m.mk_and(bv_atom, mk_side_conditions());
         m_th_rw(bv_atom_w_side_c);
@@ -504,7 +616,21 @@ namespace smt {
     final_check_status theory_fpa::final_check_eh() {
         TRACE("t_fpa", tout << "final_check_eh\n";);
         SASSERT(m_converter.m_extra_assertions.empty());
-        return FC_DONE;
+        final_check_status st = FC_DONE;
+        // refining a term may convert, and thereby abstract, further terms.
+        for (unsigned i = 0; i < m_abstracted.size(); ++i) {
+            app* t = to_app(m_abstracted.get(i));
+            if (m_refined.contains(t) || check_abstraction(t))
+                continue;
+            refine_abstraction(t);
+            st = FC_CONTINUE;
+        }
+        return st;
+    }
+
+    void theory_fpa::collect_statistics(::statistics & st) const {
+        st.update("fpa abstractions", m_stats.m_num_abstractions);
+        st.update("fpa refinements", m_stats.m_num_refinements);
     }
 
     void theory_fpa::init_model(model_generator & mg) {
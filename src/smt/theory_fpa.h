@@ -30,6 +30,12 @@ namespace smt {
 
     class theory_fpa : public theory {
     protected:
+        struct stats {
+            unsigned m_num_abstractions;
+            unsigned m_num_refinements;
+            void reset() { memset(this, 0, sizeof(stats)); }
+            stats() { reset(); }
+        };
 
 
         class fpa_value_proc : public model_value_proc {
@@ -91,6 +97,10 @@ namespace smt {
         obj_map<expr, expr*>      m_conversions;
         bool                      m_is_initialized;
         obj_hashtable<func_decl>  m_is_added_to_model;
+        stats                     m_stats;
+        expr_ref_vector           m_abstracted;    // terms encoded lazily, see fpa2bv_converter_wrapped::set_lazy
+        obj_hashtable<expr>       m_is_abstracted;
+        obj_hashtable<expr>       m_refined;
 
         final_check_status final_check_eh() override;
         bool internalize_atom(app * atom, bool gate_ctx) override;
@@ -116,6 +126,7 @@ namespace smt {
         ~theory_fpa() override;
 
         void display(std::ostream & out) const override;
+        void collect_statistics(::statistics & st) const override;
 
     protected:
         expr_ref mk_side_conditions();
@@ -124,6 +135,13 @@ namespace smt {
         void attach_new_th_var(enode * n);
         void assert_cnstr(expr * e);
 
+        void register_abstractions();
+        bool get_wrapped_value(expr * e, expr_ref & val);
+        bool get_rm_value(expr * e, mpf_rounding_mode & rm);
+        bool get_fp_value(expr * e, mpf & v);
+        bool check_abstraction(app * t);
+        void refine_abstraction(app * t);
+
 
         enode* ensure_enode(expr* e);
         enode* get_root(expr* a) { return ensure_enode(a)->get_root(); }
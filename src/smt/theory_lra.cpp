@@ -172,6 +172,11 @@ class theory_lra::imp {
     unsigned               m_asserted_qhead;
 
     svector<unsigned>       m_bv_to_propagate;      // Boolean variables that can be propagated
+
+    // theory scores for case_split=7: number of arithmetic conflicts a bound atom participated in.
+    unsigned_vector        m_conflict_count;
+    bool_var_vector        m_scored_vars;
+    svector<double>        m_scores;
     
     svector<std::pair<theory_var, theory_var> >       m_assume_eq_candidates; 
     unsigned                                          m_assume_eq_head;
@@ -284,6 +289,7 @@ class theory_lra::imp {
             m_nla->settings().horner_row_length_limit =     prms.arith_nl_horner_row_length_limit();
             m_nla->settings().run_grobner =                 prms.arith_nl_grobner();
             m_nla->settings().run_nra  =                    prms.arith_nl_nra();
+            m_nla->settings().nra_subpaving =               prms.arith_nl_nra_subpaving();
             m_nla->settings().grobner_subs_fixed =          prms.arith_nl_grobner_subs_fixed();
             m_nla->settings().grobner_eqs_growth =          prms.arith_nl_grobner_eqs_growth();
             m_nla->settings().grobner_expr_size_growth =    prms.arith_nl_grobner_expr_size_growth();
@@ -923,6 +929,8 @@ public:
         theory_var v = null_theory_var;
         bool_var bv = ctx().mk_bool_var(atom);
         m_bool_var2bound.erase(bv);
+        if (bv < static_cast<bool_var>(m_conflict_count.size()))
+            m_conflict_count[bv] = 0;
         ctx().set_var_theory(bv, get_id());
         if (a.is_le(atom, n1, n2) && a.is_extended_numeral(n2, r) && is_app(n1)) {
             v = internalize_def(to_app(n1));
@@ -1078,6 +1086,47 @@ public:
 
     void restart_eh() {
         m_arith_eq_adapter.restart_eh();
+        update_theory_scores();
+    }
+
+    bool use_theory_scores() const {
+        return ctx().get_fparams().m_case_split_strategy == CS_ACTIVITY_THEORY_SCORE;
+    }
+
+    void inc_conflict_count(literal_vector const& core) {
+        for (literal lit : core) {
+            bool_var v = lit.var();
+            if (!m_bool_var2bound.contains(v))
+                continue;
+            m_conflict_count.reserve(v + 1, 0);
+            ++m_conflict_count[v];
+        }
+    }
+
+    /**
+       \brief supply the case split queue with the relative number of
+       arithmetic conflicts each bound atom participated in. 
+       The counts are halved on every restart to favor recent conflicts.
+    */
+    void update_theory_scores() {
+        if (!use_theory_scores())
+            return;
+        unsigned max_count = 0;
+        for (unsigned c : m_conflict_count)
+            max_count = std::max(max_count, c);
+        if (max_count == 0)
+            return;
+        m_scored_vars.reset();
+        m_scores.reset();
+        for (bool_var v = 0; v < static_cast<bool_var>(m_conflict_count.size()); ++v) {
+            unsigned c = m_conflict_count[v];
+            if (c == 0 || !m_bool_var2bound.contains(v))
+                continue;
+            m_scored_vars.push_back(v);
+            m_scores.push_back(static_cast<double>(c) / max_count);
+            m_conflict_count[v] = c / 2;
+        }
+        ctx().set_theory_scores(m_scored_vars.size(), m_scored_vars.data(), m_scores.data());
     }
 
     void relevant_eh(app* n) {
@@ -3205,6 +3254,8 @@ public:
         
         // SASSERT(validate_conflict(m_core, m_eqs));
         dump_conflict(m_core, m_eqs);
+        if (use_theory_scores())
+            inc_conflict_count(m_core);
         if (is_conflict) {
             ctx().set_conflict(
                 ctx().mk_justification(
@@ -3252,6 +3303,7 @@ public:
         m_scopes.reset();
         m_stats.reset();
         m_bv_to_propagate.reset();
+        m_conflict_count.reset();
         m_model_is_initialized = false;
     }
 
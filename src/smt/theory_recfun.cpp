@@ -21,7 +21,9 @@ Revision History:
 #include "ast/ast_util.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/for_each_expr.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "smt/theory_recfun.h"
+#include "smt/params/smt_params_helper.hpp"
 
 
 #define TRACEFN(x) TRACE("recfun", tout << x << '\n';)
@@ -34,7 +36,8 @@ namespace smt {
           m_util(m_plugin.u()), 
           m_disabled_guards(m),
           m_enabled_guards(m),
-          m_preds(m) {
+          m_preds(m),
+          m_ground_pinned(m) {
         }
 
     theory_recfun::~theory_recfun() {
@@ -92,6 +95,13 @@ namespace smt {
         for (auto & kv : m_guard2pending) 
             dealloc(kv.m_value);
         m_guard2pending.reset();
+        m_ground_values.reset();
+        m_ground_pinned.reset();
+    }
+
+    void theory_recfun::init_search_eh() {
+        smt_params_helper p(ctx.get_params());
+        m_ground_steps = p.recfun_ground_steps();
     }
 
     /*
@@ -303,6 +313,46 @@ namespace smt {
      *
      * also body-expand paths that do not depend on any defined fun
      */
+    /**
+     * Evaluate `f(args)` directly when all arguments are values.
+     * The rewriter unfolds the definition within a budget of rewrite steps.
+     * If the result is a value, assert `f(args) = value` instead of case axioms.
+     */
+    bool theory_recfun::assert_ground_axiom(recfun::case_expansion & e) {
+        if (m_ground_steps == 0)
+            return false;
+        for (expr* arg : e.m_args)
+            if (!m.is_value(arg))
+                return false;
+        app* lhs = e.m_lhs;
+        expr* val = nullptr;
+        if (!m_ground_values.find(lhs, val)) {
+            params_ref p;
+            p.set_uint("max_steps", m_ground_steps);
+            th_rewriter rw(m, p);
+            expr_ref r(m);
+            try {
+                rw(lhs, r);
+            }
+            catch (rewriter_exception &) {
+                return false;
+            }
+            if (!m.is_value(r))
+                return false;
+            m_ground_pinned.push_back(lhs);
+            m_ground_pinned.push_back(r);
+            m_ground_values.insert(lhs, r);
+            val = r;
+        }
+        ++m_stats.m_ground_evaluations;
+        TRACEFN("ground evaluation " << mk_pp(lhs, m) << " = " << mk_pp(val, m));
+        literal lit = mk_eq_lit(lhs, val);
+        std::function<literal(void)> fn = [&]() { return lit; };
+        scoped_trace_stream _tr(*this, fn);
+        ctx.mk_th_axiom(get_id(), 1, &lit);
+        return true;
+    }
+
     void theory_recfun::assert_case_axioms(recfun::case_expansion & e) {
 
         if (e.m_def->is_fun_macro()) {
@@ -310,6 +360,9 @@ namespace smt {
             return;
         }
 
+        if (assert_ground_axiom(e))
+            return;
+
         ++m_stats.m_case_expansions;
         TRACEFN("assert_case_axioms " << e
                 << " with " << e.m_def->get_cases().size() << " cases");
@@ -486,6 +539,7 @@ namespace smt {
         st.update("recfun macro expansion", m_stats.m_macro_expansions);
         st.update("recfun case expansion", m_stats.m_case_expansions);
         st.update("recfun body expansion", m_stats.m_body_expansions);
+        st.update("recfun ground evaluation", m_stats.m_ground_evaluations);
     }
 
 }
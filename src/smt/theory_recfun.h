@@ -28,7 +28,7 @@ namespace smt {
 
     class theory_recfun : public theory {
         struct stats {
-            unsigned m_case_expansions, m_body_expansions, m_macro_expansions;
+            unsigned m_case_expansions, m_body_expansions, m_macro_expansions, m_ground_evaluations;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -51,6 +51,11 @@ namespace smt {
         scoped_ptr_vector<propagation_item> m_propagation_queue;
         unsigned                            m_qhead { 0 };
 
+        // values of recursive functions applied to values; they are kept across scopes.
+        unsigned                 m_ground_steps { 0 };
+        obj_map<app, expr*>      m_ground_values;
+        expr_ref_vector          m_ground_pinned;
+
         void push_body_expand(expr* e) { push(alloc(propagation_item, alloc(recfun::body_expansion, u(), to_app(e)))); }
         void push_case_expand(expr* e) { push(alloc(propagation_item, alloc(recfun::case_expansion, u(), to_app(e)))); }
         void push_guard(expr* e) { push(alloc(propagation_item, e)); }
@@ -71,6 +76,7 @@ namespace smt {
 
         expr_ref apply_args(unsigned depth, recfun::vars const & vars, expr_ref_vector const & args, expr * e); //!< substitute variables by args
         void assert_macro_axiom(recfun::case_expansion & e);
+        bool assert_ground_axiom(recfun::case_expansion & e);
         void assert_case_axioms(recfun::case_expansion & e);
         void assert_body_axiom(recfun::body_expansion & e);
         void block_core(expr_ref_vector const& core);
@@ -90,6 +96,7 @@ namespace smt {
         bool internalize_atom(app * atom, bool gate_ctx) override;
         bool internalize_term(app * term) override;
         void reset_eh() override;
+        void init_search_eh() override;
         void relevant_eh(app * n) override;
         char const * get_name() const override;
         final_check_status final_check_eh() override;
@@ -317,6 +317,35 @@ struct scoped_enable_trace {
     }
 };
 
+/**
+   Length stage of final check: the length constraints implied by the
+   current assignment are added before word equations are solved. Each
+   step adds lemmas over lengths that remain valid for the later stages.
+*/
+bool theory_seq::final_check_lengths() {
+    if (check_length_coherence()) {
+        ++m_stats.m_check_length_coherence;
+        TRACEFIN("length_first: check_length_coherence");
+        return true;
+    }
+    if (check_fixed_length(true, false)) {
+        ++m_stats.m_fixed_length;
+        TRACEFIN("length_first: zero_length");
+        return true;
+    }
+    if (get_fparams().m_split_w_len && len_based_split()) {
+        ++m_stats.m_branch_variable;
+        TRACEFIN("length_first: split_based_on_length");
+        return true;
+    }
+    if (reduce_length_eq()) {
+        ++m_stats.m_branch_variable;
+        TRACEFIN("length_first: reduce_length");
+        return true;
+    }
+    return false;
+}
+
 final_check_status theory_seq::final_check_eh() {
     if (!m_has_seq) {
         return FC_DONE;
@@ -326,6 +355,8 @@ final_check_status theory_seq::final_check_eh() {
     TRACE("seq", display(tout << "level: " << ctx.get_scope_level() << "\n"););
     TRACE("seq_verbose", ctx.display(tout););
 
+    if (get_fparams().m_seq_length_first && final_check_lengths()) 
+        return FC_CONTINUE;
     if (simplify_and_solve_eqs()) {
         ++m_stats.m_solve_eqs;
         TRACEFIN("solve_eqs");
@@ -1869,6 +1900,7 @@ void theory_seq::collect_statistics(::statistics & st) const {
     st.update("seq fixed length", m_stats.m_fixed_length);
     st.update("seq int.to.str", m_stats.m_int_string);
     st.update("seq str.from_ubv", m_stats.m_ubv_string);
+    m_regex.collect_statistics(st);
 }
 
 void theory_seq::init_search_eh() {
@@ -1893,10 +1925,30 @@ void theory_seq::init_model(expr_ref_vector const& es) {
 
 void theory_seq::finalize_model(model_generator& mg) {
     m_rep.pop_scope(1);
+    m_model_strings.reset();
+}
+
+/**
+   \brief Retrieve the string value of s in the model under construction.
+   Canonization and rewriting of s are done once per model, since the same
+   sub-sequences occur in the values of many sequence terms.
+*/
+bool theory_seq::get_model_string(expr* s, zstring& result) {
+    if (m_model_strings.find(s, result))
+        return true;
+    dependency* deps = nullptr;
+    expr_ref tmp(m);
+    if (!canonize(s, deps, tmp)) tmp = s;
+    m_str_rewrite(tmp);
+    if (!m_util.str.is_string(tmp, result))
+        return false;
+    m_model_strings.insert(s, result);
+    return true;
 }
 
 void theory_seq::init_model(model_generator & mg) {
     m_rep.push_scope();
+    m_model_strings.reset();
     m_factory = alloc(seq_factory, get_manager(), get_family_id(), mg.get_model());
     mg.register_factory(m_factory);
     for (ne const& n : m_nqs) {
@@ -1965,16 +2017,12 @@ public:
                     break;
                 }
                 case string_source: {
-                    dependency* deps = nullptr;
-                    expr_ref tmp(th.m);
-                    if (!th.canonize(m_strings[k], deps, tmp)) tmp = m_strings[k];
-                    th.m_str_rewrite(tmp);
                     zstring zs;
-                    if (th.m_util.str.is_string(tmp, zs)) {
+                    if (th.m_util.str.is_string(m_strings[k], zs) || th.get_model_string(m_strings[k], zs)) {
                         add_buffer(sbuffer, zs);
                     }
                     else {
-                        TRACE("seq", tout << "Not a string: " << tmp << "\n";);
+                        TRACE("seq", tout << "Not a string: " << mk_pp(m_strings[k], th.m) << "\n";);
                     }
                     ++k;
                     break;
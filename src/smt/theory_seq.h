@@ -370,6 +370,7 @@ namespace smt {
         trail_stack      m_trail_stack;
         stats            m_stats;
         ptr_vector<expr> m_todo, m_concat;
+        obj_map<expr, zstring> m_model_strings;  // string values of sequence terms during model construction
         expr_ref_vector  m_ls, m_rs, m_lhs, m_rhs;
         expr_ref_pair_vector m_new_eqs;
 
@@ -385,6 +386,7 @@ namespace smt {
         obj_hashtable<expr>            m_is_digit;         // expressions that have been constrained to be digits
 
         final_check_status final_check_eh() override;
+        bool final_check_lengths();
         bool internalize_atom(app* atom, bool) override;
         bool internalize_term(app*) override;
         void internalize_eq_eh(app * atom, bool_var v) override;
@@ -415,6 +417,7 @@ namespace smt {
         bool is_beta_redex(enode* p, enode* n) const override;
 
         void init_model(expr_ref_vector const& es);
+        bool get_model_string(expr* s, zstring& result);
         app* get_ite_value(expr* a);
         void get_ite_concat(ptr_vector<expr>& head, ptr_vector<expr>& tail);
         
@@ -28,6 +28,7 @@ Notes:
 #include "smt/smt_context.h"
 #include "smt/theory_arith.h"
 #include "smt/theory_special_relations.h"
+#include "smt/params/smt_params_helper.hpp"
 
 
 namespace smt {
@@ -599,6 +600,44 @@ namespace smt {
         return l_true;
     }
 
+    /**
+       \brief Eager propagation for partial orders.
+       Negated atoms v1 !-> v2 that are contradicted by a path of asserted
+       atoms cause a conflict, and unassigned atoms v1 -> v2 that are implied
+       by such a path are propagated.
+    */
+    lbool theory_special_relations::propagate_po_eager(relation& r) {
+        lbool res = final_check_po(r);
+        if (res != l_true)
+            return res;
+        for (atom* a : m_atoms) {
+            if (ctx.inconsistent())
+                return l_false;
+            if (&a->get_relation() != &r)
+                continue;
+            literal lit(a->var());
+            if (ctx.get_assignment(lit) != l_undef)
+                continue;
+            if (r.m_uf.find(a->v1()) != r.m_uf.find(a->v2()))
+                continue;
+            r.m_explanation.reset();
+            unsigned timestamp = r.m_graph.get_timestamp();
+            if (!r.m_graph.find_shortest_reachable_path(a->v1(), a->v2(), timestamp, r))
+                continue;
+            literal_vector const& lits = r.m_explanation;
+            TRACE("special_relations", ctx.display_literals_verbose(tout << "propagate " << lit << " ", lits) << "\n";);
+            ++m_num_propagations;
+            ctx.assign(lit, ctx.mk_justification(
+                           ext_theory_propagation_justification(get_id(), ctx.get_region(), lits.size(), lits.data(), 0, nullptr, lit)));
+        }
+        return ctx.inconsistent() ? l_false : l_true;
+    }
+
+    void theory_special_relations::init_search_eh() {
+        smt_params_helper p(ctx.get_params());
+        m_eager = p.special_relations_eager();
+    }
+
     void theory_special_relations::propagate() {
         if (m_can_propagate) {
             for (auto const& kv : m_relations) {
@@ -610,6 +649,7 @@ namespace smt {
 
     lbool theory_special_relations::propagate(relation& r) {
         lbool res = l_true;
+        unsigned qhead = r.m_asserted_qhead;
         while (res == l_true && r.m_asserted_qhead < r.m_asserted_atoms.size()) {
             atom& a = *r.m_asserted_atoms[r.m_asserted_qhead];
             switch (r.m_property) {
@@ -633,6 +673,8 @@ namespace smt {
             }
             ++r.m_asserted_qhead;
         }
+        if (res == l_true && m_eager && r.m_property == sr_po && qhead < r.m_asserted_qhead) 
+            res = propagate_po_eager(r);
         return res;
     }
 
@@ -687,6 +729,7 @@ namespace smt {
         for (auto const& kv : m_relations) {
             kv.m_value->m_graph.collect_statistics(st);
         }
+        st.update("special relations propagations", m_num_propagations);
     }
 
     model_value_proc * theory_special_relations::mk_value(enode * n, model_generator & mg) {
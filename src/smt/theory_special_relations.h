@@ -134,6 +134,8 @@ namespace smt {
         obj_map<func_decl, relation*>  m_relations;
         bool_var2atom                  m_bool_var2atom;
         bool                           m_can_propagate;
+        bool                           m_eager = false;
+        unsigned                       m_num_propagations = 0;
         
 
         void del_atoms(unsigned old_size);
@@ -151,6 +153,7 @@ namespace smt {
         lbool  propagate_plo(atom& a);
         lbool  propagate_po(atom& a); 
         lbool  propagate_tc(atom& a); 
+        lbool  propagate_po_eager(relation& r);
         theory_var mk_var(expr* e);
         void count_children(graph const& g, unsigned_vector& num_children);
         void ensure_strict(graph& g);
@@ -189,7 +192,7 @@ namespace smt {
         final_check_status final_check_eh() override;
         void reset_eh() override;
         void assign_eh(bool_var v, bool is_true) override;
-        void init_search_eh() override {}
+        void init_search_eh() override;
         void push_scope_eh() override;
         void pop_scope_eh(unsigned num_scopes) override;
         void restart_eh() override {}
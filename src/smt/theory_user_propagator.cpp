@@ -79,7 +79,7 @@ void theory_user_propagator::add_expr(expr* term, bool ensure_enode) {
     ctx.attach_th_var(n, this, v);
     literal_vector explain;
     if (ctx.is_fixed(n, r, explain))
-        m_prop.push_back(prop_info(explain, v, r));
+        new_fixed_eh(v, r, explain.size(), explain.data());
     
 }
 
@@ -91,7 +91,8 @@ void theory_user_propagator::propagate_cb(
            ctx.display(tout << "redundant consequence: " << mk_pp(conseq, m) << "\n"));
 
     expr_ref _conseq(conseq, m);
-    ctx.get_rewriter()(conseq, _conseq);
+    if (!m.is_false(conseq))
+        ctx.get_rewriter()(conseq, _conseq);
     if (ctx.lit_internalized(_conseq) && ctx.get_assignment(ctx.get_literal(_conseq)) == l_true) 
         return;
     m_prop.push_back(prop_info(num_fixed, fixed_ids, num_eqs, eq_lhs, eq_rhs, _conseq));    
@@ -152,6 +153,12 @@ final_check_status theory_user_propagator::final_check_eh() {
     return done ? FC_DONE : FC_CONTINUE;
 }
 
+/**
+   \brief queue the fixed event of v. The callbacks of the queued
+   events are delivered together in propagate(), ahead of the
+   consequences they cause, so events of assignments that are undone
+   before the next round of propagation are never delivered.
+*/
 void theory_user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned num_lits, literal const* jlits) {
     if (!m_fixed_eh)
         return;
@@ -161,12 +168,7 @@ void theory_user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned nu
     m_fixed.insert(v);
     ctx.push_trail(insert_map<uint_set, unsigned>(m_fixed, v));
     m_id2justification.setx(v, literal_vector(num_lits, jlits), literal_vector());
-    try {
-         m_fixed_eh(m_user_context, this, var2expr(v), value);
-     }
-     catch (...) {
-        throw default_exception("Exception thrown in \"fixed\"-callback");
-     }
+    m_prop.push_back(prop_info(literal_vector(), v, expr_ref(value, m)));
 }
 
 bool_var theory_user_propagator::enode_to_bool(enode* n, unsigned bit) {
@@ -336,7 +338,16 @@ void theory_user_propagator::propagate_consequence(prop_info const& prop) {
 }
 
 void theory_user_propagator::propagate_new_fixed(prop_info const& prop) {
-    new_fixed_eh(prop.m_var, prop.m_conseq, prop.m_lits.size(), prop.m_lits.data());
+    // the callback may add to m_prop, which invalidates prop
+    expr_ref value(prop.m_conseq);
+    theory_var v = prop.m_var;
+    ++m_stats.m_num_fixed;
+    try {
+        m_fixed_eh(m_user_context, this, var2expr(v), value);
+    }
+    catch (...) {
+        throw default_exception("Exception thrown in \"fixed\"-callback");
+    }
 }
 
 
@@ -397,6 +408,7 @@ bool theory_user_propagator::internalize_term(app* term)  {
 void theory_user_propagator::collect_statistics(::statistics & st) const {
     st.update("user-propagations", m_stats.m_num_propagations);
     st.update("user-watched",      get_num_vars());
+    st.update("user-fixed",        m_stats.m_num_fixed);
 }
 
 
@@ -52,6 +52,7 @@ namespace smt {
 
         struct stats {
             unsigned m_num_propagations;
+            unsigned m_num_fixed;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
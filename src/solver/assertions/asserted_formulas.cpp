@@ -226,6 +226,7 @@ void asserted_formulas::pop_scope(unsigned num_scopes) {
     m_macro_manager.pop_scope(num_scopes);
     unsigned new_lvl    = m_scopes.size() - num_scopes;
     scope & s           = m_scopes[new_lvl];
+    unsigned num_subst  = m_scoped_substitution.size();
     m_inconsistent      = s.m_inconsistent_old;
     m_defined_names.pop(num_scopes);
     m_elim_term_ite.pop(num_scopes);
@@ -233,7 +234,10 @@ void asserted_formulas::pop_scope(unsigned num_scopes) {
     m_formulas.shrink(s.m_formulas_lim);
     m_qhead    = s.m_formulas_lim;
     m_scopes.shrink(new_lvl);
-    flush_cache();
+    // The substitution is the only state of m_rewriter that depends on the scope.
+    // Keep the rewrite cache across incremental calls unless popping removed equalities from it.
+    if (num_subst != m_scoped_substitution.size())
+        flush_cache();
     TRACE("asserted_formulas_scopes", tout << "after pop " << num_scopes << "\n";);
 }
 
@@ -358,6 +362,9 @@ void asserted_formulas::display_ll(std::ostream & out, ast_mark & pp_visited) co
 }
 
 void asserted_formulas::collect_statistics(statistics & st) const {
+    st.update("rewriter cache hits", m_rewriter.get_num_cache_hits());
+    st.update("rewriter cache misses", m_rewriter.get_num_cache_misses());
+    st.update("rewriter cache flushes", m_num_cache_flushes);
 }
 
 
@@ -213,6 +213,7 @@ class asserted_formulas {
     apply_quasi_macros_fn       m_apply_quasi_macros;
     flatten_clauses_fn          m_flatten_clauses;
     unsigned                    m_lazy_scopes;
+    unsigned                    m_num_cache_flushes = 0;
 
     void force_push();
     void push_scope_core();
@@ -229,7 +230,6 @@ class asserted_formulas {
     void apply_quasi_macros();
     void nnf_cnf();
     void reduce_and_solve();
-    void flush_cache() { m_rewriter.reset(); m_rewriter.set_substitution(&m_substitution); }
     void set_eliminate_and(bool flag);
     void propagate_values();
     unsigned propagate_values(unsigned i);
@@ -256,6 +256,7 @@ public:
     bool inconsistent() const { return m_inconsistent; }
     proof * get_inconsistency_proof() const;
     void reduce();
+    void flush_cache() { m_rewriter.reset(); m_rewriter.set_substitution(&m_substitution); m_num_cache_flushes++; }
     unsigned get_num_formulas() const { return m_formulas.size(); }
     unsigned get_formulas_last_level() const;
     unsigned get_qhead() const { return m_qhead; }
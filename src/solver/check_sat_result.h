@@ -43,8 +43,10 @@ protected:
     lbool       m_status; 
     model_converter_ref m_mc0;
     double      m_time;
+    uint64_t    m_rlimit;        // resource units consumed by the last check
+    uint64_t    m_total_rlimit;  // resource units consumed by all checks
 public:
-    check_sat_result():m_ref_count(0), m_status(l_undef), m_time(0) {}
+    check_sat_result():m_ref_count(0), m_status(l_undef), m_time(0), m_rlimit(0), m_total_rlimit(0) {}
     virtual ~check_sat_result() {}
     void inc_ref() { m_ref_count++; }
     void dec_ref() { SASSERT(m_ref_count > 0); m_ref_count--; if (m_ref_count == 0) dealloc(this); }
@@ -66,17 +68,37 @@ public:
     virtual void get_labels(svector<symbol> & r) = 0;
     virtual ast_manager& get_manager() const = 0;
 
+    /**
+       \brief record the time and the resource units of a check.
+       The resource count of the manager is shared by all solvers of the
+       manager, the difference attributes it to this solver.
+    */
     class scoped_solver_time {
         check_sat_result& c;
         timer t;
+        uint64_t m_count;
     public:
-        scoped_solver_time(check_sat_result& c):c(c) { c.m_time = 0; }
-        ~scoped_solver_time() { c.m_time = t.get_seconds(); }
+        scoped_solver_time(check_sat_result& c):c(c), m_count(c.get_manager().limit().count()) { c.m_time = 0; }
+        ~scoped_solver_time() { 
+            c.m_time = t.get_seconds(); 
+            c.m_rlimit = c.get_manager().limit().count() - m_count;
+            c.m_total_rlimit += c.m_rlimit;
+        }
     };
 
     void collect_timer_stats(statistics& st) const {
         if (m_time != 0) 
             st.update("time", m_time);
+        auto update = [&](char const* name, uint64_t value) {
+            if (value <= UINT_MAX)
+                st.update(name, static_cast<unsigned>(value));
+            else
+                st.update(name, static_cast<double>(value));
+        };
+        if (m_total_rlimit != 0) {
+            update("solver rlimit count", m_rlimit);
+            update("solver rlimit total", m_total_rlimit);
+        }
     }
 
 };
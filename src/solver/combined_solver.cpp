@@ -21,6 +21,10 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/common_msgs.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_util.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "ast/rewriter/expr_safe_replace.h"
+#include "model/model.h"
 #include "solver/solver.h"
 #include "solver/combined_solver_params.hpp"
 #include <atomic>
@@ -65,6 +69,22 @@ private:
     bool                 m_ignore_solver1;
     inc_unknown_behavior m_inc_unknown_behavior;
     unsigned             m_inc_timeout;
+
+    // Results of previous check-sat calls keyed by the assertions after
+    // renaming uninterpreted constants by order of first occurrence.
+    struct cache_entry {
+        expr_ref             m_key;
+        lbool                m_result;
+        model_ref            m_model;
+        func_decl_ref_vector m_consts;
+        cache_entry(ast_manager& m): m_key(m), m_result(l_undef), m_consts(m) {}
+    };
+    ptr_vector<cache_entry> m_cache;    // least recently used first
+    unsigned             m_cache_size = 0;
+    bool                 m_use_cache_result = false;
+    model_ref            m_cache_model;
+    unsigned             m_cache_hits = 0;
+    unsigned             m_cache_misses = 0;
     
     void switch_inc_mode() {
         m_inc_mode = true;
@@ -90,6 +110,100 @@ private:
         m_inc_timeout    = p.solver2_timeout();
         m_ignore_solver1 = p.ignore_solver1();
         m_inc_unknown_behavior = static_cast<inc_unknown_behavior>(p.solver2_unknown());
+        m_cache_size     = p.cache_size();
+        while (m_cache.size() > m_cache_size)
+            evict_cache_entry();
+    }
+
+    void evict_cache_entry() {
+        dealloc(m_cache[0]);
+        m_cache.erase(m_cache.begin());
+    }
+
+    expr_ref mk_cache_key(func_decl_ref_vector& consts) {
+        ast_manager& m = get_manager();
+        expr_safe_replace rep(m);
+        ast_mark visited;
+        ptr_vector<expr> todo;
+        unsigned sz = get_num_assertions();
+        for (unsigned i = 0; i < sz; ++i) {
+            todo.push_back(get_assertion(i));
+            while (!todo.empty()) {
+                expr* e = todo.back();
+                todo.pop_back();
+                if (visited.is_marked(e))
+                    continue;
+                visited.mark(e, true);
+                if (is_uninterp_const(e)) {
+                    std::string name = "cache!" + std::to_string(consts.size());
+                    consts.push_back(to_app(e)->get_decl());
+                    rep.insert(e, m.mk_const(symbol(name.c_str()), e->get_sort()));
+                }
+                else if (is_app(e)) {
+                    for (unsigned j = to_app(e)->get_num_args(); j-- > 0; )
+                        todo.push_back(to_app(e)->get_arg(j));
+                }
+                else if (is_quantifier(e))
+                    todo.push_back(to_quantifier(e)->get_expr());
+            }
+        }
+        th_rewriter rw(m);
+        expr_ref_vector fmls(m);
+        expr_ref tmp(m);
+        for (unsigned i = 0; i < sz; ++i) {
+            rep(get_assertion(i), tmp);
+            rw(tmp);
+            flatten_and(tmp, fmls);
+        }
+        std::sort(fmls.data(), fmls.data() + fmls.size(), ast_lt_proc());
+        unsigned j = 0;
+        for (unsigned i = 0; i < fmls.size(); ++i)
+            if (j == 0 || fmls.get(j - 1) != fmls.get(i))
+                fmls[j++] = fmls.get(i);
+        fmls.shrink(j);
+        return mk_and(fmls);
+    }
+
+    bool use_cache(unsigned num_assumptions) const {
+        return m_cache_size > 0 && num_assumptions == 0 && get_num_assumptions() == 0 && !get_manager().proofs_enabled();
+    }
+
+    bool check_cache(expr* key, func_decl_ref_vector const& consts, lbool& r) {
+        for (unsigned i = m_cache.size(); i-- > 0; ) {
+            cache_entry* e = m_cache[i];
+            if (e->m_key != key)
+                continue;
+            r = e->m_result;
+            m_cache_model = nullptr;
+            if (e->m_model) {
+                // rename the constants of the cached query to the current ones
+                m_cache_model = e->m_model->copy();
+                expr_ref_vector vals(get_manager());
+                for (func_decl* c : e->m_consts)
+                    vals.push_back(m_cache_model->get_const_interp(c));
+                for (func_decl* c : e->m_consts)
+                    m_cache_model->unregister_decl(c);
+                for (unsigned j = 0; j < consts.size() && j < vals.size(); ++j)
+                    if (vals.get(j) && vals.get(j)->get_sort() == consts[j]->get_range())
+                        m_cache_model->register_decl(consts[j], vals.get(j));
+            }
+            m_cache.erase(m_cache.begin() + i);
+            m_cache.push_back(e);
+            return true;
+        }
+        return false;
+    }
+
+    void insert_cache(expr* key, func_decl_ref_vector const& consts, lbool r) {
+        cache_entry* e = alloc(cache_entry, get_manager());
+        e->m_key = key;
+        e->m_result = r;
+        e->m_consts.append(consts);
+        if (r == l_true)
+            get_model_core(e->m_model);
+        if (m_cache.size() >= m_cache_size)
+            evict_cache_entry();
+        m_cache.push_back(e);
     }
 
     ast_manager& get_manager() const override { return m_solver1->get_manager(); }
@@ -124,6 +238,10 @@ public:
         m_use_solver1_results = true;
     }
 
+    ~combined_solver() override {
+        std::for_each(m_cache.begin(), m_cache.end(), delete_proc<cache_entry>());
+    }
+
     solver* translate(ast_manager& m, params_ref const& p) override {
         TRACE("solver", tout << "translate\n";);
         solver* s1 = m_solver1->translate(m, p);
@@ -208,6 +326,27 @@ public:
     }
 
     lbool check_sat_core(unsigned num_assumptions, expr * const * assumptions) override {
+        m_use_cache_result = false;
+        if (!use_cache(num_assumptions))
+            return check_sat_core1(num_assumptions, assumptions);
+        func_decl_ref_vector consts(get_manager());
+        expr_ref key = mk_cache_key(consts);
+        lbool r = l_undef;
+        if (check_cache(key, consts, r)) {
+            ++m_cache_hits;
+            IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"using cached result\")\n";);
+            m_check_sat_executed = true;
+            m_use_cache_result = true;
+            return r;
+        }
+        ++m_cache_misses;
+        r = check_sat_core1(num_assumptions, assumptions);
+        if (r != l_undef)
+            insert_cache(key, consts, r);
+        return r;
+    }
+
+    lbool check_sat_core1(unsigned num_assumptions, expr * const * assumptions) {
         m_check_sat_executed  = true;        
         m_use_solver1_results = false;
 
@@ -288,9 +427,15 @@ public:
         m_solver2->collect_statistics(st);
         if (m_use_solver1_results)
             m_solver1->collect_statistics(st);
+        if (m_cache_size > 0) {
+            st.update("combined-solver cache hits", m_cache_hits);
+            st.update("combined-solver cache misses", m_cache_misses);
+        }
     }
 
     void get_unsat_core(expr_ref_vector & r) override {
+        if (m_use_cache_result)
+            return;
         if (m_use_solver1_results)
             m_solver1->get_unsat_core(r);
         else
@@ -298,7 +443,9 @@ public:
     }
 
     void get_model_core(model_ref & m) override {
-        if (m_use_solver1_results)
+        if (m_use_cache_result)
+            m = m_cache_model;
+        else if (m_use_solver1_results)
             m_solver1->get_model(m);
         else
             m_solver2->get_model(m);
@@ -319,6 +466,8 @@ public:
     }
 
     proof * get_proof() override {
+        if (m_use_cache_result)
+            return nullptr;
         if (m_use_solver1_results)
             return m_solver1->get_proof();
         else
@@ -338,6 +487,8 @@ public:
     }
 
     void get_labels(svector<symbol> & r) override {
+        if (m_use_cache_result)
+            return;
         if (m_use_solver1_results)
             return m_solver1->get_labels(r);
         else
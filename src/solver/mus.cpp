@@ -38,6 +38,7 @@ struct mus::imp {
     expr_ref_vector          m_soft;
     vector<rational>         m_weights;
     rational                 m_weight;
+    bool                     m_divide = false;
 
     imp(solver& s): 
         m_solver(s), m(s.get_manager()), m_lit2expr(m),  m_assumptions(m), m_soft(m)
@@ -74,9 +75,57 @@ struct mus::imp {
             mus.push_back(m_lit2expr.back());
             return l_true;
         }
+        if (m_divide)
+            return get_mus_qx(mus);
         return get_mus1(mus);
     }
 
+    // divide and conquer (QuickXplain)
+    lbool get_mus_qx(expr_ref_vector& mus) {
+        ptr_vector<expr> candidates(m_lit2expr.size(), m_lit2expr.data());
+        expr_ref_vector background(m);
+        return get_mus_qx(background, false, candidates, mus);
+    }
+
+    /**
+       \brief Add to mus a minimal subset of candidates that is inconsistent
+       together with background. If check is set, background may already
+       be inconsistent by itself, and then nothing is added.
+    */
+    lbool get_mus_qx(expr_ref_vector& background, bool check, ptr_vector<expr> const& candidates, expr_ref_vector& mus) {
+        if (check) {
+            lbool is_sat;
+            {
+                scoped_append _sa(*this, background, m_assumptions);
+                is_sat = m_solver.check_sat(background);
+            }
+            if (is_sat == l_undef)
+                return l_undef;
+            if (is_sat == l_false)
+                return l_true;
+            update_model();
+        }
+        if (candidates.size() == 1) {
+            mus.push_back(candidates[0]);
+            return l_true;
+        }
+        IF_VERBOSE(12, verbose_stream() << "(mus split: " << candidates.size() << " new core: " << mus.size() << ")\n";);
+        unsigned half = candidates.size() / 2;
+        ptr_vector<expr> c1(half, candidates.data());
+        ptr_vector<expr> c2(candidates.size() - half, candidates.data() + half);
+        unsigned sz = mus.size();
+        lbool is_sat;
+        {
+            scoped_append _sa(*this, background, c1);
+            is_sat = get_mus_qx(background, true, c2, mus);
+        }
+        if (is_sat != l_true)
+            return is_sat;
+        unsigned sz2 = mus.size();
+        scoped_append _sa(*this, background, ptr_vector<expr>(sz2 - sz, mus.data() + sz));
+        return get_mus_qx(background, sz2 > sz, c1, mus);
+    }
+
     lbool get_mus1(expr_ref_vector& mus) {
         ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
         expr_ref_vector core_exprs(m);
@@ -346,6 +395,10 @@ struct mus::imp {
         return m_weight;
     }
 
+    void set_divide(bool f) {
+        m_divide = f;
+    }
+
 };
 
 mus::mus(solver& s) {
@@ -380,3 +433,7 @@ void mus::set_soft(unsigned sz, expr* const* soft, rational const* weights) {
 rational mus::get_best_model(model_ref& mdl) {
     return m_imp->get_best_model(mdl);
 }
+
+void mus::set_divide(bool f) {
+    m_imp->set_divide(f);
+}
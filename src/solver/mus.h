@@ -59,6 +59,13 @@ class mus {
     void set_soft(unsigned sz, expr* const* soft, rational const* weights);
 
     rational get_best_model(model_ref& mdl);
+
+    /**
+       Use divide and conquer (QuickXplain) instead of removing 
+       one soft constraint at a time. It takes fewer solver calls 
+       when the MUS is small compared to the set of soft constraints.
+    */
+    void set_divide(bool f);
     
 };
 
@@ -29,6 +29,8 @@ Notes:
 --*/
 
 #include "util/scoped_ptr_vector.h"
+#include "util/stopwatch.h"
+#include "util/thread_pool.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
@@ -82,27 +84,6 @@ class parallel_tactic : public tactic {
         unsigned                     m_num_waiters;
         std::atomic<bool>            m_shutdown;
 
-        void inc_wait() {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_num_waiters;
-        }
-
-        void dec_wait() {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            --m_num_waiters;
-        }
-
-        solver_state* try_get_task() {
-            solver_state* st = nullptr;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (!m_tasks.empty()) {
-                st = m_tasks.back();
-                m_tasks.pop_back();
-                m_active.push_back(st);
-            }
-            return st;
-        }
-
     public:
 
         task_queue(): 
@@ -137,23 +118,22 @@ class parallel_tactic : public tactic {
             return m_tasks.empty() && m_num_waiters > 0;
         }
 
+        /**
+           \brief retrieve the most recently added task.
+           The queue is inspected and updated in a single critical section;
+           idle workers block on m_cond until a task is added or the queue shuts down.
+        */
         solver_state* get_task() { 
-            while (!m_shutdown) {
-                inc_wait();
-                solver_state* st = try_get_task();
-                if (st) {
-                    dec_wait();
-                    return st;
-                }
-                {
-                    std::unique_lock<std::mutex> lock(m_mutex);
-                    if (!m_shutdown) {
-                        m_cond.wait(lock);
-                    }
-                }
-                dec_wait();
-            }
-            return nullptr;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            ++m_num_waiters;
+            m_cond.wait(lock, [&]() { return m_shutdown || !m_tasks.empty(); });
+            --m_num_waiters;
+            if (m_shutdown) 
+                return nullptr;
+            solver_state* st = m_tasks.back();
+            m_tasks.pop_back();
+            m_active.push_back(st);
+            return st;
         }
 
         void task_done(solver_state* st) {
@@ -221,6 +201,7 @@ class parallel_tactic : public tactic {
         unsigned        m_depth;                  // number of nested calls to cubing
         double          m_width;                  // estimate of fraction of problem handled by state
         bool            m_giveup;
+        unsigned        m_shared_head = 0;        // number of shared clauses imported into m_solver
 
     public:
         solver_state(ast_manager* m, solver* s, params_ref const& p): 
@@ -249,6 +230,12 @@ class parallel_tactic : public tactic {
         
         bool has_assumptions() const { return !m_assumptions.empty(); }
 
+        expr_ref_vector const& asserted_cubes() const { return m_asserted_cubes; }
+
+        unsigned shared_head() const { return m_shared_head; }
+
+        void set_shared_head(unsigned h) { m_shared_head = h; }
+
         solver_state* clone() {
             SASSERT(!m_cubes.empty());
             ast_manager& m = m_solver->get_manager();
@@ -261,6 +248,7 @@ class parallel_tactic : public tactic {
             for (expr* c : m_assumptions) st->m_assumptions.push_back(tr(c));
             st->m_depth = m_depth;
             st->m_width = m_width;
+            st->m_shared_head = m_shared_head;
             return st;
         }
 
@@ -377,6 +365,12 @@ private:
 
     solver_ref    m_solver;
     ast_manager&  m_manager;
+    ast_manager   m_share_manager;
+    expr_ref_vector m_shared;           // clauses that refute cubes, shared between workers
+    std::mutex    m_share_mutex;
+    unsigned      m_num_imported;
+    unsigned      m_share_max_size;
+    bool          m_display_stats;
     params_ref    m_params;
     sref_vector<model> m_models;
     expr_ref_vector m_core;
@@ -407,6 +401,9 @@ private:
         m_last_depth = 0;
         m_backtrack_frequency = pp.conquer_backtrack_frequency();
         m_conquer_delay = pp.conquer_delay();
+        m_share_max_size = pp.share_max_size();
+        m_display_stats = pp.stats();
+        m_num_imported = 0;
         m_exn_code = 0;
         m_params.set_bool("override_incremental", true);
         m_core.reset();
@@ -487,9 +484,42 @@ private:
         m_last_depth = s.get_depth();
     }
 
+    /**
+       \brief The asserted cubes of s together with the cube c are inconsistent.
+       The clause that refutes them does not depend on the cubes, so it is
+       added to the shared clauses if it is short.
+    */
+    void share_refuted_cube(solver_state& s, expr_ref_vector const& c) {
+        unsigned sz = s.asserted_cubes().size() + c.size();
+        if (s.has_assumptions() || sz == 0 || sz > m_share_max_size) 
+            return;
+        ast_manager& m = s.m();
+        expr_ref_vector lits(m);
+        for (expr* e : s.asserted_cubes()) 
+            lits.push_back(mk_not(m, e));
+        for (expr* e : c) 
+            lits.push_back(mk_not(m, e));
+        expr_ref clause = mk_or(lits);
+        std::lock_guard<std::mutex> lock(m_share_mutex);
+        ast_translation tr(m, m_share_manager);
+        m_shared.push_back(tr(clause.get()));
+    }
+
+    void import_shared(solver_state& s) {
+        std::lock_guard<std::mutex> lock(m_share_mutex);
+        if (s.shared_head() == m_shared.size())
+            return;
+        ast_translation tr(m_share_manager, s.m());
+        for (unsigned i = s.shared_head(); i < m_shared.size(); ++i) 
+            s.get_solver().assert_expr(tr(m_shared.get(i)));
+        m_num_imported += m_shared.size() - s.shared_head();
+        s.set_shared_head(m_shared.size());
+    }
+
     void report_unsat(solver_state& s) {        
         inc_unsat(s);
         close_branch(s, l_false);
+        share_refuted_cube(s, expr_ref_vector(s.m()));
         if (s.has_assumptions()) {
             expr_ref_vector core(s.m());
             s.get_solver().get_unsat_core(core);
@@ -516,6 +546,7 @@ private:
 
     cube_again:
         if (canceled(s)) return;
+        if (m_share_max_size > 0) import_shared(s);
         // extract up to one cube and add it.
         cube.reset();
         cube.append(s.split_cubes(1));
@@ -580,6 +611,7 @@ private:
             switch (is_sat) {
             case l_false: 
                 cutoff = c.size();
+                share_refuted_cube(s, c);
                 backtrack(*conquer.get(), c, (num_backtracks++) % m_backtrack_frequency == 0);
                 if (cutoff != c.size()) {
                     IF_VERBOSE(0, verbose_stream() << "(tactic.parallel :backtrack " << cutoff << " -> " << c.size() << ")\n");
@@ -691,16 +723,25 @@ private:
         return memory::above_high_watermark();
     }
 
-    void run_solver() {
+    void run_solver(unsigned id) {
+        stopwatch busy, idle;
+        unsigned num_tasks = 0;
         try {
+            idle.start();
             while (solver_state* st = m_queue.get_task()) {
+                idle.stop();
+                busy.start();
+                ++num_tasks;
                 cube_and_conquer(*st);                
                 collect_statistics(*st);
                 m_queue.task_done(st);
                 if (!st->m().inc()) m_queue.shutdown();
                 IF_VERBOSE(2, display(verbose_stream()););
                 dealloc(st);
+                busy.stop();
+                idle.start();
             }
+            idle.stop();
         }
         catch (z3_exception& ex) {   
             IF_VERBOSE(1, verbose_stream() << ex.msg() << "\n";);
@@ -715,6 +756,13 @@ private:
                 m_exn_code = -1;
             }
         }
+        if (m_display_stats) {
+            double b = busy.get_seconds(), i = idle.get_seconds();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            verbose_stream() << "(tactic.parallel :worker " << id << " :tasks " << num_tasks
+                             << " :busy " << b << " :idle " << i
+                             << " :utilization " << (b + i > 0 ? 100.0 * b / (b + i) : 0.0) << "%)\n";
+        }
     }
 
     void collect_statistics(solver_state& s) {
@@ -728,11 +776,7 @@ private:
 
     lbool solve(model_ref& mdl) {        
         add_branches(1);
-        vector<std::thread> threads;
-        for (unsigned i = 0; i < m_num_threads; ++i) 
-            threads.push_back(std::thread([this]() { run_solver(); }));
-        for (std::thread& t : threads) 
-            t.join();
+        thread_pool::run(m_num_threads, [this](unsigned i) { run_solver(i); });
         m_queue.stats(m_stats);
         m_manager.limit().reset_cancel();
         if (m_exn_code == -1) 
@@ -770,6 +814,8 @@ public:
     parallel_tactic(solver* s, params_ref const& p) :
         m_solver(s),
         m_manager(s->get_manager()),        
+        m_share_manager(m_manager, true),
+        m_shared(m_share_manager),
         m_params(p),
         m_core(m_manager) {
         init();
@@ -831,6 +877,7 @@ public:
     void cleanup() override {
         m_queue.reset();
         m_models.reset();
+        m_shared.reset();
     }
 
     tactic* translate(ast_manager& m) override {
@@ -842,6 +889,8 @@ public:
         m_params.copy(p);
         parallel_params pp(p);
         m_conquer_delay = pp.conquer_delay();
+        m_share_max_size = pp.share_max_size();
+        m_display_stats = pp.stats();
     }
 
     void collect_statistics(statistics & st) const override {
@@ -849,6 +898,8 @@ public:
         st.update("par unsat", m_num_unsat);
         st.update("par models", m_models.size());
         st.update("par progress", m_progress);
+        st.update("par shared clauses", m_shared.size());
+        st.update("par imported clauses", m_num_imported);
     }
 
     void reset_statistics() override {
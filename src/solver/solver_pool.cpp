@@ -270,11 +270,29 @@ public:
         m_base = new_base;
     }
 
+    /**
+       \brief drop the assertions of this solver.
+       The assertions already in the base solver are guarded by m_pred.
+       Instead of rebuilding the base solver, the scope is retired by
+       asserting the negation of m_pred and a fresh predicate guards
+       subsequent assertions. Clauses learned from the other assertions
+       of the base solver are retained; the base solver is rebuilt only
+       after too many scopes were retired.
+    */
     void reset() {
         SASSERT(!m_pushed);
-        m_head = 0;
         m_assertions.reset();
-        m_pool.refresh(m_base.get());
+        if (m_head == 0)
+            return;
+        m_head = 0;
+        if (is_virtual() && m_pool.retire(m_base.get())) {
+            m_base->assert_expr(m.mk_not(m_pred));
+            m_pred = m_pool.mk_pred();
+            m_assumptions.set(0, m_pred);
+        }
+        else {
+            m_pool.refresh(m_base.get());
+        }
     }
 
 private:
@@ -333,7 +351,9 @@ private:
 solver_pool::solver_pool(solver* base_solver, unsigned num_pools):
     m_base_solver(base_solver),
     m_num_pools(num_pools),
-    m_current_pool(0)
+    m_current_pool(0),
+    m_num_preds(0),
+    m_max_dead_scopes(16)
 {
     SASSERT(num_pools > 0);
 }
@@ -364,6 +384,8 @@ void solver_pool::collect_statistics(statistics &st) const {
     st.update("pool_solver.checks", m_stats.m_num_checks);
     st.update("pool_solver.checks.sat", m_stats.m_num_sat_checks);
     st.update("pool_solver.checks.undef", m_stats.m_num_undef_checks);
+    st.update("pool_solver.dead_scopes", m_stats.m_num_dead_scopes);
+    st.update("pool_solver.refreshes", m_stats.m_num_refreshes);
 }
 
 void solver_pool::reset_statistics() {
@@ -384,8 +406,8 @@ void solver_pool::reset_statistics() {
    \brief Create a fresh solver instance.
    The first num_pools solvers are independent and
    use a fresh instance of the base solver.
-   Subsequent solvers reuse the first num_polls base solvers, rotating
-   among the first num_pools.
+   Subsequent solvers share one of the first num_pools base solvers,
+   the one with the fewest assertions.
 */
 solver* solver_pool::mk_solver() {
     ref<solver> base_solver;
@@ -394,17 +416,39 @@ solver* solver_pool::mk_solver() {
         base_solver = m_base_solver->translate(m, m_base_solver->get_params());
     }
     else {
-        solver* s = m_solvers[(m_current_pool++) % m_num_pools];
-        base_solver = dynamic_cast<pool_solver*>(s)->base_solver();
+        for (unsigned i = 0; i < m_num_pools; ++i) {
+            solver* s = dynamic_cast<pool_solver*>(m_solvers[(m_current_pool + i) % m_num_pools])->base_solver();
+            if (!base_solver || s->get_num_assertions() < base_solver->get_num_assertions())
+                base_solver = s;
+        }
+        m_current_pool++;
     }
-    std::stringstream name;
-    name << "vsolver#" << m_solvers.size();
-    app_ref pred(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
+    app_ref pred = mk_pred();
     pool_solver* solver = alloc(pool_solver, base_solver.get(), *this, pred);
     m_solvers.push_back(solver);
     return solver;
 }
 
+app_ref solver_pool::mk_pred() {
+    ast_manager& m = m_base_solver->get_manager();
+    std::stringstream name;
+    name << "vsolver#" << m_num_preds++;
+    return app_ref(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
+}
+
+/**
+   \brief record that a scope of base_solver is retired.
+   Return false if the base solver should be rebuilt instead.
+*/
+bool solver_pool::retire(solver* base_solver) {
+    unsigned& n = m_dead_scopes.insert_if_not_there(base_solver, 0);
+    if (n >= m_max_dead_scopes)
+        return false;
+    ++n;
+    m_stats.m_num_dead_scopes++;
+    return true;
+}
+
 void solver_pool::reset_solver(solver* s) {
     pool_solver* ps = dynamic_cast<pool_solver*>(s);
     SASSERT(ps);
@@ -414,6 +458,8 @@ void solver_pool::reset_solver(solver* s) {
 void solver_pool::refresh(solver* base_solver) {
     ast_manager& m = m_base_solver->get_manager();
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
+    m_dead_scopes.erase(base_solver);
+    m_stats.m_num_refreshes++;
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
         if (base_solver == s->base_solver()) {
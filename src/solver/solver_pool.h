@@ -26,6 +26,7 @@ Notes:
 
 #include "solver/solver.h"
 #include "util/stopwatch.h"
+#include "util/map.h"
 
 class pool_solver;
 
@@ -37,6 +38,8 @@ class solver_pool {
         unsigned m_num_checks;
         unsigned m_num_sat_checks;
         unsigned m_num_undef_checks;
+        unsigned m_num_dead_scopes;
+        unsigned m_num_refreshes;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -44,6 +47,9 @@ class solver_pool {
     ref<solver>         m_base_solver;
     unsigned            m_num_pools;
     unsigned            m_current_pool;
+    unsigned            m_num_preds;
+    unsigned            m_max_dead_scopes;  // retired scopes kept by a base solver before it is rebuilt
+    ptr_addr_map<solver, unsigned> m_dead_scopes;
     sref_vector<solver> m_solvers;
     stats               m_stats;
 
@@ -53,6 +59,8 @@ class solver_pool {
     stopwatch m_proof_watch;
 
     void refresh(solver* s);
+    bool retire(solver* s);
+    app_ref mk_pred();
 
     ptr_vector<solver> get_base_solvers() const;
   
@@ -0,0 +1,305 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bv2int_tactic.cpp
+
+Abstract:
+
+    Translate bit-vector problems into integer arithmetic problems.
+
+    Every bit-vector term t of size n is represented by an integer term in
+    the range [0, 2^n). Bit-vector constants are replaced by integer
+    constants with range constraints. Operations that wrap around are
+    translated using mod 2^n, so the arithmetic solver axiomatizes the
+    modular reductions only for the terms it needs them for.
+
+    Supported operations are the arithmetic operations except signed
+    division, comparisons, concatenation, extraction, extensions, negation,
+    shifts by numerals and masking with numerals of the form 2^k - 1.
+    The tactic fails on goals with other bit-vector operations, or with
+    bit-vector arguments of uninterpreted functions.
+
+--*/
+#include "ast/ast_pp.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "tactic/tactical.h"
+#include "tactic/generic_model_converter.h"
+#include "tactic/bv/bv2int_tactic.h"
+
+class bv2int_tactic : public tactic {
+    ast_manager&                m;
+    params_ref                  m_params;
+    bv_util                     bv;
+    arith_util                  a;
+    obj_map<expr, expr*>        m_cache;
+    expr_ref_vector             m_pinned;
+    ptr_vector<expr>            m_todo;
+    expr_ref_vector             m_axioms;
+    generic_model_converter_ref m_mc;
+    unsigned                    m_num_vars = 0;
+
+    void checkpoint() {
+        if (!m.inc())
+            throw tactic_exception(m.limit().get_cancel_msg());
+    }
+
+    void unsupported(expr* e) {
+        TRACE("bv2int", tout << "unsupported " << mk_pp(e, m) << "\n";);
+        throw tactic_exception("bv2int: goal contains unsupported bit-vector operations");
+    }
+
+    expr* pin(expr* e) {
+        m_pinned.push_back(e);
+        return e;
+    }
+
+    rational pow2(unsigned n) { return rational::power_of_two(n); }
+
+    expr* mk_num(rational const& r) { return pin(a.mk_int(r)); }
+
+    expr* umod(expr* e, unsigned n) {
+        rational r;
+        if (a.is_numeral(e, r))
+            return mk_num(mod(r, pow2(n)));
+        return pin(a.mk_mod(e, mk_num(pow2(n))));
+    }
+
+    expr* idiv(expr* x, expr* y) { return pin(a.mk_idiv(x, y)); }
+
+    // the value of x, read as a two's complement number of size n.
+    expr* to_signed(expr* x, unsigned n) {
+        return pin(m.mk_ite(a.mk_ge(x, mk_num(pow2(n - 1))), a.mk_sub(x, mk_num(pow2(n))), x));
+    }
+
+    expr* mk_var(app* x) {
+        unsigned n = bv.get_bv_size(x);
+        expr* v = pin(m.mk_fresh_const(x->get_decl()->get_name(), a.mk_int()));
+        m_axioms.push_back(a.mk_ge(v, mk_num(rational::zero())));
+        m_axioms.push_back(a.mk_lt(v, mk_num(pow2(n))));
+        parameter p(n);
+        m_mc->hide(to_app(v)->get_decl());
+        m_mc->add(x->get_decl(), m.mk_app(bv.get_fid(), OP_INT2BV, 1, &p, 1, &v));
+        ++m_num_vars;
+        return v;
+    }
+
+    bool has_bv_arg(app* t) {
+        for (expr* arg : *t)
+            if (bv.is_bv(arg))
+                return true;
+        return false;
+    }
+
+    /**
+       \brief Translate t, given the translations of its arguments.
+    */
+    expr* mk_app(app* t, ptr_buffer<expr> const& args) {
+        rational r, k;
+        unsigned sz = 0;
+        if (bv.is_numeral(t, r, sz))
+            return mk_num(r);
+        if (bv.is_bv(t) && is_uninterp_const(t))
+            return mk_var(t);
+        if (t->get_family_id() != bv.get_fid()) {
+            // equalities, distinct and if-then-else are kept, but range over integers.
+            if ((bv.is_bv(t) || has_bv_arg(t)) && t->get_family_id() != m.get_basic_family_id())
+                unsupported(t);
+            // the declarations of these operators range over bit-vectors, build new ones over integers.
+            if (m.is_ite(t))
+                return pin(m.mk_ite(args[0], args[1], args[2]));
+            if (m.is_eq(t))
+                return pin(m.mk_eq(args[0], args[1]));
+            if (m.is_distinct(t))
+                return pin(m.mk_distinct(args.size(), args.data()));
+            if (has_bv_arg(t))
+                unsupported(t);
+            return pin(m.mk_app(t->get_decl(), args.size(), args.data()));
+        }
+        unsigned n = bv.is_bv(t) ? bv.get_bv_size(t) : bv.get_bv_size(t->get_arg(0));
+        expr* x = args.empty() ? nullptr : args[0];
+        expr* y = args.size() < 2 ? nullptr : args[1];
+        switch (t->get_decl_kind()) {
+        case OP_BADD:
+            return umod(pin(a.mk_add(args.size(), args.data())), n);
+        case OP_BSUB:
+            return umod(pin(a.mk_sub(args.size(), args.data())), n);
+        case OP_BMUL:
+            return umod(pin(a.mk_mul(args.size(), args.data())), n);
+        case OP_BNEG:
+            return umod(pin(a.mk_uminus(x)), n);
+        case OP_BNOT:
+            return pin(a.mk_sub(mk_num(pow2(n) - 1), x));
+        case OP_BUDIV:
+        case OP_BUDIV_I:
+            return pin(m.mk_ite(m.mk_eq(y, mk_num(rational::zero())), mk_num(pow2(n) - 1), idiv(x, y)));
+        case OP_BUREM:
+        case OP_BUREM_I:
+            return pin(m.mk_ite(m.mk_eq(y, mk_num(rational::zero())), x, a.mk_mod(x, y)));
+        case OP_ULEQ:
+            return pin(a.mk_le(x, y));
+        case OP_UGEQ:
+            return pin(a.mk_ge(x, y));
+        case OP_ULT:
+            return pin(a.mk_lt(x, y));
+        case OP_UGT:
+            return pin(a.mk_gt(x, y));
+        case OP_SLEQ:
+            return pin(a.mk_le(to_signed(x, n), to_signed(y, n)));
+        case OP_SGEQ:
+            return pin(a.mk_ge(to_signed(x, n), to_signed(y, n)));
+        case OP_SLT:
+            return pin(a.mk_lt(to_signed(x, n), to_signed(y, n)));
+        case OP_SGT:
+            return pin(a.mk_gt(to_signed(x, n), to_signed(y, n)));
+        case OP_CONCAT: {
+            expr* result = args[0];
+            for (unsigned i = 1; i < args.size(); ++i) {
+                unsigned w = bv.get_bv_size(t->get_arg(i));
+                result = pin(a.mk_add(a.mk_mul(mk_num(pow2(w)), result), args[i]));
+            }
+            return result;
+        }
+        case OP_EXTRACT: {
+            unsigned lo = bv.get_extract_low(t), hi = bv.get_extract_high(t);
+            if (lo > 0)
+                x = idiv(x, mk_num(pow2(lo)));
+            if (hi + 1 < bv.get_bv_size(t->get_arg(0)))
+                x = umod(x, hi - lo + 1);
+            return x;
+        }
+        case OP_ZERO_EXT:
+            return x;
+        case OP_SIGN_EXT: {
+            unsigned w = bv.get_bv_size(t->get_arg(0));
+            return pin(m.mk_ite(a.mk_ge(x, mk_num(pow2(w - 1))), a.mk_add(x, mk_num(pow2(n) - pow2(w))), x));
+        }
+        case OP_BSHL:
+            if (!bv.is_numeral(t->get_arg(1), k))
+                unsupported(t);
+            if (k >= rational(n))
+                return mk_num(rational::zero());
+            return umod(pin(a.mk_mul(mk_num(pow2(k.get_unsigned())), x)), n);
+        case OP_BLSHR:
+            if (!bv.is_numeral(t->get_arg(1), k))
+                unsupported(t);
+            if (k >= rational(n))
+                return mk_num(rational::zero());
+            return idiv(x, mk_num(pow2(k.get_unsigned())));
+        case OP_BAND:
+            // masking by 2^k - 1 keeps the k least significant bits.
+            if (args.size() == 2 && bv.is_numeral(t->get_arg(1), k) && (k + 1).is_power_of_two(sz))
+                return umod(x, sz);
+            if (args.size() == 2 && bv.is_numeral(t->get_arg(0), k) && (k + 1).is_power_of_two(sz))
+                return umod(y, sz);
+            unsupported(t);
+            return nullptr;
+        case OP_BV2INT:
+            return x;
+        case OP_INT2BV:
+            return umod(x, n);
+        default:
+            unsupported(t);
+            return nullptr;
+        }
+    }
+
+    expr* to_int(expr* e) {
+        expr* r = nullptr;
+        if (m_cache.find(e, r))
+            return r;
+        ptr_buffer<expr> args;
+        m_todo.push_back(e);
+        while (!m_todo.empty()) {
+            checkpoint();
+            expr* t = m_todo.back();
+            if (m_cache.contains(t)) {
+                m_todo.pop_back();
+                continue;
+            }
+            if (!is_app(t))
+                unsupported(t);
+            bool visited = true;
+            for (expr* arg : *to_app(t)) {
+                if (!m_cache.contains(arg)) {
+                    m_todo.push_back(arg);
+                    visited = false;
+                }
+            }
+            if (!visited)
+                continue;
+            m_todo.pop_back();
+            args.reset();
+            for (expr* arg : *to_app(t))
+                args.push_back(m_cache[arg]);
+            m_pinned.push_back(t);
+            m_cache.insert(t, mk_app(to_app(t), args));
+        }
+        return m_cache[e];
+    }
+
+    void reset() {
+        m_cache.reset();
+        m_pinned.reset();
+        m_todo.reset();
+        m_axioms.reset();
+        m_mc = nullptr;
+    }
+
+public:
+    bv2int_tactic(ast_manager& m, params_ref const& p):
+        m(m),
+        m_params(p),
+        bv(m),
+        a(m),
+        m_pinned(m),
+        m_axioms(m) {
+    }
+
+    char const* name() const override { return "bv2int"; }
+
+    tactic* translate(ast_manager& m) override {
+        return alloc(bv2int_tactic, m, m_params);
+    }
+
+    void updt_params(params_ref const& p) override {
+        m_params.append(p);
+    }
+
+    void collect_param_descrs(param_descrs& r) override {
+        r.insert("bv2int_timeout", CPK_UINT, "(default: 5000) time limit in milliseconds for solving the translated goal in the qfbv-int tactic, before falling back to bit-blasting");
+    }
+
+    void collect_statistics(statistics& st) const override {
+        st.update("bv2int vars", m_num_vars);
+    }
+
+    void reset_statistics() override {
+        m_num_vars = 0;
+    }
+
+    void operator()(goal_ref const& g, goal_ref_buffer& result) override {
+        tactic_report report("bv2int", *g);
+        fail_if_proof_generation("bv2int", g);
+        reset();
+        m_mc = alloc(generic_model_converter, m, "bv2int");
+        for (unsigned i = 0; !g->inconsistent() && i < g->size(); ++i)
+            g->update(i, to_int(g->form(i)), nullptr, g->dep(i));
+        for (expr* ax : m_axioms)
+            g->assert_expr(ax);
+        g->add(m_mc.get());
+        g->inc_depth();
+        result.push_back(g.get());
+        reset();
+    }
+
+    void cleanup() override {
+        reset();
+    }
+};
+
+tactic * mk_bv2int_tactic(ast_manager & m, params_ref const & p) {
+    return clean(alloc(bv2int_tactic, m, p));
+}
@@ -0,0 +1,23 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bv2int_tactic.h
+
+Abstract:
+
+    Translate bit-vector problems into integer arithmetic problems.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_bv2int_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+  ADD_TACTIC("bv2int", "translate bit-vector terms into integer terms modulo 2^n; fails if the goal contains operations that have no arithmetic counterpart.", "mk_bv2int_tactic(m, p)")
+*/
@@ -162,6 +162,8 @@ struct ctx_simplify_tactic::imp {
     unsigned long long          m_max_memory;
     unsigned                    m_max_depth;
     unsigned                    m_max_steps;
+    unsigned                    m_max_assertion_steps;
+    unsigned                    m_assertion_steps_start = 0;
     bool                        m_bail_on_blowup;
 
     imp(ast_manager & _m, simplifier* simp, params_ref const & p):
@@ -195,6 +197,7 @@ struct ctx_simplify_tactic::imp {
     void updt_params(params_ref const & p) {
         m_max_memory   = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_max_steps    = p.get_uint("max_steps", UINT_MAX);
+        m_max_assertion_steps = p.get_uint("max_assertion_steps", UINT_MAX);
         m_max_depth    = p.get_uint("max_depth", 1024);
         m_bail_on_blowup = p.get_bool("bail_on_blowup", false);
         m_simp->updt_params(p);
@@ -324,7 +327,9 @@ struct ctx_simplify_tactic::imp {
 
     void simplify(expr * t, expr_ref & r) {
         r = nullptr;
-        if (m_depth >= m_max_depth || m_num_steps >= m_max_steps || !is_app(t) || !m_simp->may_simplify(t)) {
+        if (m_depth >= m_max_depth || m_num_steps >= m_max_steps ||
+            m_num_steps - m_assertion_steps_start >= m_max_assertion_steps ||
+            !is_app(t) || !m_simp->may_simplify(t)) {
             r = t;
             return;
         }
@@ -527,6 +532,7 @@ struct ctx_simplify_tactic::imp {
         expr_ref r(m);
         for (unsigned i = 0; !g.inconsistent() && i < sz; ++i) {
             m_depth = 0;
+            m_assertion_steps_start = m_num_steps;
             simplify(g.form(i), r);
             if (i < sz - 1 && !m.is_true(r) && !m.is_false(r) && !g.dep(i) && !assert_expr(r, false)) {
                 r = m.mk_false();
@@ -542,6 +548,7 @@ struct ctx_simplify_tactic::imp {
         for (unsigned i = sz; !g.inconsistent() && i > 0; ) {
             m_depth = 0;
             --i;
+            m_assertion_steps_start = m_num_steps;
             simplify(g.form(i), r);
             if (i > 0 && !m.is_true(r) && !m.is_false(r) && !g.dep(i) && !assert_expr(r, false)) {
                 r = m.mk_false();
@@ -556,6 +563,7 @@ struct ctx_simplify_tactic::imp {
         TRACE("ctx_simplify_tactic", tout << "simplifying:\n" << mk_ismt2_pp(s, m) << "\n";);
         SASSERT(scope_level() == 0);
         m_depth = 0;
+        m_assertion_steps_start = m_num_steps;
         simplify(s, r);
         SASSERT(scope_level() == 0);
         SASSERT(m_depth == 0);
@@ -613,6 +621,7 @@ void ctx_simplify_tactic::get_param_descrs(param_descrs & r) {
     insert_max_memory(r);
     insert_max_steps(r);
     r.insert("max_depth", CPK_UINT, "(default: 1024) maximum term depth.");
+    r.insert("max_assertion_steps", CPK_UINT, "(default: infty) maximum number of steps spent on a single assertion.");
     r.insert("propagate_eq", CPK_BOOL, "(default: false) enable equality propagation from bounds.");
 }
 
@@ -15,20 +15,40 @@ Author:
 
 Notes:
 
+    With threads > 1 the assertions are split into contiguous blocks.
+    Each block is copied into its own ast_manager and simplified by its
+    own th_rewriter. The results are copied back in the original order,
+    so the resulting goal does not depend on thread scheduling.
+
 --*/
 #include "tactic/core/simplify_tactic.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include "util/thread_pool.h"
+#endif
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
+    params_ref      m_params;
     unsigned        m_num_steps;
+    unsigned        m_threads;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
         m_num_steps(0) {
+        updt_params(p);
+    }
+
+    void updt_params(params_ref const & p) {
+        m_params.copy(p);
+        m_threads = p.get_uint("threads", 1);
+        m_r.updt_params(p);
     }
 
     ~imp() {
@@ -47,6 +67,16 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        unsigned num_threads = std::min(m_threads, g.size() / 2);
+#ifdef SINGLE_THREAD
+        num_threads = 1;
+#endif
+        if (num_threads > 1 && !g.proofs_enabled() && !m().has_trace_stream()) {
+            simplify_par(g, num_threads);
+            TRACE("simplifier", g.display(tout););
+            g.elim_redundancies();
+            return;
+        }
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -67,6 +97,71 @@ struct simplify_tactic::imp {
         TRACE("after_simplifier_detail", g.display_with_dependencies(tout););
     }
 
+#ifdef SINGLE_THREAD
+    void simplify_par(goal & g, unsigned num_threads) {
+        UNREACHABLE();
+    }
+#else
+    void simplify_par(goal & g, unsigned num_threads) {
+        unsigned size = g.size();
+        unsigned block = (size + num_threads - 1) / num_threads;
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_limits scl(m().limit());
+        vector<expr_ref_vector> fmls;
+        unsigned_vector steps(num_threads, 0u);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager * new_m = alloc(ast_manager, m(), true);
+            managers.push_back(new_m);
+            scl.push_child(&new_m->limit());
+            ast_translation translator(m(), *new_m);
+            fmls.push_back(expr_ref_vector(*new_m));
+            for (unsigned idx = i * block; idx < std::min(size, (i + 1) * block); ++idx)
+                fmls.back().push_back(translator(g.form(idx)));
+        }
+
+        std::string ex_msg;
+        bool failed = false;
+        mutex mux;
+
+        auto worker_thread = [&](unsigned i) {
+            try {
+                th_rewriter rw(*managers[i], m_params);
+                expr_ref new_curr(*managers[i]);
+                for (unsigned j = 0; j < fmls[i].size(); ++j) {
+                    rw(fmls[i].get(j), new_curr);
+                    steps[i] += rw.get_num_steps();
+                    fmls[i][j] = new_curr;
+                }
+            }
+            catch (z3_exception & ex) {
+                lock_guard lock(mux);
+                if (!failed) {
+                    failed = true;
+                    ex_msg = ex.msg();
+                }
+                for (ast_manager* new_m : managers)
+                    new_m->limit().cancel();
+            }
+        };
+
+        thread_pool::run(num_threads, worker_thread);
+
+        if (failed)
+            throw rewriter_exception(std::move(ex_msg));
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_translation translator(*managers[i], m(), false);
+            m_num_steps += steps[i];
+            unsigned idx = i * block;
+            for (expr* f : fmls[i]) {
+                g.update(idx, translator(f), nullptr, g.dep(idx));
+                ++idx;
+                if (g.inconsistent())
+                    return;
+            }
+        }
+    }
+#endif
+
     unsigned get_num_steps() const { return m_num_steps; }
 };
 
@@ -81,11 +176,12 @@ simplify_tactic::~simplify_tactic() {
 
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params.append(p);
-    m_imp->m_r.updt_params(m_params);
+    m_imp->updt_params(m_params);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
     th_rewriter::get_param_descrs(r);
+    r.insert("threads", CPK_UINT, "number of threads used to simplify the assertions of large goals", "1");
 }
 
 void simplify_tactic::operator()(goal_ref const & in, 
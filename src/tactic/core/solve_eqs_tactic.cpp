@@ -29,6 +29,7 @@ Revision History:
 #include "tactic/tactical.h"
 #include "tactic/generic_model_converter.h"
 #include "tactic/tactic_params.hpp"
+#include "util/stopwatch.h"
 
 class solve_eqs_tactic : public tactic {
     struct imp {
@@ -57,6 +58,9 @@ class solve_eqs_tactic : public tactic {
         bool                          m_produce_proofs;
         bool                          m_produce_unsat_cores;
         bool                          m_produce_models;
+        stopwatch                     m_collect_watch;
+        stopwatch                     m_sort_watch;
+        stopwatch                     m_substitute_watch;
         
         imp(ast_manager & m, params_ref const & p, expr_replacer * r, bool owner):
             m_manager(m),
@@ -921,9 +925,60 @@ class solve_eqs_tactic : public tactic {
                   });
         }
 
+        /**
+           \brief Return true if f contains one of the variables marked in has_var.
+           Results for shared subterms are memoized in visited/has_var across calls,
+           so checking all assertions of a goal is linear in its size.
+        */
+        bool mentions_var(expr * f, expr_mark & visited, expr_mark & has_var) {
+            if (visited.is_marked(f))
+                return has_var.is_marked(f);
+            ptr_buffer<expr, 128> todo;
+            todo.push_back(f);
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                if (visited.is_marked(e)) {
+                    todo.pop_back();
+                    continue;
+                }
+                if (!is_app(e)) {
+                    // be conservative on quantifiers and bound variables
+                    visited.mark(e);
+                    has_var.mark(e, is_quantifier(e));
+                    todo.pop_back();
+                    continue;
+                }
+                bool pending = false;
+                for (expr * arg : *to_app(e)) {
+                    if (!visited.is_marked(arg)) {
+                        todo.push_back(arg);
+                        pending = true;
+                    }
+                }
+                if (pending)
+                    continue;
+                todo.pop_back();
+                visited.mark(e);
+                for (expr * arg : *to_app(e)) {
+                    if (has_var.is_marked(arg)) {
+                        has_var.mark(e);
+                        break;
+                    }
+                }
+            }
+            return has_var.is_marked(f);
+        }
+
         void substitute(goal & g) {
             // force the cache of m_r to be reset.
             m_r->set_substitution(m_norm_subst.get());
+
+            // only assertions that mention an eliminated variable are rewritten
+            expr_mark visited, has_var;
+            for (app * v : m_ordered_vars) {
+                visited.mark(v);
+                has_var.mark(v);
+            }
             
             expr_ref new_f(m());
             proof_ref new_pr(m());
@@ -944,6 +999,9 @@ class solve_eqs_tactic : public tactic {
                     continue;
                 }
 
+                if (!mentions_var(f, visited, has_var))
+                    continue;
+
                 m_r->operator()(f, new_f, new_pr, new_dep);
 
                 TRACE("solve_eqs_subst", tout << mk_ismt2_pp(f, m()) << "\n--->\n" << mk_ismt2_pp(new_f, m()) << "\n";);
@@ -1052,20 +1110,29 @@ class solve_eqs_tactic : public tactic {
                     if (!m_produce_proofs && m_context_solve && rounds < 3) {
                         distribute_and_or(*(g.get()));
                     }
-                    collect_num_occs(*g);
-                    collect(*g);
-                    if (!m_produce_proofs && m_context_solve && rounds < 3) {
-                        collect_hoist(*g);
+                    {
+                        scoped_watch _sw(m_collect_watch);
+                        collect_num_occs(*g);
+                        collect(*g);
+                        if (!m_produce_proofs && m_context_solve && rounds < 3) {
+                            collect_hoist(*g);
+                        }
                     }
                     if (m_subst->empty()) {
                         break;
                     }
-                    sort_vars();
+                    {
+                        scoped_watch _sw(m_sort_watch);
+                        sort_vars();
+                    }
                     if (m_ordered_vars.empty()) {
                         break;
                     }
-                    normalize();
-                    substitute(*(g.get()));
+                    {
+                        scoped_watch _sw(m_substitute_watch);
+                        normalize();
+                        substitute(*(g.get()));
+                    }
                     if (g->inconsistent()) {
                         break;
                     }
@@ -1128,16 +1195,25 @@ public:
 
         imp * d = alloc(imp, m, m_params, r, owner);
         d->m_num_eliminated_vars = num_elim_vars;
+        d->m_collect_watch = m_imp->m_collect_watch;
+        d->m_sort_watch = m_imp->m_sort_watch;
+        d->m_substitute_watch = m_imp->m_substitute_watch;
         std::swap(d, m_imp);        
         dealloc(d);
     }
 
     void collect_statistics(statistics & st) const override {
         st.update("eliminated vars", m_imp->get_num_eliminated_vars());
+        st.update("solve-eqs collect time", m_imp->m_collect_watch.get_seconds());
+        st.update("solve-eqs sort time", m_imp->m_sort_watch.get_seconds());
+        st.update("solve-eqs substitute time", m_imp->m_substitute_watch.get_seconds());
     }
 
     void reset_statistics() override {
         m_imp->m_num_eliminated_vars = 0;
+        m_imp->m_collect_watch.reset();
+        m_imp->m_sort_watch.reset();
+        m_imp->m_substitute_watch.reset();
     }
     
 };
@@ -9,6 +9,11 @@ Abstract:
 
     This solver identifies bounded integers and rewrites them to bit-vectors.
 
+    With int2bv_adaptive_bits = k > 0, the bit-vectors are first restricted to 
+    their k low bits: a guard literal asserts that the high bits are zero and 
+    is passed as an assumption. When a guard occurs in an unsat core, the
+    number of bits of its bit-vector is doubled.
+
 Author:
 
     Nikolaj Bjorner (nbjorner) 2016-10-23
@@ -45,6 +50,19 @@ class bounded_int2bv_solver : public solver_na2as {
     mutable bv2int_rewriter_ctx   m_rewriter_ctx;
     mutable bv2int_rewriter_star  m_rewriter;
     mutable bool                  m_flushed;
+    unsigned                      m_adaptive_bits;
+    mutable expr_ref_vector       m_guards;
+    mutable obj_map<func_decl, expr*>    m_bv2guard;   // bit-vector -> guard that restricts its high bits
+    mutable obj_map<expr, func_decl*>    m_guard2bv;
+    mutable obj_map<func_decl, unsigned> m_bv2bits;    // bit-vector -> number of bits allowed by its guard
+    struct guard_undo {
+        func_decl* m_bv;
+        expr*      m_guard;                            // previous guard, nullptr if there was none
+        unsigned   m_bits;                             // previous number of bits, 0 if there was none
+    };
+    mutable svector<guard_undo>   m_guard_trail;       // restores guards that were replaced in a scope
+    unsigned_vector               m_guard_trail_lim;
+    unsigned                      m_num_widenings = 0;
 
 public:
 
@@ -59,7 +77,9 @@ public:
         m_int_fns(m),
         m_rewriter_ctx(m, p, p.get_uint("max_bv_size", UINT_MAX)),
         m_rewriter(m, m_rewriter_ctx),
-        m_flushed(false)
+        m_flushed(false),
+        m_adaptive_bits(p.get_uint("int2bv_adaptive_bits", 0)),
+        m_guards(m)
     {
         solver::updt_params(p);
         m_bounds.push_back(alloc(bound_manager, m));
@@ -111,6 +131,7 @@ public:
         flush_assertions();
         m_solver->push();
         m_bv_fns_lim.push_back(m_bv_fns.size());
+        m_guard_trail_lim.push_back(m_guard_trail.size());
         m_bounds.push_back(alloc(bound_manager, m));
     }
 
@@ -121,9 +142,17 @@ public:
         if (n > 0) {
             SASSERT(n <= m_bv_fns_lim.size());
             unsigned new_sz = m_bv_fns_lim.size() - n;
+            undo_guards(m_guard_trail_lim[new_sz]);
+            m_guard_trail_lim.resize(new_sz);
             unsigned lim = m_bv_fns_lim[new_sz];
             for (unsigned i = m_int_fns.size(); i > lim; ) {
                 --i;
+                expr* g = nullptr;
+                if (m_bv2guard.find(m_bv_fns.get(i), g)) {
+                    m_guard2bv.erase(g);
+                    m_bv2guard.erase(m_bv_fns.get(i));
+                    m_bv2bits.erase(m_bv_fns.get(i));
+                }
                 m_int2bv.erase(m_int_fns[i].get());
                 m_bv2int.erase(m_bv_fns[i].get());
                 m_bv2offset.erase(m_bv_fns[i].get());
@@ -142,14 +171,48 @@ public:
 
     lbool check_sat_core2(unsigned num_assumptions, expr * const * assumptions) override {
         flush_assertions();
-        return m_solver->check_sat_core(num_assumptions, assumptions);
+        if (m_bv2guard.empty())
+            return m_solver->check_sat_core(num_assumptions, assumptions);
+        expr_ref_vector asms(m), core(m);
+        while (true) {
+            asms.reset();
+            asms.append(num_assumptions, assumptions);
+            for (auto const& kv : m_bv2guard)
+                asms.push_back(kv.m_value);
+            lbool r = m_solver->check_sat_core(asms.size(), asms.data());
+            if (r != l_false)
+                return r;
+            core.reset();
+            m_solver->get_unsat_core(core);
+            bool widened = false;
+            for (expr* c : core) {
+                func_decl* f = nullptr;
+                if (m_guard2bv.find(c, f)) {
+                    widen(f);
+                    widened = true;
+                }
+            }
+            if (!widened)
+                return r;
+        }
     }
 
-    void updt_params(params_ref const & p) override { solver::updt_params(p); m_solver->updt_params(p);  }
-    void collect_param_descrs(param_descrs & r) override { m_solver->collect_param_descrs(r); }
+    void updt_params(params_ref const & p) override { 
+        solver::updt_params(p); 
+        m_solver->updt_params(p);  
+        m_adaptive_bits = get_params().get_uint("int2bv_adaptive_bits", m_adaptive_bits);
+    }
+    void collect_param_descrs(param_descrs & r) override { 
+        m_solver->collect_param_descrs(r); 
+        r.insert("int2bv_adaptive_bits", CPK_UINT, "initial number of bits of bit-vectors for bounded integers, the number is doubled when it is too small (0 - use the bits of the bounds)", "0");
+    }
     void set_produce_models(bool f) override { m_solver->set_produce_models(f); }
     void set_progress_callback(progress_callback * callback) override { m_solver->set_progress_callback(callback);  }
-    void collect_statistics(statistics & st) const override { m_solver->collect_statistics(st); }
+    void collect_statistics(statistics & st) const override { 
+        m_solver->collect_statistics(st); 
+        if (m_num_widenings > 0)
+            st.update("int2bv widenings", m_num_widenings);
+    }
     void get_unsat_core(expr_ref_vector & r) override { m_solver->get_unsat_core(r); }
     void set_phase(expr* e) override { m_solver->set_phase(e); }
     phase* get_phase() override { return m_solver->get_phase(); }
@@ -177,6 +240,8 @@ public:
         generic_model_converter* mc = alloc(generic_model_converter, m, "bounded_int2bv");
         for (func_decl* f : m_bv_fns) 
             mc->hide(f);
+        for (expr* g : m_guards)
+            mc->hide(to_app(g)->get_decl());
         for (auto const& kv : m_int2bv) {
             rational offset;
             VERIFY (m_bv2offset.find(kv.m_value, offset));
@@ -241,6 +306,63 @@ public:
 
 private:
 
+    /**
+       \brief Restrict the bit-vector f to its low num_bits bits using a fresh guard literal.
+       The restriction is removed if num_bits covers all bits of f.
+    */
+    void restrict_bits(func_decl* f, unsigned num_bits) const {
+        unsigned sz = m_bv.get_bv_size(f->get_range());
+        expr* g = nullptr;
+        unsigned bits = 0;
+        m_bv2bits.find(f, bits);
+        if (m_bv2guard.find(f, g)) {
+            m_guard2bv.erase(g);
+            m_bv2guard.erase(f);
+        }
+        m_guard_trail.push_back({ f, g, bits });
+        m_bv2bits.insert(f, num_bits);
+        if (num_bits >= sz)
+            return;
+        expr_ref guard(m.mk_fresh_const("g", m.mk_bool_sort()), m);
+        expr_ref high(m_bv.mk_extract(sz - 1, num_bits, m.mk_const(f)), m);
+        m_guards.push_back(guard);
+        m_bv2guard.insert(f, guard);
+        m_guard2bv.insert(guard, f);
+        m_solver->assert_expr(m.mk_implies(guard, m.mk_eq(high, m_bv.mk_numeral(rational::zero(), sz - num_bits))));
+    }
+
+    /**
+       \brief restore the guards that were replaced since the trail had size sz.
+       The guard implications asserted in the popped scopes are gone,
+       while the guards they replaced are still asserted.
+    */
+    void undo_guards(unsigned sz) {
+        while (m_guard_trail.size() > sz) {
+            guard_undo const& u = m_guard_trail.back();
+            expr* g = nullptr;
+            if (m_bv2guard.find(u.m_bv, g)) {
+                m_guard2bv.erase(g);
+                m_bv2guard.erase(u.m_bv);
+            }
+            if (u.m_guard) {
+                m_bv2guard.insert(u.m_bv, u.m_guard);
+                m_guard2bv.insert(u.m_guard, u.m_bv);
+            }
+            if (u.m_bits > 0)
+                m_bv2bits.insert(u.m_bv, u.m_bits);
+            else
+                m_bv2bits.erase(u.m_bv);
+            m_guard_trail.pop_back();
+        }
+    }
+
+    void widen(func_decl* f) {
+        ++m_num_widenings;
+        unsigned num_bits = m_bv2bits[f];
+        IF_VERBOSE(10, verbose_stream() << "(int2bv.widen " << f->get_name() << " " << num_bits << " -> " << 2 * num_bits << ")\n");
+        restrict_bits(f, 2 * num_bits);
+    }
+
     void accumulate_sub(expr_safe_replace& sub) const {
         for (unsigned i = 0; i < m_bounds.size(); ++i) {
             accumulate_sub(sub, *m_bounds[i]);
@@ -275,6 +397,8 @@ private:
                     if (!offset.is_zero() && !n.is_power_of_two(shift)) {
                         m_assertions.push_back(m_bv.mk_ule(b, m_bv.mk_numeral(n-rational::one(), num_bits)));
                     }
+                    if (m_adaptive_bits > 0 && m_adaptive_bits < num_bits) 
+                        restrict_bits(fbv, m_adaptive_bits);
                 }
                 else {
                     VERIFY(m_bv2offset.find(fbv, offset));
@@ -377,6 +377,37 @@ namespace smtfd {
         unsigned   m_val_offset;
     };
 
+    /**
+       \brief Ground subterms of a growing set of terms.
+       Subterms of terms that were added before are not traversed again.
+    */
+    class ground_subterms {
+        ptr_vector<expr> m_terms, m_todo;
+        expr_mark        m_visited;
+    public:
+        void add(expr* e) {
+            m_todo.push_back(e);
+            while (!m_todo.empty()) {
+                expr* t = m_todo.back();
+                m_todo.pop_back();
+                if (m_visited.is_marked(t))
+                    continue;
+                m_visited.mark(t, true);
+                m_terms.push_back(t);
+                if (is_app(t))
+                    for (expr* arg : *to_app(t))
+                        m_todo.push_back(arg);
+            }
+        }
+
+        void add(expr_ref_vector const& es, unsigned start = 0) {
+            for (unsigned i = start; i < es.size(); ++i)
+                add(es.get(i));
+        }
+
+        ptr_vector<expr> const& terms() const { return m_terms; }
+    };
+
     class theory_plugin;
 
     class plugin_context {
@@ -441,8 +472,9 @@ namespace smtfd {
          * \brief add theory axioms that are violdated in the current model
          * the round indicator is used to prioritize "cheap" axioms before
          * expensive axiom instantiation. 
+         * ground contains the ground subterms of core.
          */
-        bool add_theory_axioms(expr_ref_vector const& core, unsigned round);
+        bool add_theory_axioms(expr_ref_vector const& core, ground_subterms const& ground, unsigned round);
 
         std::ostream& display(std::ostream& out);
 
@@ -612,7 +644,7 @@ namespace smtfd {
         }
     }
 
-    bool plugin_context::add_theory_axioms(expr_ref_vector const& core, unsigned round) {
+    bool plugin_context::add_theory_axioms(expr_ref_vector const& core, ground_subterms const& ground, unsigned round) {
         unsigned max_rounds = 0;
         for (theory_plugin* p : m_plugins) {
             max_rounds = std::max(max_rounds, p->max_rounds());
@@ -621,7 +653,7 @@ namespace smtfd {
             return false;
         }
         else if (round < max_rounds) {
-            for (expr* t : subterms::ground(core)) {
+            for (expr* t : ground.terms()) {
                 for (theory_plugin* p : m_plugins) {
                     p->check_term(t, round);
                 }
@@ -1701,8 +1733,10 @@ namespace smtfd {
             m_context.reset(m_model);           
             expr_ref_vector terms(core);
             terms.append(m_axioms);
+            ground_subterms ground;
+            ground.add(terms);
 
-            for (unsigned round = 0; !m_context.at_max() && m_context.add_theory_axioms(terms, round); ++round) {}
+            for (unsigned round = 0; !m_context.at_max() && m_context.add_theory_axioms(terms, ground, round); ++round) {}
             
             TRACE("smtfd", m_context.display(tout););
             for (expr* f : m_context) {
@@ -1990,12 +2024,19 @@ namespace smtfd {
             lbool r = l_true;
             unsigned round = 0;
             m_context.reset(m_model);
+            // the core is fixed during refinement and axioms are only added, 
+            // so the ground subterms are extended incrementally across rounds.
+            ground_subterms ground;
+            ground.add(core);
+            unsigned num_axioms = 0;
             while (true) {
                 
                 expr_ref_vector terms(core);
                 terms.append(m_axioms);
+                ground.add(m_axioms, num_axioms);
+                num_axioms = m_axioms.size();
 
-                if (!m_context.add_theory_axioms(terms, round)) {
+                if (!m_context.add_theory_axioms(terms, ground, round)) {
                     break;
                 }
                 if (m_context.empty()) {
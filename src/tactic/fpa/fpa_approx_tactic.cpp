@@ -0,0 +1,309 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    fpa_approx_tactic.cpp
+
+Abstract:
+
+    Tactic that approximates floating-point constraints by real arithmetic.
+
+Notes:
+
+    Floating-point values that are NaN or infinite, rounding mode terms
+    outside of arithmetic operations, and operations without an exact
+    real counterpart (fp.sqrt, fp.rem, fp.roundToIntegral, conversions)
+    make the tactic fail. Every floating-point constant is bounded by the
+    largest finite value of its sort in the approximation.
+
+--*/
+#include "ast/fpa_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/ast_pp.h"
+#include "model/model_evaluator.h"
+#include "tactic/tactical.h"
+#include "tactic/smtlogics/smt_tactic.h"
+#include "tactic/fpa/qffp_tactic.h"
+#include "tactic/fpa/fpa_approx_tactic.h"
+
+class fpa_approx_tactic : public tactic {
+    ast_manager &       m;
+    params_ref          m_params;
+    fpa_util            m_fpa;
+    arith_util          m_arith;
+    obj_map<expr, expr*> m_cache;
+    expr_ref_vector     m_pinned;
+    expr_ref_vector     m_bounds;       // range of the real counterparts
+    app_ref_vector      m_fp_consts;    // floating-point constants of the goal
+    app_ref_vector      m_real_consts;  // their real counterparts
+    app_ref_vector      m_rm_consts;    // rounding mode constants used by operations
+    app_ref_vector      m_kept_consts;  // constants of other sorts, shared with the approximation
+
+    void fail(char const * msg) {
+        throw tactic_exception(std::string("fp-approx: ") + msg);
+    }
+
+    expr * arg(app * a, unsigned i) {
+        expr * r = nullptr;
+        if (!m_cache.find(a->get_arg(i), r))
+            fail("unsupported rounding mode term");
+        return r;
+    }
+
+    expr_ref mk_real_const(app * a) {
+        mpf_manager & fm = m_fpa.fm();
+        unsigned ebits = m_fpa.get_ebits(a->get_sort());
+        unsigned sbits = m_fpa.get_sbits(a->get_sort());
+        app_ref r(m.mk_fresh_const(a->get_decl()->get_name().str(), m_arith.mk_real()), m);
+        m_fp_consts.push_back(a);
+        m_real_consts.push_back(r);
+        scoped_mpf mx(fm);
+        scoped_mpq q(fm.mpq_manager());
+        fm.mk_max_value(ebits, sbits, false, mx);
+        fm.to_rational(mx, q);
+        expr_ref bound(m_arith.mk_numeral(rational(q), false), m);
+        m_bounds.push_back(m_arith.mk_le(r, bound));
+        m_bounds.push_back(m_arith.mk_ge(r, m_arith.mk_uminus(bound)));
+        return expr_ref(r, m);
+    }
+
+    expr_ref translate_fpa(app * a) {
+        mpf_manager & fm = m_fpa.fm();
+        expr_ref zero(m_arith.mk_real(0), m);
+        switch (a->get_decl_kind()) {
+        case OP_FPA_NUM: {
+            scoped_mpf v(fm);
+            scoped_mpq q(fm.mpq_manager());
+            VERIFY(m_fpa.is_numeral(a, v));
+            if (fm.is_nan(v) || fm.is_inf(v))
+                fail("special values are not supported");
+            fm.to_rational(v, q);
+            return expr_ref(m_arith.mk_numeral(rational(q), false), m);
+        }
+        case OP_FPA_PLUS_ZERO:
+        case OP_FPA_MINUS_ZERO:
+            return zero;
+        case OP_FPA_ADD:
+            return expr_ref(m_arith.mk_add(arg(a, 1), arg(a, 2)), m);
+        case OP_FPA_SUB:
+            return expr_ref(m_arith.mk_sub(arg(a, 1), arg(a, 2)), m);
+        case OP_FPA_MUL:
+            return expr_ref(m_arith.mk_mul(arg(a, 1), arg(a, 2)), m);
+        case OP_FPA_DIV:
+            return expr_ref(m_arith.mk_div(arg(a, 1), arg(a, 2)), m);
+        case OP_FPA_FMA:
+            return expr_ref(m_arith.mk_add(m_arith.mk_mul(arg(a, 1), arg(a, 2)), arg(a, 3)), m);
+        case OP_FPA_NEG:
+            return expr_ref(m_arith.mk_uminus(arg(a, 0)), m);
+        case OP_FPA_ABS:
+            return expr_ref(m.mk_ite(m_arith.mk_lt(arg(a, 0), zero), m_arith.mk_uminus(arg(a, 0)), arg(a, 0)), m);
+        case OP_FPA_MIN:
+            return expr_ref(m.mk_ite(m_arith.mk_le(arg(a, 0), arg(a, 1)), arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_MAX:
+            return expr_ref(m.mk_ite(m_arith.mk_ge(arg(a, 0), arg(a, 1)), arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_EQ:
+            return expr_ref(m.mk_eq(arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_LT:
+            return expr_ref(m_arith.mk_lt(arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_GT:
+            return expr_ref(m_arith.mk_gt(arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_LE:
+            return expr_ref(m_arith.mk_le(arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_GE:
+            return expr_ref(m_arith.mk_ge(arg(a, 0), arg(a, 1)), m);
+        case OP_FPA_IS_ZERO:
+            return expr_ref(m.mk_eq(arg(a, 0), zero), m);
+        case OP_FPA_IS_NAN:
+        case OP_FPA_IS_INF:
+            return expr_ref(m.mk_false(), m);
+        case OP_FPA_IS_NEGATIVE:
+            return expr_ref(m_arith.mk_lt(arg(a, 0), zero), m);
+        case OP_FPA_IS_POSITIVE:
+            return expr_ref(m_arith.mk_gt(arg(a, 0), zero), m);
+        case OP_FPA_TO_REAL:
+            return expr_ref(arg(a, 0), m);
+        default:
+            fail("unsupported floating-point operation");
+            return zero;
+        }
+    }
+
+    expr_ref mk_real_app(app * a) {
+        family_id fid = a->get_family_id();
+        sort * s = a->get_sort();
+        if (is_uninterp_const(a)) {
+            if (m_fpa.is_float(s))
+                return mk_real_const(a);
+            if (m_fpa.is_rm(s))
+                fail("unsupported rounding mode term");
+            m_kept_consts.push_back(a);
+            return expr_ref(a, m);
+        }
+        if (fid == m_fpa.get_family_id())
+            return translate_fpa(a);
+        if (fid == m.get_basic_family_id() || (fid == m_arith.get_family_id() && !m_arith.is_numeral(a))) {
+            ptr_buffer<expr> args;
+            for (unsigned i = 0; i < a->get_num_args(); ++i)
+                args.push_back(arg(a, i));
+            return expr_ref(m.mk_app(fid, a->get_decl_kind(), args.size(), args.data()), m);
+        }
+        if (m_arith.is_numeral(a))
+            return expr_ref(a, m);
+        fail("unsupported operator");
+        return expr_ref(m);
+    }
+
+    expr * to_real(expr * e) {
+        ptr_buffer<expr> todo;
+        todo.push_back(e);
+        while (!todo.empty()) {
+            expr * c = todo.back();
+            if (m_cache.contains(c)) {
+                todo.pop_back();
+                continue;
+            }
+            if (!is_app(c))
+                fail("quantifiers are not supported");
+            app * a = to_app(c);
+            bool visited = true;
+            for (expr * arg : *a) {
+                if (m_fpa.is_rm(arg) && a->get_family_id() == m_fpa.get_family_id()) {
+                    // rounding is ignored by the approximation.
+                    if (is_uninterp_const(arg))
+                        m_rm_consts.push_back(to_app(arg));
+                    continue;
+                }
+                if (!m_cache.contains(arg)) {
+                    todo.push_back(arg);
+                    visited = false;
+                }
+            }
+            if (!visited)
+                continue;
+            expr_ref r = mk_real_app(a);
+            m_pinned.push_back(r);
+            m_cache.insert(c, r);
+            todo.pop_back();
+        }
+        return m_cache[e];
+    }
+
+    /**
+       \brief Round the real model to floating-point values and return it if
+       it satisfies the original formulas.
+    */
+    model_ref validate(goal const & g, model & rmdl) {
+        mpf_manager & fm = m_fpa.fm();
+        model_ref mdl = alloc(model, m);
+        for (unsigned i = 0; i < m_fp_consts.size(); ++i) {
+            app * a = m_fp_consts.get(i);
+            expr_ref v = rmdl(m_real_consts.get(i));
+            rational r;
+            if (!m_arith.is_numeral(v, r))
+                return model_ref();
+            scoped_mpf f(fm);
+            fm.set(f, m_fpa.get_ebits(a->get_sort()), m_fpa.get_sbits(a->get_sort()), MPF_ROUND_NEAREST_TEVEN, r.to_mpq());
+            mdl->register_decl(a->get_decl(), m_fpa.mk_value(f));
+        }
+        for (app * a : m_rm_consts)
+            if (!mdl->has_interpretation(a->get_decl()))
+                mdl->register_decl(a->get_decl(), m_fpa.mk_round_nearest_ties_to_even());
+        for (app * a : m_kept_consts)
+            if (!mdl->has_interpretation(a->get_decl()))
+                mdl->register_decl(a->get_decl(), rmdl(a));
+        model_evaluator ev(*mdl);
+        ev.set_model_completion(true);
+        expr_ref val(m);
+        for (unsigned i = 0; i < g.size(); ++i) {
+            ev(g.form(i), val);
+            if (!m.is_true(val)) {
+                TRACE("fp_approx", tout << "rounded model falsifies " << mk_pp(g.form(i), m) << "\n";);
+                return model_ref();
+            }
+        }
+        return mdl;
+    }
+
+    void reset() {
+        m_cache.reset();
+        m_pinned.reset();
+        m_bounds.reset();
+        m_fp_consts.reset();
+        m_real_consts.reset();
+        m_rm_consts.reset();
+        m_kept_consts.reset();
+    }
+
+public:
+    fpa_approx_tactic(ast_manager & m, params_ref const & p):
+        m(m),
+        m_params(p),
+        m_fpa(m),
+        m_arith(m),
+        m_pinned(m),
+        m_bounds(m),
+        m_fp_consts(m),
+        m_real_consts(m),
+        m_rm_consts(m),
+        m_kept_consts(m) {
+    }
+
+    tactic * translate(ast_manager & m) override {
+        return alloc(fpa_approx_tactic, m, m_params);
+    }
+
+    char const * name() const override { return "fp-approx"; }
+
+    void updt_params(params_ref const & p) override {
+        m_params.append(p);
+    }
+
+    void collect_param_descrs(param_descrs & r) override {
+    }
+
+    void operator()(goal_ref const & g, goal_ref_buffer & result) override {
+        tactic_report report("fp-approx", *g);
+        fail_if_proof_generation("fp-approx", g);
+        fail_if_has_quantifiers("fp-approx", g);
+        reset();
+        goal_ref approx = alloc(goal, m, false, true, false);
+        for (unsigned i = 0; i < g->size(); ++i)
+            approx->assert_expr(to_real(g->form(i)));
+        for (expr * e : m_bounds)
+            approx->assert_expr(e);
+
+        tactic_ref solver = mk_smt_tactic(m, m_params);
+        model_ref rmdl;
+        labels_vec labels;
+        proof_ref pr(m);
+        expr_dependency_ref core(m);
+        std::string reason;
+        if (check_sat(*solver, approx, rmdl, labels, pr, core, reason) != l_true)
+            fail("no model of the real approximation");
+        model_ref mdl = validate(*g, *rmdl);
+        if (!mdl)
+            fail("the approximate model does not satisfy the goal");
+        IF_VERBOSE(10, verbose_stream() << "(fp-approx :validated-model)\n");
+        bool models_enabled = g->models_enabled();
+        g->reset();
+        if (models_enabled)
+            g->add(model2model_converter(mdl.get()));
+        g->inc_depth();
+        result.push_back(g.get());
+        reset();
+    }
+
+    void cleanup() override {
+        reset();
+    }
+};
+
+tactic * mk_fpa_approx_tactic(ast_manager & m, params_ref const & p) {
+    return alloc(fpa_approx_tactic, m, p);
+}
+
+tactic * mk_qffp_approx_tactic(ast_manager & m, params_ref const & p) {
+    return or_else(try_for(mk_fpa_approx_tactic(m, p), 5000),
+                   mk_qffp_tactic(m, p));
+}
@@ -0,0 +1,34 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    fpa_approx_tactic.h
+
+Abstract:
+
+    Tactic that approximates floating-point constraints by real arithmetic.
+
+    Floating-point operations are replaced by their exact real counterparts,
+    ignoring rounding. A model of the real approximation is rounded to the
+    nearest floating-point values and accepted only if it satisfies the
+    original goal under IEEE semantics. The tactic fails otherwise, so it is
+    meant to be combined with a complete tactic using or-else.
+
+Notes:
+
+    The tactic only ever establishes satisfiability.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_fpa_approx_tactic(ast_manager & m, params_ref const & p = params_ref());
+tactic * mk_qffp_approx_tactic(ast_manager & m, params_ref const & p = params_ref());
+/*
+  ADD_TACTIC("fp-approx", "(try to) find a model of a floating-point goal using a real arithmetic approximation.", "mk_fpa_approx_tactic(m, p)")
+  ADD_TACTIC("qffp-approx", "try fp-approx and fall back to the bit-blasting tactic for QF_FP.", "mk_qffp_approx_tactic(m, p)")
+*/
@@ -49,11 +49,17 @@ void generic_model_converter::operator()(model_ref & md) {
     expr_ref val(m);
     unsigned arity;
     bool reset_ev = false;
+    ptr_buffer<func_decl> hidden;
     for (unsigned i = m_entries.size(); i-- > 0; ) {
         entry const& e = m_entries[i];
         switch (e.m_instruction) {
         case instruction::HIDE:
-            md->unregister_decl(e.m_f);
+            // consecutive hidden declarations are removed from the model together.
+            hidden.push_back(e.m_f);
+            if (i == 0 || m_entries[i - 1].m_instruction != instruction::HIDE) {
+                md->unregister_decls(hidden.size(), hidden.data());
+                hidden.reset();
+            }
             break;
         case instruction::ADD:
             ev(e.m_def, val);
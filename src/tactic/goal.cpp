@@ -475,14 +475,11 @@ unsigned goal::num_exprs() const {
 
 void goal::shrink(unsigned j) {
     SASSERT(j <= size());
-    unsigned sz = size();
-    for (unsigned i = j; i < sz; i++)
-        m().pop_back(m_forms);
-    for (unsigned i = j; i < sz; i++)
-        m().pop_back(m_proofs);
+    m().shrink(m_forms, j);
+    if (m().size(m_proofs) > j)
+        m().shrink(m_proofs, j);
     if (unsat_core_enabled()) 
-        for (unsigned i = j; i < sz; i++)
-            m().pop_back(m_dependencies);
+        m().shrink(m_dependencies, j);
 }
 
 /**
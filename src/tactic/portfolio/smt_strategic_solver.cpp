@@ -30,6 +30,7 @@ Notes:
 #include "tactic/smtlogics/qfauflia_tactic.h"
 #include "tactic/smtlogics/qfaufbv_tactic.h"
 #include "tactic/smtlogics/qfufbv_tactic.h"
+#include "tactic/smtlogics/qfufbv_tactic_params.hpp"
 #include "tactic/smtlogics/qfidl_tactic.h"
 #include "tactic/smtlogics/nra_tactic.h"
 #include "tactic/portfolio/default_tactic.h"
@@ -46,6 +47,7 @@ Notes:
 #include "solver/parallel_params.hpp"
 #include "tactic/tactic_params.hpp"
 #include "parsers/smt2/smt2parser.h"
+#include <fstream>
 
 
 
@@ -110,6 +112,8 @@ static solver* mk_special_solver_for_logic(ast_manager & m, params_ref const & p
         return mk_fd_solver(m, p);
     if (logic == "SMTFD" && !m.proofs_enabled() && !pp.enable())
         return mk_smtfd_solver(m, p);
+    if (logic == "QF_UFBV" && !m.proofs_enabled() && !pp.enable() && qfufbv_tactic_params(p).lazy_solver())
+        return mk_qfufbv_ackr_solver(m, p);
     return nullptr;
 }
 
@@ -128,6 +132,19 @@ static solver* mk_solver_for_logic(ast_manager & m, params_ref const & p, symbol
 
 class smt_strategic_solver_factory : public solver_factory {
     symbol m_logic;
+
+    static bool is_set(symbol const& s) {
+        return s != symbol::null && !s.is_numerical() && s.str()[0];
+    }
+
+    static tactic* parse_tactic(ast_manager& m, params_ref const& p, symbol const& l, std::istream& is, char const* file_name) {
+        cmd_context ctx(false, &m, l);
+        sexpr_ref se = parse_sexpr(ctx, is, p, file_name);
+        if (!se)
+            return nullptr;
+        return sexpr2tactic(ctx, se.get());
+    }
+
 public:
     smt_strategic_solver_factory(symbol const & logic):m_logic(logic) {}
     
@@ -141,16 +158,17 @@ public:
 
         tactic_params tp;
         tactic_ref t;
-        if (tp.default_tactic() != symbol::null &&
-            !tp.default_tactic().is_numerical() && 
-            tp.default_tactic().str()[0]) {
-            cmd_context ctx(false, &m, l);
+        if (is_set(tp.default_tactic())) {
             std::istringstream is(tp.default_tactic().str());
-            char const* file_name = "";
-            sexpr_ref se = parse_sexpr(ctx, is, p, file_name);
-            if (se) {
-                t = sexpr2tactic(ctx, se.get());
-            }
+            t = parse_tactic(m, p, l, is, "");
+        }
+        else if (is_set(tp.default_tactic_file())) {
+            std::string file_name = tp.default_tactic_file().str();
+            std::ifstream is(file_name);
+            if (is.bad() || is.fail()) 
+                warning_msg("could not open tactic file '%s', using built-in strategy", file_name.c_str());
+            else
+                t = parse_tactic(m, p, l, is, file_name.c_str());
         }
 
         if (!t) {
@@ -748,6 +748,9 @@ public:
                 expr * cur = cur_depth_exprs[i];
 
                 (*this)(to_app(cur), new_value);
+                // the cone above a term whose value did not change is up to date.
+                if (to_app(cur)->get_num_args() > 0 && m_mpz_manager.eq(new_value, m_tracker.get_value(cur)))
+                    continue;
                 m_tracker.set_value(cur, new_value);
                 // Andreas: Should actually always have uplinks ...
                 if (m_tracker.has_uplinks(cur)) {
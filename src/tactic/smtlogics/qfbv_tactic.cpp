@@ -25,11 +25,13 @@ Notes:
 #include "tactic/bv/bv1_blaster_tactic.h"
 #include "tactic/bv/max_bv_sharing_tactic.h"
 #include "tactic/bv/bv_size_reduction_tactic.h"
+#include "tactic/bv/bv2int_tactic.h"
 #include "tactic/aig/aig_tactic.h"
 #include "sat/tactic/sat_tactic.h"
 #include "sat/sat_solver/inc_sat_solver.h"
 #include "ackermannization/ackermannize_bv_tactic.h"
 #include "tactic/smtlogics/smt_tactic.h"
+#include "tactic/smtlogics/qfnia_tactic.h"
 
 #define MEMLIMIT 300
 
@@ -127,3 +129,9 @@ tactic * mk_qfbv_tactic(ast_manager & m, params_ref const & p) {
     return mk_qfbv_tactic(m, p, new_sat, mk_smt_tactic(m, p));
 
 }
+
+tactic * mk_qfbv_int_tactic(ast_manager & m, params_ref const & p) {
+    unsigned timeout = p.get_uint("bv2int_timeout", 5000);
+    tactic * int_st = and_then(mk_bv2int_tactic(m, p), mk_qfnia_tactic(m, p), mk_fail_if_undecided_tactic());
+    return or_else(try_for(int_st, timeout), mk_qfbv_tactic(m, p));
+}
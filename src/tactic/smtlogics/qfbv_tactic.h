@@ -32,3 +32,9 @@ tactic * mk_qfbv_preamble(ast_manager& m, params_ref const& p);
 
 tactic * mk_qfbv_tactic(ast_manager & m, params_ref const & p, tactic* sat, tactic* smt);
 
+tactic * mk_qfbv_int_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+  ADD_TACTIC("qfbv-int", "strategy for QF_BV problems that are mostly arithmetic: solve the problem translated to integer arithmetic, and fall back to bit-blasting if the translation fails or times out.", "mk_qfbv_int_tactic(m, p)")
+*/
+
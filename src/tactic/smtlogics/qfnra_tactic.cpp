@@ -22,6 +22,7 @@ Notes:
 #include "tactic/arith/nla2bv_tactic.h"
 #include "nlsat/tactic/qfnra_nlsat_tactic.h"
 #include "tactic/smtlogics/smt_tactic.h"
+#include "solver/parallel_params.hpp"
 
 static tactic * mk_qfnra_sat_solver(ast_manager& m, params_ref const& p, unsigned bv_size) {
     params_ref nra2sat_p = p;
@@ -42,14 +43,34 @@ tactic * mk_qfnra_tactic(ast_manager & m, params_ref const& p) {
     p2.set_uint("seed", 13);
     p2.set_bool("factor", false);
 
+    tactic * st = or_else(try_for(mk_qfnra_nlsat_tactic(m, p0), 5000),
+                          try_for(mk_qfnra_nlsat_tactic(m, p1), 10000),
+                          mk_qfnra_sat_solver(m, p, 4),
+                          and_then(try_for(mk_smt_tactic(m), 5000), mk_fail_if_undecided_tactic()),
+                          mk_qfnra_sat_solver(m, p, 6),
+                          mk_qfnra_nlsat_tactic(m, p2));
+
+    parallel_params pp(p);
+    if (pp.enable()) {
+        // portfolio of nlsat variable orderings, each thread works on its own copy of the goal
+        params_ref p3 = p;
+        p3.set_bool("shuffle_vars", true);
+        p3.set_uint("seed", 17);
+        params_ref p4 = p;
+        p4.set_bool("reorder", false);
+        params_ref p5 = p;
+        p5.set_bool("shuffle_vars", true);
+        p5.set_uint("seed", 19);
+        p5.set_bool("factor", false);
+        st = par(st,
+                 mk_qfnra_nlsat_tactic(m, p3),
+                 mk_qfnra_nlsat_tactic(m, p4),
+                 mk_qfnra_nlsat_tactic(m, p5));
+    }
+
     return and_then(mk_simplify_tactic(m, p), 
                     mk_propagate_values_tactic(m, p),
-                    or_else(try_for(mk_qfnra_nlsat_tactic(m, p0), 5000),
-                            try_for(mk_qfnra_nlsat_tactic(m, p1), 10000),
-                            mk_qfnra_sat_solver(m, p, 4),
-                            and_then(try_for(mk_smt_tactic(m), 5000), mk_fail_if_undecided_tactic()),
-                            mk_qfnra_sat_solver(m, p, 6),
-                            mk_qfnra_nlsat_tactic(m, p2)));
+                    st);
 }
 
 
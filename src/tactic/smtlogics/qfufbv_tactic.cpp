@@ -31,6 +31,7 @@ Notes:
 #include "model/model_smt2_pp.h"
 #include "ackermannization/lackr.h"
 #include "ackermannization/ackermannization_params.hpp"
+#include "ackermannization/lackr_solver.h"
 #include "tactic/smtlogics/qfufbv_ackr_model_converter.h"
 ///////////////
 #include "sat/sat_solver/inc_sat_solver.h"
@@ -201,3 +202,7 @@ tactic * mk_qfufbv_ackr_tactic(ast_manager & m, params_ref const & p) {
     return and_then(preamble_t,
                     cond(mk_is_qfufbv_probe(), actual_tactic, mk_smt_tactic(m, p)));
 }
+
+solver * mk_qfufbv_ackr_solver(ast_manager & m, params_ref const & p) {
+    return mk_lackr_solver(m, p, mk_inc_sat_solver(m, p));
+}
@@ -21,11 +21,14 @@ Notes:
 #include "util/params.h"
 class ast_manager;
 class tactic;
+class solver;
 
 tactic * mk_qfufbv_tactic(ast_manager & m, params_ref const & p = params_ref());
 
 tactic * mk_qfufbv_ackr_tactic(ast_manager & m, params_ref const & p);
 
+solver * mk_qfufbv_ackr_solver(ast_manager & m, params_ref const & p);
+
 /*
   ADD_TACTIC("qfufbv", "builtin strategy for solving QF_UFBV problems.", "mk_qfufbv_tactic(m, p)")
   ADD_TACTIC("qfufbv_ackr", "A tactic for solving QF_UFBV based on Ackermannization.", "mk_qfufbv_ackr_tactic(m, p)")
@@ -19,11 +19,87 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include "util/stopwatch.h"
+#include "util/union_find.h"
 #include "tactic/tactical.h"
-#ifndef SINGLE_THREAD
-#include <thread>
-#endif
+#include "tactic/tactic_params.hpp"
 #include <vector>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/**
+   \brief Wrapper that reports time, memory and goal size of a child tactic.
+   Children of tacticals are wrapped when tactic.profile is set, so the
+   report follows the shape of the tactic pipeline: nested tactics are
+   emitted first with a larger depth.
+*/
+class profile_tactical : public tactic {
+    tactic_ref m_t;
+    static thread_local unsigned s_depth;
+
+    static unsigned num_exprs(goal_ref_buffer const& r) {
+        unsigned n = 0;
+        for (goal* g : r)
+            n += g->num_exprs();
+        return n;
+    }
+
+public:
+    profile_tactical(tactic* t): m_t(t) {}
+
+    char const* name() const override { return m_t->name(); }
+
+    void operator()(goal_ref const& in, goal_ref_buffer& result) override {
+        unsigned depth = s_depth++;
+        unsigned exprs_in = in->num_exprs();
+        size_t mem_before = memory::get_allocation_size();
+        stopwatch sw;
+        sw.start();
+        try {
+            m_t->operator()(in, result);
+        }
+        catch (...) {
+            --s_depth;
+            IF_VERBOSE(0, verbose_stream() << "(tactic-profile :depth " << depth << " :tactic " << m_t->name()
+                       << " :time " << sw.get_current_seconds() << " :exception true)\n");
+            throw;
+        }
+        --s_depth;
+        double mem_delta = (static_cast<double>(memory::get_allocation_size()) - static_cast<double>(mem_before)) / (1024.0 * 1024.0);
+        IF_VERBOSE(0, verbose_stream() << "(tactic-profile :depth " << depth << " :tactic " << m_t->name()
+                   << " :time " << sw.get_current_seconds()
+                   << " :memory-delta " << std::fixed << std::setprecision(2) << mem_delta << std::defaultfloat
+                   << " :exprs-in " << exprs_in << " :exprs-out " << num_exprs(result)
+                   << " :goals-out " << result.size() << ")\n");
+    }
+
+    void cleanup() override { m_t->cleanup(); }
+    void collect_statistics(statistics & st) const override { m_t->collect_statistics(st); }
+    void reset_statistics() override { m_t->reset_statistics(); }
+    void updt_params(params_ref const & p) override { m_t->updt_params(p); }
+    void collect_param_descrs(param_descrs & r) override { m_t->collect_param_descrs(r); }
+    void reset() override { m_t->reset(); }
+    void set_logic(symbol const& l) override { m_t->set_logic(l); }
+    void set_progress_callback(progress_callback * callback) override { m_t->set_progress_callback(callback); }
+    void user_propagate_register_expr(expr* e) override { m_t->user_propagate_register_expr(e); }
+    void user_propagate_clear() override { m_t->user_propagate_clear(); }
+
+    /**
+       \brief translated tacticals re-wrap their children in their constructors.
+    */
+    tactic* translate(ast_manager& m) override { return m_t->translate(m); }
+
+    static tactic* mk(tactic* t) {
+        if (!t || dynamic_cast<profile_tactical*>(t) || !tactic_params().profile())
+            return t;
+        return alloc(profile_tactical, t);
+    }
+};
+
+thread_local unsigned profile_tactical::s_depth = 0;
 
 class binary_tactical : public tactic {
 protected:
@@ -33,8 +109,8 @@ protected:
 public:
 
     binary_tactical(tactic * t1, tactic * t2):
-        m_t1(t1),
-        m_t2(t2) {
+        m_t1(profile_tactical::mk(t1)),
+        m_t2(profile_tactical::mk(t2)) {
         SASSERT(m_t1);
         SASSERT(m_t2);
     }
@@ -269,7 +345,7 @@ public:
     nary_tactical(unsigned num, tactic * const * ts) {
         for (unsigned i = 0; i < num; i++) {
             SASSERT(ts[i]);
-            m_ts.push_back(ts[i]);
+            m_ts.push_back(profile_tactical::mk(ts[i]));
         }
     }
 
@@ -543,14 +619,7 @@ public:
             }
         };
 
-        vector<std::thread> threads(sz);
-
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i].join();
-        }
+        thread_pool::run(sz, worker_thread);
         
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
@@ -769,13 +838,7 @@ public:
             if (m.has_trace_stream())
                 throw default_exception("threads and trace are incompatible");
 
-            vector<std::thread> threads(r1_size);
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i].join();
-            }
+            thread_pool::run(r1_size, worker_thread);
             
             if (failed) {
                 switch (ex_kind) {
@@ -1268,3 +1331,233 @@ tactic * skip_if_failed(tactic * t) {
     return or_else(t, mk_skip_tactic());
 }
 
+
+/**
+   \brief Split the goal into components that share no uninterpreted symbols,
+   apply the tactic to every component, and merge the results.
+   Quantifiers can bound the size of uninterpreted sorts, so when the goal
+   has quantifiers, assertions that share an uninterpreted sort are also
+   kept in the same component.
+   
+   The goal is unsat if some component is unsat, and sat if all components are
+   sat; the model converters of the components are then concatenated.
+   Components that are not decided are conjoined back into a single subgoal.
+   If the tactic splits a component into several subgoals, the components
+   are dropped and the tactic is applied to the whole goal instead.
+*/
+class par_components_tactical : public unary_tactical {
+
+    void add_sort(ast_manager & m, sort * s, unsigned i, obj_map<sort, unsigned> & owner, svector<std::pair<unsigned, unsigned>> & links) {
+        if (m.is_uninterp(s)) {
+            unsigned j;
+            if (!owner.find(s, j))
+                owner.insert(s, i);
+            else if (i != j)
+                links.push_back({ i, j });
+            return;
+        }
+        for (parameter const & p : s->parameters())
+            if (p.is_ast() && is_sort(p.get_ast()))
+                add_sort(m, to_sort(p.get_ast()), i, owner, links);
+    }
+
+    unsigned partition(goal const & g, unsigned_vector & comp) {
+        ast_manager & m = g.m();
+        basic_union_find uf;
+        obj_map<func_decl, unsigned> owner;
+        obj_map<sort, unsigned> sort_owner;
+        svector<std::pair<unsigned, unsigned>> sort_links;
+        bool has_quantifiers = false;
+        expr_mark visited;
+        ptr_buffer<expr> todo;
+        unsigned sz = g.size();
+        for (unsigned i = 0; i < sz; ++i)
+            uf.mk_var();
+        for (unsigned i = 0; i < sz; ++i) {
+            visited.reset();
+            todo.push_back(g.form(i));
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                todo.pop_back();
+                if (visited.is_marked(e))
+                    continue;
+                visited.mark(e, true);
+                add_sort(m, e->get_sort(), i, sort_owner, sort_links);
+                if (is_app(e)) {
+                    app * a = to_app(e);
+                    if (a->get_family_id() == null_family_id) {
+                        unsigned j;
+                        if (owner.find(a->get_decl(), j))
+                            uf.merge(i, j);
+                        else
+                            owner.insert(a->get_decl(), i);
+                    }
+                    todo.append(a->get_num_args(), a->get_args());
+                }
+                else if (is_quantifier(e)) {
+                    quantifier * q = to_quantifier(e);
+                    has_quantifiers = true;
+                    for (unsigned k = 0; k < q->get_num_decls(); ++k)
+                        add_sort(m, q->get_decl_sort(k), i, sort_owner, sort_links);
+                    todo.push_back(q->get_expr());
+                }
+            }
+        }
+        if (has_quantifiers)
+            for (auto const & [i, j] : sort_links)
+                uf.merge(i, j);
+        unsigned_vector root2comp(sz, UINT_MAX);
+        unsigned num_comps = 0;
+        comp.reset();
+        for (unsigned i = 0; i < sz; ++i) {
+            unsigned r = uf.find(i);
+            if (root2comp[r] == UINT_MAX)
+                root2comp[r] = num_comps++;
+            comp.push_back(root2comp[r]);
+        }
+        return num_comps;
+    }
+
+    void solve_seq(goal_ref_vector const & comps, std::vector<goal_ref_buffer> & results) {
+        for (unsigned i = 0; i < comps.size(); ++i) {
+            m_t->operator()(comps[i], results[i]);
+            if (is_decided_unsat(results[i]))
+                return;
+        }
+    }
+
+#ifndef SINGLE_THREAD
+    void solve_par(ast_manager & m, unsigned num_threads, goal_ref_vector const & comps, std::vector<goal_ref_buffer> & results) {
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_limits scl(m.limit());
+        tactic_ref_vector ts;
+        goal_ref_vector in_copies;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
+            managers.push_back(new_m);
+            ts.push_back(m_t->translate(*new_m));
+            scl.push_child(&new_m->limit());
+        }
+        for (unsigned i = 0; i < comps.size(); ++i) {
+            ast_translation translator(m, *managers[i % num_threads]);
+            in_copies.push_back(comps[i]->translate(translator));
+        }
+
+        std::vector<goal_ref_buffer> copy_results;
+        copy_results.resize(comps.size());
+        std::atomic<bool> found_unsat(false);
+        std::string ex_msg;
+        bool failed = false;
+        std::mutex mux;
+
+        auto worker_thread = [&](unsigned w) {
+            try {
+                for (unsigned i = w; i < comps.size() && !found_unsat; i += num_threads) {
+                    (*ts.get(w))(in_copies[i], copy_results[i]);
+                    if (is_decided_unsat(copy_results[i])) {
+                        found_unsat = true;
+                        for (unsigned j = 0; j < num_threads; ++j)
+                            if (j != w)
+                                managers[j]->limit().cancel();
+                    }
+                }
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!found_unsat && !failed) {
+                    failed = true;
+                    ex_msg = ex.msg();
+                }
+            }
+        };
+
+        thread_pool::run(num_threads, worker_thread);
+
+        for (unsigned i = 0; i < comps.size(); ++i) {
+            ast_translation translator(*managers[i % num_threads], m, false);
+            if (found_unsat && !is_decided_unsat(copy_results[i]))
+                continue;
+            for (goal * g : copy_results[i])
+                results[i].push_back(g->translate(translator));
+        }
+        if (failed && !found_unsat)
+            throw default_exception(std::move(ex_msg));
+    }
+#endif
+
+public:
+    par_components_tactical(tactic * t): unary_tactical(t) {}
+
+    char const* name() const override { return "par_components"; }
+
+    void operator()(goal_ref const & in, goal_ref_buffer & result) override {
+        ast_manager & m = in->m();
+        unsigned_vector comp;
+        unsigned num_comps = in->proofs_enabled() || in->inconsistent() ? 1 : partition(*in, comp);
+        if (num_comps <= 1) {
+            m_t->operator()(in, result);
+            return;
+        }
+        IF_VERBOSE(10, verbose_stream() << "(par-components :num-components " << num_comps << ")\n");
+
+        goal_ref_vector comps;
+        for (unsigned i = 0; i < num_comps; ++i) {
+            goal * g = alloc(goal, m, false, in->models_enabled(), in->unsat_core_enabled());
+            g->set_prec(in->prec());
+            comps.push_back(g);
+        }
+        for (unsigned i = 0; i < in->size(); ++i)
+            comps[comp[i]]->assert_expr(in->form(i), nullptr, in->dep(i));
+
+        std::vector<goal_ref_buffer> results;
+        results.resize(num_comps);
+        unsigned num_threads = std::min(num_comps, std::thread::hardware_concurrency());
+#ifdef SINGLE_THREAD
+        num_threads = 1;
+#endif
+        if (num_threads <= 1 || m.has_trace_stream())
+            solve_seq(comps, results);
+#ifndef SINGLE_THREAD
+        else
+            solve_par(m, num_threads, comps, results);
+#endif
+
+        for (goal_ref_buffer & r : results) {
+            if (is_decided_unsat(r)) {
+                goal & g = *r[0];
+                in->reset();
+                in->add(g.dc());
+                in->updt_prec(g.prec());
+                in->assert_expr(m.mk_false(), nullptr, g.dep(0));
+                result.push_back(in.get());
+                return;
+            }
+        }
+        for (goal_ref_buffer & r : results) {
+            if (r.size() != 1) {
+                m_t->operator()(in, result);
+                return;
+            }
+        }
+
+        in->reset();
+        for (goal_ref_buffer & r : results) {
+            goal & g = *r[0];
+            for (unsigned i = 0; i < g.size(); ++i)
+                in->assert_expr(g.form(i), nullptr, g.dep(i));
+            in->add(g.mc());
+            in->add(g.dc());
+            in->updt_prec(g.prec());
+        }
+        in->inc_depth();
+        result.push_back(in.get());
+    }
+
+    tactic * translate(ast_manager & m) override {
+        return translate_core<par_components_tactical>(m);
+    }
+};
+
+tactic * par_components(tactic * t) {
+    return alloc(par_components_tactical, t);
+}
@@ -75,6 +75,10 @@ tactic * when(probe * p, tactic * t);
 // alias for (or-else t skip)
 tactic * skip_if_failed(tactic * t);
 
+// Apply t to every group of assertions that share no uninterpreted symbols
+// with the rest of the goal, and combine the results.
+tactic * par_components(tactic * t);
+
 // Execute the given tactic only if proof production is not enabled.
 // If proof production is enabled it is a skip
 tactic * if_no_proofs(tactic * t);
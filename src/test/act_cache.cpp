@@ -0,0 +1,83 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    act_cache.cpp
+
+Abstract:
+
+    Test the dense mode of the rewriter cache on a large shared bit-vector term.
+
+--*/
+
+#include "ast/act_cache.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "util/stopwatch.h"
+#include <iostream>
+
+static expr_ref mk_shared_bv_dag(ast_manager& m, unsigned depth) {
+    bv_util bv(m);
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(32)), m);
+    expr_ref y(m.mk_const(symbol("y"), bv.mk_sort(32)), m);
+    expr_ref a(x, m), b(y, m);
+    for (unsigned i = 0; i < depth; ++i) {
+        expr_ref c(bv.mk_bv_add(a, bv.mk_numeral(rational(0), 32)), m);
+        expr_ref d(bv.mk_bv_xor(b, a), m);
+        a = bv.mk_bv_mul(c, d);
+        b = bv.mk_bv_add(d, c);
+    }
+    return expr_ref(m.mk_eq(a, b), m);
+}
+
+static void tst_act_cache_dense_mode() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    act_cache c(m);
+    c.set_dense(true);
+    bv_util bv(m);
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(8)), m);
+    expr_ref one(bv.mk_numeral(rational(1), 8), m);
+    expr_ref t(bv.mk_bv_add(x, one), m);
+    c.insert(t, x);
+    c.insert(t, 1, one);
+    ENSURE(c.find(t) == x.get());
+    ENSURE(c.find(t, 1) == one.get());
+    ENSURE(c.find(x) == nullptr);
+    ENSURE(c.size() == 2);
+    c.filter([&](expr* e) { return e != t.get(); });
+    ENSURE(c.empty());
+    c.insert(t, one);
+    c.set_dense(false);
+    ENSURE(c.empty());
+}
+
+static void tst_th_rewriter_dense(unsigned depth) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref fml = mk_shared_bv_dag(m, depth);
+    expr_ref r1(m), r2(m);
+    params_ref p;
+    th_rewriter rw1(m, p);
+    stopwatch sw;
+    sw.start();
+    rw1(fml, r1);
+    sw.stop();
+    double t1 = sw.get_seconds();
+    p.set_bool("cache_dense", true);
+    th_rewriter rw2(m, p);
+    sw.reset();
+    sw.start();
+    rw2(fml, r2);
+    sw.stop();
+    std::cout << "depth " << depth << " hashed: " << t1 << "s dense: " << sw.get_seconds() << "s\n";
+    ENSURE(r1 == r2);
+}
+
+void tst_act_cache() {
+    tst_act_cache_dense_mode();
+    tst_th_rewriter_dense(100);
+    tst_th_rewriter_dense(2000);
+}
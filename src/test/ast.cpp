@@ -17,6 +17,13 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include "ast/ast_serialize.h"
+#include "ast/ast_translation.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/datatype_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include <sstream>
 
 static void tst1() {
     ast_manager m;
@@ -132,6 +139,61 @@ static void tst5() {
 }
 
 
+static void tst_serialize() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+    sort_ref U(m.mk_uninterpreted_sort(symbol("U")), m);
+    sort_ref I(a.mk_int(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), U, I), m);
+    expr_ref u(m.mk_const(symbol("u"), U), m);
+    expr_ref x(m.mk_var(0, I), m);
+    expr_ref body(a.mk_le(m.mk_app(f, u.get()), a.mk_add(x, a.mk_numeral(rational(-7, 3), false))), m);
+    symbol name("x");
+    sort * s = I;
+    expr_ref q(m.mk_forall(1, &s, &name, body), m);
+    expr_ref b(m.mk_eq(bv.mk_numeral(rational(5), 8), m.mk_const(symbol(3), bv.mk_sort(8))), m);
+    ast * roots[3] = { q.get(), b.get(), q.get() };
+
+    std::stringstream buffer;
+    ast_serialize(m, 3, roots, buffer);
+
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    ast_ref_vector result(m2);
+    ast_deserialize(m2, buffer, result);
+    ENSURE(result.size() == 3);
+    ast_translation tr(m, m2);
+    for (unsigned i = 0; i < 3; ++i)
+        ENSURE(result.get(i) == tr(roots[i]));
+}
+
+static void tst_serialize_datatype() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    datatype_util dt(m);
+    constructor_decl * cs[2] = { mk_constructor_decl(symbol("red"), symbol("is-red"), 0, nullptr),
+                                 mk_constructor_decl(symbol("green"), symbol("is-green"), 0, nullptr) };
+    datatype_decl * d = mk_datatype_decl(dt, symbol("Color"), 0, nullptr, 2, cs);
+    sort_ref_vector sorts(m);
+    VERIFY(dt.plugin().mk_datatypes(1, &d, 0, nullptr, sorts));
+    del_datatype_decl(d);
+    expr_ref c(m.mk_const(symbol("c"), sorts.get(0)), m);
+    expr_ref red(m.mk_const(dt.get_datatype_constructors(sorts.get(0))->get(0)), m);
+    expr_ref e(m.mk_eq(c, red), m);
+    ast * root = e.get();
+    std::stringstream buffer;
+    bool failed = false;
+    try {
+        ast_serialize(m, 1, &root, buffer);
+    }
+    catch (default_exception &) {
+        failed = true;
+    }
+    ENSURE(failed);
+}
+
 struct foo {
     unsigned       m_id; 
     unsigned short m_ref_count;
@@ -153,5 +215,7 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst_serialize();
+    tst_serialize_datatype();
 }
 
@@ -74,6 +74,28 @@ namespace dd {
         std::cout << c1 << "\n";
         std::cout << c1.bdd_size() << "\n";
     }
+
+    // cached results must stay valid across collections and cache growth.
+    static void test5() {
+        bdd_manager m(60);
+        bdd p1 = m.mk_false(), p2 = m.mk_false();
+        for (unsigned i = 0; i < 30; ++i) {
+            p1 = p1 ^ (m.mk_var(2*i) && m.mk_var(2*i + 1));
+            if (i % 7 == 0)
+                m.gc();
+        }
+        for (unsigned i = 30; i-- > 0; ) 
+            p2 = (m.mk_var(2*i + 1) && m.mk_var(2*i)) ^ p2;
+        SASSERT(p1 == p2);
+        m.gc();
+        bdd n1 = !p1;
+        m.gc();
+        SASSERT((!n1) == p1);
+        SASSERT((n1 && p2).is_false());
+        SASSERT((n1 || p2).is_true());
+        SASSERT(m.mk_ite(p1, n1, p2).is_false());
+        std::cout << "parity size: " << p1.bdd_size() << "\n";
+    }
 }
 
 void tst_bdd() {
@@ -81,4 +103,5 @@ void tst_bdd() {
     dd::test2();
     dd::test3();
     dd::test4();
+    dd::test5();
 }
@@ -231,6 +231,25 @@ void tst_sh(ast_manager & m, unsigned sz) {
 //     TRACE("bit_blaster", tout << "ashr " << c.size() << "\n"; display(tout, c, false););
 }
 
+static void tst_polarity_sharing(ast_manager & m, bool ext_gates) {
+    bit_blaster_params params;
+    params.m_bb_ext_gates = ext_gates;
+    bit_blaster blaster(m, params);
+    expr_ref_vector a(m);
+    mk_bits(m, "p", 3, a);
+    expr_ref na(m.mk_not(a.get(0)), m), nb(m.mk_not(a.get(1)), m), nc(m.mk_not(a.get(2)), m);
+    expr_ref r1(m), r2(m);
+    // carry(~a, ~b, c) = ~carry(a, b, ~c), both should be built from the same gate.
+    blaster.mk_carry(na, nb, a.get(2), r1);
+    blaster.mk_carry(a.get(0), a.get(1), nc, r2);
+    ENSURE(m.is_complement(r1, r2));
+    if (ext_gates) {
+        blaster.mk_xor3(na, a.get(1), a.get(2), r1);
+        blaster.mk_xor3(a.get(0), a.get(1), a.get(2), r2);
+        ENSURE(m.is_complement(r1, r2));
+    }
+}
+
 void tst_bit_blaster() {
     ast_manager m;
     reg_decl_plugins(m);
@@ -242,4 +261,6 @@ void tst_bit_blaster() {
     tst_le(m, 4);
     tst_eqs(m, 8);
     tst_sh(m, 4);
+    tst_polarity_sharing(m, false);
+    tst_polarity_sharing(m, true);
 }
@@ -0,0 +1,72 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bounded_int2bv.cpp
+
+Abstract:
+
+    Tests for adaptive bit-widths in the bounded int2bv solver.
+
+--*/
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "model/model.h"
+#include "solver/solver.h"
+#include "tactic/fd_solver/fd_solver.h"
+#include <iostream>
+
+static void check_model(solver& s, expr* x, rational const& lo, rational const& hi) {
+    ast_manager& m = s.get_manager();
+    arith_util a(m);
+    model_ref mdl;
+    s.get_model(mdl);
+    ENSURE(mdl);
+    // the guards that restrict the bit-widths are not part of the model.
+    for (unsigned i = 0; i < mdl->get_num_constants(); ++i)
+        ENSURE(mdl->get_constant(i) == to_app(x)->get_decl());
+    expr_ref v = (*mdl)(x);
+    rational r;
+    ENSURE(a.is_numeral(v, r));
+    std::cout << "x = " << r << "\n";
+    ENSURE(lo <= r && r <= hi);
+}
+
+void tst_bounded_int2bv() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    params_ref p;
+    p.set_uint("int2bv_adaptive_bits", 1);
+    ref<solver> s = mk_fd_solver(m, p);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    s->assert_expr(a.mk_ge(x, a.mk_int(0)));
+    s->assert_expr(a.mk_le(x, a.mk_int(100)));
+
+    // the bit-vector for x is widened inside the scope.
+    s->push();
+    s->assert_expr(a.mk_ge(x, a.mk_int(40)));
+    ENSURE(s->check_sat(0, nullptr) == l_true);
+    check_model(*s, x, rational(40), rational(100));
+    s->pop(1);
+
+    // the guards of the popped scope are no longer assumed.
+    s->push();
+    s->assert_expr(a.mk_le(x, a.mk_int(1)));
+    ENSURE(s->check_sat(0, nullptr) == l_true);
+    check_model(*s, x, rational(0), rational(1));
+    s->pop(1);
+
+    s->push();
+    s->assert_expr(a.mk_ge(x, a.mk_int(70)));
+    s->assert_expr(a.mk_le(x, a.mk_int(75)));
+    ENSURE(s->check_sat(0, nullptr) == l_true);
+    check_model(*s, x, rational(70), rational(75));
+    s->assert_expr(a.mk_ge(x, a.mk_int(76)));
+    ENSURE(s->check_sat(0, nullptr) == l_false);
+    s->pop(1);
+
+    ENSURE(s->check_sat(0, nullptr) == l_true);
+    check_model(*s, x, rational(0), rational(100));
+}
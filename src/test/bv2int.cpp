@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    bv2int.cpp
+
+Abstract:
+
+    Tests for the bv2int and qfbv-int tactics.
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <iostream>
+#include <string>
+
+static void check(char const * spec, char const * expected) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    std::string r = Z3_eval_smtlib2_string(ctx, spec);
+    Z3_del_context(ctx);
+    std::cout << r;
+    ENSURE(r == expected);
+}
+
+static void check_tactics(char const * decls, char const * sat_expected) {
+    // bv2int fails instead of falling back, so the translation has to succeed.
+    std::string s(decls);
+    check((s + "(check-sat-using (then bv2int smt))").c_str(), sat_expected);
+    check((s + "(check-sat-using qfbv-int)").c_str(), sat_expected);
+}
+
+void tst_bv2int() {
+    // wraparound
+    check("(declare-const x (_ BitVec 8))"
+          "(assert (= (bvadd x #x01) #x00))"
+          "(check-sat-using (then bv2int smt))"
+          "(eval x)",
+          "sat\n#xff\n");
+    check_tactics("(declare-const x (_ BitVec 8)) (declare-const y (_ BitVec 8))"
+                  "(assert (= (bvmul x #x02) #x01))",
+                  "unsat\n");
+    check_tactics("(declare-const x (_ BitVec 8)) (declare-const y (_ BitVec 8))"
+                  "(assert (bvugt x #xf0)) (assert (bvult (bvadd x #x20) #x20)) (assert (distinct x y))",
+                  "sat\n");
+    // signed comparison
+    check_tactics("(declare-const x (_ BitVec 8))"
+                  "(assert (bvslt x #x00)) (assert (bvsgt x #x7f))",
+                  "unsat\n");
+    check("(declare-const x (_ BitVec 8))"
+          "(assert (bvslt x #x00)) (assert (bvugt x #xfd))"
+          "(check-sat-using (then bv2int smt))"
+          "(eval (or (= x #xfe) (= x #xff)))",
+          "sat\ntrue\n");
+    // extract and concat
+    check("(declare-const y (_ BitVec 4))"
+          "(assert (= (concat y #x5) #xa5))"
+          "(check-sat-using (then bv2int smt))"
+          "(eval y)",
+          "sat\n#xa\n");
+    check_tactics("(declare-const x (_ BitVec 8))"
+                  "(assert (= ((_ extract 7 4) x) #x3)) (assert (bvuge x #x40))",
+                  "unsat\n");
+}
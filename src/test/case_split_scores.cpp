@@ -0,0 +1,54 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    case_split_scores.cpp
+
+Abstract:
+
+    Tests for the case split queue that scales activities by scores
+    supplied by theory solvers (smt.case_split=7).
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <iostream>
+#include <string>
+
+static void check(char const * spec, char const * expected) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    std::string cmd = std::string("(set-option :auto_config false) (set-option :smt.case_split 7)"
+                                  "(set-option :smt.restart_strategy 3)") + spec;
+    std::string r = Z3_eval_smtlib2_string(ctx, cmd.c_str());
+    Z3_del_context(ctx);
+    std::cout << r;
+    ENSURE(r == expected);
+}
+
+static std::string mk_pigeons(unsigned n, unsigned holes) {
+    std::string s;
+    for (unsigned i = 0; i < n; ++i) {
+        std::string x = "x" + std::to_string(i);
+        s += "(declare-const " + x + " Real)";
+        s += "(assert (or";
+        for (unsigned h = 0; h < holes; ++h)
+            s += " (= " + x + " " + std::to_string(h) + ")";
+        s += "))";
+        for (unsigned j = 0; j < i; ++j)
+            s += "(assert (or (< x" + std::to_string(j) + " " + x + ") (> x" + std::to_string(j) + " " + x + ")))";
+    }
+    return s;
+}
+
+void tst_case_split_scores() {
+    check((mk_pigeons(6, 6) + "(assert (>= (+ x0 x1) 9)) (check-sat)").c_str(), "sat\n");
+    check((mk_pigeons(7, 6) + "(check-sat)").c_str(), "unsat\n");
+    check("(declare-const x Real) (declare-const y Real)"
+          "(assert (or (< x 0) (> x 10))) (assert (or (< y 0) (> y 10)))"
+          "(assert (= (+ x y) 5)) (assert (< (- x y) 10)) (assert (> (- x y) (- 10)))"
+          "(check-sat)",
+          "unsat\n");
+}
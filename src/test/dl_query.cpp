@@ -203,7 +203,45 @@ void dl_query_test_wpa(smt_params & fparams, params_ref& params) {
 
 }
 
+static void dl_query_test_incremental() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params fparams;
+    params_ref params;
+    params.set_bool("datalog.incremental_saturation", true);
+    register_engine re;
+    context ctx(m, re, fparams);
+    ctx.updt_params(params);
+    parser* p = parser::create(ctx, m);
+    VERIFY(p->parse_string("Z 64\n\nE(x : Z, y : Z)\nT(x : Z, y : Z)\n"
+                           "T(X,Y) :- E(X,Y).\nT(X,Z) :- E(X,Y), T(Y,Z).\nE(\"a\",\"b\")."));
+    dealloc(p);
+
+    func_decl * e = ctx.try_get_predicate_decl(symbol("E"));
+    func_decl * t = ctx.try_get_predicate_decl(symbol("T"));
+    ENSURE(e && t);
+    dl_decl_util util(m);
+    sort * s = e->get_domain(0);
+    // "a" and "b" are the first two constants of Z seen by the parser.
+    app_ref a(util.mk_numeral(0, s), m), b(util.mk_numeral(1, s), m), c(util.mk_numeral(2, s), m);
+    app_ref t_ab(m.mk_app(t, a.get(), b.get()), m);
+    app_ref t_ac(m.mk_app(t, a.get(), c.get()), m);
+
+    ENSURE(ctx.query(t_ab) == l_true);
+    ENSURE(ctx.query(t_ac) == l_false);
+
+    // T has to be recomputed after E grows, even though it was saturated before.
+    relation_fact f(m);
+    f.push_back(b);
+    f.push_back(c);
+    ctx.add_fact(e, f);
+    ENSURE(ctx.query(t_ac) == l_true);
+    ENSURE(ctx.query(t_ab) == l_true);
+}
+
 void tst_dl_query() {
+    dl_query_test_incremental();
+
     smt_params fparams;
     params_ref params;
     params.set_sym("default_table", symbol("sparse"));
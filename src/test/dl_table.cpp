@@ -96,6 +96,57 @@ void test_dl_bitvector_table() {
     test_table(mk_bv_table);
 }
 
+static void test_sparse_table_filters() {
+    datalog::table_signature sig;
+    sig.push_back(8);
+    sig.push_back(8);
+    sig.push_back(8);
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);    
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::table_plugin * p = m.get_table_plugin(symbol("sparse"));
+    ENSURE(p);
+
+    datalog::table_base* tbl = p->mk_empty(sig);
+    datalog::table_fact row;
+    row.resize(3);
+    for (unsigned i = 0; i < 8; ++i) {
+        row[0] = i % 3;
+        row[1] = i;
+        row[2] = (i % 2 == 0) ? i : 7 - i;
+        tbl->add_fact(row);
+    }
+
+    datalog::table_mutator_fn * eq = m.mk_filter_equal_fn(*tbl, 1, 0);
+    (*eq)(*tbl);
+    for (unsigned i = 0; i < 8; ++i) {
+        row[0] = i % 3;
+        row[1] = i;
+        row[2] = (i % 2 == 0) ? i : 7 - i;
+        ENSURE(tbl->contains_fact(row) == (i % 3 == 1));
+    }
+
+    unsigned identical[2] = { 1, 2 };
+    datalog::table_mutator_fn * id = m.mk_filter_identical_fn(*tbl, 2, identical);
+    (*id)(*tbl);
+    // rows 1, 4 and 7 survived the first filter, only 4 has equal columns 1 and 2
+    for (unsigned i = 0; i < 8; ++i) {
+        row[0] = i % 3;
+        row[1] = i;
+        row[2] = (i % 2 == 0) ? i : 7 - i;
+        ENSURE(tbl->contains_fact(row) == (i == 4));
+    }
+    tbl->display(std::cout);
+
+    dealloc(eq);
+    dealloc(id);
+    tbl->deallocate();
+}
+
 void tst_dl_table() {
     test_dl_bitvector_table();
+    test_sparse_table_filters();
 }
@@ -129,3 +129,116 @@ void tst_hashtable() {
 void tst_hashtable() {
 }
 #endif
+
+#include <iostream>
+#include "util/map.h"
+#include "util/obj_hashtable.h"
+#include "util/swiss_table.h"
+#include "util/stopwatch.h"
+
+static void tst_swiss_random() {
+    random_gen rand(0);
+    u_map<unsigned> ref;
+    swiss_u_map<unsigned> h;
+    for (unsigned i = 0; i < 100000; ++i) {
+        unsigned k = rand() % 2000;
+        switch (rand() % 4) {
+        case 0:
+        case 1:
+            ref.insert(k, i);
+            h.insert(k, i);
+            break;
+        case 2:
+            ref.erase(k);
+            h.erase(k);
+            break;
+        default: {
+            unsigned v1 = 0, v2 = 0;
+            bool f1 = ref.find(k, v1), f2 = h.find(k, v2);
+            ENSURE(f1 == f2);
+            ENSURE(!f1 || v1 == v2);
+            break;
+        }
+        }
+        ENSURE(ref.size() == h.size());
+    }
+    unsigned n = 0;
+    for (auto const& kv : h) {
+        ENSURE(ref.contains(kv.m_key));
+        ENSURE(ref[kv.m_key] == kv.m_value);
+        ++n;
+    }
+    ENSURE(n == h.size());
+    h.reset();
+    ENSURE(h.empty() && !h.contains(0));
+
+    int xs[3] = { 1, 2, 3 };
+    swiss_ptr_addr_map<int, unsigned> p;
+    for (unsigned i = 0; i < 3; ++i)
+        p.insert(xs + i, i);
+    p.remove(xs + 1);
+    ENSURE(p.size() == 2 && p[xs + 2] == 2 && !p.contains(xs + 1));
+}
+
+struct bench_obj {
+    unsigned m_hash;
+    unsigned hash() const { return m_hash; }
+};
+
+template<typename Map, typename Key>
+static unsigned bench_lookups(Map & m, vector<Key> const & keys, unsigned rounds, double & secs) {
+    // insert every other key, so half of the lookups are misses.
+    for (unsigned i = 0; i < keys.size(); i += 2)
+        m.insert(keys[i], i);
+    stopwatch sw;
+    sw.start();
+    unsigned found = 0;
+    unsigned v;
+    for (unsigned r = 0; r < rounds; ++r)
+        for (Key const & k : keys)
+            found += m.find(k, v);
+    sw.stop();
+    secs = sw.get_seconds();
+    return found;
+}
+
+/**
+   \brief Microbenchmark of lookups in u_map/swiss_u_map and obj_map/swiss_obj_map.
+   obj_map compares the hash-codes of the keys, which are stored in the keys,
+   while swiss_obj_map first compares the control bytes.
+*/
+static void tst_swiss_bench() {
+    unsigned n = 1 << 18, rounds = 8;
+    random_gen rand(0);
+    vector<unsigned> ukeys;
+    for (unsigned i = 0; i < n; ++i)
+        ukeys.push_back(i * 2654435761u);
+    double t1 = 0, t2 = 0;
+    {
+        u_map<unsigned> m1;
+        swiss_u_map<unsigned> m2;
+        unsigned f1 = bench_lookups(m1, ukeys, rounds, t1);
+        unsigned f2 = bench_lookups(m2, ukeys, rounds, t2);
+        ENSURE(f1 == f2 && f1 == n / 2 * rounds);
+        std::cout << "lookups u_map: " << t1 << "s swiss_u_map: " << t2 << "s\n";
+    }
+    svector<bench_obj> objs;
+    for (unsigned i = 0; i < n; ++i)
+        objs.push_back({ hash_u(i) });
+    vector<bench_obj*> okeys;
+    for (bench_obj & o : objs)
+        okeys.push_back(&o);
+    shuffle(okeys.size(), okeys.data(), rand);
+    {
+        obj_map<bench_obj, unsigned> m1;
+        swiss_obj_map<bench_obj, unsigned> m2;
+        unsigned f1 = bench_lookups(m1, okeys, rounds, t1);
+        unsigned f2 = bench_lookups(m2, okeys, rounds, t2);
+        ENSURE(f1 == f2 && f1 == n / 2 * rounds);
+        std::cout << "lookups obj_map: " << t1 << "s swiss_obj_map: " << t2 << "s\n";
+    }
+}
+void tst_swiss_table() {
+    tst_swiss_random();
+    tst_swiss_bench();
+}
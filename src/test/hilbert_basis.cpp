@@ -643,6 +643,8 @@ void tst_hilbert_basis() {
     }
     else {
         gorrila_test(0, 10, 7, 20, 11);
+        // dimension 20 benchmark, the size of invariants found by karr/Horn engines.
+        gorrila_test(0, 20, 3, 3, 10);
     }
 
     return;
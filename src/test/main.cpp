@@ -153,6 +153,7 @@ int main(int argc, char ** argv) {
     TST(symbol);
     TST(heap);
     TST(hashtable);
+    TST(swiss_table);
     TST(rational);
     TST(inf_rational);
     TST(ast);
@@ -201,6 +202,7 @@ int main(int argc, char ** argv) {
     TST(nlarith_util);
     TST(api_bug);
     TST(arith_rewriter);
+    TST(act_cache);
     TST(check_assumptions);
     TST(smt_context);
     TST(theory_dl);
@@ -264,4 +266,14 @@ int main(int argc, char ** argv) {
     //TST_ARGV(hs);
     TST(finder);
     TST(totalizer);
+    TST(par_components);
+    TST(bv2int);
+    TST(maxsmt_portfolio);
+    TST(case_split_scores);
+    TST(bounded_int2bv);
+    TST(sat_xor_gauss);
+    TST(pattern_inference);
+    TST(mbp_bv);
+    TST(lackr_solver);
+    TST(sat_maxsat);
 }
@@ -0,0 +1,59 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    maxsmt_portfolio.cpp
+
+Abstract:
+
+    Tests for the MaxSMT portfolio: the optimum found by the portfolio
+    has to coincide with the optimum found by maxres.
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <iostream>
+#include <string>
+
+static std::string solve(char const * engine, char const * spec) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    std::string cmd = std::string("(set-option :opt.maxsat_engine ") + engine + ")" + spec;
+    std::string r = Z3_eval_smtlib2_string(ctx, cmd.c_str());
+    Z3_del_context(ctx);
+    std::cout << engine << ": " << r;
+    return r;
+}
+
+static void check(char const * spec, char const * expected) {
+    std::string r1 = solve("maxres", spec);
+    std::string r2 = solve("portfolio", spec);
+    ENSURE(r1 == expected);
+    ENSURE(r1 == r2);
+}
+
+void tst_maxsmt_portfolio() {
+    // weighted soft constraints over Booleans
+    check("(declare-const a Bool) (declare-const b Bool) (declare-const c Bool) (declare-const d Bool)"
+          "(assert (or (not a) (not b))) (assert (or (not b) (not c))) (assert (or (not c) (not d)))"
+          "(assert (or (not a) (not d)))"
+          "(assert-soft a :weight 3) (assert-soft b :weight 2) (assert-soft c :weight 4)"
+          "(assert-soft d :weight 1)"
+          "(check-sat) (get-objectives)",
+          "sat\n(objectives\n ( 3)\n)\n");
+    // weighted soft constraints over integers
+    check("(declare-const x Int) (declare-const y Int)"
+          "(assert (<= 0 x 10)) (assert (<= 0 y 10)) (assert (<= (+ x y) 7))"
+          "(assert-soft (>= x 5) :weight 4) (assert-soft (>= y 5) :weight 3)"
+          "(assert-soft (>= x 3) :weight 2) (assert-soft (>= y 3) :weight 2)"
+          "(assert-soft (= x y) :weight 1)"
+          "(check-sat) (get-objectives)",
+          "sat\n(objectives\n ( 6)\n)\n");
+    // unsat hard constraints
+    check("(declare-const a Bool)"
+          "(assert a) (assert (not a)) (assert-soft a :weight 2)"
+          "(check-sat)",
+          "unsat\n");
+}
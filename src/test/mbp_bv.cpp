@@ -0,0 +1,124 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    mbp_bv.cpp
+
+Abstract:
+
+    Tests for model based projection of bit-vector variables.
+
+--*/
+
+#include "qe/mbp/mbp_bv.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_pp.h"
+#include "ast/occurs.h"
+#include "ast/expr_abstract.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "parsers/smt2/smt2parser.h"
+#include "cmd_context/cmd_context.h"
+#include "smt/smt_context.h"
+#include <iostream>
+#include <sstream>
+
+static expr_ref parse_fml(ast_manager& m, char const* str) {
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::ostringstream buffer;
+    buffer << "(declare-const x (_ BitVec 8))\n"
+           << "(declare-const y (_ BitVec 8))\n"
+           << "(declare-const z (_ BitVec 8))\n"
+           << "(declare-const u (_ BitVec 8))\n"
+           << "(declare-const w (_ BitVec 16))\n"
+           << "(assert " << str << ")\n";
+    std::istringstream is(buffer.str());
+    VERIFY(parse_smt2_commands(ctx, is));
+    return expr_ref(ctx.assertions().get(0), m);
+}
+
+static app_ref get_x(ast_manager& m) {
+    bv_util bv(m);
+    return app_ref(m.mk_const(symbol("x"), bv.mk_sort(8)), m);
+}
+
+/**
+   \brief project x from ex in a model of ex. The projection must hold in
+   the model and imply the existential closure of ex over x.
+*/
+static void test_project(char const* ex) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params params;
+    params.m_model = true;
+    expr_ref fml = parse_fml(m, ex);
+    app_ref x = get_x(m);
+    model_ref mdl;
+    {
+        smt::context ctx(m, params);
+        ctx.assert_expr(fml);
+        VERIFY(l_true == ctx.check());
+        ctx.get_model(mdl);
+    }
+    expr_ref_vector lits(m);
+    flatten_and(fml, lits);
+    app_ref_vector vars(m);
+    mbp::bv_project_plugin plugin(m);
+    VERIFY(plugin(*mdl, x, vars, lits));
+    expr_ref pr = mk_and(lits);
+    std::cout << "original:  " << fml << "\n";
+    std::cout << "projected: " << pr << "\n";
+    ENSURE(!occurs(x, pr));
+
+    // sat: the projection is consistent with the model.
+    ENSURE(mdl->is_true(pr));
+
+    // unsat: the projection implies E x . fml
+    expr_ref body(m), efml(m);
+    expr* v = x;
+    symbol x_name("x");
+    sort* x_sort = x->get_sort();
+    expr_abstract(m, 0, 1, &v, fml, body);
+    efml = m.mk_exists(1, &x_sort, &x_name, body);
+    smt::context ctx(m, params);
+    ctx.assert_expr(pr);
+    ctx.assert_expr(m.mk_not(efml));
+    ENSURE(l_false == ctx.check());
+}
+
+static void test_unsupported(char const* ex) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params params;
+    params.m_model = true;
+    expr_ref fml = parse_fml(m, ex);
+    app_ref x = get_x(m);
+    model_ref mdl;
+    {
+        smt::context ctx(m, params);
+        ctx.assert_expr(fml);
+        VERIFY(l_true == ctx.check());
+        ctx.get_model(mdl);
+    }
+    expr_ref_vector lits(m);
+    flatten_and(fml, lits);
+    app_ref_vector vars(m);
+    mbp::bv_project_plugin plugin(m);
+    ENSURE(!plugin(*mdl, x, vars, lits));
+}
+
+void tst_mbp_bv() {
+    // equalities solved by inversion
+    test_project("(and (= (bvadd x y) z) (bvule x u))");
+    test_project("(and (= (bvxor (bvnot x) y) z) (bvule y x))");
+    test_project("(and (= (bvmul #x03 x) y) (not (= x z)))");
+    test_project("(and (= (concat x y) w) (bvule y #x10))");
+    // bounds
+    test_project("(and (bvule y x) (bvule z x) (bvule x u))");
+    test_project("(and (not (bvule x y)) (bvule x #xf0))");
+    test_project("(bvule x u)");
+    // x occurs below an operator that is not inverted
+    test_unsupported("(= (bvmul x x) y)");
+    test_unsupported("(and (bvule y x) (= (bvand x z) u))");
+}
@@ -65,5 +65,25 @@ void tst_model_evaluator() {
         eval(e, v);
         std::cout << e << " " << v << "\n";
     }
-    
+
+    {
+        // update the interpretation of x and invalidate only the evaluations depending on x
+        model mdl2(m);
+        func_decl_ref x(m.mk_const_decl(symbol("x"), sI), m);
+        func_decl_ref y(m.mk_const_decl(symbol("y"), sI), m);
+        expr_ref xe(m.mk_const(x), m), ye(m.mk_const(y), m);
+        mdl2.register_decl(x, a.mk_int(1));
+        mdl2.register_decl(y, a.mk_int(2));
+        expr_ref x2(a.mk_mul(a.mk_int(2), xe), m), y3(a.mk_mul(a.mk_int(3), ye), m);
+        expr_ref t1(a.mk_add(x2, y3), m), t2(a.mk_sub(y3, x2), m);
+        ENSURE(mdl2(t1) == a.mk_int(8));
+        ENSURE(mdl2(t2) == a.mk_int(4));
+        mdl2.register_decl(x, a.mk_int(5));
+        mdl2.reset_eval_cache(x);
+        ENSURE(mdl2(t1) == a.mk_int(16));
+        ENSURE(mdl2(t2) == a.mk_int(-4));
+        mdl2.register_decl(y, a.mk_int(0));
+        mdl2.reset_eval_cache(y);
+        ENSURE(mdl2(t1) == a.mk_int(10));
+    }
 }
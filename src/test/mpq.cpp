@@ -160,7 +160,38 @@ static void tst_prev_power_2() {
     tst_prev_power_2((1ll << 60), 3, 58);
 }
 
+static void tst_small_rat_ops() {
+    unsynch_mpq_manager m;
+    scoped_mpq a(m), b(m), c(m), d(m);
+    // operands whose components are at the boundary of small integers
+    m.set(a, INT_MIN, INT_MAX);
+    m.set(b, INT_MAX, INT_MAX - 1);
+    m.add(a, b, c);
+    m.set(d, "1/4611686011984936962");
+    ENSURE(m.eq(c, d));
+    m.sub(a, b, c);
+    m.set(d, "-9223372028264841217/4611686011984936962");
+    ENSURE(m.eq(c, d));
+    m.mul(a, b, c);
+    m.set(d, "-1073741824/1073741823");
+    ENSURE(m.eq(c, d));
+    // results are normalized
+    m.set(a, 1, 6);
+    m.set(b, 1, 3);
+    m.add(a, b, c);
+    m.set(d, 1, 2);
+    ENSURE(m.eq(c, d));
+    m.sub(a, a, c);
+    ENSURE(m.is_zero(c));
+    m.set(a, 2, 3);
+    m.set(b, 3, 4);
+    m.mul(a, b, a);
+    m.set(d, 1, 2);
+    ENSURE(m.eq(a, d));
+}
+
 void tst_mpq() {
+    tst_small_rat_ops();
     tst_prev_power_2();
     set_str_bug();
     bug2();
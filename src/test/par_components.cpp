@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    par_components.cpp
+
+Abstract:
+
+    Tests for the par-components tactical.
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <iostream>
+#include <string>
+
+static void check(char const * spec, char const * expected) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    std::string r = Z3_eval_smtlib2_string(ctx, spec);
+    Z3_del_context(ctx);
+    std::cout << r;
+    ENSURE(r == expected);
+}
+
+void tst_par_components() {
+    // independent components
+    check("(declare-const x Int) (declare-const y Int)"
+          "(assert (> x 0)) (assert (< y 0))"
+          "(check-sat-using (par-components smt))"
+          "(eval (and (> x 0) (< y 0)))",
+          "sat\ntrue\n");
+    // one unsat component decides the goal
+    check("(declare-const x Int) (declare-const y Int)"
+          "(assert (> x 0)) (assert (< x 0)) (assert (> y 0))"
+          "(check-sat-using (par-components smt))",
+          "unsat\n");
+    // the assertions share no symbols, but the quantifier bounds the size of S
+    check("(declare-sort S 0) (declare-const a S) (declare-const b S) (declare-const c S)"
+          "(assert (forall ((x S)) (= x a)))"
+          "(assert (distinct b c))"
+          "(check-sat-using (par-components smt))",
+          "unsat\n");
+}
@@ -302,6 +302,38 @@ static void tst5() {
     m.del(a1);
 }
 
+template<bool PRESERVE_ROOTS>
+static void tst_shrink() {
+    typedef parray_manager<int_parray_config<PRESERVE_ROOTS> > int_parray_manager;
+    typedef typename int_parray_manager::ref int_array;
+
+    dummy_value_manager<int> vm;
+    small_object_allocator   a;
+    int_parray_manager m(vm, a);
+
+    int_array a1;
+    int_array a2;
+    for (unsigned i = 0; i < 100; i++) 
+        m.push_back(a1, i);
+    m.copy(a1, a2);
+    // a2 is shared with a1, and most elements are removed.
+    m.shrink(a2, 10);
+    ENSURE(m.size(a2) == 10);
+    ENSURE(m.size(a1) == 100);
+    for (unsigned i = 0; i < m.size(a1); i++) 
+        ENSURE(static_cast<unsigned>(m.get(a1, i)) == i);
+    for (unsigned i = 0; i < m.size(a2); i++) 
+        ENSURE(static_cast<unsigned>(m.get(a2, i)) == i);
+    // few elements are removed.
+    m.shrink(a1, 95);
+    ENSURE(m.size(a1) == 95);
+    ENSURE(m.get(a1, 94) == 94);
+    m.shrink(a1, 95);
+    ENSURE(m.size(a1) == 95);
+    m.del(a1);
+    m.del(a2);
+}
+
 void tst_parray() {
     // enable_trace("parray_mem");
     tst1<true>();
@@ -310,6 +342,8 @@ void tst_parray() {
     tst1<false>();
     tst2<false>();
     tst3<false>();
+    tst_shrink<true>();
+    tst_shrink<false>();
     // tst4();
     tst5();
 }
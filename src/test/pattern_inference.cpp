@@ -0,0 +1,55 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    pattern_inference.cpp
+
+Abstract:
+
+    Tests for the process wide cache of inferred patterns (pi.cache).
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <iostream>
+#include <string>
+
+static void check(char const * spec, char const * expected) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    std::string cmd = std::string("(set-option :pi.cache true)") + spec;
+    std::string r = Z3_eval_smtlib2_string(ctx, cmd.c_str());
+    Z3_del_context(ctx);
+    std::cout << r;
+    ENSURE(r == expected);
+}
+
+void tst_pattern_inference() {
+    char const* unsat_spec =
+        "(declare-fun f (Int) Int)"
+        "(assert (forall ((x Int)) (> (f x) x)))"
+        "(assert (< (f 3) 2))"
+        "(check-sat)";
+    char const* sat_spec =
+        "(declare-fun f (Int) Int) (declare-fun g (Int Int) Int)"
+        "(assert (forall ((x Int)) (>= (f x) 0)))"
+        "(assert (forall ((x Int) (y Int)) (= (g x y) (g y x))))"
+        "(assert (= (f 2) 5)) (assert (= (g 1 2) 3))"
+        "(check-sat)";
+    // the second context of each pair reuses the patterns of the first.
+    for (unsigned i = 0; i < 2; ++i) {
+        check(unsat_spec, "unsat\n");
+        check(sat_spec, "sat\n");
+    }
+    // the same quantifiers under a different configuration.
+    std::string spec = std::string("(set-option :pi.max_multi_patterns 1)") + unsat_spec;
+    check(spec.c_str(), "unsat\n");
+    // a cached quantifier declared in a different order of declarations.
+    check("(declare-fun h (Int) Int) (declare-fun f (Int) Int)"
+          "(assert (forall ((x Int)) (> (f x) x)))"
+          "(assert (< (f (h 0)) (h 0)))"
+          "(check-sat)",
+          "unsat\n");
+}
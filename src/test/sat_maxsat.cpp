@@ -0,0 +1,148 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    sat_maxsat.cpp
+
+Abstract:
+
+    Tests for weighted MaxSAT on the SAT core.
+
+--*/
+#include "sat/sat_maxsat.h"
+#include "sat/dimacs.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <iostream>
+#include <sstream>
+
+static lbool solve(char const* wcnf, uint64_t& cost, sat::model& mdl) {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    sat::maxsat ms(s);
+    std::istringstream in(wcnf);
+    VERIFY(parse_wcnf(in, std::cerr, s, ms));
+    lbool r = ms();
+    cost = ms.upper();
+    if (r == l_true) {
+        ENSURE(ms.lower() == ms.upper());
+        mdl = ms.get_model();
+    }
+    return r;
+}
+
+static void check(char const* wcnf, lbool expected, uint64_t expected_cost) {
+    uint64_t cost = 0;
+    sat::model mdl;
+    lbool r = solve(wcnf, cost, mdl);
+    std::cout << r << " " << cost << "\n";
+    ENSURE(r == expected);
+    if (r == l_true)
+        ENSURE(cost == expected_cost);
+}
+
+static bool is_sat(vector<int> const& clause, unsigned bits) {
+    for (int l : clause) {
+        bool val = (bits >> (std::abs(l) - 1)) & 1;
+        if (val == (l > 0))
+            return true;
+    }
+    return false;
+}
+
+/**
+   \brief compare the optimum against enumeration of all assignments.
+*/
+static void check_random(random_gen& rand, unsigned num_vars, unsigned num_hard, unsigned num_soft) {
+    vector<vector<int>> clauses;
+    vector<unsigned> weights;
+    std::ostringstream out;
+    out << "p wcnf " << num_vars << " " << (num_hard + num_soft) << " 1000\n";
+    for (unsigned i = 0; i < num_hard + num_soft; ++i) {
+        vector<int> clause;
+        unsigned len = 1 + rand(3);
+        for (unsigned j = 0; j < len; ++j) {
+            int v = 1 + rand(num_vars);
+            clause.push_back(rand(2) ? v : -v);
+        }
+        unsigned w = i < num_hard ? 1000 : 1 + rand(5);
+        out << w;
+        for (int l : clause)
+            out << " " << l;
+        out << " 0\n";
+        clauses.push_back(clause);
+        weights.push_back(w);
+    }
+    bool found = false;
+    uint64_t best = 0;
+    for (unsigned bits = 0; bits < (1u << num_vars); ++bits) {
+        uint64_t cost = 0;
+        bool hard_sat = true;
+        for (unsigned i = 0; i < clauses.size(); ++i) {
+            if (is_sat(clauses[i], bits))
+                continue;
+            if (i < num_hard)
+                hard_sat = false;
+            else
+                cost += weights[i];
+        }
+        if (hard_sat && (!found || cost < best)) {
+            found = true;
+            best = cost;
+        }
+    }
+    uint64_t cost = 0;
+    sat::model mdl;
+    lbool r = solve(out.str().c_str(), cost, mdl);
+    ENSURE(r == (found ? l_true : l_false));
+    if (!found)
+        return;
+    ENSURE(cost == best);
+    // the model attains the optimum, DIMACS variable v is variable v of the solver.
+    unsigned bits = 0;
+    for (unsigned v = 0; v < num_vars; ++v)
+        if (mdl[v + 1] == l_true)
+            bits |= (1u << v);
+    uint64_t model_cost = 0;
+    for (unsigned i = 0; i < clauses.size(); ++i) {
+        if (is_sat(clauses[i], bits))
+            continue;
+        ENSURE(i >= num_hard);
+        model_cost += weights[i];
+    }
+    ENSURE(model_cost == best);
+}
+
+void tst_sat_maxsat() {
+    // one of the soft clauses -1 and -2 is violated, and one of 3 and -3.
+    check("p wcnf 3 6 100\n"
+          "100 1 2 0\n"
+          "3 -1 0\n"
+          "2 -2 0\n"
+          "1 -3 0\n"
+          "1 3 0\n"
+          "5 1 2 3 0\n",
+          l_true, 3);
+    // format with h for hard clauses
+    check("h 1 2 0\n"
+          "3 -1 0\n"
+          "2 -2 0\n",
+          l_true, 2);
+    // all soft clauses can be satisfied
+    check("p wcnf 2 3 10\n"
+          "10 1 2 0\n"
+          "4 -1 0\n"
+          "4 2 0\n",
+          l_true, 0);
+    // the hard clauses are unsatisfiable
+    check("p wcnf 1 3 10\n"
+          "10 1 0\n"
+          "10 -1 0\n"
+          "1 1 0\n",
+          l_false, 0);
+    random_gen rand(0);
+    for (unsigned i = 0; i < 200; ++i)
+        check_random(rand, 6, 1 + rand(4), 4 + rand(12));
+}
@@ -0,0 +1,94 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    sat_xor_gauss.cpp
+
+Abstract:
+
+    Tests for Gauss-Jordan elimination of XOR constraints.
+
+--*/
+#include "sat/sat_solver.h"
+#include "sat/sat_xor_gauss.h"
+#include "util/util.h"
+#include <iostream>
+
+// add the clauses of the xor of vars equal to rhs.
+static void add_xor(sat::solver& s, unsigned n, sat::bool_var const* vars, bool rhs) {
+    sat::literal_vector lits;
+    for (unsigned mask = 0; mask < (1u << n); ++mask) {
+        unsigned parity = 0;
+        lits.reset();
+        for (unsigned i = 0; i < n; ++i) {
+            bool neg = (mask & (1u << i)) != 0;
+            parity ^= neg;
+            lits.push_back(sat::literal(vars[i], neg));
+        }
+        // the clause excludes the assignment where exactly the negated variables are true.
+        if ((parity != 0) == rhs)
+            continue;
+        s.mk_clause(lits.size(), lits.data());
+    }
+}
+
+static void add_xor3(sat::solver& s, sat::bool_var a, sat::bool_var b, sat::bool_var c, bool rhs) {
+    sat::bool_var vars[3] = { a, b, c };
+    add_xor(s, 3, vars, rhs);
+}
+
+static void tst_units() {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < 4; ++i)
+        s.mk_var();
+    // the sum of the rows is x2 = 1 ^ 1 ^ 0
+    add_xor3(s, 0, 1, 2, true);
+    add_xor3(s, 1, 2, 3, true);
+    add_xor3(s, 0, 2, 3, false);
+    sat::xor_gauss xg(s);
+    ENSURE(xg.init());
+    xg.display(std::cout);
+    ENSURE(!s.inconsistent());
+    ENSURE(s.value(2) == l_false);
+    xg.detach();
+    ENSURE(s.check() == l_true);
+    ENSURE(s.get_model()[2] == l_false);
+}
+
+static void tst_conflict() {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < 6; ++i)
+        s.mk_var();
+    // every variable occurs in two rows, the sum of the right hand sides is 1.
+    add_xor3(s, 0, 1, 2, true);
+    add_xor3(s, 0, 3, 4, true);
+    add_xor3(s, 1, 3, 5, true);
+    add_xor3(s, 2, 4, 5, false);
+    sat::xor_gauss xg(s);
+    ENSURE(xg.init());
+    ENSURE(s.inconsistent());
+    xg.detach();
+}
+
+static void tst_no_xors() {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < 3; ++i)
+        s.mk_var();
+    sat::literal lits[3] = { sat::literal(0, false), sat::literal(1, false), sat::literal(2, false) };
+    s.mk_clause(3, lits);
+    sat::xor_gauss xg(s);
+    ENSURE(!xg.init());
+}
+
+void tst_sat_xor_gauss() {
+    tst_units();
+    tst_conflict();
+    tst_no_xors();
+}
@@ -4,6 +4,8 @@
 // run it with app-verifier (becuzz yes ...)
 
 #include "util/scoped_timer.h"
+#include "util/cancel_eh.h"
+#include "util/rlimit.h"
 #include "util/util.h"
 #include "util/vector.h"
 #include "util/trace.h"
@@ -36,8 +38,27 @@ static void worker_thread(unsigned tid) {
     }
 }
 
+// a loop that checks the resource limit returns shortly after the timer cancels it.
+static void cancel_latency_test() {
+    reslimit lim;
+    for (unsigned i = 0; i < 20; ++i) {
+        {
+            cancel_eh<reslimit> eh(lim);
+            scoped_timer timer(1 + i % 5, &eh);
+            while (lim.inc())
+                ;
+        }
+        ENSURE(lim.not_canceled());
+    }
+    std::cout << "max cancel latency " << lim.max_cancel_latency() << "ms\n";
+    ENSURE(lim.max_cancel_latency() < 1000);
+}
+
 void tst_scoped_timer() {
 
+    std::cout << "cancel latency test\n";
+    cancel_latency_test();
+
     std::cout << "sequential test\n";
     worker_thread(0);
 
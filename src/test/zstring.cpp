@@ -21,6 +21,25 @@ static void tst_ascii_roundtrip() {
     }
 }
 
+// Substrings share the characters of their string; check that they behave as copies.
+static void tst_substrings() {
+    zstring a("hello world");
+    zstring u("\\u{1F600}world");
+    zstring w = a.extract(6, 5);
+    zstring v = u.extract(1, 5);
+    ENSURE(w == zstring("world"));
+    ENSURE(v == w);
+    ENSURE(v.hash() == w.hash());
+    ENSURE(a.extract(0, 6) + w == a);
+    ENSURE(w.suffixof(a) && !w.prefixof(a));
+    ENSURE(a.extract(3, 0).empty() && a.extract(20, 1).empty());
+    ENSURE(u[0] == 0x1F600 && u.length() == 6);
+    a = zstring("other");
+    ENSURE(w.encode() == "world");
+    ENSURE(a.replace(zstring("th"), w) == zstring("oworlder"));
+}
+
 void tst_zstring() {
     tst_ascii_roundtrip();
+    tst_substrings();
 }
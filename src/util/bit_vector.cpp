@@ -185,6 +185,26 @@ bit_vector & bit_vector::operator&=(bit_vector const & source) {
     return *this;
 }
 
+bit_vector & bit_vector::operator^=(bit_vector const & source) {
+    if (size() < source.size())
+        resize(source.size(), false);
+    unsigned n2 = source.num_words();
+    SASSERT(n2 <= num_words());
+    unsigned bit_rest = source.m_num_bits % 32;
+    if (bit_rest == 0) {
+        for (unsigned i = 0; i < n2; i++)
+            m_data[i] ^= source.m_data[i];
+    }
+    else {
+        unsigned i = 0;
+        for (i = 0; i < n2 - 1; i++)
+            m_data[i] ^= source.m_data[i];
+        unsigned mask = MK_MASK(bit_rest);
+        m_data[i] ^= source.m_data[i] & mask;
+    }
+    return *this;
+}
+
 void bit_vector::display(std::ostream & out) const {
 #if 1
     unsigned i = m_num_bits;
@@ -21,6 +21,9 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/page.h"
+#include "util/scoped_profile.h"
+#include "util/thread_pool.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -28,7 +31,12 @@ void env_params::updt_params() {
     enable_warning_messages(p.get_bool("warning", true));
     memory::set_max_size(megabytes_to_bytes(p.get_uint("memory_max_size", 0)));
     memory::set_max_alloc_count(p.get_uint("memory_max_alloc_count", 0));
-    memory::set_high_watermark(p.get_uint("memory_high_watermark", 0));
+    memory::set_high_watermark(megabytes_to_bytes(p.get_uint("memory_high_watermark", 0)));
+    set_huge_page_arenas(p.get_bool("memory_huge_pages", false));
+    thread_pool::set_affinity(p.get_bool("thread_affinity", false));
+    bool profile = p.get_bool("profile", false);
+    if (profile != scoped_profile::enabled())
+        scoped_profile::enable(profile, p.get_str("profile_file", "z3.folded"));
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -37,4 +45,8 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_size", CPK_UINT, "set hard upper limit for memory consumption (in megabytes), if 0 then there is no limit", "0");
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("memory_huge_pages", CPK_BOOL, "allocate region and small object memory from thread-local arenas backed by huge pages (arena memory is not returned to the system and not counted by memory_max_size)", "false");
+    d.insert("thread_affinity", CPK_BOOL, "pin the worker threads of parallel solvers and tactics to distinct cores, filling one NUMA node before the next (Linux only); together with memory_huge_pages, workers allocate from memory on their own node", "false");
+    d.insert("profile", CPK_BOOL, "record the time spent in the main solver phases", "false");
+    d.insert("profile_file", CPK_STRING, "file receiving the profile in folded stack format on exit", "z3.folded");
 }
@@ -133,6 +133,7 @@ struct gparams::imp {
     smap<char const *>   m_module_descrs;
     param_descrs         m_param_descrs;
     smap<params_ref* >   m_module_params;
+    atomic<unsigned>     m_num_module_params { 0 }; // size of m_module_params, readable without the lock.
     params_ref           m_params;
     region               m_region;
     std::string          m_buffer;
@@ -186,6 +187,7 @@ public:
             dealloc(kv.m_value);
         }
         m_module_params.reset();        
+        m_num_module_params = 0;
         m_region.reset();
     }
 
@@ -262,6 +264,7 @@ public:
             if (!m_module_params.find(mod_name.c_str(), p)) {
                 p = alloc(params_ref);
                 m_module_params.insert(cpy(mod_name.c_str()), p);                
+                m_num_module_params = m_module_params.size();
             }
             SASSERT(p);
             return *p;
@@ -464,6 +467,10 @@ public:
     params_ref get_module(char const* module_name) {
         params_ref result;
         params_ref * ps = nullptr;
+        // parameter objects for solvers and tactics are created very often,
+        // and usually no module parameters are set. Then the lock is not needed.
+        if (m_num_module_params == 0)
+            return result;
         {
             lock_guard lock(*gparams_mux);
             if (m_module_params.find(module_name, ps)) {
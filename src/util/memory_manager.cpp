@@ -13,6 +13,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "util/error_codes.h"
 #include "util/debug.h"
 #include "util/scoped_timer.h"
+#include "util/thread_pool.h"
 // The following two function are automatically generated by the mk_make.py script.
 // The script collects ADD_INITIALIZER and ADD_FINALIZER commands in the .h files.
 // For example, rational.h contains
@@ -118,6 +119,21 @@ bool memory::above_high_watermark() {
     return g_memory_watermark < g_memory_alloc_size;
 }
 
+/**
+   \brief Return true if the allocated memory is within 1/8 of the high watermark,
+   or of the maximum size if it is smaller. Solvers use it to release memory they
+   can recompute before the limits are reached.
+*/
+bool memory::under_pressure() {
+    long long limit = g_memory_watermark;
+    if (g_memory_max_size != 0 && (limit == 0 || g_memory_max_size < limit))
+        limit = g_memory_max_size;
+    if (limit == 0)
+        return false;
+    lock_guard lock(*g_memory_mux);
+    return limit - limit / 8 < g_memory_alloc_size;
+}
+
 // The following methods are only safe to invoke at 
 // initialization time, that is, before threads are created.
 
@@ -133,6 +149,9 @@ static bool g_finalizing = false;
 
 void memory::finalize(bool shutdown) {
     if (g_memory_initialized) {
+        // worker threads release their thread local memory when they exit.
+        if (shutdown)
+            thread_pool::finalize();
         g_finalizing = true;
         mem_finalize();
         // we leak the mutex since we need it to be always live since memory may
@@ -249,6 +268,7 @@ static void synchronize_counters(bool allocating) {
             counts_exceeded = true;
     }
     g_memory_thread_alloc_size = 0;
+    g_memory_thread_alloc_count = 0;
     if (out_of_mem && allocating) {
         throw_out_of_memory();
     }
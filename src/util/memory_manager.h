@@ -53,6 +53,7 @@ public:
     static void initialize(size_t max_size);
     static void set_high_watermark(size_t watermak);
     static bool above_high_watermark();
+    static bool under_pressure();
     static void set_max_size(size_t max_size);
     static void set_max_alloc_count(size_t max_count);
     static void finalize(bool shutdown = true);
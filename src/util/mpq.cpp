@@ -349,6 +349,25 @@ void mpq_manager<SYNCH>::lin_arith_op(mpq const& a, mpq const& b, mpq& c, mpz& g
     }                                           
 }
 
+/**
+   \brief Set c to n/d in normal form, where n and d are obtained from operations on 
+   small rationals (see is_small). The numerators and denominators of small rationals 
+   fit in 32 bits, so sums of two products and products of them fit in 64 bits 
+   and the fast paths below cannot overflow.
+*/
+template<bool SYNCH>
+void mpq_manager<SYNCH>::set_small_rat(mpq & c, int64_t n, uint64_t d) {
+    SASSERT(d != 0);
+    uint64_t abs_n = n < 0 ? static_cast<uint64_t>(-n) : static_cast<uint64_t>(n);
+    uint64_t g = u64_gcd(abs_n, d);
+    if (g > 1) {
+        n /= static_cast<int64_t>(g);
+        d /= g;
+    }
+    mpz_manager<SYNCH>::set(c.m_num, n);
+    mpz_manager<SYNCH>::set(c.m_den, d);
+}
+
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c, mpz& g1, mpz& g2, mpz& tmp1, mpz& tmp2) {
 #if 1
@@ -380,7 +399,12 @@ void mpq_manager<SYNCH>::rat_mul(mpz const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c) {
     STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " * " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        set_small_rat(c, 
+                      static_cast<int64_t>(a.m_num.m_val) * b.m_num.m_val,
+                      static_cast<uint64_t>(static_cast<int64_t>(a.m_den.m_val) * b.m_den.m_val));
+    }
+    else if (SYNCH) {
         mpz g1, g2, tmp1, tmp2;
         rat_mul(a, b, c, g1, g2, tmp1, tmp2);
         del(g1);
@@ -397,7 +421,12 @@ void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_add(mpq const & a, mpq const & b, mpq & c) {
     STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        set_small_rat(c, 
+                      static_cast<int64_t>(a.m_num.m_val) * b.m_den.m_val + static_cast<int64_t>(b.m_num.m_val) * a.m_den.m_val,
+                      static_cast<uint64_t>(static_cast<int64_t>(a.m_den.m_val) * b.m_den.m_val));
+    }
+    else if (SYNCH) {
         mpz_stack tmp1, tmp2, tmp3, g;
         lin_arith_op<false>(a, b, c, g, tmp1, tmp2, tmp3);
         del(tmp1);
@@ -414,7 +443,12 @@ void mpq_manager<SYNCH>::rat_add(mpq const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_sub(mpq const & a, mpq const & b, mpq & c) {
     STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " - " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        set_small_rat(c, 
+                      static_cast<int64_t>(a.m_num.m_val) * b.m_den.m_val - static_cast<int64_t>(b.m_num.m_val) * a.m_den.m_val,
+                      static_cast<uint64_t>(static_cast<int64_t>(a.m_den.m_val) * b.m_den.m_val));
+    }
+    else if (SYNCH) {
         mpz tmp1, tmp2, tmp3, g;
         lin_arith_op<true>(a, b, c, g, tmp1, tmp2, tmp3);
         del(tmp1);
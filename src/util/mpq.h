@@ -108,6 +108,8 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_mul(mpq const & a, mpq const & b, mpq & c, mpz& g1, mpz& g2, mpz& tmp1, mpz& tmp2);
 
+    void set_small_rat(mpq & c, int64_t n, uint64_t d);
+
 public:
     typedef mpq numeral;
     typedef mpq rational;
@@ -514,8 +514,12 @@ void mpz_manager<SYNCH>::addmul(mpz const & a, mpz const & b, mpz const & c, mpz
     else if (is_minus_one(b)) {
         sub(a, c, d);
     }
+    else if (is_small(a) && is_small(b) && is_small(c)) {
+        // |b*c| <= 2^62, so the result fits in 64 bits.
+        set_i64(d, i64(a) + i64(b) * i64(c));
+    }
     else {
-        mpz tmp;
+        mpz_stack tmp;
         mul(b,c,tmp);
         add(a,tmp,d);
         del(tmp);
@@ -532,8 +536,12 @@ void mpz_manager<SYNCH>::submul(mpz const & a, mpz const & b, mpz const & c, mpz
     else if (is_minus_one(b)) {
         add(a, c, d);
     }
+    else if (is_small(a) && is_small(b) && is_small(c)) {
+        // |b*c| <= 2^62, so the result fits in 64 bits.
+        set_i64(d, i64(a) - i64(b) * i64(c));
+    }
     else {
-        mpz tmp;
+        mpz_stack tmp;
         mul(b,c,tmp);
         sub(a,tmp,d);
         del(tmp);
@@ -39,6 +39,8 @@ public:
     void mark(T const & obj, bool flag) {
         unsigned id = m_proc(obj);
         if (id >= m_marks.size()) {
+            if (!flag)
+                return;
             m_marks.resize(id+1, 0);
         }
         m_marks.set(id, flag);
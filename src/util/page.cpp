@@ -18,6 +18,188 @@ Revision History:
 --*/
 #include "util/page.h"
 #include "util/debug.h"
+#include "util/mutex.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#define ARENA_CHUNK_SIZE (2 * 1024 * 1024)
+
+static_assert(ARENA_CHUNK_SIZE % ARENA_BLOCK_SIZE == 0, "arena blocks must tile chunks");
+
+static bool g_huge_page_arenas = false;
+
+void set_huge_page_arenas(bool f) {
+    g_huge_page_arenas = f;
+}
+
+bool huge_page_arenas() {
+    return g_huge_page_arenas;
+}
+
+/**
+   \brief Allocate a chunk of ARENA_CHUNK_SIZE bytes aligned at ARENA_CHUNK_SIZE.
+   Explicit huge pages (MAP_HUGETLB) are used if they are reserved, and otherwise
+   transparent huge pages are requested with madvise.
+*/
+static char * alloc_arena_chunk() {
+#ifdef __linux__
+#ifdef MAP_HUGETLB
+    void * h = mmap(nullptr, ARENA_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (h != MAP_FAILED)
+        return static_cast<char *>(h);
+#endif
+    void * p = mmap(nullptr, 2 * ARENA_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw out_of_memory_error();
+    char * begin = static_cast<char *>(p);
+    char * r = reinterpret_cast<char *>((reinterpret_cast<size_t>(begin) + ARENA_CHUNK_SIZE - 1) & ~static_cast<size_t>(ARENA_CHUNK_SIZE - 1));
+    if (r != begin)
+        munmap(begin, r - begin);
+    if (r + ARENA_CHUNK_SIZE != begin + 2 * ARENA_CHUNK_SIZE)
+        munmap(r + ARENA_CHUNK_SIZE, begin + 2 * ARENA_CHUNK_SIZE - (r + ARENA_CHUNK_SIZE));
+#ifdef MADV_HUGEPAGE
+    madvise(r, ARENA_CHUNK_SIZE, MADV_HUGEPAGE);
+#endif
+    return r;
+#else
+    return static_cast<char *>(memory::allocate(ARENA_CHUNK_SIZE));
+#endif
+}
+
+namespace {
+    /**
+       \brief Free blocks of threads that have exited.
+       The pool is never destroyed, as static objects may free blocks
+       during their destruction.
+    */
+    struct arena_pool {
+        mutex  m_mux;
+        void * m_free = nullptr;
+
+        void * alloc_block() {
+            lock_guard lock(m_mux);
+            void * r = m_free;
+            if (r)
+                m_free = *static_cast<void **>(r);
+            return r;
+        }
+
+        void free_block(void * b) {
+            lock_guard lock(m_mux);
+            *static_cast<void **>(b) = m_free;
+            m_free = b;
+        }
+    };
+
+    arena_pool & get_arena_pool() {
+        static arena_pool * g_pool = new arena_pool();
+        return *g_pool;
+    }
+
+    /**
+       \brief Blocks of one thread.
+       The arena is trivially destructible, so it remains usable after the
+       thread local destructors of its thread have run. This is the case for
+       static objects of the main thread that free blocks at exit.
+       release() hands the blocks of the arena to the pool when the thread
+       ends, and blocks are then allocated and freed through the pool.
+    */
+    struct arena {
+        char * m_next = nullptr; // unused part [m_next, m_end) of the current chunk
+        char * m_end  = nullptr;
+        void * m_free = nullptr; // free list of blocks
+        bool   m_released = false;
+
+        void release() {
+            while (m_next != m_end) {
+                free_block(m_next);
+                m_next += ARENA_BLOCK_SIZE;
+            }
+            m_released = true;
+            if (!m_free)
+                return;
+            void * last = m_free;
+            while (*static_cast<void **>(last))
+                last = *static_cast<void **>(last);
+            arena_pool & p = get_arena_pool();
+            lock_guard lock(p.m_mux);
+            *static_cast<void **>(last) = p.m_free;
+            p.m_free = m_free;
+            m_free = nullptr;
+        }
+
+        void * alloc_block() {
+            if (m_released) {
+                void * r = get_arena_pool().alloc_block();
+                if (r)
+                    return r;
+                char * c = alloc_arena_chunk();
+                for (char * b = c + ARENA_BLOCK_SIZE; b != c + ARENA_CHUNK_SIZE; b += ARENA_BLOCK_SIZE)
+                    get_arena_pool().free_block(b);
+                return c;
+            }
+            if (m_free) {
+                void * r = m_free;
+                m_free = *static_cast<void **>(r);
+                return r;
+            }
+            if (m_next == m_end) {
+                arena_pool & p = get_arena_pool();
+                lock_guard lock(p.m_mux);
+                if (p.m_free) {
+                    void * r = p.m_free;
+                    p.m_free = *static_cast<void **>(r);
+                    return r;
+                }
+            }
+            if (m_next == m_end) {
+                m_next = alloc_arena_chunk();
+                m_end  = m_next + ARENA_CHUNK_SIZE;
+            }
+            void * r = m_next;
+            m_next += ARENA_BLOCK_SIZE;
+            return r;
+        }
+
+        void free_block(void * b) {
+            if (m_released) {
+                get_arena_pool().free_block(b);
+                return;
+            }
+            *static_cast<void **>(b) = m_free;
+            m_free = b;
+        }
+    };
+
+#ifdef SINGLE_THREAD
+    arena g_arena;
+
+    void init_arena() {}
+#else
+    thread_local arena g_arena;
+
+    struct arena_release {
+        bool m_init = false;
+        ~arena_release() { g_arena.release(); }
+    };
+
+    thread_local arena_release g_arena_release;
+
+    // register the release of the arena of the current thread.
+    void init_arena() { g_arena_release.m_init = true; }
+#endif
+}
+
+void * alloc_arena_block() {
+    if (g_arena.m_next == g_arena.m_end && !g_arena.m_free && !g_arena.m_released)
+        init_arena();
+    return g_arena.alloc_block();
+}
+
+void dealloc_arena_block(void * b) {
+    g_arena.free_block(b);
+}
 
 inline void set_page_header(char * page, char * prev, bool default_page) {
     size_t header = reinterpret_cast<size_t>(prev) | static_cast<size_t>(default_page); 
@@ -30,20 +212,29 @@ inline char * alloc_page(size_t s) { char * r = alloc_svect(char, s+PAGE_HEADER_
 
 inline void del_page(char * page) { dealloc_svect(page - PAGE_HEADER_SZ); }
 
-void del_pages(char * page) {
+/**
+   \brief Delete a list of pages. If arena is true, then default pages are arena blocks.
+*/
+void del_pages(char * page, bool arena) {
     while (page != nullptr) {
         char * prev = prev_page(page);
-        del_page(page);
+        if (arena && is_default_page(page))
+            dealloc_arena_block(page - PAGE_HEADER_SZ);
+        else
+            del_page(page);
         page = prev;
     }
 }
 
-char * allocate_default_page(char * prev, char * & free_pages) {
+char * allocate_default_page(char * prev, char * & free_pages, bool arena) {
     char * r;
     if (free_pages) {
         r = free_pages;
         free_pages = prev_page(free_pages);
     }
+    else if (arena) {
+        r = static_cast<char *>(alloc_arena_block()) + PAGE_HEADER_SZ;
+    }
     else {
         r = alloc_page(DEFAULT_PAGE_SIZE);
     }
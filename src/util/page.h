@@ -33,8 +33,26 @@ inline bool is_default_page(char * page) {
     return static_cast<bool>(tagged_ptr & 1);
 }
 inline char * end_of_default_page(char * p) { return p + DEFAULT_PAGE_SIZE; }
-void del_pages(char * page);
-char * allocate_default_page(char * prev, char * & free_pages);
+void del_pages(char * page, bool arena = false);
+char * allocate_default_page(char * prev, char * & free_pages, bool arena = false);
 char * allocate_page(char * prev, size_t sz);
 void recycle_page(char * p, char * & free_pages);
 
+/**
+   \brief Arenas of blocks of ARENA_BLOCK_SIZE bytes (the size of a default page with
+   its header) carved from 2MB chunks that are backed by huge pages when the
+   platform supports it. Each thread allocates from its own chunks, so blocks are
+   placed on the NUMA node of the thread that first touches them. Blocks freed by
+   a thread are reused by that thread; the free blocks of a thread that exits
+   are passed on to other threads. Chunks are never returned to the system and
+   they are not counted by the memory manager.
+
+   Regions and small object allocators created while arenas are enabled take their
+   default pages and chunks from the arenas.
+*/
+#define ARENA_BLOCK_SIZE (DEFAULT_PAGE_SIZE + PAGE_HEADER_SZ)
+void set_huge_page_arenas(bool f);
+bool huge_page_arenas();
+void * alloc_arena_block();
+void dealloc_arena_block(void * b);
+
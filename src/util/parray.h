@@ -515,6 +515,21 @@ public:
         pop_back(r);
     }
 
+    /**
+       \brief Shrink r to its first sz elements.
+       If more than half of the elements are removed from a shared array,
+       r gets a copy of its own first, so that the removed elements are
+       not recorded as a trail of pop_back cells.
+    */
+    void shrink(ref & r, unsigned sz) {
+        unsigned r_sz = size(r);
+        SASSERT(sz <= r_sz);
+        if (r_sz - sz > sz)
+            unshare(r);
+        for (; r_sz > sz; --r_sz)
+            pop_back(r);
+    }
+
     void unshare(ref & r) {
         if (r.root() && r.unshared())
             return;
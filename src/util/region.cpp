@@ -56,7 +56,7 @@ void region::pop_scope() {
 #include "util/page.h"
 
 inline void region::allocate_page() {
-    m_curr_page     = allocate_default_page(m_curr_page, m_free_pages);
+    m_curr_page     = allocate_default_page(m_curr_page, m_free_pages, m_arena);
     m_curr_ptr      = m_curr_page;
     m_curr_end_ptr  = end_of_default_page(m_curr_page);
 }
@@ -67,12 +67,13 @@ region::region() {
     m_curr_end_ptr = nullptr;
     m_free_pages   = nullptr;
     m_mark         = nullptr;
+    m_arena        = huge_page_arenas();
     allocate_page();
 }
 
 region::~region() {
-    del_pages(m_curr_page);
-    del_pages(m_free_pages);
+    del_pages(m_curr_page, m_arena);
+    del_pages(m_free_pages, m_arena);
 }
 
 void * region::allocate(size_t size) {
@@ -69,6 +69,7 @@ class region {
     char *   m_curr_end_ptr; //!< Point to the end of the current page.
     char *   m_free_pages;
     mark *   m_mark;
+    bool     m_arena;        //!< default pages are taken from the huge page arenas.
     void allocate_page();
     void recycle_curr_page();
 public:
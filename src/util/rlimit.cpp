@@ -19,6 +19,7 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/common_msgs.h"
 #include "util/mutex.h"
+#include <chrono>
 
 
 static DECLARE_MUTEX(g_rlimit_mux);
@@ -35,7 +36,14 @@ reslimit::reslimit():
     m_cancel(0),
     m_suspend(false),
     m_count(0),
-    m_limit(std::numeric_limits<uint64_t>::max()) {
+    m_limit(std::numeric_limits<uint64_t>::max()),
+    m_cancel_start(0),
+    m_cancel_latency(0),
+    m_max_cancel_latency(0) {
+}
+
+static uint64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 uint64_t reslimit::count() const {
@@ -108,11 +116,17 @@ void reslimit::inc_cancel() {
 void reslimit::dec_cancel() {
     lock_guard lock(*g_rlimit_mux);
     if (m_cancel > 0) {
+        if (m_cancel == 1 && m_cancel_start > 0) {
+            m_cancel_latency = (now_us() - m_cancel_start) / 1000.0;
+            m_max_cancel_latency = std::max(m_max_cancel_latency, m_cancel_latency);
+        }
         set_cancel(m_cancel-1);
     }
 }
 
 void reslimit::set_cancel(unsigned f) {
+    if (f > 0 && m_cancel == 0)
+        m_cancel_start = now_us();
     m_cancel = f;
     for (unsigned i = 0; i < m_children.size(); ++i) {
         m_children[i]->set_cancel(f);
@@ -35,6 +35,9 @@ class reslimit {
     uint64_t        m_limit;
     svector<uint64_t> m_limits;
     ptr_vector<reslimit> m_children;
+    std::atomic<uint64_t> m_cancel_start;   // microseconds, time of the last cancel request
+    double          m_cancel_latency;       // milliseconds from the last cancel request to its release
+    double          m_max_cancel_latency;
 
     void set_cancel(unsigned f);
     friend class scoped_suspend_rlimit;
@@ -59,6 +62,14 @@ public:
 
     void inc_cancel();
     void dec_cancel();
+
+    /**
+       \brief time in milliseconds between the last cancel request and
+       the return of the operation it canceled, that is, the matching
+       dec_cancel.
+    */
+    double cancel_latency() const { return m_cancel_latency; }
+    double max_cancel_latency() const { return m_max_cancel_latency; }
 };
 
 class scoped_rlimit {
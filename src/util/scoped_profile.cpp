@@ -0,0 +1,108 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    scoped_profile.cpp
+
+Abstract:
+
+    Low-overhead phase profiling that is available in release builds.
+
+--*/
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "util/scoped_profile.h"
+
+atomic<bool> scoped_profile::s_enabled(false);
+
+namespace {
+    typedef std::chrono::steady_clock profile_clock;
+
+    struct frame {
+        size_t                    m_stack_len;  // length of the folded stack before the frame was pushed
+        profile_clock::time_point m_start;
+        uint64_t                  m_children;   // microseconds spent in nested frames
+    };
+
+    struct thread_profile {
+        std::string        m_stack;
+        std::vector<frame> m_frames;
+        std::unordered_map<std::string, uint64_t> m_self;
+    };
+
+#ifdef SINGLE_THREAD
+    thread_profile t_profile;
+#else
+    thread_local thread_profile t_profile;
+#endif
+
+    mutex        g_mux;
+    std::string  g_file;
+    std::map<std::string, uint64_t> g_self;
+}
+
+void scoped_profile::push(char const * name) {
+    thread_profile & p = t_profile;
+    p.m_frames.push_back({ p.m_stack.size(), profile_clock::now(), 0 });
+    if (!p.m_stack.empty())
+        p.m_stack += ';';
+    p.m_stack += name;
+}
+
+void scoped_profile::pop() {
+    thread_profile & p = t_profile;
+    if (p.m_frames.empty())
+        return;
+    frame f = p.m_frames.back();
+    p.m_frames.pop_back();
+    uint64_t total = std::chrono::duration_cast<std::chrono::microseconds>(profile_clock::now() - f.m_start).count();
+    uint64_t self = total > f.m_children ? total - f.m_children : 0;
+    p.m_self[p.m_stack] += self;
+    p.m_stack.resize(f.m_stack_len);
+    if (!p.m_frames.empty()) {
+        p.m_frames.back().m_children += total;
+        return;
+    }
+    lock_guard lock(g_mux);
+    for (auto const & kv : p.m_self)
+        g_self[kv.first] += kv.second;
+    p.m_self.clear();
+}
+
+void scoped_profile::enable(bool f, char const * file) {
+    lock_guard lock(g_mux);
+    g_file = file ? file : "";
+    s_enabled = f;
+}
+
+void scoped_profile::reset() {
+    lock_guard lock(g_mux);
+    g_self.clear();
+}
+
+void scoped_profile::display(std::ostream & out) {
+    lock_guard lock(g_mux);
+    for (auto const & kv : g_self)
+        if (kv.second > 0)
+            out << kv.first << " " << kv.second << "\n";
+}
+
+void scoped_profile::finalize() {
+    bool has_data;
+    std::string file;
+    {
+        lock_guard lock(g_mux);
+        has_data = !g_self.empty();
+        file = g_file;
+    }
+    if (has_data && !file.empty()) {
+        std::ofstream out(file);
+        display(out);
+    }
+    reset();
+    s_enabled = false;
+}
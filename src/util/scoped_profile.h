@@ -0,0 +1,51 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    scoped_profile.h
+
+Abstract:
+
+    Low-overhead phase profiling that is available in release builds.
+
+    A scoped_profile object attributes the time spent in its scope to
+    the current stack of named phases of its thread. Profiling is
+    enabled at runtime with the global parameter profile=true; when it
+    is disabled a scope costs a single test of a global flag.
+
+    The per-thread totals are merged when the outermost scope of a
+    thread ends. At finalization they are written to profile_file in
+    the folded stack format of flamegraph.pl: one line per stack
+    "phase1;phase2;phase3 <microseconds of self time>".
+
+--*/
+#pragma once
+
+#include <ostream>
+#include <string>
+#include "util/mutex.h"
+
+class scoped_profile {
+    static atomic<bool> s_enabled;
+    bool m_on;
+    void push(char const * name);
+    void pop();
+public:
+    scoped_profile(char const * name): m_on(s_enabled) {
+        if (m_on) push(name);
+    }
+    ~scoped_profile() {
+        if (m_on) pop();
+    }
+
+    static bool enabled() { return s_enabled; }
+    static void enable(bool f, char const * file);
+    static void reset();
+    static void display(std::ostream & out);
+    static void finalize();
+};
+
+/*
+    ADD_FINALIZER('scoped_profile::finalize();')
+*/
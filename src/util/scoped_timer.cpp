@@ -20,94 +20,192 @@ Revision History:
 --*/
 
 #include "util/scoped_timer.h"
-#include "util/mutex.h"
 #include "util/util.h"
-#include <atomic>
+#include <algorithm>
 #include <chrono>
 #include <climits>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <thread>
-#include <vector>
 #ifndef _WINDOWS
 #include <pthread.h>
 #endif
 
-enum scoped_timer_work_state { IDLE = 0, WORKING = 1, EXITING = 2 };
+/**
+   All timers are served by a single thread using a hashed timing wheel
+   with a resolution of one millisecond. A timer is kept in the slot of
+   its expiry tick modulo the number of slots, so arming and disarming
+   are constant time list operations. The thread sleeps until the
+   earliest known expiry, then visits the slots of the elapsed ticks
+   and dispatches the handlers of the expired timers.
+*/
 
 struct scoped_timer_state {
-    std::thread m_thread;
-    std::timed_mutex m_mutex;
-    event_handler * eh;
-    unsigned ms;
-    std::atomic<scoped_timer_work_state> work;
-    std::condition_variable_any cv;
+    event_handler *      eh = nullptr;
+    uint64_t             expiry = 0;     // tick at which the timer fires
+    bool                 armed = false;
+    scoped_timer_state * prev = nullptr;
+    scoped_timer_state * next = nullptr;
 };
 
-static std::vector<scoped_timer_state*> available_workers;
-static std::mutex workers;
-static atomic<unsigned> num_workers(0);
+namespace {
+    const unsigned num_slots = 1024;      // power of two
+
+    struct timer_wheel {
+        std::mutex                     mux;
+        std::condition_variable        cv;       // wakes the service thread
+        std::condition_variable        done_cv;  // signals the end of a dispatch or of all timers
+        std::thread                    thread;
+        bool                           running = false;
+        bool                           exiting = false;
+        unsigned                       num_armed = 0;
+        uint64_t                       cursor = 0;        // first tick not yet visited
+        uint64_t                       next_expiry = UINT64_MAX;
+        scoped_timer_state *           firing = nullptr;  // timer whose handler is running
+        scoped_timer_state *           slots[num_slots] = { nullptr };
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        uint64_t now() const {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        }
 
-static void thread_func(scoped_timer_state *s) {
-    workers.lock();
-    while (true) {
-        s->cv.wait(workers, [=]{ return s->work != IDLE; });
-        workers.unlock();
+        void link(scoped_timer_state * s) {
+            scoped_timer_state *& head = slots[s->expiry & (num_slots - 1)];
+            s->prev = nullptr;
+            s->next = head;
+            if (head)
+                head->prev = s;
+            head = s;
+            s->armed = true;
+            ++num_armed;
+        }
 
-        if (s->work == EXITING)
-            return;
+        void unlink(scoped_timer_state * s) {
+            if (s->prev)
+                s->prev->next = s->next;
+            else
+                slots[s->expiry & (num_slots - 1)] = s->next;
+            if (s->next)
+                s->next->prev = s->prev;
+            s->prev = s->next = nullptr;
+            s->armed = false;
+            if (--num_armed == 0)
+                done_cv.notify_all();
+        }
 
-        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(s->ms);
+        void arm(scoped_timer_state * s, unsigned ms) {
+            std::unique_lock<std::mutex> lock(mux);
+            if (!running) {
+                running = true;
+                thread = std::thread([this]() { run(); });
+            }
+            uint64_t t = now();
+            if (num_armed == 0)
+                cursor = t;
+            s->expiry = t + ms;
+            link(s);
+            if (s->expiry < next_expiry) {
+                next_expiry = s->expiry;
+                cv.notify_one();
+            }
+        }
 
-        while (!s->m_mutex.try_lock_until(end)) {
-            if (std::chrono::steady_clock::now() >= end) {
+        void disarm(scoped_timer_state * s) {
+            std::unique_lock<std::mutex> lock(mux);
+            if (s->armed)
+                unlink(s);
+            while (firing == s)
+                done_cv.wait(lock);
+        }
+
+        // dispatch the expired timers of the slot of tick t.
+        void fire(uint64_t t, uint64_t now, std::unique_lock<std::mutex> & lock) {
+            scoped_timer_state * s = slots[t & (num_slots - 1)];
+            while (s) {
+                if (s->expiry > now) {
+                    s = s->next;
+                    continue;
+                }
+                unlink(s);
+                firing = s;
+                lock.unlock();
                 s->eh->operator()(TIMEOUT_EH_CALLER);
-                goto next;
+                lock.lock();
+                firing = nullptr;
+                done_cv.notify_all();
+                // the slot may have changed while the lock was released.
+                s = slots[t & (num_slots - 1)];
+            }
+        }
+
+        uint64_t find_next_expiry() const {
+            uint64_t r = UINT64_MAX;
+            if (num_armed == 0)
+                return r;
+            for (unsigned i = 0; i < num_slots; ++i)
+                for (scoped_timer_state * s = slots[i]; s; s = s->next)
+                    r = std::min(r, s->expiry);
+            return r;
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mux);
+            while (!exiting) {
+                if (num_armed == 0) {
+                    next_expiry = UINT64_MAX;
+                    cv.wait(lock);
+                    continue;
+                }
+                uint64_t t = now();
+                if (t < next_expiry) {
+                    cv.wait_until(lock, start + std::chrono::milliseconds(next_expiry));
+                    continue;
+                }
+                uint64_t from = cursor;
+                if (t - from >= num_slots)
+                    from = t - num_slots + 1;
+                for (uint64_t i = from; i <= t; ++i)
+                    fire(i, t, lock);
+                cursor = t + 1;
+                next_expiry = find_next_expiry();
             }
         }
 
-        s->m_mutex.unlock();
+        void stop() {
+            std::unique_lock<std::mutex> lock(mux);
+            while (num_armed > 0 || firing)
+                done_cv.wait(lock);
+            if (!running)
+                return;
+            exiting = true;
+            cv.notify_one();
+            lock.unlock();
+            thread.join();
+            lock.lock();
+            running = false;
+            exiting = false;
+        }
+    };
 
-    next:
-        s->work = IDLE;
-        workers.lock();
+    timer_wheel & get_wheel() {
+        // leaked on purpose: timers may be destroyed during static destruction.
+        static timer_wheel * w = new timer_wheel;
+        return *w;
     }
 }
 
-
 scoped_timer::scoped_timer(unsigned ms, event_handler * eh) {
     if (ms == 0 || ms == UINT_MAX)
         return;
-
-    workers.lock();
-    if (available_workers.empty()) {
-        // start new thead
-        workers.unlock();
-        s = new scoped_timer_state;
-        ++num_workers;
-        init_state(ms, eh);
-        s->m_thread = std::thread(thread_func, s);
-    }
-    else {
-        // re-use existing thread
-        s = available_workers.back();
-        available_workers.pop_back();
-        init_state(ms, eh);
-        workers.unlock();
-        s->cv.notify_one();
-    }
+    init_state(ms, eh);
 }
     
 scoped_timer::~scoped_timer() {
     if (!s)
         return;
-
-    s->m_mutex.unlock();
-    while (s->work == WORKING)
-        std::this_thread::yield();
-    workers.lock();
-    available_workers.push_back(s);
-    workers.unlock();
+    get_wheel().disarm(s);
+    delete s;
 }
 
 void scoped_timer::initialize() {
@@ -121,30 +219,11 @@ void scoped_timer::initialize() {
 }
 
 void scoped_timer::finalize() {
-    unsigned deleted = 0;
-    while (deleted < num_workers) {
-        workers.lock();
-        for (auto w : available_workers) {
-            w->work = EXITING;
-            w->cv.notify_one();
-        }
-        decltype(available_workers) cleanup_workers;
-        std::swap(available_workers, cleanup_workers);
-        workers.unlock();
-
-        for (auto w : cleanup_workers) {
-            ++deleted;
-            w->m_thread.join();
-            delete w;
-        }
-    }
-    num_workers = 0;
-    available_workers.clear();
+    get_wheel().stop();
 }
 
 void scoped_timer::init_state(unsigned ms, event_handler * eh) {
-    s->ms = ms;
+    s = new scoped_timer_state;
     s->eh = eh;
-    s->m_mutex.lock();
-    s->work = WORKING;
+    get_wheel().arm(s, ms);
 }
@@ -23,6 +23,7 @@ Revision History:
 #include "util/debug.h"
 #include "util/util.h"
 #include "util/vector.h"
+#include "util/page.h"
 #include<iomanip>
 #ifdef Z3DEBUG
 # include <iostream>
@@ -37,6 +38,24 @@ small_object_allocator::small_object_allocator(char const * id) {
         m_id = id;
     });
     m_alloc_size = 0;
+    m_arena = huge_page_arenas();
+}
+
+small_object_allocator::chunk * small_object_allocator::mk_chunk() {
+    static_assert(sizeof(chunk) <= ARENA_BLOCK_SIZE, "chunks must fit in arena blocks");
+    if (m_arena)
+        return new (alloc_arena_block()) chunk();
+    return alloc(chunk);
+}
+
+void small_object_allocator::del_chunk(chunk * c) {
+    if (m_arena) {
+        c->~chunk();
+        dealloc_arena_block(c);
+    }
+    else {
+        dealloc(c);
+    }
 }
 
 small_object_allocator::~small_object_allocator() {
@@ -44,7 +63,7 @@ small_object_allocator::~small_object_allocator() {
         chunk * c = m_chunks[i];
         while (c) {
             chunk * next = c->m_next;
-            dealloc(c);
+            del_chunk(c);
             c = next;
         }
     }
@@ -60,7 +79,7 @@ void small_object_allocator::reset() {
         chunk * c = m_chunks[i];
         while (c) {
             chunk * next = c->m_next;
-            dealloc(c);
+            del_chunk(c);
             c = next;
         }
         m_chunks[i] = nullptr;
@@ -133,7 +152,7 @@ void * small_object_allocator::allocate(size_t size) {
             return r;
         }
     }
-    chunk * new_c = alloc(chunk);
+    chunk * new_c = mk_chunk();
     new_c->m_next = c;
     m_chunks[slot_id] = new_c;
     void * r = new_c->m_curr;
@@ -222,7 +241,7 @@ void small_object_allocator::consolidate() {
                 num_free_in_chunk++;
             }
             if (num_free_in_chunk == num_objs_per_chunk) {
-                dealloc(curr_chunk);
+                del_chunk(curr_chunk);
             }
             else {
                 curr_chunk->m_next = last_chunk;
@@ -33,9 +33,12 @@ class small_object_allocator {
         char    m_data[CHUNK_SIZE];
         chunk():m_curr(m_data) {}
     };
+    chunk * mk_chunk();
+    void del_chunk(chunk * c);
     chunk *     m_chunks[NUM_SLOTS];
     void  *     m_free_list[NUM_SLOTS];
     size_t      m_alloc_size;
+    bool        m_arena;  // chunks are taken from the huge page arenas.
 #ifdef Z3DEBUG
     char const * m_id;
 #endif
@@ -138,6 +138,48 @@ std::ostream& statistics::display_smt2(std::ostream & out) const {
     return out;
 }
 
+static void display_json_key(std::ostream & out, char const * key) {
+    if (*key == ':')
+        key++;
+    out << "\"";
+    for (; *key; ++key) {
+        if (*key == '"' || *key == '\\')
+            out << "\\";
+        out << *key;
+    }
+    out << "\"";
+}
+
+/**
+   \brief display the statistics as a single line JSON object.
+*/
+std::ostream& statistics::display_json(std::ostream & out) const {
+    key2val m_u;
+    key2dval m_d;
+    mk_map(m_stats, m_u);
+    mk_map(m_d_stats, m_d);
+    ptr_buffer<char> keys;
+    get_keys(m_u, keys);
+    get_keys(m_d, keys);
+    std::sort(keys.begin(), keys.end(), str_lt());
+    out << "{";
+    for (unsigned i = 0; i < keys.size(); i++) {
+        char * k = keys.get(i);
+        if (i > 0)
+            out << ", ";
+        display_json_key(out, k);
+        unsigned val;
+        if (m_u.find(k, val)) 
+            out << ": " << val;
+        else {
+            double d_val = 0.0;
+            m_d.find(k, d_val);
+            out << ": " << std::fixed << std::setprecision(2) << d_val;
+        }
+    }
+    return out << "}";
+}
+
 std::ostream& statistics::display(std::ostream & out) const {
     INIT_DISPLAY();
 
@@ -243,4 +285,8 @@ void get_memory_statistics(statistics& st) {
 
 void get_rlimit_statistics(reslimit& l, statistics& st) {
     get_uint64_stats(st, "rlimit count", l.count());
+    if (l.max_cancel_latency() > 0) {
+        st.update("cancel latency", l.cancel_latency());
+        st.update("max cancel latency", l.max_cancel_latency());
+    }
 }
@@ -0,0 +1,387 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    swiss_table.h
+
+Abstract:
+
+    Open addressing hash map with control-byte metadata (Swiss table).
+
+    Every slot has a control byte: empty, deleted, or the 7 low bits of
+    the hash-code of its key. Slots are probed in groups of 16: the control
+    bytes of a group are compared with the hash bits of the key at once
+    (with SSE2 when available), and keys are only compared for matching bytes.
+    Lookups of absent keys stop at the first group with an empty slot.
+
+    swiss_obj_map, swiss_u_map and swiss_ptr_addr_map provide the commonly
+    used part of the interface of obj_map, u_map and ptr_addr_map.
+
+--*/
+#pragma once
+
+#include <utility>
+#include "util/memory_manager.h"
+#include "util/hash.h"
+#include "util/debug.h"
+#include "util/util.h"
+#include "util/map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define Z3_SWISS_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+template<typename Key, typename Value, typename HashProc, typename EqProc>
+class swiss_map : private HashProc, private EqProc {
+public:
+    struct key_data {
+        Key    m_key;
+        Value  m_value;
+        key_data(): m_key(), m_value() {}
+        Value const & get_value() const { return m_value; }
+        key_data & get_data() { return *this; }
+        key_data const & get_data() const { return *this; }
+    };
+    typedef key_data entry;
+    typedef Key      key;
+    typedef Value    value;
+
+private:
+    static const unsigned    c_group   = 16;
+    static const signed char c_empty   = -128;
+    static const signed char c_deleted = -2;
+
+    signed char * m_ctrl     = nullptr;
+    key_data *    m_slots    = nullptr;
+    unsigned      m_capacity = 0;
+    unsigned      m_size     = 0;
+    unsigned      m_deleted  = 0;
+
+    static unsigned first_bit(unsigned mask) {
+        SASSERT(mask != 0);
+#ifdef _MSC_VER
+        unsigned long r;
+        _BitScanForward(&r, mask);
+        return r;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    /**
+       \brief Return the mask of the control bytes of the group at c that are equal to h.
+    */
+    static unsigned match(signed char const * c, signed char h) {
+#ifdef Z3_SWISS_SSE2
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const *>(c));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h))));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < c_group; ++i)
+            if (c[i] == h)
+                r |= 1u << i;
+        return r;
+#endif
+    }
+
+    /**
+       \brief Return the mask of the empty or deleted control bytes of the group at c.
+       These are exactly the bytes with the sign bit set.
+    */
+    static unsigned match_free(signed char const * c) {
+#ifdef Z3_SWISS_SSE2
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(c))));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < c_group; ++i)
+            if (c[i] < 0)
+                r |= 1u << i;
+        return r;
+#endif
+    }
+
+    /**
+       \brief Hash-codes of z3 keys are often weak in the low bits (e.g., u_hash is the identity).
+       They are mixed because the low 7 bits are stored in the control byte and
+       the next bits select the group.
+    */
+    unsigned get_hash(Key const & k) const {
+        unsigned h = HashProc::operator()(k) * 0x9e3779b1u;
+        return h ^ (h >> 15);
+    }
+
+    static signed char h2(unsigned h) { return static_cast<signed char>(h & 0x7f); }
+
+    unsigned group_mask() const { return (m_capacity / c_group) - 1; }
+
+    key_data * find_core(Key const & k, unsigned h) const {
+        if (m_capacity == 0)
+            return nullptr;
+        unsigned mask = group_mask();
+        unsigned g    = (h >> 7) & mask;
+        signed char b = h2(h);
+        for (unsigned i = 1; ; ++i) {
+            signed char const * c = m_ctrl + g * c_group;
+            for (unsigned m = match(c, b); m != 0; m &= m - 1) {
+                key_data * s = m_slots + g * c_group + first_bit(m);
+                if (EqProc::operator()(s->m_key, k))
+                    return s;
+            }
+            if (match(c, c_empty) != 0)
+                return nullptr;
+            g = (g + i) & mask; // triangular probing visits every group.
+        }
+    }
+
+    /**
+       \brief Return the index of the first free slot on the probe sequence of h.
+    */
+    unsigned find_free(unsigned h) const {
+        unsigned mask = group_mask();
+        unsigned g    = (h >> 7) & mask;
+        for (unsigned i = 1; ; ++i) {
+            unsigned m = match_free(m_ctrl + g * c_group);
+            if (m != 0)
+                return g * c_group + first_bit(m);
+            g = (g + i) & mask;
+        }
+    }
+
+    void alloc_table(unsigned capacity) {
+        SASSERT(capacity % c_group == 0);
+        m_capacity = capacity;
+        m_ctrl     = static_cast<signed char *>(memory::allocate(capacity));
+        for (unsigned i = 0; i < capacity; ++i)
+            m_ctrl[i] = c_empty;
+        m_slots    = alloc_vect<key_data>(capacity);
+        m_size     = 0;
+        m_deleted  = 0;
+    }
+
+    void dealloc_table() {
+        if (m_capacity == 0)
+            return;
+        memory::deallocate(m_ctrl);
+        dealloc_vect(m_slots, m_capacity);
+        m_ctrl     = nullptr;
+        m_slots    = nullptr;
+        m_capacity = 0;
+    }
+
+    void rehash(unsigned capacity) {
+        signed char * old_ctrl  = m_ctrl;
+        key_data *    old_slots = m_slots;
+        unsigned      old_cap   = m_capacity;
+        alloc_table(capacity);
+        for (unsigned i = 0; i < old_cap; ++i) {
+            if (old_ctrl[i] < 0)
+                continue;
+            unsigned h = get_hash(old_slots[i].m_key);
+            unsigned j = find_free(h);
+            m_ctrl[j]  = h2(h);
+            m_slots[j] = std::move(old_slots[i]);
+            m_size++;
+        }
+        if (old_cap > 0) {
+            memory::deallocate(old_ctrl);
+            dealloc_vect(old_slots, old_cap);
+        }
+    }
+
+    /**
+       \brief Make room for one more key: at most 7/8 of the slots are used or deleted.
+    */
+    void reserve_one() {
+        if (m_capacity == 0) {
+            alloc_table(c_group);
+            return;
+        }
+        if (8 * (m_size + m_deleted + 1) <= 7 * m_capacity)
+            return;
+        // reclaim deleted slots if they make up a large part of the table.
+        rehash(2 * m_size + 2 < m_capacity ? m_capacity : 2 * m_capacity);
+    }
+
+    key_data * insert_core(Key const & k, bool & is_new) {
+        unsigned h = get_hash(k);
+        key_data * s = find_core(k, h);
+        if (s) {
+            is_new = false;
+            return s;
+        }
+        reserve_one();
+        unsigned j = find_free(h);
+        if (m_ctrl[j] == c_deleted)
+            m_deleted--;
+        m_ctrl[j] = h2(h);
+        m_slots[j].m_key = k;
+        m_size++;
+        is_new = true;
+        return m_slots + j;
+    }
+
+public:
+    class iterator {
+        swiss_map const * m_map;
+        unsigned          m_idx;
+        void skip() { while (m_idx < m_map->m_capacity && m_map->m_ctrl[m_idx] < 0) ++m_idx; }
+    public:
+        iterator(swiss_map const * map, unsigned idx): m_map(map), m_idx(idx) { skip(); }
+        key_data & operator*() const { return m_map->m_slots[m_idx]; }
+        key_data * operator->() const { return m_map->m_slots + m_idx; }
+        iterator & operator++() { ++m_idx; skip(); return *this; }
+        bool operator==(iterator const & other) const { return m_idx == other.m_idx; }
+        bool operator!=(iterator const & other) const { return m_idx != other.m_idx; }
+    };
+
+    swiss_map(HashProc const & h = HashProc(), EqProc const & e = EqProc()):
+        HashProc(h),
+        EqProc(e) {
+    }
+
+    swiss_map(swiss_map const & other):
+        HashProc(other),
+        EqProc(other) {
+        for (auto const & kv : other)
+            insert(kv.m_key, kv.m_value);
+    }
+
+    swiss_map & operator=(swiss_map const & other) = delete;
+
+    ~swiss_map() {
+        dealloc_table();
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, m_capacity); }
+
+    unsigned size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    unsigned capacity() const { return m_capacity; }
+
+    void reset() {
+        if (m_size == 0 && m_deleted == 0)
+            return;
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0)
+                m_slots[i] = key_data();
+            m_ctrl[i] = c_empty;
+        }
+        m_size    = 0;
+        m_deleted = 0;
+    }
+
+    void finalize() {
+        dealloc_table();
+        m_size    = 0;
+        m_deleted = 0;
+    }
+
+    void insert(Key const & k, Value const & v) {
+        bool is_new;
+        insert_core(k, is_new)->m_value = v;
+    }
+
+    void insert(Key const & k, Value && v) {
+        bool is_new;
+        insert_core(k, is_new)->m_value = std::move(v);
+    }
+
+    Value & insert_if_not_there(Key const & k, Value const & v) {
+        bool is_new;
+        key_data * s = insert_core(k, is_new);
+        if (is_new)
+            s->m_value = v;
+        return s->m_value;
+    }
+
+    entry * insert_if_not_there3(Key const & k, Value const & v) {
+        bool is_new;
+        key_data * s = insert_core(k, is_new);
+        if (is_new)
+            s->m_value = v;
+        return s;
+    }
+
+    entry * find_core(Key const & k) const {
+        return find_core(k, get_hash(k));
+    }
+
+    bool find(Key const & k, Value & v) const {
+        key_data * s = find_core(k);
+        if (s)
+            v = s->m_value;
+        return s != nullptr;
+    }
+
+    Value const & find(Key const & k) const {
+        key_data * s = find_core(k);
+        SASSERT(s);
+        return s->m_value;
+    }
+
+    Value & find(Key const & k) {
+        key_data * s = find_core(k);
+        SASSERT(s);
+        return s->m_value;
+    }
+
+    Value const & get(Key const & k, Value const & default_value) const {
+        key_data * s = find_core(k);
+        return s ? s->m_value : default_value;
+    }
+
+    Value const & operator[](Key const & k) const { return find(k); }
+
+    Value & operator[](Key const & k) { return find(k); }
+
+    bool contains(Key const & k) const {
+        return find_core(k) != nullptr;
+    }
+
+    void remove(Key const & k) {
+        key_data * s = find_core(k);
+        if (!s)
+            return;
+        unsigned j = static_cast<unsigned>(s - m_slots);
+        *s = key_data();
+        // a slot can become empty again if its group was never full,
+        // since then no probe sequence continued past this group.
+        unsigned g = j - j % c_group;
+        if (match(m_ctrl + g, c_empty) != 0) {
+            m_ctrl[j] = c_empty;
+        }
+        else {
+            m_ctrl[j] = c_deleted;
+            m_deleted++;
+        }
+        m_size--;
+    }
+
+    void erase(Key const & k) {
+        remove(k);
+    }
+
+    void swap(swiss_map & other) noexcept {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_deleted, other.m_deleted);
+    }
+};
+
+template<typename Key, typename Value>
+class swiss_obj_map : public swiss_map<Key *, Value, obj_ptr_hash<Key>, ptr_eq<Key> > {};
+
+template<typename Value>
+class swiss_u_map : public swiss_map<unsigned, Value, u_hash, u_eq> {};
+
+template<typename Key, typename Value>
+class swiss_ptr_addr_map : public swiss_map<Key *, Value, ptr_hash<Key>, ptr_eq<Key> > {};
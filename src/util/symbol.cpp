@@ -35,36 +35,33 @@ const symbol symbol::null;
 
 /**
    \brief Symbol table manager. It stores the symbol strings created at runtime.
+
+   Strings are stored in a region, preceded by their hash-code.
 */
 namespace {
+
+char const * mk_symbol_str(region & r, char const * d, size_t l, size_t h) {
+    // store the hash-code before the string
+    size_t * mem = static_cast<size_t*>(r.allocate(l + 1 + sizeof(size_t)));
+    *mem = h;
+    mem++;
+    memcpy(mem, d, l+1);
+    return reinterpret_cast<const char*>(mem);
+}
+
+#ifdef SINGLE_THREAD
 class internal_symbol_table {
     region        m_region; //!< Region used to store symbol strings.
     str_hashtable m_table;  //!< Table of created symbol strings.
-    DECLARE_MUTEX(lock);
     
 public:
 
-    internal_symbol_table() {
-        ALLOC_MUTEX(lock);
-    }
-
-    ~internal_symbol_table() {
-        DEALLOC_MUTEX(lock);
-    }
-
     char const * get_str(char const * d) {
         const char * result;
-        lock_guard _lock(*lock);
         str_hashtable::entry * e;
         if (m_table.insert_if_not_there_core(d, e)) {
             // new entry
-            size_t l   = strlen(d);
-            // store the hash-code before the string
-            size_t * mem = static_cast<size_t*>(m_region.allocate(l + 1 + sizeof(size_t)));
-            *mem = e->get_hash();
-            mem++;
-            result = reinterpret_cast<const char*>(mem);
-            memcpy(mem, d, l+1);
+            result = mk_symbol_str(m_region, d, strlen(d), e->get_hash());
             // update the entry with the new ptr.
             e->set_data(result);
         }
@@ -75,6 +72,95 @@ public:
         return result;
     }
 };
+#else
+/**
+   \brief Open addressing table of symbol strings.
+   
+   Lookups do not take the lock: slots are only ever filled (never cleared), and
+   a slot is published after the string it points to is written.
+   Insertions take the lock and search the table again before adding the string.
+   When the table grows, the new slot array is published and the old one is kept
+   alive until the table is destroyed, so concurrent readers of the old array
+   are safe. A reader that misses a string inserted concurrently falls back to
+   the locked path.
+*/
+class internal_symbol_table {
+    struct slots {
+        unsigned                         m_capacity;
+        std::atomic<char const *> *      m_data;
+        slots *                          m_prev;
+        slots(unsigned capacity, slots * prev):
+            m_capacity(capacity),
+            m_data(alloc_vect<std::atomic<char const *>>(capacity)),
+            m_prev(prev) {}
+        ~slots() { dealloc_vect(m_data, m_capacity); }
+    };
+    region                    m_region; //!< Region used to store symbol strings.
+    std::atomic<slots *>      m_slots;
+    unsigned                  m_size = 0;
+    mutex                     m_lock;
+
+    static size_t get_hash(char const * s) {
+        return reinterpret_cast<size_t const *>(s)[-1];
+    }
+
+    static char const * find(slots const * t, char const * d, unsigned h) {
+        unsigned mask = t->m_capacity - 1;
+        for (unsigned i = hash_u(h) & mask; ; i = (i + 1) & mask) {
+            char const * s = t->m_data[i].load(std::memory_order_acquire);
+            if (!s || (get_hash(s) == h && strcmp(s, d) == 0))
+                return s;
+        }
+    }
+
+    static void insert(slots * t, char const * s) {
+        unsigned mask = t->m_capacity - 1;
+        unsigned i = hash_u(static_cast<unsigned>(get_hash(s))) & mask;
+        while (t->m_data[i].load(std::memory_order_relaxed))
+            i = (i + 1) & mask;
+        t->m_data[i].store(s, std::memory_order_release);
+    }
+
+    slots * grow(slots * t) {
+        slots * n = alloc(slots, 2 * t->m_capacity, t);
+        for (unsigned i = 0; i < t->m_capacity; ++i)
+            if (char const * s = t->m_data[i].load(std::memory_order_relaxed))
+                insert(n, s);
+        m_slots.store(n, std::memory_order_release);
+        return n;
+    }
+    
+public:
+
+    internal_symbol_table(): m_slots(alloc(slots, 256, nullptr)) {}
+
+    ~internal_symbol_table() {
+        slots * t = m_slots.load();
+        while (t) {
+            slots * prev = t->m_prev;
+            dealloc(t);
+            t = prev;
+        }
+    }
+
+    char const * get_str(char const * d, size_t l, unsigned h) {
+        char const * result = find(m_slots.load(std::memory_order_acquire), d, h);
+        if (result)
+            return result;
+        lock_guard _lock(m_lock);
+        slots * t = m_slots.load(std::memory_order_relaxed);
+        result = find(t, d, h);
+        if (result)
+            return result;
+        if (2 * (m_size + 1) > t->m_capacity)
+            t = grow(t);
+        result = mk_symbol_str(m_region, d, l, h);
+        insert(t, result);
+        m_size++;
+        return result;
+    }
+};
+#endif
 }
 
 #ifdef SINGLE_THREAD
@@ -109,8 +195,10 @@ struct internal_symbol_tables {
     }
 
     char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
+        // the hash-code is computed once: it selects the table and it is stored with the string.
+        size_t l = strlen(d);
+        unsigned h = string_hash(d, static_cast<unsigned>(l), 17);
+        return tables[h % sz]->get_str(d, l, h);
     }
 };
 
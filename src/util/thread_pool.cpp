@@ -0,0 +1,256 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.cpp
+
+Abstract:
+
+    Process wide cache of worker threads.
+
+--*/
+
+#include "util/thread_pool.h"
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#ifndef _WINDOWS
+#include <pthread.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#endif
+
+struct thread_pool_worker {
+    std::thread             m_thread;
+    std::condition_variable m_cv;
+    std::function<void()>   m_task;   // protected by workers
+    unsigned                m_id = 0;
+    bool                    m_pinned = false;
+    bool                    m_exit = false;  // protected by workers
+};
+
+static std::vector<thread_pool_worker*> idle_workers;
+static std::vector<thread_pool_worker*> all_workers;  // protected by workers
+static std::mutex workers;
+static unsigned num_workers = 0;      // protected by workers
+static bool affinity = false;
+static std::vector<unsigned> cpus;   // cores in the order they are assigned to workers
+
+#ifdef __linux__
+/**
+   \brief Return the cores the process may run on, grouped by NUMA node.
+*/
+static std::vector<unsigned> numa_cpu_order() {
+    std::vector<unsigned> result;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return result;
+    std::vector<bool> seen(CPU_SETSIZE, false);
+    auto add = [&](unsigned cpu) {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed) && !seen[cpu]) {
+            seen[cpu] = true;
+            result.push_back(cpu);
+        }
+    };
+    // node cpulists have the form 0-15,64-79
+    for (unsigned node = 0; ; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in)
+            break;
+        std::string range;
+        while (std::getline(in, range, ',')) {
+            unsigned lo = 0, hi = 0;
+            int n = sscanf(range.c_str(), "%u-%u", &lo, &hi);
+            if (n < 1)
+                continue;
+            if (n == 1)
+                hi = lo;
+            for (unsigned cpu = lo; cpu <= hi; ++cpu)
+                add(cpu);
+        }
+    }
+    // cores that are not listed under a node, e.g., when sysfs is not mounted.
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        add(cpu);
+    return result;
+}
+
+static void pin_worker(thread_pool_worker* w) {
+    w->m_pinned = true;
+    if (cpus.size() <= 1)
+        return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[(w->m_id + 1) % cpus.size()], &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+#else
+static void pin_worker(thread_pool_worker* w) {
+    w->m_pinned = true;
+}
+#endif
+
+static void worker_func(thread_pool_worker* w) {
+    std::unique_lock<std::mutex> lock(workers);
+    while (true) {
+        w->m_cv.wait(lock, [=]{ return w->m_exit || (bool)w->m_task; });
+        if (w->m_exit)
+            return;
+        std::function<void()> task = std::move(w->m_task);
+        w->m_task = nullptr;
+        if (affinity && !w->m_pinned)
+            pin_worker(w);
+        lock.unlock();
+        task();
+        task = nullptr;
+        lock.lock();
+        if (w->m_exit)
+            return;
+        idle_workers.push_back(w);
+    }
+}
+
+static void start_task(std::function<void()> task) {
+    thread_pool_worker* w = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(workers);
+        if (!idle_workers.empty()) {
+            w = idle_workers.back();
+            idle_workers.pop_back();
+            w->m_task = std::move(task);
+        }
+    }
+    if (w) {
+        w->m_cv.notify_one();
+        return;
+    }
+    w = new thread_pool_worker;
+    w->m_task = std::move(task);
+    {
+        std::lock_guard<std::mutex> lock(workers);
+        w->m_id = num_workers++;
+    }
+    w->m_thread = std::thread(worker_func, w);
+    std::lock_guard<std::mutex> lock(workers);
+    all_workers.push_back(w);
+}
+
+namespace thread_pool {
+
+    void run(unsigned n, std::function<void(unsigned)> const& f) {
+        if (n == 0)
+            return;
+        std::mutex done_mux;
+        std::condition_variable done_cv;
+        unsigned pending = n - 1;
+        std::exception_ptr ex;  // first exception thrown by another thread
+
+        {
+            // wait for the other threads also when f(0) throws:
+            // they refer to f and to the locals of this frame.
+            struct wait_all {
+                std::mutex& mux;
+                std::condition_variable& cv;
+                unsigned& pending;
+                ~wait_all() {
+                    std::unique_lock<std::mutex> lock(mux);
+                    cv.wait(lock, [&]{ return pending == 0; });
+                }
+            };
+            wait_all _wait{ done_mux, done_cv, pending };
+
+            for (unsigned i = 1; i < n; ++i) {
+                start_task([&, i]() {
+                    std::exception_ptr e;
+                    try {
+                        f(i);
+                    }
+                    catch (...) {
+                        e = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> lock(done_mux);
+                    if (e && !ex)
+                        ex = e;
+                    --pending;
+                    done_cv.notify_one();
+                });
+            }
+            f(0);
+        }
+        if (ex)
+            std::rethrow_exception(ex);
+    }
+
+    void set_affinity(bool f) {
+        // workers that are already pinned keep their core.
+        std::lock_guard<std::mutex> lock(workers);
+        affinity = f;
+#ifdef __linux__
+        if (f && cpus.empty())
+            cpus = numa_cpu_order();
+#endif
+    }
+
+    void initialize() {
+#ifndef _WINDOWS
+        static bool pthread_atfork_set = false;
+        if (!pthread_atfork_set) {
+            // threads do not survive fork. Another thread may have held the
+            // lock when fork ran, so the child only resets the state.
+            pthread_atfork(nullptr, nullptr, []() {
+                new (&workers) std::mutex();
+                idle_workers.clear();
+                all_workers.clear();
+            });
+            pthread_atfork_set = true;
+        }
+#endif
+    }
+
+    void finalize() {
+        std::vector<thread_pool_worker*> ws;
+        {
+            std::lock_guard<std::mutex> lock(workers);
+            ws.swap(all_workers);
+            idle_workers.clear();
+            for (thread_pool_worker* w : ws) {
+                w->m_exit = true;
+                w->m_cv.notify_one();
+            }
+        }
+        for (thread_pool_worker* w : ws) {
+            w->m_thread.join();
+            delete w;
+        }
+    }
+
+};
+
+#else
+
+namespace thread_pool {
+
+    void run(unsigned n, std::function<void(unsigned)> const& f) {
+        for (unsigned i = 0; i < n; ++i)
+            f(i);
+    }
+
+    void set_affinity(bool f) {}
+
+    void initialize() {}
+
+    void finalize() {}
+
+};
+
+#endif
@@ -0,0 +1,50 @@
+/*++
+Copyright (c) 2024 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.h
+
+Abstract:
+
+    Process wide cache of worker threads.
+
+    thread_pool::run(n, f) executes f(0), ..., f(n-1) concurrently, each
+    call on its own thread, and returns once all of them are done. f(0)
+    runs on the calling thread. The other calls run on threads that are
+    kept idle after they finish and are reused by later calls, so parallel
+    tactics and solvers do not pay for thread creation on every invocation.
+    New threads are started when no idle thread is available, so nested
+    calls cannot starve each other. An exception thrown by f(i) on another
+    thread is rethrown by run once all calls have finished.
+
+    thread_pool::finalize() stops and joins the threads. It is called by
+    memory::finalize on shutdown.
+
+    When affinity is enabled, every worker thread is pinned to its own
+    core (Linux only). Cores are handed out one NUMA node after the other,
+    skipping the first core, which is left to the calling thread, so up to
+    the size of a node all workers share its memory. Memory first touched
+    by a pinned worker, in particular its huge page arenas, is then placed
+    on the worker's node.
+
+--*/
+#pragma once
+
+#include <functional>
+
+namespace thread_pool {
+
+    void run(unsigned n, std::function<void(unsigned)> const& f);
+
+    void set_affinity(bool f);
+
+    void initialize();
+
+    void finalize();
+
+};
+
+/*
+    ADD_INITIALIZER('thread_pool::initialize();')
+*/
@@ -22,7 +22,10 @@ Revision History:
 #include "util/region.h"
 #include "util/obj_ref.h"
 #include "util/vector.h"
+#include <cstring>
+#include <type_traits>
 
+class typed_trail;
 
 class trail {
 public:
@@ -32,6 +35,7 @@ public:
 
 template<typename T>
 class value_trail : public trail {
+    friend class typed_trail;
     T & m_value;
     T   m_old_value;
 
@@ -73,6 +77,7 @@ public:
 
 
 class reset_flag_trail : public trail {
+    friend class typed_trail;
     bool & m_value;
 public:
     reset_flag_trail(bool & value):
@@ -100,6 +105,7 @@ public:
 
 template<typename T, bool CallDestructors=true>
 class restore_size_trail : public trail {
+    friend class typed_trail;
     vector<T, CallDestructors> & m_vector;
     unsigned                     m_old_size;
 public:
@@ -207,6 +213,7 @@ public:
 
 template<typename V>
 class push_back_vector : public trail {
+    friend class typed_trail;
     V & m_vector;
 public:
     push_back_vector(V & v):
@@ -270,6 +277,7 @@ public:
 
 template<typename T, bool CallDestructors=true>
 class push_back_trail : public trail {
+    friend class typed_trail;
     vector<T, CallDestructors> & m_vector;
 public:
     push_back_trail(vector<T, CallDestructors> & v):
@@ -379,6 +387,130 @@ public:
 };
 
 
+/**
+   \brief Stack of undo entries.
+   The common trail objects (value_trail of small trivially copyable values,
+   reset_flag_trail, push_back_vector, push_back_trail and restore_size_trail)
+   are stored inline as tagged entries. They are not allocated, and they are
+   undone in a single loop without virtual calls.
+   Other trail objects are stored by pointer.
+*/
+class typed_trail {
+    enum kind : unsigned char { TRAIL, VALUE, RESET_FLAG, VECTOR };
+    typedef void (*vector_undo)(void * v, unsigned old_size);
+    struct entry {
+        void *       m_addr;      // trail object, value or vector
+        union {
+            uint64_t    m_bits;   // saved value
+            vector_undo m_undo;   // undo of a vector update
+        };
+        unsigned     m_aux;       // size of the saved value or old size of the vector
+        kind         m_kind;
+    };
+    svector<entry> m_entries;
+
+    void push_entry(void * addr, kind k, unsigned aux) {
+        m_entries.push_back(entry());
+        entry & e = m_entries.back();
+        e.m_addr = addr;
+        e.m_bits = 0;
+        e.m_aux  = aux;
+        e.m_kind = k;
+    }
+
+public:
+    unsigned size() const { return m_entries.size(); }
+
+    void push_ptr(trail * t) { push_entry(t, TRAIL, 0); }
+
+    /**
+       \brief Record the current value of v.
+    */
+    template<typename T>
+    void push_value(T & v) {
+        static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(uint64_t), "value is not stored inline");
+        push_entry(&v, VALUE, sizeof(T));
+        memcpy(&m_entries.back().m_bits, &v, sizeof(T));
+    }
+
+    void push_reset_flag(bool & f) { push_entry(&f, RESET_FLAG, 0); }
+
+    /**
+       \brief Record that an element was pushed to v.
+    */
+    template<typename V>
+    void push_pop_back(V & v) {
+        push_entry(&v, VECTOR, 0);
+        m_entries.back().m_undo = [](void * v, unsigned) { static_cast<V *>(v)->pop_back(); };
+    }
+
+    template<typename V>
+    void push_shrink(V & v, unsigned old_size) {
+        push_entry(&v, VECTOR, old_size);
+        m_entries.back().m_undo = [](void * v, unsigned sz) { static_cast<V *>(v)->shrink(sz); };
+    }
+
+    /**
+       \brief Store obj inline if it is one of the common trail objects.
+       Return false if obj must be stored by pointer.
+    */
+    template<typename TrailObject>
+    bool push_typed(TrailObject const & obj) { return false; }
+
+    template<typename T>
+    bool push_typed(value_trail<T> const & obj) {
+        if constexpr (std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(uint64_t)) {
+            push_value(obj.m_value);
+            memcpy(&m_entries.back().m_bits, &obj.m_old_value, sizeof(T));
+            return true;
+        }
+        return false;
+    }
+
+    bool push_typed(reset_flag_trail const & obj) { push_reset_flag(obj.m_value); return true; }
+
+    template<typename V>
+    bool push_typed(push_back_vector<V> const & obj) { push_pop_back(obj.m_vector); return true; }
+
+    template<typename T, bool CallDestructors>
+    bool push_typed(push_back_trail<T, CallDestructors> const & obj) { push_pop_back(obj.m_vector); return true; }
+
+    template<typename T, bool CallDestructors>
+    bool push_typed(restore_size_trail<T, CallDestructors> const & obj) { push_shrink(obj.m_vector, obj.m_old_size); return true; }
+
+    /**
+       \brief Undo the entries above old_size, most recent first.
+    */
+    void undo(unsigned old_size) {
+        SASSERT(old_size <= m_entries.size());
+        entry * begin = m_entries.data() + old_size;
+        entry * it    = m_entries.data() + m_entries.size();
+        while (it != begin) {
+            --it;
+            switch (it->m_kind) {
+            case TRAIL:
+                static_cast<trail *>(it->m_addr)->undo();
+                break;
+            case VALUE:
+                memcpy(it->m_addr, &it->m_bits, it->m_aux);
+                break;
+            case RESET_FLAG:
+                *static_cast<bool *>(it->m_addr) = false;
+                break;
+            case VECTOR:
+                it->m_undo(it->m_addr, it->m_aux);
+                break;
+            }
+        }
+        m_entries.shrink(old_size);
+    }
+
+    /**
+       \brief Drop the entries above old_size without undoing them.
+    */
+    void shrink(unsigned old_size) { m_entries.shrink(old_size); }
+};
+
 inline void undo_trail_stack(ptr_vector<trail> & s, unsigned old_size) {
     SASSERT(old_size <= s.size());
     typename ptr_vector<trail >::iterator begin = s.begin() + old_size;
@@ -391,7 +523,7 @@ inline void undo_trail_stack(ptr_vector<trail> & s, unsigned old_size) {
 }
 
 class trail_stack {
-    ptr_vector<trail>       m_trail_stack;
+    typed_trail             m_trail_stack;
     unsigned_vector         m_scopes;
     region                  m_region;
 public:
@@ -400,13 +532,16 @@ public:
     void reset() {
         pop_scope(m_scopes.size());
         // Undo trail objects stored at lvl 0 (avoid memory leaks if lvl 0 contains new_obj_trail objects).
-        undo_trail_stack(m_trail_stack, 0);
+        m_trail_stack.undo(0);
     }
 
-    void push_ptr(trail * t) { m_trail_stack.push_back(t); }
+    void push_ptr(trail * t) { m_trail_stack.push_ptr(t); }
 
     template<typename TrailObject>
-    void push(TrailObject const & obj) { m_trail_stack.push_back(new (m_region) TrailObject(obj)); }
+    void push(TrailObject const & obj) {
+        if (!m_trail_stack.push_typed(obj))
+            m_trail_stack.push_ptr(new (m_region) TrailObject(obj));
+    }
 
     unsigned get_num_scopes() const { return m_scopes.size(); }
 
@@ -418,7 +553,7 @@ public:
         SASSERT(num_scopes <= lvl);
         unsigned new_lvl  = lvl - num_scopes;
         unsigned old_size = m_scopes[new_lvl];
-        undo_trail_stack(m_trail_stack, old_size);
+        m_trail_stack.undo(old_size);
         m_scopes.shrink(new_lvl);
         m_region.pop_scope(num_scopes);
     }
@@ -22,8 +22,20 @@ Revision History:
 
 
     
+/**
+   \brief Queue of decision variables.
+
+   By default the queue is a heap ordered by activity (VSIDS).
+   In VMTF mode (variable move-to-front) it is a list ordered by the time
+   of the last bump: a bumped variable is moved to the front of the list
+   in constant time. Every queued variable is at or behind the search
+   position m_search, so the next variable is found by walking backwards
+   from m_search.
+   The client maintains activities in both modes, so the queue can switch mode.
+*/
 class var_queue {
     typedef unsigned var;
+    static constexpr var null_var = UINT_MAX;
 
     struct lt {
         svector<unsigned> & m_activity;
@@ -31,18 +43,119 @@ class var_queue {
         bool operator()(var v1, var v2) const { return m_activity[v1] > m_activity[v2]; }
     };
     heap<lt>  m_queue;
+    svector<unsigned> & m_activity;
+    bool_vector         m_exists;   // created and not deleted
+
+    // VMTF state
+    bool              m_vmtf = false;
+    svector<var>      m_prev;     // towards less recently bumped variables
+    svector<var>      m_next;     // towards more recently bumped variables
+    svector<uint64_t> m_stamp;    // time of the last bump
+    bool_vector       m_removed;  // returned by next_var and not unassigned since
+    var               m_last   = null_var;
+    var               m_search = null_var;
+    uint64_t          m_counter = 0;
+
+    bool exists(var v) const { return v < m_exists.size() && m_exists[v]; }
+
+    void unlink(var v) {
+        var p = m_prev[v], n = m_next[v];
+        if (p != null_var) m_next[p] = n;
+        if (n == null_var) m_last = p; else m_prev[n] = p;
+        if (m_search == v) {
+            m_search = p;
+            skip_removed();
+        }
+    }
+
+    void link_last(var v) {
+        m_prev.reserve(v + 1, null_var);
+        m_next.reserve(v + 1, null_var);
+        m_stamp.reserve(v + 1, 0);
+        m_removed.reserve(v + 1, false);
+        m_prev[v] = m_last;
+        m_next[v] = null_var;
+        if (m_last != null_var) m_next[m_last] = v;
+        m_last = v;
+        m_stamp[v] = ++m_counter;
+    }
+
+    void skip_removed() {
+        while (m_search != null_var && m_removed[m_search])
+            m_search = m_prev[m_search];
+    }
+
+    void bump(var v) {
+        if (!exists(v) || v == m_last)
+            return;
+        unlink(v);
+        link_last(v);
+        if (!m_removed[v])
+            m_search = v;
+    }
+
+    void reset_vmtf() {
+        m_prev.reset();
+        m_next.reset();
+        m_stamp.reset();
+        m_removed.reset();
+        m_last = m_search = null_var;
+        m_counter = 0;
+    }
+
 public:
 
     
-    var_queue(svector<unsigned> & act):m_queue(128, lt(act)) {}
+    var_queue(svector<unsigned> & act):m_queue(128, lt(act)), m_activity(act) {}
+
+    bool is_vmtf() const { return m_vmtf; }
+
+    /**
+       \brief Switch between the activity heap and VMTF.
+       When switching to VMTF the list is ordered by activity.
+    */
+    void set_vmtf(bool f) {
+        if (f == m_vmtf)
+            return;
+        svector<var> vars;
+        for (var v = 0; v < m_exists.size(); ++v)
+            if (m_exists[v])
+                vars.push_back(v);
+        if (f) {
+            std::stable_sort(vars.begin(), vars.end(), [&](var a, var b) { return m_activity[a] < m_activity[b]; });
+            reset_vmtf();
+            for (var v : vars) {
+                link_last(v);
+                m_removed[v] = !m_queue.contains(v);
+            }
+            m_queue.reset();
+            m_search = m_last;
+            skip_removed();
+        }
+        else {
+            m_queue.reset();
+            m_queue.reserve(m_exists.size());
+            for (var v : vars)
+                if (!m_removed[v])
+                    m_queue.insert(v);
+            reset_vmtf();
+        }
+        m_vmtf = f;
+    }
     
     void activity_increased_eh(var v) {
-        if (m_queue.contains(v))
+        if (m_vmtf)
+            bump(v);
+        else if (m_queue.contains(v))
             m_queue.decreased(v);
     }
     
     void activity_changed_eh(var v, bool up) {
-        if (m_queue.contains(v)) {
+        if (m_vmtf) {
+            if (up)
+                bump(v);
+        }
+        else if (m_queue.contains(v)) {
             if (up) 
                 m_queue.decreased(v);
             else 
@@ -51,30 +164,59 @@ public:
     }
     
     void mk_var_eh(var v) {
+        m_exists.reserve(v + 1, false);
+        m_exists[v] = true;
+        if (m_vmtf) {
+            link_last(v);
+            m_removed[v] = false;
+            m_search = v;
+            return;
+        }
         m_queue.reserve(v+1);
         m_queue.insert(v);
     }
     
     void del_var_eh(var v) {
-        if (m_queue.contains(v))
+        if (!exists(v))
+            return;
+        m_exists[v] = false;
+        if (m_vmtf)
+            unlink(v);
+        else if (m_queue.contains(v))
             m_queue.erase(v);
     }
     
     void unassign_var_eh(var v) {
-        if (!m_queue.contains(v))
+        if (m_vmtf) {
+            if (exists(v) && m_removed[v]) {
+                m_removed[v] = false;
+                if (m_search == null_var || m_stamp[v] > m_stamp[m_search])
+                    m_search = v;
+            }
+        }
+        else if (!m_queue.contains(v))
             m_queue.insert(v);
     }
     
     void reset() {
         m_queue.reset();
+        m_exists.reset();
+        reset_vmtf();
     }
     
-    bool empty() const { return m_queue.empty(); }
+    bool empty() const { return m_vmtf ? m_search == null_var : m_queue.empty(); }
     
-    var next_var() { SASSERT(!empty()); return m_queue.erase_min(); }
+    var next_var() {
+        SASSERT(!empty());
+        if (!m_vmtf)
+            return m_queue.erase_min();
+        var v = m_search;
+        m_removed[v] = true;
+        skip_removed();
+        return v;
+    }
     
-    var min_var() { SASSERT(!empty()); return m_queue.min_value(); }
+    var min_var() { SASSERT(!empty()); return m_vmtf ? m_search : m_queue.min_value(); }
     
-    bool more_active(var v1, var v2) const { return m_queue.less_than(v1, v2); }
+    bool more_active(var v1, var v2) const { return m_vmtf ? m_stamp[v1] > m_stamp[v2] : m_queue.less_than(v1, v2); }
 };
-
@@ -71,17 +71,87 @@ bool zstring::is_escape_char(char const *& s, unsigned& result) {
     return false;
 }
 
+void zstring::init(unsigned sz, uint32_t const* s) {
+    SASSERT(!m_rep);
+    m_offset = 0;
+    m_length = sz;
+    if (sz == 0)
+        return;
+    bool wide = false;
+    for (unsigned i = 0; !wide && i < sz; ++i)
+        wide = s[i] > 255;
+    void * mem = memory::allocate(sizeof(rep) + sz * (wide ? sizeof(uint32_t) : sizeof(uint8_t)));
+    m_rep = new (mem) rep();
+    m_rep->m_ref_count = 1;
+    m_rep->m_size = sz;
+    m_rep->m_wide = wide;
+    if (wide) {
+        memcpy(const_cast<uint32_t*>(m_rep->wide()), s, sz * sizeof(uint32_t));
+    }
+    else {
+        uint8_t * chars = const_cast<uint8_t*>(m_rep->narrow());
+        for (unsigned i = 0; i < sz; ++i)
+            chars[i] = static_cast<uint8_t>(s[i]);
+    }
+}
+
+void zstring::dec_ref() {
+    if (m_rep && --m_rep->m_ref_count == 0) {
+        m_rep->~rep();
+        memory::deallocate(m_rep);
+    }
+    m_rep = nullptr;
+}
+
+zstring& zstring::operator=(zstring const& other) {
+    if (m_rep != other.m_rep) {
+        if (other.m_rep)
+            other.m_rep->m_ref_count++;
+        dec_ref();
+        m_rep = other.m_rep;
+    }
+    m_offset = other.m_offset;
+    m_length = other.m_length;
+    return *this;
+}
+
+zstring& zstring::operator=(zstring&& other) noexcept {
+    if (this != &other) {
+        dec_ref();
+        m_rep = other.m_rep;
+        m_offset = other.m_offset;
+        m_length = other.m_length;
+        other.m_rep = nullptr;
+        other.m_offset = other.m_length = 0;
+    }
+    return *this;
+}
+
+void zstring::append_to(buffer<uint32_t>& b) const {
+    if (m_length == 0)
+        return;
+    if (m_rep->m_wide) {
+        b.append(m_length, m_rep->wide() + m_offset);
+        return;
+    }
+    uint8_t const * chars = m_rep->narrow() + m_offset;
+    for (unsigned i = 0; i < m_length; ++i)
+        b.push_back(chars[i]);
+}
+
 zstring::zstring(char const* s) {
+    buffer<uint32_t> chars;
     while (*s) {
         unsigned ch = 0;
         if (is_escape_char(s, ch)) {
-            m_buffer.push_back(ch);
+            chars.push_back(ch);
         }
         else {
-            m_buffer.push_back(*s);
+            chars.push_back(*s);
             ++s;
         }
     }
+    init(chars.size(), chars.data());
     SASSERT(well_formed());
 }
 
@@ -96,7 +166,8 @@ string_encoding zstring::get_encoding() {
 }
 
 bool zstring::well_formed() const {
-    for (unsigned ch : m_buffer) {
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
         if (ch > max_char()) {
             IF_VERBOSE(0, verbose_stream() << "large character: " << ch << "\n";);
             return false;
@@ -106,41 +177,33 @@ bool zstring::well_formed() const {
 }
 
 zstring::zstring(unsigned ch) {
-    m_buffer.push_back(ch);
+    init(1, &ch);
 }
 
 zstring zstring::reverse() const {
-    zstring result;
+    buffer<uint32_t> result;
     for (unsigned i = length(); i-- > 0; ) {
-        result.m_buffer.push_back(m_buffer[i]);
+        result.push_back((*this)[i]);
     }
-    return result;
+    return zstring(result.size(), result.data());
 }
 
 zstring zstring::replace(zstring const& src, zstring const& dst) const {
-    zstring result;
     if (length() < src.length()) {
         return zstring(*this);
     }
     if (src.length() == 0) {
         return dst + zstring(*this);
     }
-    bool found = false;
-    for (unsigned i = 0; i < length(); ++i) {
-        bool eq = !found && i + src.length() <= length();
-        for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
-        }
-        if (eq) {
-            result.m_buffer.append(dst.m_buffer);
-            found = true;
-            i += src.length() - 1;
-        }
-        else {
-            result.m_buffer.push_back(m_buffer[i]);
-        }
+    int i = indexofu(src, 0);
+    if (i < 0) {
+        return zstring(*this);
     }
-    return result;
+    buffer<uint32_t> result;
+    extract(0, i).append_to(result);
+    dst.append_to(result);
+    extract(i + src.length(), length()).append_to(result);
+    return zstring(result.size(), result.data());
 }
 
 std::string zstring::encode() const {
@@ -148,9 +211,9 @@ std::string zstring::encode() const {
     char buffer[100];
     unsigned offset = 0;
 #define _flush() if (offset > 0) { buffer[offset] = 0; strm << buffer; offset = 0; }
-    for (unsigned i = 0; i < m_buffer.size(); ++i) {
-        unsigned ch = m_buffer[i];
-        if (ch < 32 || ch >= 128 || ('\\' == ch && i + 1 < m_buffer.size() && 'u' == m_buffer[i+1])) {
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
+        if (ch < 32 || ch >= 128 || ('\\' == ch && i + 1 < length() && 'u' == (*this)[i+1])) {
             _flush();
             strm << "\\u{" << std::hex << ch << std::dec << "}";
         }
@@ -166,33 +229,16 @@ std::string zstring::encode() const {
 
 bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool suffix = true;
-    for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
-    }
-    return suffix;
+    return other.extract(other.length() - length(), length()) == *this;
 }
 
 bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool prefix = true;
-    for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
-    }
-    return prefix;
+    return other.extract(0, length()) == *this;
 }
 
 bool zstring::contains(zstring const& other) const {
-    if (other.length() > length()) return false;
-    unsigned last = length() - other.length();
-    bool cont = false;
-    for (unsigned i = 0; !cont && i <= last; ++i) {
-        cont = true;
-        for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
-        }
-    }
-    return cont;
+    return indexofu(other, 0) >= 0;
 }
 
 int zstring::indexofu(zstring const& other, unsigned offset) const {
@@ -204,7 +250,7 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     for (unsigned i = offset; i <= last; ++i) {
         bool prefix = true;
         for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
+            prefix = (*this)[i + j] == other[j];
         }
         if (prefix) {
             return static_cast<int>(i);
@@ -219,7 +265,7 @@ int zstring::last_indexof(zstring const& other) const {
     for (unsigned last = length() - other.length() + 1; last-- > 0; ) {
         bool suffix = true;
         for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
+            suffix = (*this)[last + j] == other[j];
         }
         if (suffix) {
             return static_cast<int>(last);
@@ -230,22 +276,36 @@ int zstring::last_indexof(zstring const& other) const {
 
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
-    if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
-    }
+    if (offset + len < offset || offset >= length() || len == 0) return result;
+    result = *this;
+    result.m_offset += offset;
+    result.m_length = std::min(offset + len, length()) - offset;
     return result;
 }
 
 unsigned zstring::hash() const {
-    return unsigned_ptr_hash(m_buffer.data(), m_buffer.size(), 23);
+    if (m_length > 0 && m_rep->m_wide)
+        return unsigned_ptr_hash(m_rep->wide() + m_offset, m_length, 23);
+    buffer<uint32_t> chars;
+    append_to(chars);
+    return unsigned_ptr_hash(chars.data(), chars.size(), 23);
 }
 
 zstring zstring::operator+(zstring const& other) const {
-    zstring result(*this);
-    result.m_buffer.append(other.m_buffer);
-    return result;
+    if (other.empty())
+        return *this;
+    if (empty())
+        return other;
+    // adjacent substrings of the same string are joined without copying.
+    if (m_rep == other.m_rep && m_offset + m_length == other.m_offset) {
+        zstring result(*this);
+        result.m_length += other.m_length;
+        return result;
+    }
+    buffer<uint32_t> result;
+    append_to(result);
+    other.append_to(result);
+    return zstring(result.size(), result.data());
 }
 
 
@@ -254,8 +314,14 @@ bool zstring::operator==(const zstring& other) const {
     if (length() != other.length()) {
         return false;
     }
+    if (length() == 0 || (m_rep == other.m_rep && m_offset == other.m_offset)) {
+        return true;
+    }
+    if (!m_rep->m_wide && !other.m_rep->m_wide) {
+        return memcmp(m_rep->narrow() + m_offset, other.m_rep->narrow() + other.m_offset, length()) == 0;
+    }
     for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
+        if ((*this)[i] != other[i]) {
             return false;
         }
     }
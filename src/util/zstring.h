@@ -9,6 +9,11 @@ Abstract:
 
     String wrapper for unicode/ascii internal strings as vectors
 
+    The characters are stored in an immutable, reference counted buffer.
+    Copies and substrings (extract) share the buffer of the original string,
+    so they take constant time. Buffers of strings whose characters all fit
+    in 8 bits use one byte per character.
+
 Author:
 
     Nikolaj Bjorner (nbjorner) 2021-01-26
@@ -16,6 +21,7 @@ Author:
 --*/
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include "util/buffer.h"
@@ -29,7 +35,20 @@ enum class string_encoding {
 
 class zstring {
 private:
-    buffer<uint32_t> m_buffer;
+    struct rep {
+        std::atomic<unsigned> m_ref_count;
+        unsigned              m_size;
+        bool                  m_wide;   // characters are stored as uint32_t, otherwise as uint8_t
+        uint8_t const * narrow() const { return reinterpret_cast<uint8_t const*>(this + 1); }
+        uint32_t const * wide() const { return reinterpret_cast<uint32_t const*>(this + 1); }
+    };
+    rep *    m_rep = nullptr;
+    unsigned m_offset = 0;
+    unsigned m_length = 0;
+    void init(unsigned sz, uint32_t const* s);
+    void inc_ref() { if (m_rep) m_rep->m_ref_count++; }
+    void dec_ref();
+    void append_to(buffer<uint32_t>& b) const;
     bool well_formed() const;
     bool is_escape_char(char const *& s, unsigned& result);
 public:
@@ -66,14 +85,25 @@ public:
     zstring(char const* s);
     zstring(const std::string &str) : zstring(str.c_str()) {}
     zstring(rational const& r): zstring(r.to_string()) {}
-    zstring(unsigned sz, unsigned const* s) { m_buffer.append(sz, s); SASSERT(well_formed()); }
+    zstring(unsigned sz, unsigned const* s) { init(sz, s); SASSERT(well_formed()); }
     zstring(unsigned ch);
+    zstring(zstring const& other): m_rep(other.m_rep), m_offset(other.m_offset), m_length(other.m_length) { inc_ref(); }
+    zstring(zstring&& other) noexcept: m_rep(other.m_rep), m_offset(other.m_offset), m_length(other.m_length) {
+        other.m_rep = nullptr;
+        other.m_offset = other.m_length = 0;
+    }
+    ~zstring() { dec_ref(); }
+    zstring& operator=(zstring const& other);
+    zstring& operator=(zstring&& other) noexcept;
     zstring replace(zstring const& src, zstring const& dst) const;
     zstring reverse() const;
     std::string encode() const;
-    unsigned length() const { return m_buffer.size(); }
-    unsigned operator[](unsigned i) const { return m_buffer[i]; }
-    bool empty() const { return m_buffer.empty(); }
+    unsigned length() const { return m_length; }
+    unsigned operator[](unsigned i) const {
+        SASSERT(i < m_length);
+        return m_rep->m_wide ? m_rep->wide()[m_offset + i] : m_rep->narrow()[m_offset + i];
+    }
+    bool empty() const { return m_length == 0; }
     bool suffixof(zstring const& other) const;
     bool prefixof(zstring const& other) const;
     bool contains(zstring const& other) const;